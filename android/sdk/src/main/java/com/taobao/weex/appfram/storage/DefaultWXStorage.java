@@ -18,8 +18,10 @@
  */
 package com.taobao.weex.appfram.storage;
 
+import android.content.ComponentCallbacks2;
 import android.content.ContentValues;
 import android.content.Context;
+import android.content.res.Configuration;
 import android.database.Cursor;
 import android.database.sqlite.SQLiteDatabase;
 import android.database.sqlite.SQLiteFullException;
@@ -31,29 +33,121 @@ import com.taobao.weex.utils.WXLogUtils;
 
 import java.util.ArrayList;
 import java.util.Date;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
 import java.util.List;
 import java.util.Map;
-import java.util.concurrent.ExecutorService;
+import java.util.Set;
 import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.TimeUnit;
 
 public class DefaultWXStorage implements IWXStorageAdapter {
 
+    /**
+     * mutations within this window are committed in one transaction.
+     * */
+    private static final long FLUSH_DELAY_MS = 1000;
+
     private WXSQLiteOpenHelper mDatabaseSupplier;
 
-    private ExecutorService mExecutorService;
+    private ScheduledExecutorService mExecutorService;
 
-    private void execute(@Nullable final Runnable runnable) {
-        if (mExecutorService == null) {
-            mExecutorService = Executors.newSingleThreadExecutor();
+    /**
+     * the executor is not recreated once closed. guarded by this, like {@link #mExecutorService}.
+     * */
+    private boolean mClosed;
+
+    @Nullable
+    private final Context mApplication;
+
+    private final ComponentCallbacks2 mTrimMemoryCallback = new ComponentCallbacks2() {
+        @Override
+        public void onTrimMemory(int level) {
+            // the app went to background and may be killed, don't wait for the window
+            if (level >= TRIM_MEMORY_UI_HIDDEN) {
+                flushIfStarted();
+            }
+        }
+
+        @Override
+        public void onConfigurationChanged(Configuration newConfig) {
         }
 
+        @Override
+        public void onLowMemory() {
+        }
+    };
+
+    /**
+     * mutations which are not committed yet, in the order they were made. they are only
+     * accessed on the executor thread, and reads are served from them first.
+     * */
+    private final Map<String, PendingMutation> mPendingMutations = new LinkedHashMap<>();
+
+    private boolean mFlushScheduled;
+
+    /**
+     * the last commit failed to write some items, the database is likely full. until a commit
+     * succeeds, items are written right away so that the failure is reported to the caller.
+     * */
+    private boolean mCommitFailed;
+
+    private final Runnable mFlushTask = new Runnable() {
+        @Override
+        public void run() {
+            mFlushScheduled = false;
+            flushPendingMutations();
+        }
+    };
+
+    private static class PendingMutation {
+        static final int SET = 0;
+        static final int REMOVE = 1;
+        static final int TOUCH = 2;
+
+        final int type;
+        final String value;
+        final boolean isPersistent;
+
+        PendingMutation(int type, String value, boolean isPersistent) {
+            this.type = type;
+            this.value = value;
+            this.isPersistent = isPersistent;
+        }
+    }
+
+    private synchronized void execute(@Nullable final Runnable runnable) {
+        if (mClosed) {
+            WXLogUtils.w(WXSQLiteOpenHelper.TAG_STORAGE, "storage is closed");
+            return;
+        }
+        ensureExecutor();
+
         if(runnable != null) {
             mExecutorService.execute(WXThread.secure(runnable));
         }
     }
 
+    private synchronized void flushIfStarted() {
+        if (!mClosed && mExecutorService != null) {
+            mExecutorService.execute(WXThread.secure(mFlushTask));
+        }
+    }
+
+    private synchronized void ensureExecutor() {
+        if (mExecutorService == null) {
+            mExecutorService = Executors.newSingleThreadScheduledExecutor();
+        }
+    }
+
     public DefaultWXStorage(Context context) {
         this.mDatabaseSupplier = new WXSQLiteOpenHelper(context);
+        mApplication = context.getApplicationContext();
+        if (mApplication != null) {
+            mApplication.registerComponentCallbacks(mTrimMemoryCallback);
+        }
     }
 
 
@@ -62,7 +156,7 @@ public class DefaultWXStorage implements IWXStorageAdapter {
         execute(new Runnable() {
             @Override
             public void run() {
-                Map<String, Object> data = StorageResultHandler.setItemResult(performSetItem(key, value, false, true));
+                Map<String, Object> data = StorageResultHandler.setItemResult(pendSetItem(key, value, false));
                 if (listener == null) {
                     return;
                 }
@@ -76,7 +170,7 @@ public class DefaultWXStorage implements IWXStorageAdapter {
         execute(new Runnable() {
             @Override
             public void run() {
-                Map<String, Object> data = StorageResultHandler.getItemResult(performGetItem(key));
+                Map<String, Object> data = StorageResultHandler.getItemResult(pendGetItem(key));
                 if (listener == null) {
                     return;
                 }
@@ -90,7 +184,7 @@ public class DefaultWXStorage implements IWXStorageAdapter {
         execute(new Runnable() {
             @Override
             public void run() {
-                Map<String, Object> data = StorageResultHandler.removeItemResult(performRemoveItem(key));
+                Map<String, Object> data = StorageResultHandler.removeItemResult(pendRemoveItem(key));
                 if (listener == null) {
                     return;
                 }
@@ -104,6 +198,7 @@ public class DefaultWXStorage implements IWXStorageAdapter {
         execute(new Runnable() {
             @Override
             public void run() {
+                flushPendingMutations();
                 Map<String, Object> data = StorageResultHandler.getLengthResult(performGetLength());
                 if (listener == null) {
                     return;
@@ -118,6 +213,7 @@ public class DefaultWXStorage implements IWXStorageAdapter {
         execute(new Runnable() {
             @Override
             public void run() {
+                flushPendingMutations();
                 Map<String, Object> data = StorageResultHandler.getAllkeysResult(performGetAllKeys());
                 if (listener == null) {
                     return;
@@ -132,7 +228,7 @@ public class DefaultWXStorage implements IWXStorageAdapter {
         execute(new Runnable() {
             @Override
             public void run() {
-                Map<String, Object> data = StorageResultHandler.setItemResult(performSetItem(key, value, true, true));
+                Map<String, Object> data = StorageResultHandler.setItemResult(pendSetItem(key, value, true));
                 if (listener == null) {
                     return;
                 }
@@ -142,18 +238,152 @@ public class DefaultWXStorage implements IWXStorageAdapter {
     }
 
     @Override
-    public void close() {
+    public synchronized void close() {
+        if (mClosed) {
+            return;
+        }
+        mClosed = true;
+        if (mApplication != null) {
+            // the application holds its callbacks forever
+            mApplication.unregisterComponentCallbacks(mTrimMemoryCallback);
+        }
         try {
-            mDatabaseSupplier.closeDatabase();
             if (mExecutorService != null) {
+                // commit the pending mutations before the database is closed
+                mExecutorService.execute(WXThread.secure(new Runnable() {
+                    @Override
+                    public void run() {
+                        flushPendingMutations();
+                        mDatabaseSupplier.closeDatabase();
+                    }
+                }));
                 mExecutorService.shutdown();
                 mExecutorService = null;
+            } else {
+                mDatabaseSupplier.closeDatabase();
             }
         } catch (Exception e) {
             WXLogUtils.e(WXSQLiteOpenHelper.TAG_STORAGE, e.getMessage());
         }
     }
 
+    private boolean pendSetItem(String key, String value, boolean isPersistent) {
+        mPendingMutations.remove(key);
+        if (mCommitFailed) {
+            // the pending removals may make room for it
+            flushPendingMutations();
+            boolean result = performSetItem(key, value, isPersistent, true);
+            mCommitFailed = !result || !mPendingMutations.isEmpty();
+            return result;
+        }
+        mPendingMutations.put(key, new PendingMutation(PendingMutation.SET, value, isPersistent));
+        scheduleFlush();
+        return true;
+    }
+
+    private String pendGetItem(String key) {
+        PendingMutation mutation = mPendingMutations.get(key);
+        if (mutation == null) {
+            String value = performGetItem(key);
+            if (value != null) {
+                mPendingMutations.put(key, new PendingMutation(PendingMutation.TOUCH, null, false));
+                scheduleFlush();
+            }
+            return value;
+        }
+        if (mutation.type == PendingMutation.REMOVE) {
+            return null;
+        }
+        if (mutation.type == PendingMutation.TOUCH) {
+            return performGetItem(key);
+        }
+        // a pending SET is committed with a fresh timestamp anyway
+        return mutation.value;
+    }
+
+    private boolean pendRemoveItem(String key) {
+        PendingMutation mutation = mPendingMutations.get(key);
+        boolean exists;
+        if (mutation == null || mutation.type == PendingMutation.TOUCH) {
+            exists = performContainsItem(key);
+        } else {
+            exists = mutation.type == PendingMutation.SET;
+        }
+        if (exists) {
+            mPendingMutations.remove(key);
+            mPendingMutations.put(key, new PendingMutation(PendingMutation.REMOVE, null, false));
+            scheduleFlush();
+        }
+        return exists;
+    }
+
+    private void scheduleFlush() {
+        if (mFlushScheduled) {
+            return;
+        }
+        synchronized (this) {
+            // the task closing the storage commits the pending mutations
+            if (mClosed) {
+                return;
+            }
+            ensureExecutor();
+            mFlushScheduled = true;
+            mExecutorService.schedule(WXThread.secure(mFlushTask), FLUSH_DELAY_MS, TimeUnit.MILLISECONDS);
+        }
+    }
+
+    /**
+     * commit all the pending mutations in one transaction. the items which fail to be written
+     * stay pending, they are still served to reads and retried by the next commit.
+     * */
+    private void flushPendingMutations() {
+        if (mPendingMutations.isEmpty()) {
+            return;
+        }
+        SQLiteDatabase database = mDatabaseSupplier.getDatabase();
+        if (database == null) {
+            return;
+        }
+
+        WXLogUtils.d(WXSQLiteOpenHelper.TAG_STORAGE, "commit " + mPendingMutations.size() + " mutations to storage");
+        Set<String> failedKeys = new LinkedHashSet<>();
+        try {
+            database.beginTransaction();
+            try {
+                for (Map.Entry<String, PendingMutation> entry : mPendingMutations.entrySet()) {
+                    String key = entry.getKey();
+                    PendingMutation mutation = entry.getValue();
+                    if (mutation.type == PendingMutation.SET) {
+                        if (!performSetItem(key, mutation.value, mutation.isPersistent, true)) {
+                            failedKeys.add(key);
+                        }
+                    } else if (mutation.type == PendingMutation.REMOVE) {
+                        performRemoveItem(key);
+                    } else {
+                        performTouchItem(key);
+                    }
+                }
+                database.setTransactionSuccessful();
+            } finally {
+                database.endTransaction();
+            }
+        } catch (Exception e) {
+            WXLogUtils.e(WXSQLiteOpenHelper.TAG_STORAGE, "DefaultWXStorage occurred an exception when commit mutations:" + e.getMessage());
+            mCommitFailed = true;
+            return;
+        }
+        Iterator<Map.Entry<String, PendingMutation>> iterator = mPendingMutations.entrySet().iterator();
+        while (iterator.hasNext()) {
+            if (!failedKeys.contains(iterator.next().getKey())) {
+                iterator.remove();
+            }
+        }
+        for (String key : failedKeys) {
+            WXLogUtils.e(WXSQLiteOpenHelper.TAG_STORAGE, "failed to commit setItem(key = " + key + "), retry later");
+        }
+        mCommitFailed = !failedKeys.isEmpty();
+    }
+
     private boolean performSetItem(String key, String value, boolean isPersistent, boolean allowRetryWhenFull) {
         SQLiteDatabase database = mDatabaseSupplier.getDatabase();
         if (database == null) {
@@ -248,12 +478,6 @@ public class DefaultWXStorage implements IWXStorageAdapter {
                 null, null, null);
         try {
             if (c.moveToNext()) {
-                ContentValues values = new ContentValues();
-                //update timestamp
-                values.put(WXSQLiteOpenHelper.COLUMN_TIMESTAMP, WXSQLiteOpenHelper.sDateFormatter.format(new Date()));
-                int updateResult = mDatabaseSupplier.getDatabase().update(WXSQLiteOpenHelper.TABLE_STORAGE, values, WXSQLiteOpenHelper.COLUMN_KEY + "= ?", new String[]{key});
-
-                WXLogUtils.d(WXSQLiteOpenHelper.TAG_STORAGE, "update timestamp " + (updateResult == 1 ? "success" : "failed") + " for operation [getItem(key = " + key + ")]");
                 return c.getString(c.getColumnIndex(WXSQLiteOpenHelper.COLUMN_VALUE));
             } else {
                 return null;
@@ -266,6 +490,42 @@ public class DefaultWXStorage implements IWXStorageAdapter {
         }
     }
 
+    private boolean performTouchItem(String key) {
+        SQLiteDatabase database = mDatabaseSupplier.getDatabase();
+        if (database == null) {
+            return false;
+        }
+
+        ContentValues values = new ContentValues();
+        //update timestamp
+        values.put(WXSQLiteOpenHelper.COLUMN_TIMESTAMP, WXSQLiteOpenHelper.sDateFormatter.format(new Date()));
+        int updateResult = database.update(WXSQLiteOpenHelper.TABLE_STORAGE, values, WXSQLiteOpenHelper.COLUMN_KEY + "= ?", new String[]{key});
+
+        WXLogUtils.d(WXSQLiteOpenHelper.TAG_STORAGE, "update timestamp " + (updateResult == 1 ? "success" : "failed") + " for operation [getItem(key = " + key + ")]");
+        return updateResult == 1;
+    }
+
+    private boolean performContainsItem(String key) {
+        SQLiteDatabase database = mDatabaseSupplier.getDatabase();
+        if (database == null) {
+            return false;
+        }
+
+        Cursor c = database.query(WXSQLiteOpenHelper.TABLE_STORAGE,
+                new String[]{WXSQLiteOpenHelper.COLUMN_KEY},
+                WXSQLiteOpenHelper.COLUMN_KEY + "=?",
+                new String[]{key},
+                null, null, null);
+        try {
+            return c.moveToNext();
+        } catch (Exception e) {
+            WXLogUtils.e(WXSQLiteOpenHelper.TAG_STORAGE, "DefaultWXStorage occurred an exception when execute containsItem:" + e.getMessage());
+            return false;
+        } finally {
+            c.close();
+        }
+    }
+
     private boolean performRemoveItem(String key) {
         SQLiteDatabase database = mDatabaseSupplier.getDatabase();
         if (database == null) {
@@ -28,6 +28,13 @@ import java.util.Map;
  * storage implementation.
  * */
 public interface IWXStorageAdapter {
+    /**
+     * the writes may be committed behind: the listener can be called with success once the item
+     * is buffered, before it's written to the disk. an implementation which does so must serve
+     * the buffered items to the following reads, keep retrying the ones it fails to commit, and
+     * report failures to the callers again once its commits fail, e.g. when the disk is full.
+     * {@link #setItemPersistent(String, String, OnResultReceivedListener)} follows the same contract.
+     * */
     void setItem(String key, String value,OnResultReceivedListener listener);
 
     void getItem(String key,OnResultReceivedListener listener);
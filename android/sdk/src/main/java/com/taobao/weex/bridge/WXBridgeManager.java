@@ -255,6 +255,9 @@ public class WXBridgeManager implements Callback, BactchExecutor {
     }
     if (wxsdkInstance.isNeedValidate()
         && WXSDKManager.getInstance().getValidateProcessor() != null) {
+      String[] names = WXModuleManager.resolveModuleMethodName(moduleStr, methodStr);
+      moduleStr = names[0];
+      methodStr = names[1];
       WXValidateProcessor.WXModuleValidateResult validateResult = WXSDKManager
           .getInstance().getValidateProcessor()
           .onModuleValidate(wxsdkInstance, moduleStr, methodStr, args, options);
@@ -1965,7 +1968,9 @@ public class WXBridgeManager implements Callback, BactchExecutor {
     }
 
     WXJSObject[] args = {new WXJSObject(WXJSObject.JSON,
-        WXJsonUtils.fromObjectToJSONString(modules))};
+        WXJsonUtils.fromObjectToJSONString(modules)),
+        new WXJSObject(WXJSObject.JSON,
+            WXJsonUtils.fromObjectToJSONString(WXModuleManager.getModuleDispatchIds(modules.keySet())))};
     try {
       mWXBridge.execJS("", null, METHOD_REGISTER_MODULES, args);
     } catch (Throwable e) {
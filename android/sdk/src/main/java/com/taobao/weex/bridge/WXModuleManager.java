@@ -39,8 +39,11 @@ import com.taobao.weex.utils.WXExceptionUtils;
 import com.taobao.weex.utils.WXLogUtils;
 
 import java.io.Serializable;
+import java.util.ArrayList;
+import java.util.Collection;
 import java.util.HashMap;
 import java.util.Iterator;
+import java.util.List;
 import java.util.Map;
 import java.util.Map.Entry;
 import java.util.concurrent.ConcurrentHashMap;
@@ -59,6 +62,14 @@ public class WXModuleManager {
   private static Map<String, WXModule> sGlobalModuleMap = new HashMap<>();
   private static Map<String, WXDomModule> sDomModuleMap = new HashMap<>();
 
+  /**
+   * module dispatch table, indexed by module id. Ids are published to JavaScript along with
+   * registerModules, so that module methods can be called without resolving names every call.
+   * Only accessed in js thread.
+   */
+  private static List<ModuleDispatchEntry> sModuleDispatchTable = new ArrayList<>();
+  private static Map<String, ModuleDispatchEntry> sModuleDispatchMap = new HashMap<>();
+
   /**
    * monitor keys
    */
@@ -129,9 +140,89 @@ public class WXModuleManager {
       //may throw this exception:
       //java.lang.String cannot be stored in an array of type java.util.HashMap$HashMapEntry[]
     }
+    registerDispatchEntry(moduleName, factory);
     return true;
   }
 
+  private static void registerDispatchEntry(String moduleName, ModuleFactory factory) {
+    // keep the id of a re-registered module, js framework may have cached it.
+    ModuleDispatchEntry old = sModuleDispatchMap.get(moduleName);
+    int moduleId = old != null ? old.mId : sModuleDispatchTable.size();
+    ModuleDispatchEntry entry = new ModuleDispatchEntry(moduleId, moduleName, factory);
+    if (old != null) {
+      sModuleDispatchTable.set(moduleId, entry);
+    } else {
+      sModuleDispatchTable.add(entry);
+    }
+    sModuleDispatchMap.put(moduleName, entry);
+  }
+
+  /**
+   * Get dispatch ids of modules.
+   * @param moduleNames module names
+   * @return ids formatted as {name: {id: moduleId, methods: {method: methodId}}}
+   */
+  static Map<String, Object> getModuleDispatchIds(Collection<String> moduleNames) {
+    Map<String, Object> dispatchIds = new HashMap<>();
+    for (String moduleName : moduleNames) {
+      ModuleDispatchEntry entry = sModuleDispatchMap.get(moduleName);
+      if (entry == null) {
+        continue;
+      }
+      Map<String, Integer> methodIds = new HashMap<>();
+      for (int i = 0; i < entry.mMethods.length; i++) {
+        methodIds.put(entry.mMethods[i], i);
+      }
+      Map<String, Object> ids = new HashMap<>();
+      ids.put("id", entry.mId);
+      ids.put("methods", methodIds);
+      dispatchIds.put(moduleName, ids);
+    }
+    return dispatchIds;
+  }
+
+  /**
+   * Resolve module name and method name, which may be dispatch ids passed through JNI as strings.
+   * @return {moduleName, methodName}
+   */
+  static String[] resolveModuleMethodName(String moduleStr, String methodStr) {
+    ModuleDispatchEntry entry = findDispatchEntry(moduleStr);
+    if (entry == null) {
+      return new String[]{moduleStr, methodStr};
+    }
+    int methodId = parseDispatchId(methodStr);
+    if (methodId >= 0 && methodId < entry.mMethods.length) {
+      methodStr = entry.mMethods[methodId];
+    }
+    return new String[]{entry.mName, methodStr};
+  }
+
+  private static ModuleDispatchEntry findDispatchEntry(String moduleStr) {
+    int moduleId = parseDispatchId(moduleStr);
+    if (moduleId >= 0) {
+      return moduleId < sModuleDispatchTable.size() ? sModuleDispatchTable.get(moduleId) : null;
+    }
+    return sModuleDispatchMap.get(moduleStr);
+  }
+
+  /**
+   * @return the dispatch id, or -1 if the string is a name.
+   */
+  private static int parseDispatchId(String str) {
+    if (str == null || str.length() == 0 || str.length() > 9) {
+      return -1;
+    }
+    int id = 0;
+    for (int i = 0; i < str.length(); i++) {
+      char c = str.charAt(i);
+      if (c < '0' || c > '9') {
+        return -1;
+      }
+      id = id * 10 + (c - '0');
+    }
+    return id;
+  }
+
   static boolean registerJSModule(String moduleName, ModuleFactory factory) {
     Map<String, Object> modules = new HashMap<>();
     modules.put(moduleName, factory.getMethods());
@@ -140,11 +231,21 @@ public class WXModuleManager {
   }
 
   static Object callModuleMethod(final String instanceId, String moduleStr, String methodStr, JSONArray args) {
-    ModuleFactory factory = sModuleFactoryMap.get(moduleStr);
-    if(factory == null){
+    ModuleDispatchEntry entry = findDispatchEntry(moduleStr);
+    if(entry == null){
       WXLogUtils.e("[WXModuleManager] module factory not found.");
       return null;
     }
+    ModuleFactory factory = entry.mFactory;
+    moduleStr = entry.mName;
+    final Invoker invoker;
+    int methodId = parseDispatchId(methodStr);
+    if (methodId >= 0 && methodId < entry.mInvokers.length) {
+      invoker = entry.mInvokers[methodId];
+      methodStr = entry.mMethods[methodId];
+    } else {
+      invoker = factory.getMethodInvoker(methodStr);
+    }
     final WXModule wxModule = findModule(instanceId, moduleStr,factory);
     if (wxModule == null) {
       return null;
@@ -152,7 +253,6 @@ public class WXModuleManager {
     WXSDKInstance instance = WXSDKManager.getInstance().getSDKInstance(instanceId);
     wxModule.mWXSDKInstance = instance;
 
-    final Invoker invoker = factory.getMethodInvoker(methodStr);
     try {
       if(instance != null) {
         IWXUserTrackAdapter userTrackAdapter = WXSDKManager.getInstance().getIWXUserTrackAdapter();
@@ -411,6 +511,29 @@ public class WXModuleManager {
     return sDomModuleMap.get(instanceId);
   }
 
+  /**
+   * Methods of a module resolved on registration, indexed by method id.
+   */
+  private static class ModuleDispatchEntry {
+    final int mId;
+    final String mName;
+    final ModuleFactory mFactory;
+    final String[] mMethods;
+    final Invoker[] mInvokers;
+
+    ModuleDispatchEntry(int id, String name, ModuleFactory factory) {
+      mId = id;
+      mName = name;
+      mFactory = factory;
+      String[] methods = factory.getMethods();
+      mMethods = methods != null ? methods : new String[0];
+      mInvokers = new Invoker[mMethods.length];
+      for (int i = 0; i < mMethods.length; i++) {
+        mInvokers[i] = factory.getMethodInvoker(mMethods[i]);
+      }
+    }
+  }
+
   public static void reload(){
     if (sModuleFactoryMap != null && sModuleFactoryMap.size() > 0) {
       for (Map.Entry<String, ModuleFactory> entry : sModuleFactoryMap.entrySet()) {
@@ -322,15 +322,33 @@ public class WXTextDomObject extends WXDomObject {
   Layout createLayout(float width, boolean forceWidth, @Nullable Layout previousLayout) {
     float textWidth;
     textWidth = getTextWidth(mTextPaint, width, forceWidth);
-    Layout layout;
+    WXTextLayoutCache.Key key = null;
     if (!FloatUtil.floatsEqual(previousWidth, textWidth) || previousLayout == null) {
-      boolean forceRtl = false;
-      Object direction = getStyles().get(Constants.Name.DIRECTION);
-      if (direction != null && "text".equals(mType)) {
-        forceRtl = direction.equals(Constants.Name.RTL);
+      // subclasses may build their spans differently
+      if (getClass() == WXTextDomObject.class && mText != null) {
+        key = new WXTextLayoutCache.Key(mText, (int) Math.ceil(textWidth), mIsColorSet ? mColor : UNSET,
+            mFontSize, mFontStyle, mFontWeight, mLineHeight, mNumberOfLines, mFontFamily, mAlignment,
+            textOverflow, mTextDecoration, isForceRtl());
+        Layout cached = WXTextLayoutCache.get(key);
+        if (cached != null) {
+          return cached;
+        }
       }
+    }
+    Layout layout = createLayoutImp(textWidth, previousLayout);
+    if (key != null) {
+      WXTextLayoutCache.put(key, layout);
+    }
+    return layout;
+  }
+
+  private
+  @NonNull
+  Layout createLayoutImp(float textWidth, @Nullable Layout previousLayout) {
+    Layout layout;
+    if (!FloatUtil.floatsEqual(previousWidth, textWidth) || previousLayout == null) {
       layout = StaticLayoutProxy.create(spanned, mTextPaint, (int) Math.ceil(textWidth),
-          Layout.Alignment.ALIGN_NORMAL, 1, 0, false, forceRtl);
+          Layout.Alignment.ALIGN_NORMAL, 1, 0, false, isForceRtl());
     } else {
       layout = previousLayout;
     }
@@ -356,6 +374,11 @@ public class WXTextDomObject extends WXDomObject {
     return layout;
   }
 
+  private boolean isForceRtl() {
+    Object direction = getStyles().get(Constants.Name.DIRECTION);
+    return direction != null && "text".equals(mType) && direction.equals(Constants.Name.RTL);
+  }
+
   /**
    * Truncate the source span to the specified lines.
    * Caller of this method must ensure that the lines of text is <strong>greater than desired lines and need truncate</strong>.
@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ * 
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+package com.taobao.weex.dom;
+
+import android.support.annotation.NonNull;
+import android.support.annotation.Nullable;
+import android.support.v4.util.LruCache;
+import android.text.Layout;
+import android.text.TextUtils;
+
+import com.taobao.weex.ui.component.WXTextDecoration;
+
+/**
+ * Text layouts shared by the text nodes with the same text, style and width, like the
+ * price labels or the tags repeated in list cells. A {@link Layout} is immutable once it's
+ * created, so the nodes measure and draw with the same one.
+ * The least recently used layouts are evicted when their estimated size exceeds the limit.
+ */
+public class WXTextLayoutCache {
+
+  // estimated bytes of a character, with its glyph and position, and of a line
+  private static final int CHAR_SIZE = 16;
+  private static final int LINE_SIZE = 64;
+  private static final int MAX_SIZE = 1024 * 1024;
+
+  private static final LruCache<Key, Layout> sLayouts = new LruCache<Key, Layout>(MAX_SIZE) {
+    @Override
+    protected int sizeOf(Key key, Layout layout) {
+      return key.text.length() * CHAR_SIZE + layout.getLineCount() * LINE_SIZE;
+    }
+  };
+
+  /**
+   * The text with everything its layout depends on.
+   */
+  static class Key {
+    final String text;
+    final int width;
+    final int color;
+    final int fontSize;
+    final int fontStyle;
+    final int fontWeight;
+    final int lineHeight;
+    final int lines;
+    final @Nullable String fontFamily;
+    final @Nullable Layout.Alignment alignment;
+    final @Nullable TextUtils.TruncateAt textOverflow;
+    final WXTextDecoration textDecoration;
+    final boolean forceRtl;
+    private final int hashCode;
+
+    Key(@NonNull String text, int width, int color, int fontSize, int fontStyle, int fontWeight,
+        int lineHeight, int lines, @Nullable String fontFamily, @Nullable Layout.Alignment alignment,
+        @Nullable TextUtils.TruncateAt textOverflow, WXTextDecoration textDecoration, boolean forceRtl) {
+      this.text = text;
+      this.width = width;
+      this.color = color;
+      this.fontSize = fontSize;
+      this.fontStyle = fontStyle;
+      this.fontWeight = fontWeight;
+      this.lineHeight = lineHeight;
+      this.lines = lines;
+      this.fontFamily = fontFamily;
+      this.alignment = alignment;
+      this.textOverflow = textOverflow;
+      this.textDecoration = textDecoration;
+      this.forceRtl = forceRtl;
+
+      int result = text.hashCode();
+      result = 31 * result + width;
+      result = 31 * result + color;
+      result = 31 * result + fontSize;
+      result = 31 * result + fontStyle;
+      result = 31 * result + fontWeight;
+      result = 31 * result + lineHeight;
+      result = 31 * result + lines;
+      result = 31 * result + (fontFamily != null ? fontFamily.hashCode() : 0);
+      result = 31 * result + (alignment != null ? alignment.hashCode() : 0);
+      result = 31 * result + (textOverflow != null ? textOverflow.hashCode() : 0);
+      result = 31 * result + (textDecoration != null ? textDecoration.hashCode() : 0);
+      result = 31 * result + (forceRtl ? 1 : 0);
+      hashCode = result;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+      if (this == o) {
+        return true;
+      }
+      if (!(o instanceof Key)) {
+        return false;
+      }
+      Key key = (Key) o;
+      return hashCode == key.hashCode
+          && width == key.width
+          && color == key.color
+          && fontSize == key.fontSize
+          && fontStyle == key.fontStyle
+          && fontWeight == key.fontWeight
+          && lineHeight == key.lineHeight
+          && lines == key.lines
+          && forceRtl == key.forceRtl
+          && alignment == key.alignment
+          && textOverflow == key.textOverflow
+          && textDecoration == key.textDecoration
+          && TextUtils.equals(fontFamily, key.fontFamily)
+          && text.equals(key.text);
+    }
+
+    @Override
+    public int hashCode() {
+      return hashCode;
+    }
+  }
+
+  static @Nullable Layout get(@NonNull Key key) {
+    return sLayouts.get(key);
+  }
+
+  static void put(@NonNull Key key, @NonNull Layout layout) {
+    sLayouts.put(key, layout);
+  }
+
+  /**
+   * Drop all the layouts, for example when a font is loaded, the texts laid out
+   * with the fallback font have to be laid out again.
+   */
+  public static void clear() {
+    sLayouts.evictAll();
+  }
+
+  public static int hitCount() {
+    return sLayouts.hitCount();
+  }
+
+  public static int missCount() {
+    return sLayouts.missCount();
+  }
+}
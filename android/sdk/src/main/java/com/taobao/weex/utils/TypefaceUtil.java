@@ -31,6 +31,7 @@ import com.taobao.weex.adapter.IWXHttpAdapter;
 import com.taobao.weex.common.WXRequest;
 import com.taobao.weex.common.WXResponse;
 import com.taobao.weex.dom.WXStyle;
+import com.taobao.weex.dom.WXTextLayoutCache;
 
 import java.io.File;
 import java.util.HashMap;
@@ -121,6 +122,8 @@ public class TypefaceUtil {
         }
         fontDo.setState(FontDO.STATE_SUCCESS);
         fontDo.setTypeface(typeface);
+        // the texts were laid out with the fallback font
+        WXTextLayoutCache.clear();
       } else {
         WXLogUtils.e(TAG, "Font asset file not found " + fontDo.getUrl());
       }
@@ -239,6 +242,7 @@ public class TypefaceUtil {
         if (fontDo != null) {
           fontDo.setState(FontDO.STATE_SUCCESS);
           fontDo.setTypeface(typeface);
+          WXTextLayoutCache.clear();
           if(WXEnvironment.isApkDebugable()) {
             WXLogUtils.d(TAG, "load local font file success");
           }
@@ -22,6 +22,7 @@ import android.graphics.Color;
 import android.graphics.LinearGradient;
 import android.graphics.Shader;
 import android.support.annotation.NonNull;
+import android.support.v4.util.LruCache;
 import android.util.Pair;
 import android.text.TextUtils;
 
@@ -37,6 +38,11 @@ import java.util.StringTokenizer;
 public class WXResourceUtils {
 
   private final static Map<String, Integer> colorMap = new HashMap<>();
+  /**
+   * Parsed colors by their strings, a page uses the same few colors again and again.
+   * Strings which aren't colors aren't cached, as the result depends on the default color.
+   */
+  private final static LruCache<String, Integer> colorCache = new LruCache<>(512);
   private final static int RGB_SIZE = 3;
   private final static int RGBA_SIZE = 4;
   private final static int HEX = 16;
@@ -236,6 +242,11 @@ public class WXResourceUtils {
     if (TextUtils.isEmpty(color)) {
       return defaultColor;
     }
+    Integer cached = colorCache.get(color);
+    if (cached != null) {
+      return cached;
+    }
+    String key = color;
     color = color.trim(); //remove non visible codes
 
     int resultColor = defaultColor;
@@ -246,6 +257,7 @@ public class WXResourceUtils {
         result = handler.handle(color);
         if (result.first) {
           resultColor = result.second;
+          colorCache.put(key, resultColor);
           break;
         }
       } catch (RuntimeException e) {
@@ -18,7 +18,9 @@
  */
 package com.taobao.weex.appfram.storage;
 
+import static org.junit.Assert.assertEquals;
 import static org.mockito.Mockito.anyMapOf;
+import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.timeout;
 import static org.mockito.Mockito.verify;
 import static org.powermock.api.mockito.PowerMockito.mockStatic;
@@ -29,6 +31,7 @@ import org.junit.Before;
 import org.junit.Rule;
 import org.junit.Test;
 import org.junit.runner.RunWith;
+import org.mockito.ArgumentCaptor;
 import org.mockito.Mock;
 import org.mockito.MockitoAnnotations;
 import org.powermock.core.classloader.annotations.PowerMockIgnore;
@@ -37,6 +40,8 @@ import org.robolectric.RobolectricTestRunner;
 import org.robolectric.RuntimeEnvironment;
 import org.robolectric.annotation.Config;
 
+import java.util.Map;
+
 /**
  * Created by sospartan on 7/28/16.
  */
@@ -104,4 +109,22 @@ public class DefaultWXStorageTest {
     verify(listener,timeout(3000).times(1)).onReceived(anyMapOf(String.class,Object.class));
     storage.close();
   }
+
+  @Test
+  public void testReadPendingWrites() throws Exception {
+    storage.setItem("key1","value1",null);
+    storage.setItem("key2","value2",null);
+    storage.removeItem("key2",null);
+    storage.getItem("key1",listener);
+
+    ArgumentCaptor<Map> captor = ArgumentCaptor.forClass(Map.class);
+    verify(listener,timeout(3000).times(1)).onReceived(captor.capture());
+    assertEquals("value1",captor.getValue().get("data"));
+
+    IWXStorageAdapter.OnResultReceivedListener lengthListener = mock(IWXStorageAdapter.OnResultReceivedListener.class);
+    storage.length(lengthListener);
+    verify(lengthListener,timeout(3000).times(1)).onReceived(captor.capture());
+    assertEquals(1L,captor.getValue().get("data"));
+    storage.close();
+  }
 }
@@ -35,6 +35,9 @@ import org.robolectric.RobolectricTestRunner;
 import org.robolectric.RuntimeEnvironment;
 import org.robolectric.annotation.Config;
 
+import java.util.Arrays;
+import java.util.Map;
+
 import static org.junit.Assert.*;
 
 /**
@@ -90,6 +93,27 @@ public class WXModuleManagerTest {
     WXModuleManager.callModuleMethod(instance.getInstanceId(),"test1","testCallbackMethod",args);
   }
 
+  @Test
+  public void testModuleDispatchIds() throws Exception {
+    Map<String, Object> dispatchIds = WXModuleManager.getModuleDispatchIds(Arrays.asList("test1", "test2", "test"));
+    assertNull(dispatchIds.get("test"));
+
+    Map<String, Object> ids = (Map<String, Object>) dispatchIds.get("test1");
+    int moduleId = (Integer) ids.get("id");
+    int methodId = ((Map<String, Integer>) ids.get("methods")).get("testMethod");
+    assertNotEquals(moduleId, ((Map<String, Object>) dispatchIds.get("test2")).get("id"));
+
+    String[] names = WXModuleManager.resolveModuleMethodName(String.valueOf(moduleId), String.valueOf(methodId));
+    assertEquals("test1", names[0]);
+    assertEquals("testMethod", names[1]);
+
+    names = WXModuleManager.resolveModuleMethodName("test2", "testMethod");
+    assertEquals("test2", names[0]);
+    assertEquals("testMethod", names[1]);
+
+    WXModuleManager.callModuleMethod(instance.getInstanceId(), String.valueOf(moduleId), String.valueOf(methodId), null);
+  }
+
   @Test
   public void testDestroyInstanceModules() throws Exception {
     testCallModuleMethod();//module instance is lazy create.
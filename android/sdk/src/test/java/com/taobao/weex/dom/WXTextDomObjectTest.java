@@ -71,6 +71,26 @@ public class WXTextDomObjectTest {
     assertEquals(output.width,10f,0.1f);
   }
 
+  @Test
+  public void testSharedLayout() throws Exception {
+    WXTextLayoutCache.clear();
+    WXTextDomObject other = new WXTextDomObject();
+    other.getStyles().put(LINES,10);
+    other.getStyles().put(FONT_SIZE,10);
+    other.getAttrs().put(VALUE,"test");
+    dom.layoutBefore();
+    other.layoutBefore();
+
+    int hits = WXTextLayoutCache.hitCount();
+    MeasureOutput output = new MeasureOutput();
+    WXTextDomObject.TEXT_MEASURE_FUNCTION.measure(dom,100,output);
+    MeasureOutput otherOutput = new MeasureOutput();
+    WXTextDomObject.TEXT_MEASURE_FUNCTION.measure(other,100,otherOutput);
+
+    assertEquals(hits + 1,WXTextLayoutCache.hitCount());
+    assertEquals(output.height,otherOutput.height,0.1f);
+  }
+
   @Test
   public void testLayoutAfter() throws Exception {
     dom.layoutAfter();
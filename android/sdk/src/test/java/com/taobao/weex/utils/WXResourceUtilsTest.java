@@ -131,6 +131,17 @@ public class WXResourceUtilsTest {
     assertEquals(color, Integer.MIN_VALUE);
   }
 
+  @Test
+  public void testCachedColor() throws Exception {
+    assertEquals(WXResourceUtils.getColor(" #ff0000 "), 0xffff0000);
+    assertEquals(WXResourceUtils.getColor(" #ff0000 "), 0xffff0000);
+    assertEquals(WXResourceUtils.getColor("red", 0), 0xffff0000);
+
+    //strings which aren't colors get the default color every time
+    assertEquals(WXResourceUtils.getColor("#sss", 1), 1);
+    assertEquals(WXResourceUtils.getColor("#sss", 2), 2);
+  }
+
   @Test
   public void testGetShader() throws Exception {
     Shader shader = WXResourceUtils.getShader("linear-gradient(to bottom,#a80077,blue)", 100, 100);
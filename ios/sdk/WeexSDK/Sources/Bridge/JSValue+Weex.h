@@ -23,4 +23,10 @@
 
 + (JSValue *)wx_valueWithReturnValueFromInvocation:(NSInvocation *)invocation inContext:(JSContext *)context;
 
+/**
+ * Convert the element sent by JS framework to dictionary, the element may be
+ * an object or a pre-encoded JSON string.
+ */
+- (NSDictionary *)wx_toElementDictionary;
+
 @end
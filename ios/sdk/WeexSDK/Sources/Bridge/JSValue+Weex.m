@@ -18,6 +18,7 @@
  */
 
 #import "JSValue+Weex.h"
+#import "WXUtility.h"
 #import <objc/runtime.h>
 
 @implementation JSValue (Weex)
@@ -98,4 +99,14 @@
     return returnValue;
 }
 
+- (NSDictionary *)wx_toElementDictionary
+{
+    if ([self isString]) {
+        NSData *data = [[self toString] dataUsingEncoding:NSUTF8StringEncoding];
+        id element = data ? WXJSONObjectFromData(data) : nil;
+        return [element isKindOfClass:[NSDictionary class]] ? element : nil;
+    }
+    return [self toDictionary];
+}
+
 @end
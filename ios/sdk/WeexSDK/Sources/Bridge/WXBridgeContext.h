@@ -79,6 +79,13 @@
  *  @param method    :   object of bridge method
  **/
 - (void)executeJsMethod:(WXCallJSMethod *)method;
+
+/**
+ *  Execute JS Methods, the ones of an instance are sent in one call
+ *  @param methods   :   objects of bridge method
+ **/
+- (void)executeJsMethods:(NSArray<WXCallJSMethod *> *)methods;
+
 /**
  *  Register Modules Method
  *  @param modules   :   module list
@@ -41,6 +41,7 @@
 #import "WXPrerenderManager.h"
 #import "WXTracingManager.h"
 #import "WXExceptionUtils.h"
+#import "WXCodeCache.h"
 
 #define SuppressPerformSelectorLeakWarning(Stuff) \
 do { \
@@ -341,6 +342,31 @@ _Pragma("clang diagnostic pop") \
         return [method invoke];
     }];
     
+    if ([_jsBridge respondsToSelector:@selector(registerCallNativeModuleById:)]) {
+        [_jsBridge registerCallNativeModuleById:^NSInvocation*(NSString *instanceId, NSUInteger moduleId, NSUInteger methodId, NSArray *arguments, NSDictionary *options) {
+            
+            WXModuleMethodDescriptor *descriptor = [WXModuleFactory methodDescriptorWithModuleId:moduleId methodId:methodId];
+            if (!descriptor) {
+                WXLogError(@"module method not found for callNativeModule:%lu.%lu", (unsigned long)moduleId, (unsigned long)methodId);
+                return nil;
+            }
+            
+            WXSDKInstance *instance = [WXSDKManager instanceForID:instanceId];
+            
+            if (!instance) {
+                WXLogInfo(@"instance not found for callNativeModule:%@.%@, maybe already destroyed", descriptor.moduleName, descriptor.methodName);
+                return nil;
+            }
+            
+            WXModuleMethod *method = [[WXModuleMethod alloc] initWithMethodDescriptor:descriptor arguments:arguments options:options instance:instance];
+            if(![descriptor.moduleName isEqualToString:@"dom"] && instance.needPrerender){
+                [WXPrerenderManager storePrerenderModuleTasks:method forUrl:instance.scriptURL.absoluteString];
+                return nil;
+            }
+            return [method invoke];
+        }];
+    }
+    
     [_jsBridge registerCallNativeComponent:^void(NSString *instanceId, NSString *componentRef, NSString *methodName, NSArray *args, NSDictionary *options) {
         WXSDKInstance *instance = [WXSDKManager instanceForID:instanceId];
         WXComponentMethod *method = [[WXComponentMethod alloc] initWithComponentRef:componentRef methodName:methodName arguments:args instance:instance];
@@ -502,7 +528,9 @@ _Pragma("clang diagnostic pop") \
     
     WX_MONITOR_PERF_START(WXPTFrameworkExecute);
 
-    [self.jsBridge executeJSFramework:script];
+    if (![[WXCodeCache sharedCache] executeScript:script sourceURL:[NSURL URLWithString:@"native-bundle-main.js"] bridge:self.jsBridge]) {
+        [self.jsBridge executeJSFramework:script];
+    }
     
     WX_MONITOR_PERF_END(WXPTFrameworkExecute);
     
@@ -557,6 +585,21 @@ _Pragma("clang diagnostic pop") \
     [self performSelector:@selector(_sendQueueLoop) withObject:nil];
 }
 
+- (void)executeJsMethods:(NSArray<WXCallJSMethod *> *)methods
+{
+    WXAssertBridgeThread();
+    
+    for (WXCallJSMethod *method in methods) {
+        NSMutableArray *sendQueue = method.instance ? self.sendQueue[method.instance.instanceId] : nil;
+        if (!sendQueue) {
+            WXLogInfo(@"No send queue for instance:%@, may it has been destroyed so method:%@ is ignored", method.instance, method.methodName);
+            continue;
+        }
+        [sendQueue addObject:method];
+    }
+    [self performSelector:@selector(_sendQueueLoop) withObject:nil];
+}
+
 - (void)executeAllJsService
 {
     for(NSDictionary *service in _jsServiceQueue) {
@@ -572,7 +615,9 @@ _Pragma("clang diagnostic pop") \
 {
     if(self.frameworkLoadFinished) {
         WXAssert(script, @"param script required!");
-        [self.jsBridge executeJavascript:script];
+        if (![[WXCodeCache sharedCache] executeScript:script sourceURL:nil bridge:self.jsBridge]) {
+            [self.jsBridge executeJavascript:script];
+        }
         
         if ([self.jsBridge exception]) {
             NSString *exception = [[self.jsBridge exception] toString];
@@ -596,7 +641,13 @@ _Pragma("clang diagnostic pop") \
     
     if(!modules) return;
     
-    [self callJSMethod:@"registerModules" args:@[modules]];
+    if ([_jsBridge respondsToSelector:@selector(registerCallNativeModuleById:)]) {
+        // publish the dispatch ids, so that js framework could call module methods by ids.
+        NSDictionary *dispatchIds = [WXModuleFactory moduleDispatchIdsWithNames:[modules allKeys]];
+        [self callJSMethod:@"registerModules" args:@[modules, dispatchIds]];
+    } else {
+        [self callJSMethod:@"registerModules" args:@[modules]];
+    }
 }
 
 - (void)registerComponents:(NSArray *)components
@@ -32,5 +32,10 @@
 
 - (NSInvocation *)invocationWithTarget:(id)target selector:(SEL)selector;
 
+/**
+ * Same as invocationWithTarget:selector:, using a method signature resolved in advance.
+ */
+- (NSInvocation *)invocationWithTarget:(id)target selector:(SEL)selector signature:(NSMethodSignature *)signature;
+
 @end
 
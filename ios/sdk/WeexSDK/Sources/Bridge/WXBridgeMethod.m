@@ -91,11 +91,15 @@
 }
 
 - (NSInvocation *)invocationWithTarget:(id)target selector:(SEL)selector
+{
+    return [self invocationWithTarget:target selector:selector signature:[target methodSignatureForSelector:selector]];
+}
+
+- (NSInvocation *)invocationWithTarget:(id)target selector:(SEL)selector signature:(NSMethodSignature *)signature
 {
     WXAssert(target, @"No target for method:%@", self);
     WXAssert(selector, @"No selector for method:%@", self);
     
-    NSMethodSignature *signature = [target methodSignatureForSelector:selector];
     if (!signature) {
         NSString *errorMessage = [NSString stringWithFormat:@"target:%@, selector:%@ doesn't have a method signature", target, NSStringFromSelector(selector)];
         WX_MONITOR_FAIL(WXMTJSBridge, WX_ERR_INVOKE_NATIVE, errorMessage);
@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "WXBridgeProtocol.h"
+
+/**
+ * Caches the bytecode of the js framework and services on disk, by the hash of the script, so
+ * the next launch doesn't parse them again. It's used with bridges that implement the code cache
+ * methods of WXBridgeProtocol.
+ */
+@interface WXCodeCache : NSObject
+
++ (instancetype)sharedCache;
+
+/**
+ * Executes the script with the bridge, from the bytecode cached by a previous run if there is a
+ * valid one, otherwise the bytecode is cached after the script is executed.
+ * Returns NO without executing the script if the bridge doesn't support code caches.
+ */
+- (BOOL)executeScript:(NSString *)script sourceURL:(NSURL *)sourceURL bridge:(id<WXBridgeProtocol>)bridge;
+
+/**
+ * Removes all the cached bytecode.
+ */
+- (void)clear;
+
+/**
+ * hits, misses, rejections, stores, evictions and bytes of the cache.
+ */
+- (NSDictionary *)metrics;
+
+@end
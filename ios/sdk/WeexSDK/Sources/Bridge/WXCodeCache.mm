@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXCodeCache.h"
+#import "WXCodeCacheStore.h"
+#import "WXLog.h"
+
+// the cached bytecode of scripts which are not used any more is removed beyond this
+static const size_t WXCodeCacheCapacity = 20 * 1024 * 1024;
+
+class WXBridgeCodeCacheEngine : public WXCodeCacheEngine {
+public:
+    WXBridgeCodeCacheEngine(id<WXBridgeProtocol> bridge, NSString *script, NSURL *sourceURL)
+    : _bridge(bridge), _script(script), _sourceURL(sourceURL) {}
+
+    std::string version() override
+    {
+        NSString *version = [_bridge codeCacheVersion];
+        return version.UTF8String ?: "";
+    }
+
+    bool execute(const char *source, size_t length, const uint8_t *cache, size_t cacheLength) override
+    {
+        // the entry is mapped until the store's execute returns
+        NSData *codeCache = cache ? [NSData dataWithBytesNoCopy:(void *)cache length:cacheLength freeWhenDone:NO] : nil;
+        return [_bridge executeJavascript:_script sourceURL:_sourceURL codeCache:codeCache];
+    }
+
+    bool produce(const char *source, size_t length, std::vector<uint8_t> &cache) override
+    {
+        NSData *codeCache = [_bridge codeCacheForJavascript:_script sourceURL:_sourceURL];
+        if (codeCache.length == 0) {
+            return false;
+        }
+        const uint8_t *bytes = (const uint8_t *)codeCache.bytes;
+        cache.assign(bytes, bytes + codeCache.length);
+        return true;
+    }
+
+private:
+    id<WXBridgeProtocol> _bridge;
+    NSString *_script;
+    NSURL *_sourceURL;
+};
+
+@implementation WXCodeCache
+{
+    std::unique_ptr<WXCodeCacheStore> _store;
+}
+
++ (instancetype)sharedCache
+{
+    static WXCodeCache *sharedCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[WXCodeCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        NSString *cacheDirectory = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        NSString *directory = [cacheDirectory stringByAppendingPathComponent:@"wxcodecache"];
+        _store.reset(new WXCodeCacheStore(directory.fileSystemRepresentation, WXCodeCacheCapacity));
+    }
+    return self;
+}
+
+- (BOOL)executeScript:(NSString *)script sourceURL:(NSURL *)sourceURL bridge:(id<WXBridgeProtocol>)bridge
+{
+    if (![bridge respondsToSelector:@selector(codeCacheVersion)]
+        || ![bridge respondsToSelector:@selector(executeJavascript:sourceURL:codeCache:)]
+        || ![bridge respondsToSelector:@selector(codeCacheForJavascript:sourceURL:)]) {
+        return NO;
+    }
+    
+    // the scripts are hashed as UTF-16, which NSString usually holds already
+    NSUInteger length = script.length;
+    const UniChar *characters = CFStringGetCharactersPtr((__bridge CFStringRef)script);
+    NSMutableData *buffer = nil;
+    if (!characters) {
+        buffer = [NSMutableData dataWithLength:length * sizeof(UniChar)];
+        [script getCharacters:(unichar *)buffer.mutableBytes range:NSMakeRange(0, length)];
+        characters = (const UniChar *)buffer.bytes;
+    }
+    
+    WXBridgeCodeCacheEngine engine(bridge, script, sourceURL);
+    BOOL hit = _store->execute(engine, (const char *)characters, length * sizeof(UniChar));
+    WXLogDebug(@"Executed %@ %@ code cache", sourceURL.absoluteString ?: @"script", hit ? @"from" : @"without");
+    return YES;
+}
+
+- (void)clear
+{
+    _store->clear();
+}
+
+- (NSDictionary *)metrics
+{
+    WXCodeCacheMetrics metrics = _store->metrics();
+    return @{@"hits": @(metrics.hits),
+             @"misses": @(metrics.misses),
+             @"rejections": @(metrics.rejections),
+             @"stores": @(metrics.stores),
+             @"evictions": @(metrics.evictions),
+             @"bytes": @(_store->totalSize())};
+}
+
+@end
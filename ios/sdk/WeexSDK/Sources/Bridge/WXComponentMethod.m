@@ -20,7 +20,7 @@
 #import "WXComponentMethod.h"
 #import "WXComponentFactory.h"
 #import "WXComponentManager.h"
-#import "WXSDKInstance.h"
+#import "WXSDKInstance_private.h"
 #import "WXLog.h"
 #import "WXUtility.h"
 
@@ -51,9 +51,9 @@
         }
         SEL selector = [WXComponentFactory methodWithComponentName:component.type withMethod:self.methodName];
         NSInvocation * invocation = [self invocationWithTarget:component selector:selector];
-        WXPerformBlockOnMainThread(^{
+        [self.instance.componentManager performBlockOnMainThreadAfterUITasks:^{
             [invocation invoke];
-        });
+        }];
     });
     
     
@@ -37,6 +37,7 @@
 #import "WXExtendCallNativeManager.h"
 #import "WXTracingManager.h"
 #import "WXExceptionUtils.h"
+#import "WXTimerScheduler.h"
 
 #import <dlfcn.h>
 
@@ -50,6 +51,8 @@
 @property (nonatomic, strong)  NSMutableDictionary *intervaltimers;
 @property (nonatomic)  long long intervalTimerId;
 @property (nonatomic, strong)  NSMutableDictionary *callbacks;
+@property (nonatomic, strong)  WXTimerScheduler *timerScheduler;
+@property (nonatomic, copy)  WXJSCallNativeModuleById callNativeModuleByIdBlock;
 
 @end
 
@@ -71,14 +74,19 @@
 
         __weak typeof(self) weakSelf = self;
         
-        NSDictionary *data = [WXUtility getEnvironment];
-        _jsContext[@"WXEnvironment"] = data;
+        // all the timers of the js thread fire from one run loop timer, the timeouts which fire together call back in one call
+        _timerScheduler = [[WXTimerScheduler alloc] initWithRunLoop:[NSRunLoop currentRunLoop] handler:^(NSArray *targets) {
+            [weakSelf fireTimers:targets];
+        }];
+        
+        _jsContext[@"WXEnvironment"] = [self _environment];
         
         _jsContext[@"setTimeout"] = ^(JSValue *function, JSValue *timeout) {
             // this setTimeout is used by internal logic in JS framework, normal setTimeout called by users will call WXTimerModule's method;
-            [weakSelf performSelector: @selector(triggerTimeout:) withObject:^() {
+            void(^block)(void) = ^() {
                 [function callWithArguments:@[]];
-            } afterDelay:[timeout toDouble] / 1000];
+            };
+            [weakSelf.timerScheduler scheduleTarget:@{@"function": [block copy]} milliseconds:[timeout toDouble] repeats:NO];
         };
         
         _jsContext[@"setTimeoutWeex"] = ^(JSValue *appId, JSValue *ret,JSValue *arg ) {
@@ -222,7 +230,7 @@
     id callAddElementBlock = ^(JSValue *instanceId, JSValue *ref, JSValue *element, JSValue *index, JSValue *ifCallback) {
         
         NSString *instanceIdString = [instanceId toString];
-        NSDictionary *componentData = [element toDictionary];
+        NSDictionary *componentData = [element wx_toElementDictionary];
         NSString *parentRef = [ref toString];
         NSInteger insertIndex = [[index toNumber] integerValue];
         [WXTracingManager startTracingWithInstanceId:instanceIdString ref:componentData[@"ref"] className:nil name:WXTJSCall phase:WXTracingBegin functionName:@"addElement" options:@{@"threadName":WXTJSBridgeThread,@"componentData":componentData}];
@@ -239,7 +247,7 @@
     id WXJSCallCreateBodyBlock = ^(JSValue *instanceId, JSValue *body,JSValue *ifCallback) {
         
         NSString *instanceIdString = [instanceId toString];
-        NSDictionary *bodyData = [body toDictionary];
+        NSDictionary *bodyData = [body wx_toElementDictionary];
         
         WXLogDebug(@"callCreateBody...%@, %@,", instanceIdString, bodyData);
         [WXTracingManager startTracingWithInstanceId:instanceIdString ref:bodyData[@"ref"] className:nil name:WXTJSCall phase:WXTracingBegin functionName:@"createBody" options:@{@"threadName":WXTJSBridgeThread}];
@@ -361,7 +369,23 @@
 
 - (void)registerCallNativeModule:(WXJSCallNativeModule)callNativeModuleBlock
 {
+    __weak typeof(self) weakSelf = self;
     _jsContext[@"callNativeModule"] = ^JSValue *(JSValue *instanceId, JSValue *moduleName, JSValue *methodName, JSValue *args, JSValue *options) {
+        WXJSCallNativeModuleById callNativeModuleByIdBlock = weakSelf.callNativeModuleByIdBlock;
+        if (callNativeModuleByIdBlock && [moduleName isNumber] && [methodName isNumber]) {
+            // dispatch ids published with registerModules, no need to convert and resolve the names.
+            NSString *instanceIdString = [instanceId toString];
+            NSUInteger moduleId = [moduleName toUInt32];
+            NSUInteger methodId = [methodName toUInt32];
+            NSArray *argsArray = [args toArray];
+            NSDictionary *optionsDic = [options toDictionary];
+            
+            WXLogDebug(@"callNativeModule...%@,%lu,%lu,%@", instanceIdString, (unsigned long)moduleId, (unsigned long)methodId, argsArray);
+            
+            NSInvocation *invocation = callNativeModuleByIdBlock(instanceIdString, moduleId, methodId, argsArray, optionsDic);
+            return [JSValue wx_valueWithReturnValueFromInvocation:invocation inContext:[JSContext currentContext]];
+        }
+        
         NSString *instanceIdString = [instanceId toString];
         NSString *moduleNameString = [moduleName toString];
         NSString *methodNameString = [methodName toString];
@@ -377,6 +401,11 @@
     };
 }
 
+- (void)registerCallNativeModuleById:(WXJSCallNativeModuleById)callNativeModuleByIdBlock
+{
+    self.callNativeModuleByIdBlock = callNativeModuleByIdBlock;
+}
+
 - (void)registerCallNativeComponent:(WXJSCallNativeComponent)callNativeComponentBlock
 {
     _jsContext[@"callNativeComponent"] = ^void(JSValue *instanceId, JSValue *componentName, JSValue *methodName, JSValue *args, JSValue *options) {
@@ -399,8 +428,15 @@
 
 - (void)resetEnvironment
 {
-    NSDictionary *data = [WXUtility getEnvironment];
-    _jsContext[@"WXEnvironment"] = data;
+    _jsContext[@"WXEnvironment"] = [self _environment];
+}
+
+- (NSDictionary *)_environment
+{
+    NSMutableDictionary *data = [[WXUtility getEnvironment] mutableCopy];
+    // callAddElement and callCreateBody accept elements pre-encoded as JSON string
+    data[@"elementEncoding"] = @"json";
+    return data;
 }
 
 //typedef void (*WXJSCGarbageCollect)(JSContextRef);
@@ -464,24 +500,37 @@
     block();
 }
 
-- (void)callBack:(NSDictionary *)dic
+- (void)fireTimers:(NSArray *)targets
 {
-    if([dic objectForKey:@"ret"] && [_timers containsObject:[dic objectForKey:@"ret"]]) {
-        [[WXSDKManager bridgeMgr] callBack:[dic objectForKey:@"appId"] funcId:[dic objectForKey:@"ret"]  params:[dic objectForKey:@"arg"] keepAlive:NO];
+    NSMutableArray *callbacks = [NSMutableArray array];
+    for (NSDictionary *dic in targets) {
+        if (dic[@"ret"]) {
+            if ([_timers containsObject:dic[@"ret"]]) {
+                [callbacks addObject:@{@"instanceId": dic[@"appId"], @"funcId": dic[@"ret"], @"params": dic[@"arg"]}];
+            }
+            continue;
+        }
+        // the callbacks of the timers which fired before are sent first
+        [[WXSDKManager bridgeMgr] callBacks:callbacks];
+        [callbacks removeAllObjects];
+        if (dic[@"timerId"]) {
+            [self callBackInterval:dic];
+        } else {
+            [self triggerTimeout:dic[@"function"]];
+        }
     }
-
+    [[WXSDKManager bridgeMgr] callBacks:callbacks];
 }
 
-
 - (void)callBackInterval:(NSDictionary *)dic
 {
-    if(dic[@"function"] && [dic objectForKey:@"appId"] && [_intervaltimers objectForKey:[dic objectForKey:@"appId"]]){
-        NSMutableArray *timers = [_intervaltimers objectForKey:[dic objectForKey:@"appId"]];
-        void(^block)(void) = ((void(^)(void))dic[@"function"]);
-        if(block && [timers containsObject:[dic objectForKey:@"timerId"]]){
-            block();
-            [self executeInterval:[dic objectForKey:@"appId"] function:block arg:[dic objectForKey:@"arg"] timerId:[[dic objectForKey:@"timerId"] longLongValue]];
-        }
+    NSMutableArray *timers = dic[@"appId"] ? [_intervaltimers objectForKey:dic[@"appId"]] : nil;
+    void(^block)(void) = ((void(^)(void))dic[@"function"]);
+    if(block && [timers containsObject:[dic objectForKey:@"timerId"]]){
+        block();
+    } else {
+        // cleared, or its instance was destroyed
+        [_timerScheduler cancel:[dic[@"identifier"] unsignedLongLongValue]];
     }
 }
 
@@ -500,7 +549,7 @@
     [timeoutInfo setObject:appId forKey:@"appId"];
     [timeoutInfo setObject:ret forKey:@"ret"];
     [timeoutInfo setObject:arg forKey:@"arg"];
-    [self performSelector:@selector(callBack:) withObject:timeoutInfo afterDelay:interval inModes:@[NSRunLoopCommonModes]];
+    [_timerScheduler scheduleTarget:timeoutInfo milliseconds:[arg doubleValue] repeats:NO];
 }
 
 - (long long)triggerInterval:(NSString *)appId function:(void(^)(void))block arg:(NSString *)arg
@@ -526,13 +575,13 @@
 
 -(void)executeInterval:(NSString *)appId function:(void(^)(void))block arg:(NSString *)arg timerId:(long long)timerId
 {
-    double interval = [arg doubleValue]/1000.0f;
     NSMutableDictionary *intervalInfo = [NSMutableDictionary new];
     [intervalInfo setObject:appId forKey:@"appId"];
     [intervalInfo setObject:arg forKey:@"arg"];
     [intervalInfo setObject:@(timerId) forKey:@"timerId"];
     [intervalInfo setObject:[block copy] forKey:@"function"];
-    [self performSelector:@selector(callBackInterval:) withObject:intervalInfo afterDelay:interval inModes:@[NSRunLoopCommonModes]];
+    uint64_t identifier = [_timerScheduler scheduleTarget:intervalInfo milliseconds:[arg doubleValue] repeats:YES];
+    [intervalInfo setObject:@(identifier) forKey:@"identifier"];
 }
 
 - (void)triggerClearInterval:(NSString *)instanceId ret:(long long)timerId
@@ -19,6 +19,8 @@
 
 #import "WXBridgeMethod.h"
 
+@class WXModuleMethodDescriptor;
+
 typedef enum : NSUInteger {
     WXModuleMethodTypeSync,
     WXModuleMethodTypeAsync,
@@ -29,6 +31,7 @@ typedef enum : NSUInteger {
 @property (nonatomic, assign) WXModuleMethodType methodType;
 @property (nonatomic, strong, readonly) NSString *moduleName;
 @property (nonatomic, strong, readonly) NSDictionary *options;
+@property (nonatomic, strong, readonly) WXModuleMethodDescriptor *methodDescriptor;
 
 - (instancetype)initWithModuleName:(NSString *)moduleName
                         methodName:(NSString *)methodName
@@ -36,6 +39,14 @@ typedef enum : NSUInteger {
                            options:(NSDictionary *)options
                           instance:(WXSDKInstance *)instance;
 
+/**
+ * Create a module method already resolved by WXModuleFactory, used when js calls by dispatch ids.
+ */
+- (instancetype)initWithMethodDescriptor:(WXModuleMethodDescriptor *)methodDescriptor
+                               arguments:(NSArray *)arguments
+                                 options:(NSDictionary *)options
+                                instance:(WXSDKInstance *)instance;
+
 - (NSInvocation *)invoke;
 
 @end
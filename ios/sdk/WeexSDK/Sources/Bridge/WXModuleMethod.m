@@ -44,6 +44,18 @@
     return self;
 }
 
+- (instancetype)initWithMethodDescriptor:(WXModuleMethodDescriptor *)methodDescriptor
+                               arguments:(NSArray *)arguments
+                                 options:(NSDictionary *)options
+                                instance:(WXSDKInstance *)instance
+{
+    if (self = [self initWithModuleName:methodDescriptor.moduleName methodName:methodDescriptor.methodName arguments:arguments options:options instance:instance]) {
+        _methodDescriptor = methodDescriptor;
+    }
+    
+    return self;
+}
+
 - (NSInvocation *)invoke
 {
     if (self.instance.needValidate) {
@@ -73,7 +85,10 @@
         }
     }
     
-    Class moduleClass =  [WXModuleFactory classWithModuleName:_moduleName];
+    if (!_methodDescriptor) {
+        _methodDescriptor = [WXModuleFactory methodDescriptorWithModuleName:_moduleName methodName:self.methodName];
+    }
+    Class moduleClass = _methodDescriptor ? _methodDescriptor.moduleClass : [WXModuleFactory classWithModuleName:_moduleName];
     if (!moduleClass) {
         NSString *errorMessage = [NSString stringWithFormat:@"Module：%@ doesn't exist, maybe it has not been registered", _moduleName];
         WX_MONITOR_FAIL(WXMTJSBridge, WX_ERR_INVOKE_NATIVE, errorMessage);
@@ -82,10 +97,10 @@
     
     id<WXModuleProtocol> moduleInstance = [self.instance moduleForClass:moduleClass];
     WXAssert(moduleInstance, @"No instance found for module name:%@, class:%@", _moduleName, moduleClass);
-    BOOL isSync = NO;
-    SEL selector = [WXModuleFactory selectorWithModuleName:self.moduleName methodName:self.methodName isSync:&isSync];
+    BOOL isSync = _methodDescriptor.isSync;
+    SEL selector = _methodDescriptor.selector;
    
-    if (![moduleInstance respondsToSelector:selector]) {
+    if (!selector || ![moduleInstance respondsToSelector:selector]) {
         // if not implement the selector, then dispatch default module method
         if ([self.methodName isEqualToString:@"addEventListener"]) {
             [self.instance _addModuleEventObserversWithModuleMethod:self];
@@ -99,7 +114,8 @@
     }
 	
     [self commitModuleInvoke];
-    NSInvocation *invocation = [self invocationWithTarget:moduleInstance selector:selector];
+    NSMethodSignature *signature = _methodDescriptor.signature ?: [moduleInstance methodSignatureForSelector:selector];
+    NSInvocation *invocation = [self invocationWithTarget:moduleInstance selector:selector signature:signature];
     
     if (isSync) {
         [invocation invoke];
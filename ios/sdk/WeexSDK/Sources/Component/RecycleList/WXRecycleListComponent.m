@@ -29,6 +29,19 @@
 #import "WXRecycleListDataManager.h"
 #import "WXRecycleListTemplateManager.h"
 #import "WXRecycleListUpdateManager.h"
+#import "WXRecycleListPrefetcher.h"
+
+// a cell component bound to the data of an index, and laid out, before it's displayed
+@interface WXRecycleListPrefetchedCell : NSObject
+
+@property (nonatomic, strong) WXCellSlotComponent *component;
+@property (nonatomic, strong) NSDictionary *data;
+
+@end
+
+@implementation WXRecycleListPrefetchedCell
+
+@end
 
 @interface WXRecycleListComponent () <WXRecycleListLayoutDelegate, WXRecycleListUpdateDelegate, UICollectionViewDelegateFlowLayout, UICollectionViewDataSource>
 
@@ -49,6 +62,12 @@
     NSMutableDictionary *_stickyCache;
     
     NSUInteger _previousLoadMoreCellNumber;
+    
+    WXRecycleListPrefetcher *_prefetcher;
+    NSMutableDictionary<NSIndexPath *, WXRecycleListPrefetchedCell *> *_prefetchedCells;
+    NSMutableSet<NSIndexPath *> *_prefetchingIndexPaths;
+    // cell components not displayed, by template type, to prefetch with
+    NSMutableDictionary<NSString *, NSMutableArray<WXCellSlotComponent *> *> *_reusableCellComponents;
 }
 
 WX_EXPORT_METHOD(@selector(appendData:))
@@ -75,6 +94,10 @@ WX_EXPORT_METHOD(@selector(scrollTo:options:))
         _indexKey = [WXConvert NSString:attributes[@"index"]];
         _sizeCache = [NSMutableDictionary dictionary];
         _stickyCache = [NSMutableDictionary dictionary];
+        _prefetcher = [WXRecycleListPrefetcher new];
+        _prefetchedCells = [NSMutableDictionary dictionary];
+        _prefetchingIndexPaths = [NSMutableSet set];
+        _reusableCellComponents = [NSMutableDictionary dictionary];
     }
     
     return self;
@@ -287,7 +310,7 @@ WX_EXPORT_METHOD(@selector(scrollTo:options:))
 
 #pragma mark - Private
 
-- (void)_updateBindingData:(NSDictionary *)data forCell:(WXCellSlotComponent *)cellComponent atIndexPath:(NSIndexPath *)indexPath
+- (NSDictionary *)_bindingData:(NSDictionary *)data atIndexPath:(NSIndexPath *)indexPath
 {
     if (_aliasKey) {
         data = @{_aliasKey:data};
@@ -297,6 +320,12 @@ WX_EXPORT_METHOD(@selector(scrollTo:options:))
         dataNew[_indexKey] = @(indexPath.item);
         data = dataNew;
     }
+    return data;
+}
+
+- (void)_updateBindingData:(NSDictionary *)data forCell:(WXCellSlotComponent *)cellComponent atIndexPath:(NSIndexPath *)indexPath
+{
+    data = [self _bindingData:data atIndexPath:indexPath];
     
 #ifdef DEBUG
     NSDate *startTime = [NSDate date];
@@ -309,6 +338,11 @@ WX_EXPORT_METHOD(@selector(scrollTo:options:))
     WXLogDebug(@"cell:%zi update data time:%f", indexPath.item, duration);
 #endif
     
+    [self _updateCachesForCell:cellComponent atIndexPath:indexPath];
+}
+
+- (void)_updateCachesForCell:(WXCellSlotComponent *)cellComponent atIndexPath:(NSIndexPath *)indexPath
+{
     NSValue *cachedSize = _sizeCache[indexPath];
     if (!cachedSize || !CGSizeEqualToSize([cachedSize CGSizeValue] , cellComponent.calculatedFrame.size)) {
         _sizeCache[indexPath] = [NSValue valueWithCGSize:cellComponent.calculatedFrame.size];
@@ -335,6 +369,138 @@ WX_EXPORT_METHOD(@selector(scrollTo:options:))
     [_updateManager updateWithNewData:newData oldData:oldData completion:completion animation:animation];
 }
 
+#pragma mark - Prefetching
+
+- (void)scrollViewDidScroll:(UIScrollView *)scrollView
+{
+    [super scrollViewDidScroll:scrollView];
+    
+    [self _prefetchCells];
+}
+
+- (void)_prefetchCells
+{
+    NSUInteger itemCount = [_dataManager numberOfItems];
+    NSArray<NSIndexPath *> *visibleIndexPaths = [_collectionView indexPathsForVisibleItems];
+    if (itemCount == 0 || visibleIndexPaths.count == 0) {
+        return;
+    }
+    
+    NSUInteger first = NSUIntegerMax, last = 0;
+    for (NSIndexPath *indexPath in visibleIndexPaths) {
+        first = MIN(first, (NSUInteger)indexPath.item);
+        last = MAX(last, (NSUInteger)indexPath.item);
+    }
+    NSUInteger generation = _prefetcher.generation;
+    NSIndexSet *indexes = [_prefetcher indexesToPrefetchWithOffset:_collectionView.contentOffset.y
+                                                              time:CACurrentMediaTime()
+                                                      visibleRange:NSMakeRange(first, last - first + 1)
+                                                         itemCount:itemCount
+                                                 averageItemHeight:_collectionView.contentSize.height / itemCount];
+    if (_prefetcher.generation != generation || _prefetchedCells.count > _prefetcher.maxPrefetchCount * 2) {
+        // the direction has changed, or the list jumped, keep the components for the cells coming next
+        [self _discardPrefetchedCells];
+    }
+    
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [self _prefetchCellAtIndexPath:[NSIndexPath indexPathForItem:index inSection:0]];
+    }];
+}
+
+- (void)_prefetchCellAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (_prefetchedCells[indexPath] || [_prefetchingIndexPaths containsObject:indexPath] || [_collectionView cellForItemAtIndexPath:indexPath]) {
+        return;
+    }
+    
+    NSDictionary *data = [_dataManager dataAtIndex:indexPath.item];
+    NSString *templateType = [data isKindOfClass:[NSDictionary class]] ? data[_templateKey] : nil;
+    WXCellSlotComponent *cellComponent = templateType ? [self _reusableCellComponentWithType:templateType] : nil;
+    if (!cellComponent) {
+        return;
+    }
+    
+    [_prefetchingIndexPaths addObject:indexPath];
+    NSUInteger generation = _prefetcher.generation;
+    WXRecycleListPrefetcher *prefetcher = _prefetcher;
+    NSDictionary *bindingData = [self _bindingData:data atIndexPath:indexPath];
+    WXPerformBlockOnComponentThread(^{
+        // binding, layout and text measuring, off the main thread
+        BOOL cancelled = prefetcher.generation != generation;
+        if (!cancelled) {
+            [cellComponent updateCellData:bindingData];
+        }
+        WXPerformBlockOnMainThread(^{
+            [_prefetchingIndexPaths removeObject:indexPath];
+            if (cancelled || prefetcher.generation != generation || [_dataManager dataAtIndex:indexPath.item] != data) {
+                [self _recycleCellComponent:cellComponent];
+                return;
+            }
+            WXRecycleListPrefetchedCell *prefetchedCell = [WXRecycleListPrefetchedCell new];
+            prefetchedCell.component = cellComponent;
+            prefetchedCell.data = data;
+            _prefetchedCells[indexPath] = prefetchedCell;
+            [self _updateCachesForCell:cellComponent atIndexPath:indexPath];
+        });
+    });
+}
+
+- (WXCellSlotComponent *)_reusableCellComponentWithType:(NSString *)templateType
+{
+    NSMutableArray<WXCellSlotComponent *> *cellComponents = _reusableCellComponents[templateType];
+    WXCellSlotComponent *cellComponent = cellComponents.lastObject;
+    if (cellComponent) {
+        [cellComponents removeLastObject];
+        return cellComponent;
+    }
+    
+    cellComponent = [_templateManager dequeueCellSlotWithType:templateType forIndexPath:nil];
+    if (cellComponent) {
+        WXPerformBlockOnComponentThread(^{
+            [super _insertSubcomponent:cellComponent atIndex:self.subcomponents.count];
+        });
+    }
+    return cellComponent;
+}
+
+- (void)_recycleCellComponent:(WXCellSlotComponent *)cellComponent
+{
+    NSString *templateType = cellComponent.templateType;
+    if (!templateType) {
+        return;
+    }
+    NSMutableArray<WXCellSlotComponent *> *cellComponents = _reusableCellComponents[templateType];
+    if (!cellComponents) {
+        cellComponents = [NSMutableArray array];
+        _reusableCellComponents[templateType] = cellComponents;
+    }
+    [cellComponents addObject:cellComponent];
+}
+
+- (WXCellSlotComponent *)_takePrefetchedCellAtIndexPath:(NSIndexPath *)indexPath data:(NSDictionary *)data
+{
+    WXRecycleListPrefetchedCell *prefetchedCell = _prefetchedCells[indexPath];
+    if (!prefetchedCell) {
+        return nil;
+    }
+    
+    [_prefetchedCells removeObjectForKey:indexPath];
+    if (prefetchedCell.data != data) {
+        // the data has changed since
+        [self _recycleCellComponent:prefetchedCell.component];
+        return nil;
+    }
+    return prefetchedCell.component;
+}
+
+- (void)_discardPrefetchedCells
+{
+    for (WXRecycleListPrefetchedCell *prefetchedCell in _prefetchedCells.allValues) {
+        [self _recycleCellComponent:prefetchedCell.component];
+    }
+    [_prefetchedCells removeAllObjects];
+}
+
 #pragma mark - UICollectionViewDataSource
 
 - (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView
@@ -366,17 +532,27 @@ WX_EXPORT_METHOD(@selector(scrollTo:options:))
     // 3. dequeue a cell component by template type
     UICollectionViewCell *cellView = [_collectionView dequeueReusableCellWithReuseIdentifier:templateType forIndexPath:indexPath];
     WXCellSlotComponent *cellComponent = (WXCellSlotComponent *)cellView.wx_component;
-    if (!cellComponent) {
-        cellComponent = [_templateManager dequeueCellSlotWithType:templateType forIndexPath:indexPath];
+    WXCellSlotComponent *prefetchedComponent = [self _takePrefetchedCellAtIndexPath:indexPath data:data];
+    if (prefetchedComponent) {
+        // already bound and laid out, only its view needs to be attached
+        if (cellComponent) {
+            [self _recycleCellComponent:cellComponent];
+        }
+        cellComponent = prefetchedComponent;
         cellView.wx_component = cellComponent;
-        WXPerformBlockOnComponentThread(^{
-            //TODO: How can we avoid this?
-            [super _insertSubcomponent:cellComponent atIndex:self.subcomponents.count];
-        });
+    } else {
+        if (!cellComponent) {
+            cellComponent = [_templateManager dequeueCellSlotWithType:templateType forIndexPath:indexPath];
+            cellView.wx_component = cellComponent;
+            WXPerformBlockOnComponentThread(^{
+                //TODO: How can we avoid this?
+                [super _insertSubcomponent:cellComponent atIndex:self.subcomponents.count];
+            });
+        }
+        
+        // 4. binding the data to the cell component
+        [self _updateBindingData:data forCell:cellComponent atIndexPath:indexPath];
     }
-    
-    // 4. binding the data to the cell component
-    [self _updateBindingData:data forCell:cellComponent atIndexPath:indexPath];
 
     // 5. Add cell component's view to content view.
     UIView *contentView = cellComponent.view;
@@ -448,6 +624,8 @@ WX_EXPORT_METHOD(@selector(scrollTo:options:))
 
 - (void)updateManager:(WXRecycleListUpdateManager *)manager willUpdateData:(id)newData
 {
+    [_prefetcher cancel];
+    [self _discardPrefetchedCells];
     [_dataManager updateData:newData];
 }
 
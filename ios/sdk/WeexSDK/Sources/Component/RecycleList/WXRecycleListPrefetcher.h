@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <UIKit/UIKit.h>
+
+/**
+ * Predicts the cells which are about to scroll in, from the scroll velocity,
+ * so that they can be bound and laid out before they are displayed.
+ */
+@interface WXRecycleListPrefetcher : NSObject
+
+/**
+ * How far ahead to prefetch, in seconds of scrolling at the current velocity, 0.5 by default.
+ */
+@property (nonatomic, assign) NSTimeInterval lookAheadTime;
+
+/**
+ * The most cells to prefetch at once, 6 by default.
+ */
+@property (nonatomic, assign) NSUInteger maxPrefetchCount;
+
+/**
+ * Bumped when the scroll direction changes or the prefetching is cancelled,
+ * the work started in an older generation should be dropped. Readable from any thread.
+ */
+@property (atomic, readonly) NSUInteger generation;
+
+/**
+ * Records the content offset at the time, and returns the indexes of the cells
+ * which will scroll in, after the visible ones in the scroll direction.
+ * averageItemHeight: the content height divided by the item count.
+ */
+- (NSIndexSet *)indexesToPrefetchWithOffset:(CGFloat)offset
+                                       time:(NSTimeInterval)time
+                               visibleRange:(NSRange)visibleRange
+                                  itemCount:(NSUInteger)itemCount
+                          averageItemHeight:(CGFloat)averageItemHeight;
+
+- (void)cancel;
+
+@end
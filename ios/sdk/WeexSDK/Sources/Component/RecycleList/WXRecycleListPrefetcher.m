@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXRecycleListPrefetcher.h"
+
+@interface WXRecycleListPrefetcher ()
+
+@property (atomic, readwrite) NSUInteger generation;
+
+@end
+
+@implementation WXRecycleListPrefetcher
+{
+    CGFloat _lastOffset;
+    NSTimeInterval _lastTime;
+    // 1 for scrolling down, -1 for up, 0 before scrolling
+    NSInteger _direction;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _lookAheadTime = 0.5;
+        _maxPrefetchCount = 6;
+        _lastTime = -1;
+    }
+    
+    return self;
+}
+
+- (NSIndexSet *)indexesToPrefetchWithOffset:(CGFloat)offset
+                                       time:(NSTimeInterval)time
+                               visibleRange:(NSRange)visibleRange
+                                  itemCount:(NSUInteger)itemCount
+                          averageItemHeight:(CGFloat)averageItemHeight
+{
+    CGFloat distance = offset - _lastOffset;
+    NSTimeInterval interval = time - _lastTime;
+    BOOL firstSample = _lastTime < 0;
+    _lastOffset = offset;
+    _lastTime = time;
+    if (firstSample || interval <= 0 || distance == 0) {
+        return [NSIndexSet indexSet];
+    }
+    
+    NSInteger direction = distance > 0 ? 1 : -1;
+    if (direction != _direction) {
+        // the cells prefetched for the other direction won't show up soon
+        if (_direction != 0) {
+            [self cancel];
+        }
+        _direction = direction;
+    }
+    
+    CGFloat velocity = fabs(distance) / interval;
+    NSUInteger count = 1;
+    if (averageItemHeight > 0) {
+        count = MAX(count, (NSUInteger)ceil(velocity * _lookAheadTime / averageItemHeight));
+    }
+    count = MIN(count, _maxPrefetchCount);
+    
+    NSRange range;
+    if (direction > 0) {
+        NSUInteger start = NSMaxRange(visibleRange);
+        if (start >= itemCount) {
+            return [NSIndexSet indexSet];
+        }
+        range = NSMakeRange(start, MIN(count, itemCount - start));
+    } else {
+        NSUInteger end = MIN(visibleRange.location, itemCount);
+        NSUInteger start = end > count ? end - count : 0;
+        range = NSMakeRange(start, end - start);
+    }
+    return [NSIndexSet indexSetWithIndexesInRange:range];
+}
+
+- (void)cancel
+{
+    self.generation++;
+}
+
+@end
@@ -164,10 +164,11 @@
     
     WXDiffResult *diffResult;
     if (appendingData) {
-        newData = [oldData arrayByAddingObjectsFromArray:appendingData];
+        newData = [oldData arrayByAddingObjectsFromArray:[self immutableData:appendingData]];
         NSIndexSet *inserts = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(oldData.count, appendingData.count)];
         diffResult = [[WXDiffResult alloc] initWithInserts:inserts deletes:nil updates:nil];
     } else if (newData){
+        newData = [self immutableData:newData];
         diffResult = [WXDiffUtil diffWithMinimumDistance:newData oldArray:oldData];
     }
     
@@ -202,6 +203,39 @@
     [collectionView performBatchUpdates:updates completion:completion];
 }
 
+// immutable items keep their diff hashes, so they are only hashed once. the copies are deep,
+// a container keeps its hash only if the containers nested in it are immutable too
+- (NSArray *)immutableData:(NSArray *)data
+{
+    NSMutableArray *immutableData = [NSMutableArray arrayWithCapacity:data.count];
+    for (id item in data) {
+        [immutableData addObject:[self immutableItem:item]];
+    }
+    return immutableData;
+}
+
+- (id)immutableItem:(id)item
+{
+    if ([item isKindOfClass:[NSArray class]]) {
+        NSMutableArray *array = [NSMutableArray arrayWithCapacity:[item count]];
+        for (id child in item) {
+            [array addObject:[self immutableItem:child]];
+        }
+        return [array copy];
+    }
+    if ([item isKindOfClass:[NSDictionary class]]) {
+        NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:[item count]];
+        [item enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+            dictionary[key] = [self immutableItem:obj];
+        }];
+        return [dictionary copy];
+    }
+    if ([item isKindOfClass:[NSString class]]) {
+        return [item copy];
+    }
+    return item;
+}
+
 - (WXRecycleListDiffResult *)recycleListUpdatesByDiffResult:(WXDiffResult *)diffResult
 {
     NSMutableSet<NSIndexPath *> *reloadIndexPaths = [NSMutableSet set];
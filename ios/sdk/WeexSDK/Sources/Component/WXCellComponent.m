@@ -61,6 +61,11 @@
     return self == object;
 }
 
+- (NSUInteger)weex_diffHash
+{
+    return (NSUInteger)self;
+}
+
 - (void)_frameDidCalculated:(BOOL)isChanged
 {
     [super _frameDidCalculated:isChanged];
@@ -18,9 +18,9 @@
  */
 
 #import "WXImageComponent.h"
-#import "WXHandlerFactory.h"
 #import "WXComponent_internal.h"
 #import "WXImgLoaderProtocol.h"
+#import "WXImageScheduler.h"
 #import "WXLayer.h"
 #import "WXType.h"
 #import "WXConvert.h"
@@ -32,6 +32,15 @@
 #import "WXAssert.h"
 #import <pthread/pthread.h>
 
+// images of views out of the window load after the ones of the views on it
+static const CGFloat WXImageOffscreenDistance = 1000;
+
+@interface WXImageComponent ()
+
+- (void)_updateImagePriority;
+
+@end
+
 @interface WXImageView : UIImageView
 
 @end
@@ -43,6 +52,12 @@
     return [WXLayer class];
 }
 
+- (void)didMoveToWindow
+{
+    [super didMoveToWindow];
+    [(WXImageComponent *)self.wx_component _updateImagePriority];
+}
+
 @end
 
 static dispatch_queue_t WXImageUpdateQueue;
@@ -62,8 +77,12 @@ static dispatch_queue_t WXImageUpdateQueue;
 @property (nonatomic, strong) UIImage *image;
 @property (nonatomic, strong) id<WXImageOperationProtocol> imageOperation;
 @property (nonatomic, strong) id<WXImageOperationProtocol> placeholderOperation;
+// the distance of the view to the viewport when it was last measured, in points
+@property (atomic, assign) CGFloat imagePriority;
 @property (nonatomic) BOOL imageLoadEvent;
 @property (nonatomic) BOOL imageDownloadFinish;
+// pixels the content image is decoded to, zero for the original size
+@property (atomic, assign) CGSize imageDecodedSize;
 
 @end
 
@@ -103,6 +122,7 @@ WX_EXPORT_METHOD(@selector(save:))
         }
         
         _imageSharp = [WXConvert WXImageSharp:styles[@"sharpen"]];
+        _imagePriority = WXImageOffscreenDistance;
         _imageLoadEvent = NO;
         _imageDownloadFinish = NO;
     }
@@ -270,10 +290,35 @@ WX_EXPORT_METHOD(@selector(save:))
     
     [self _clipsToBounds];
     
+    self.imagePriority = [self _viewportDistance];
     [self updateImage];
     
 }
 
+// the distance of the view to the visible part of its window, in points
+- (CGFloat)_viewportDistance
+{
+    UIWindow *window = _view.window;
+    if (!window) {
+        return WXImageOffscreenDistance;
+    }
+    CGRect frame = [_view convertRect:_view.bounds toView:window];
+    CGRect bounds = window.bounds;
+    CGFloat horizontal = MAX(CGRectGetMinX(bounds) - CGRectGetMaxX(frame), CGRectGetMinX(frame) - CGRectGetMaxX(bounds));
+    CGFloat vertical = MAX(CGRectGetMinY(bounds) - CGRectGetMaxY(frame), CGRectGetMinY(frame) - CGRectGetMaxY(bounds));
+    return MAX(0, MAX(horizontal, vertical));
+}
+
+- (void)_updateImagePriority
+{
+    WXAssertMainThread();
+    CGFloat priority = [self _viewportDistance];
+    self.imagePriority = priority;
+    WXImageScheduler *scheduler = [WXImageScheduler sharedScheduler];
+    [scheduler setPriority:priority forOperation:self.imageOperation];
+    [scheduler setPriority:priority forOperation:self.placeholderOperation];
+}
+
 - (BOOL)_needsDrawBorder
 {
     return NO;
@@ -322,9 +367,23 @@ WX_EXPORT_METHOD(@selector(save:))
         WXPerformBlockOnMainThread(^{
             [weakSelf _clipsToBounds];
         });
+        
+        // the image was decoded for a smaller frame, it would be scaled up
+        CGSize decodedSize = self.imageDecodedSize;
+        if (decodedSize.width > 0 && decodedSize.height > 0) {
+            CGSize size = [WXImageScheduler decodedSizeForImageFrame:self.calculatedFrame userInfo:[self imageUserInfo]];
+            if (size.width > decodedSize.width || size.height > decodedSize.height) {
+                [self updateImage];
+            }
+        }
     }
 }
 
+- (NSDictionary *)imageUserInfo
+{
+    return @{@"imageQuality":@(self.imageQuality), @"imageSharp":@(self.imageSharp), @"blurRadius":@(self.blurRadius)};
+}
+
 - (NSString *)imageSrc
 {
     pthread_mutex_lock(&(_imageSrcMutex));
@@ -388,7 +447,7 @@ WX_EXPORT_METHOD(@selector(save:))
     WX_REWRITE_URL(self.placeholdSrc, WXResourceTypeImage, self.weexInstance)
     
     __weak typeof(self) weakSelf = self;
-    self.placeholderOperation = [[self imageLoader] downloadImageWithURL:newURL imageFrame:self.calculatedFrame userInfo:nil completed:^(UIImage *image, NSError *error, BOOL finished) {
+    self.placeholderOperation = [[WXImageScheduler sharedScheduler] loadImageWithURL:newURL imageFrame:self.calculatedFrame userInfo:nil priority:self.imagePriority completed:^(UIImage *image, NSError *error, BOOL finished) {
         dispatch_async(dispatch_get_main_queue(), ^{
             __strong typeof(self) strongSelf = weakSelf;
             UIImage *viewImage = ((UIImageView *)strongSelf.view).image;
@@ -421,15 +480,17 @@ WX_EXPORT_METHOD(@selector(save:))
     NSString *imageSrc = [NSString stringWithFormat:@"%@", self.imageSrc?:@""];
     if ([WXUtility isBlankString:imageSrc]) {
         WXLogError(@"image src is empty");
+        self.imageDecodedSize = CGSizeZero;
         return;
     }
     
     WXLogDebug(@"Updating image:%@, component:%@", self.imageSrc, self.ref);
-    NSDictionary *userInfo = @{@"imageQuality":@(self.imageQuality), @"imageSharp":@(self.imageSharp), @"blurRadius":@(self.blurRadius)};
+    NSDictionary *userInfo = [self imageUserInfo];
+    self.imageDecodedSize = [WXImageScheduler decodedSizeForImageFrame:self.calculatedFrame userInfo:userInfo];
     NSString * newURL = [imageSrc copy];
     WX_REWRITE_URL(imageSrc, WXResourceTypeImage, self.weexInstance)
     __weak typeof(self) weakSelf = self;
-    weakSelf.imageOperation = [[weakSelf imageLoader] downloadImageWithURL:newURL imageFrame:weakSelf.calculatedFrame userInfo:userInfo completed:^(UIImage *image, NSError *error, BOOL finished) {
+    weakSelf.imageOperation = [[WXImageScheduler sharedScheduler] loadImageWithURL:newURL imageFrame:weakSelf.calculatedFrame userInfo:userInfo priority:weakSelf.imagePriority completed:^(UIImage *image, NSError *error, BOOL finished) {
         dispatch_async(dispatch_get_main_queue(), ^{
             __strong typeof(self) strongSelf = weakSelf;
             
@@ -438,8 +499,9 @@ WX_EXPORT_METHOD(@selector(save:))
                 sizeDict[@"naturalWidth"] = @0;
                 sizeDict[@"naturalHeight"] = @0;
                 if (!error) {
-                    sizeDict[@"naturalWidth"] = @(image.size.width * image.scale);
-                    sizeDict[@"naturalHeight"] = @(image.size.height * image.scale);
+                    CGSize naturalSize = [WXImageScheduler naturalSizeOfImage:image];
+                    sizeDict[@"naturalWidth"] = @(naturalSize.width);
+                    sizeDict[@"naturalHeight"] = @(naturalSize.height);
                 } else {
                     [sizeDict setObject:[error description]?:@"" forKey:@"errorDesc"];
                 }
@@ -484,16 +546,6 @@ WX_EXPORT_METHOD(@selector(save:))
     _placeholderOperation = nil;
 }
 
-- (id<WXImgLoaderProtocol>)imageLoader
-{
-    static id<WXImgLoaderProtocol> imageLoader;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        imageLoader = [WXHandlerFactory handlerForProtocol:@protocol(WXImgLoaderProtocol)];
-    });
-    return imageLoader;
-}
-
 - (void)_clipsToBounds
 {
     WXAssertMainThread();
@@ -26,6 +26,7 @@
 #import "WXRuleManager.h"
 #import "WXDefine.h"
 #import "WXView.h"
+#import "WXTextLayoutCache.h"
 #import <pthread/pthread.h>
 #import <CoreText/CoreText.h>
 
@@ -128,6 +129,8 @@ CGFloat WXTextDefaultLineThroughWidth = 1.2;
     
     NSAttributedString * _ctAttributedString;
     NSString *_wordWrap;
+    // the text with the style it's laid out in, shared layouts are found by it
+    NSString *_textLayoutKey;
     
     pthread_mutex_t _ctAttributedStringMutex;
     pthread_mutexattr_t _propertMutexAttr;
@@ -263,6 +266,7 @@ do {\
     
     pthread_mutex_lock(&(_ctAttributedStringMutex));
     _ctAttributedString = nil;
+    _textLayoutKey = nil;
     pthread_mutex_unlock(&(_ctAttributedStringMutex));
     
 }
@@ -317,7 +321,6 @@ do {\
     __weak typeof(self) weakSelf = self;
     return ^CGSize (CGSize constrainedSize) {
         CGSize computedSize = CGSizeZero;
-        NSTextStorage *textStorage = nil;
         
         //TODO:more elegant way to use max and min constrained size
         if (!isnan(weakSelf.cssNode->style.minDimensions[CSS_WIDTH])) {
@@ -328,14 +331,20 @@ do {\
             constrainedSize.width = MIN(constrainedSize.width, weakSelf.cssNode->style.maxDimensions[CSS_WIDTH]);
         }
         
-        if (![self useCoreText]) {
-            textStorage = [weakSelf textStorageWithWidth:constrainedSize.width];
-            NSLayoutManager *layoutManager = textStorage.layoutManagers.firstObject;
-            NSTextContainer *textContainer = layoutManager.textContainers.firstObject;
-            computedSize = [layoutManager usedRectForTextContainer:textContainer].size;
-        } else {
-            computedSize = [weakSelf calculateTextHeightWithWidth:constrainedSize.width];
-        }
+        // the texts with the same style in the same width, like the ones in list cells, are measured once
+        WXTextLayout *layout = [WXTextLayoutCache layoutForKey:[weakSelf textLayoutKey] bounds:CGRectMake(0, 0, constrainedSize.width, 0) building:^WXTextLayout *{
+            CGSize textSize = CGSizeZero;
+            if (![weakSelf useCoreText]) {
+                NSTextStorage *textStorage = [weakSelf textStorageWithWidth:constrainedSize.width];
+                NSLayoutManager *layoutManager = textStorage.layoutManagers.firstObject;
+                NSTextContainer *textContainer = layoutManager.textContainers.firstObject;
+                textSize = [layoutManager usedRectForTextContainer:textContainer].size;
+            } else {
+                textSize = [weakSelf calculateTextHeightWithWidth:constrainedSize.width];
+            }
+            return [[WXTextLayout alloc] initWithFrame:NULL size:textSize];
+        }];
+        computedSize = layout.size;
         
         if (!isnan(weakSelf.cssNode->style.minDimensions[CSS_HEIGHT])) {
             computedSize.height = MAX(computedSize.height, weakSelf.cssNode->style.minDimensions[CSS_HEIGHT]);
@@ -344,7 +353,7 @@ do {\
         if (!isnan(weakSelf.cssNode->style.maxDimensions[CSS_HEIGHT])) {
             computedSize.height = MIN(computedSize.height, weakSelf.cssNode->style.maxDimensions[CSS_HEIGHT]);
         }
-        if (textStorage && [WXUtility isBlankString:textStorage.string]) {
+        if (![weakSelf useCoreText] && [WXUtility isBlankString:weakSelf.text]) {
             //  if the text value is empty or nil, then set the height is 0.
             computedSize.height = 0;
         }
@@ -358,6 +367,27 @@ do {\
 
 #pragma mark Text Building
 
+- (NSString *)textLayoutKey
+{
+    NSString *key = nil;
+    pthread_mutex_lock(&(_ctAttributedStringMutex));
+    if (!_textLayoutKey) {
+        // strings are prefixed by their length, so that they can't run into each other
+        _textLayoutKey = [NSString stringWithFormat:@"%d %g %g %g %ld %ld %lu %ld %g %g %@ %lu:%@ %lu:%@ %lu:%@ %lu:%@ %lu:%@",
+                          [self useCoreText], _fontSize, _fontWeight, self.weexInstance.pixelScaleFactor,
+                          (long)_fontStyle, (long)_textAlign, (unsigned long)_lines, (long)_textDecoration,
+                          _lineHeight, _letterSpacing, _color ? [WXConvert HexWithColor:_color] : @"",
+                          (unsigned long)_fontFamily.length, _fontFamily ?: @"",
+                          (unsigned long)_direction.length, _direction ?: @"",
+                          (unsigned long)_wordWrap.length, _wordWrap ?: @"",
+                          (unsigned long)_textOverflow.length, _textOverflow ?: @"",
+                          (unsigned long)self.text.length, self.text ?: @""];
+    }
+    key = _textLayoutKey;
+    pthread_mutex_unlock(&(_ctAttributedStringMutex));
+    return key;
+}
+
 - (NSAttributedString *)ctAttributedString
 {
     NSAttributedString * attributedString = nil;
@@ -674,23 +704,28 @@ do {\
         //add path
         CGPathRef cgPath = NULL;
         cgPath = CGPathCreateWithRect(textFrame, NULL);
-        CTFrameRef _coreTextFrameRef = NULL;
-        if (_coreTextFrameRef) {
-            CFRelease(_coreTextFrameRef);
-            _coreTextFrameRef = NULL;
-        }
         if(!attributedStringCopy) {
             return;
         }
-        CTFramesetterRef ctframesetterRef = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)(attributedStringCopy));
-        _coreTextFrameRef = CTFramesetterCreateFrame(ctframesetterRef, CFRangeMake(0, attributedStringCopy.length), cgPath, NULL);
+        // the cells showing the same text in the same bounds share the lines
+        WXTextLayout *layout = [WXTextLayoutCache layoutForKey:[self textLayoutKey] bounds:textFrame building:^WXTextLayout *{
+            CTFramesetterRef ctframesetterRef = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)(attributedStringCopy));
+            CTFrameRef frameRef = CTFramesetterCreateFrame(ctframesetterRef, CFRangeMake(0, attributedStringCopy.length), cgPath, NULL);
+            CFRelease(ctframesetterRef);
+            if (NULL == frameRef) {
+                return nil;
+            }
+            WXTextLayout *textLayout = [[WXTextLayout alloc] initWithFrame:frameRef size:textFrame.size];
+            CFRelease(frameRef);
+            return textLayout;
+        }];
+        // retained, the layout may be evicted by other threads while drawing
+        CTFrameRef _coreTextFrameRef = layout.frame ? (CTFrameRef)CFRetain(layout.frame) : NULL;
         CFArrayRef ctLines = NULL;
         if (NULL == _coreTextFrameRef) {
             // try to protect crash from frame is NULL
             return;
         }
-        CFRelease(ctframesetterRef);
-        ctframesetterRef = NULL;
         ctLines = CTFrameGetLines(_coreTextFrameRef);
         CFIndex lineCount = CFArrayGetCount(ctLines);
         NSMutableArray * mutableLines = [NSMutableArray new];
@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <UIKit/UIKit.h>
+#import <CoreText/CoreText.h>
+
+/**
+ * The result of laying out a text: its size, and for drawing, the lines and
+ * their origins. It's immutable, so the text components with the same text,
+ * style and bounds share it.
+ */
+@interface WXTextLayout : NSObject
+
+- (instancetype)initWithFrame:(CTFrameRef)frame size:(CGSize)size;
+
+// NULL if the text is only measured
+@property (nonatomic, readonly) CTFrameRef frame;
+@property (nonatomic, readonly) CGSize size;
+
+@end
+
+/**
+ * Text layouts of the whole process, the least recently used ones are evicted
+ * beyond the cost limit, and all of them on memory warnings or when an icon
+ * font is downloaded.
+ */
+@interface WXTextLayoutCache : NSObject
+
+/**
+ * Returns the cached layout of the text in the bounds, or calls the building
+ * block and caches the layout it returns.
+ * key: the text with its resolved style, bounds: zero high for measuring.
+ */
++ (WXTextLayout *)layoutForKey:(NSString *)key bounds:(CGRect)bounds building:(WXTextLayout *(^)(void))building;
+
+/**
+ * The max bytes of the cached layouts, 4MB by default.
+ */
++ (void)setCostLimit:(NSUInteger)costLimit;
+
++ (void)removeAllLayouts;
+
+/**
+ * hits, misses, evictions, count (the layouts cached), cost (their estimated bytes).
+ */
++ (NSDictionary<NSString *, NSNumber *> *)metrics;
+
+@end
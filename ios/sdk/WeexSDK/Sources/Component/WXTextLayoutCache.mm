@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXTextLayoutCache.h"
+#import "WXDefine.h"
+#include "WXRasterCache.h"
+
+static const NSUInteger WXTextLayoutCacheDefaultCostLimit = 4 * 1024 * 1024;
+
+// estimated bytes of a line, and of a glyph with its position and advance
+static const NSUInteger WXTextLayoutLineCost = 256;
+static const NSUInteger WXTextLayoutGlyphCost = 32;
+
+@implementation WXTextLayout
+
+- (instancetype)initWithFrame:(CTFrameRef)frame size:(CGSize)size
+{
+    if (self = [super init]) {
+        _frame = frame ? (CTFrameRef)CFRetain(frame) : NULL;
+        _size = size;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_frame) {
+        CFRelease(_frame);
+    }
+}
+
+- (NSUInteger)cost
+{
+    NSUInteger cost = sizeof(*self);
+    if (_frame) {
+        cost += CFArrayGetCount(CTFrameGetLines(_frame)) * WXTextLayoutLineCost;
+        cost += CTFrameGetVisibleStringRange(_frame).length * WXTextLayoutGlyphCost;
+    }
+    return cost;
+}
+
+@end
+
+static WXRasterCache<WXTextLayout *> &WXSharedTextLayoutCache()
+{
+    static WXRasterCache<WXTextLayout *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = new WXRasterCache<WXTextLayout *>(WXTextLayoutCacheDefaultCostLimit);
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        [center addObserverForName:UIApplicationDidReceiveMemoryWarningNotification object:nil queue:nil usingBlock:^(NSNotification *note) {
+            cache->clear();
+        }];
+        // the texts laid out with the fallback font
+        [center addObserverForName:WX_ICONFONT_DOWNLOAD_NOTIFICATION object:nil queue:nil usingBlock:^(NSNotification *note) {
+            cache->clear();
+        }];
+    });
+    return *cache;
+}
+
+@implementation WXTextLayoutCache
+
++ (WXTextLayout *)layoutForKey:(NSString *)key bounds:(CGRect)bounds building:(WXTextLayout *(^)(void))building
+{
+    NSUInteger length = key.length;
+    unichar *characters = (unichar *)malloc(length * sizeof(unichar));
+    [key getCharacters:characters range:NSMakeRange(0, length)];
+    WXRasterKey cacheKey;
+    cacheKey.add((double)bounds.origin.x).add((double)bounds.origin.y)
+            .add((double)bounds.size.width).add((double)bounds.size.height)
+            .add(characters, length * sizeof(unichar));
+    free(characters);
+    
+    WXRasterCache<WXTextLayout *> &cache = WXSharedTextLayoutCache();
+    WXTextLayout *layout = nil;
+    if (cache.get(cacheKey, layout)) {
+        return layout;
+    }
+    
+    layout = building();
+    if (layout) {
+        cache.put(cacheKey, layout, cacheKey.bytes().size() + [layout cost]);
+    }
+    return layout;
+}
+
++ (void)setCostLimit:(NSUInteger)costLimit
+{
+    WXSharedTextLayoutCache().setCostLimit(costLimit);
+}
+
++ (void)removeAllLayouts
+{
+    WXSharedTextLayoutCache().clear();
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)metrics
+{
+    WXRasterCacheMetrics metrics = WXSharedTextLayoutCache().metrics();
+    return @{
+        @"hits": @(metrics.hits),
+        @"misses": @(metrics.misses),
+        @"evictions": @(metrics.evictions),
+        @"count": @(metrics.count),
+        @"cost": @(metrics.totalCost),
+    };
+}
+
+@end
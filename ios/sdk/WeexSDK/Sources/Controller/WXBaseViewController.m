@@ -126,10 +126,6 @@
     }
     
     [_instance destroyInstance];
-    if([WXPrerenderManager isTaskReady:[self.sourceURL absoluteString]]){
-        _instance = [WXPrerenderManager instanceFromUrl:self.sourceURL.absoluteString];
-    }
-
     _instance = [[WXSDKInstance alloc] init];
     _instance.frame = CGRectMake(0.0f, 0.0f, self.view.bounds.size.width, self.view.bounds.size.height);
     _instance.pageObject = self;
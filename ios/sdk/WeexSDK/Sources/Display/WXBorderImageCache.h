@@ -0,0 +1,51 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <UIKit/UIKit.h>
+
+@class WXComponent;
+
+/**
+ * Shares the rasterized borders and backgrounds of components, the ones with
+ * the same size and border styles, like the cards of a list, are drawn once.
+ * The images are evicted least recently used first, beyond the cost limit,
+ * and all of them on memory warnings.
+ */
+@interface WXBorderImageCache : NSObject
+
+/**
+ * Returns the cached image for the borders and the background of the component,
+ * or calls the drawing block and caches the image it returns.
+ */
++ (UIImage *)imageForComponent:(WXComponent *)component size:(CGSize)size opaque:(BOOL)opaque drawing:(UIImage *(^)(void))drawing;
+
+/**
+ * The max bytes of the cached bitmaps, 8MB by default.
+ */
++ (void)setCostLimit:(NSUInteger)costLimit;
+
++ (void)removeAllImages;
+
+/**
+ * hits, misses, evictions, count (the images cached), cost (bytes of their bitmaps).
+ */
++ (NSDictionary<NSString *, NSNumber *> *)metrics;
+
+@end
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXBorderImageCache.h"
+#import "WXComponent_internal.h"
+#include "WXRasterCache.h"
+
+static const NSUInteger WXBorderImageCacheDefaultCostLimit = 8 * 1024 * 1024;
+
+static WXRasterCache<UIImage *> &WXSharedBorderImageCache()
+{
+    static WXRasterCache<UIImage *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = new WXRasterCache<UIImage *>(WXBorderImageCacheDefaultCostLimit);
+        [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification object:nil queue:nil usingBlock:^(NSNotification *note) {
+            cache->clear();
+        }];
+    });
+    return *cache;
+}
+
+// returns NO for the colors which can't be compared by their components, like pattern images
+static BOOL WXAddColorToKey(WXRasterKey &key, UIColor *color)
+{
+    if (!color) {
+        key.add((int64_t)-1);
+        return YES;
+    }
+    
+    CGColorRef cgColor = color.CGColor;
+    CGColorSpaceModel model = CGColorSpaceGetModel(CGColorGetColorSpace(cgColor));
+    if (model == kCGColorSpaceModelPattern) {
+        return NO;
+    }
+    size_t count = CGColorGetNumberOfComponents(cgColor);
+    const CGFloat *components = CGColorGetComponents(cgColor);
+    key.add((int64_t)model).add((int64_t)count);
+    for (size_t i = 0; i < count; i++) {
+        key.add((double)components[i]);
+    }
+    return YES;
+}
+
+// everything _drawBorderWithContext:size: depends on
+static BOOL WXBorderImageKey(WXComponent *component, CGSize size, BOOL opaque, WXRasterKey &key)
+{
+    key.add((double)size.width).add((double)size.height)
+       .add((double)[UIScreen mainScreen].scale)
+       .add((int64_t)opaque)
+       .add((double)component->_opacity)
+       .add((double)component->_borderTopLeftRadius).add((double)component->_borderTopRightRadius)
+       .add((double)component->_borderBottomLeftRadius).add((double)component->_borderBottomRightRadius)
+       .add((double)component->_borderTopWidth).add((double)component->_borderRightWidth)
+       .add((double)component->_borderBottomWidth).add((double)component->_borderLeftWidth)
+       .add((int64_t)component->_borderTopStyle).add((int64_t)component->_borderRightStyle)
+       .add((int64_t)component->_borderBottomStyle).add((int64_t)component->_borderLeftStyle);
+    
+    return WXAddColorToKey(key, component->_backgroundColor)
+        && WXAddColorToKey(key, component->_borderTopColor)
+        && WXAddColorToKey(key, component->_borderRightColor)
+        && WXAddColorToKey(key, component->_borderBottomColor)
+        && WXAddColorToKey(key, component->_borderLeftColor);
+}
+
+@implementation WXBorderImageCache
+
++ (UIImage *)imageForComponent:(WXComponent *)component size:(CGSize)size opaque:(BOOL)opaque drawing:(UIImage *(^)(void))drawing
+{
+    WXRasterKey key;
+    if (!WXBorderImageKey(component, size, opaque, key)) {
+        return drawing();
+    }
+    
+    WXRasterCache<UIImage *> &cache = WXSharedBorderImageCache();
+    UIImage *image = nil;
+    if (cache.get(key, image)) {
+        return image;
+    }
+    
+    image = drawing();
+    CGImageRef cgImage = image.CGImage;
+    if (cgImage) {
+        cache.put(key, image, CGImageGetBytesPerRow(cgImage) * CGImageGetHeight(cgImage));
+    }
+    return image;
+}
+
++ (void)setCostLimit:(NSUInteger)costLimit
+{
+    WXSharedBorderImageCache().setCostLimit(costLimit);
+}
+
++ (void)removeAllImages
+{
+    WXSharedBorderImageCache().clear();
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)metrics
+{
+    WXRasterCacheMetrics metrics = WXSharedBorderImageCache().metrics();
+    return @{
+        @"hits": @(metrics.hits),
+        @"misses": @(metrics.misses),
+        @"evictions": @(metrics.evictions),
+        @"count": @(metrics.count),
+        @"cost": @(metrics.totalCost),
+    };
+}
+
+@end
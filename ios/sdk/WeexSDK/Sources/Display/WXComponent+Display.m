@@ -24,6 +24,7 @@
 #import "WXAssert.h"
 #import "WXUtility.h"
 #import "WXDisplayQueue.h"
+#import "WXBorderImageCache.h"
 #import "WXThreadSafeCounter.h"
 #import "UIBezierPath+Weex.h"
 #import "WXRoundedRect.h"
@@ -101,19 +102,38 @@
             return nil;
         }
         
-        UIGraphicsBeginImageContextWithOptions(bounds.size, [self _bitmapOpaqueWithSize:bounds.size] , 0.0);
-        UIImage *image = [self drawRect:bounds];
-        if (!image) {
-            image = UIGraphicsGetImageFromCurrentImageContext();
-        }
-        UIGraphicsEndImageContext();
+        BOOL opaque = [self _bitmapOpaqueWithSize:bounds.size];
+        UIImage *(^drawing)(void) = ^UIImage *{
+            UIGraphicsBeginImageContextWithOptions(bounds.size, opaque, 0.0);
+            UIImage *image = [self drawRect:bounds];
+            if (!image) {
+                image = UIGraphicsGetImageFromCurrentImageContext();
+            }
+            UIGraphicsEndImageContext();
+            return image;
+        };
         
-        return image;
+        if ([self _drawsBorderOnly]) {
+            // components with the same borders share the image
+            return [WXBorderImageCache imageForComponent:self size:bounds.size opaque:opaque drawing:drawing];
+        }
+        return drawing();
     };
     
     return displayBlock;
 }
 
+- (BOOL)_drawsBorderOnly
+{
+    // subclasses which draw their contents, like text, are not cached
+    static IMP borderDrawing;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        borderDrawing = [WXComponent instanceMethodForSelector:@selector(drawRect:)];
+    });
+    return !_useCompositing && [self methodForSelector:@selector(drawRect:)] == borderDrawing;
+}
+
 - (WXDisplayCompletionBlock)_displayCompletionBlock
 {
     __weak typeof(self) weakSelf = self;
@@ -161,8 +181,8 @@
             return displayValue != displayCounter.value;
         };
         
-        [WXDisplayQueue addBlock:^{
-            if (isCancelled()) {
+        [WXDisplayQueue addBlock:^(BOOL cancelled) {
+            if (cancelled || isCancelled()) {
                 if (completionBlock) {
                     dispatch_async(dispatch_get_main_queue(), ^{
                         completionBlock(layer, NO);
@@ -188,7 +208,7 @@
                 }
             });
             
-        }];
+        } forKey:layer priority:[self _displayPriority]];
     } else {
         UIImage *image = displayBlock(displayBounds, ^BOOL(){
             return NO;
@@ -202,6 +222,17 @@
     }
 }
 
+// layers on the screen are drawn first
+- (WXDisplayPriority)_displayPriority
+{
+    UIWindow *window = _view.window;
+    if (!window) {
+        return WXDisplayPriorityLow;
+    }
+    CGRect frame = [_view convertRect:_view.bounds toView:window];
+    return CGRectIntersectsRect(frame, window.bounds) ? WXDisplayPriorityHigh : WXDisplayPriorityLow;
+}
+
 - (void)triggerDisplay
 {
     WXPerformBlockOnMainThread(^{
@@ -19,9 +19,38 @@
 
 #import <Foundation/Foundation.h>
 
+typedef NS_ENUM(NSInteger, WXDisplayPriority) {
+    // layers out of the screen
+    WXDisplayPriorityLow = 0,
+    WXDisplayPriorityNormal,
+    // layers on the screen
+    WXDisplayPriorityHigh,
+};
+
+// the block is called with YES instead of being run, if it's replaced or cancelled before it runs
+typedef void (^WXDisplayQueueBlock)(BOOL cancelled);
+
 // Global queue for displaying content
 @interface WXDisplayQueue : NSObject
 
 + (void)addBlock:(void(^)(void))block;
 
+/**
+ * Adds a block to draw the content of a key, usually a layer. A block which is
+ * still waiting for the same key is replaced, only the latest one is drawn.
+ * Blocks with higher priority run first, the ones with the same priority run in order.
+ */
++ (void)addBlock:(WXDisplayQueueBlock)block forKey:(id)key priority:(WXDisplayPriority)priority;
+
+/**
+ * Cancels the waiting block of a key, the running one has to check by itself.
+ */
++ (void)cancelBlockForKey:(id)key;
+
+/**
+ * pending: blocks waiting, maxPending: the most blocks waiting at once,
+ * executed, coalesced (replaced by later blocks for the same key), cancelled.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)metrics;
+
 @end
@@ -18,13 +18,134 @@
  */
 
 #import "WXDisplayQueue.h"
+#import <pthread/pthread.h>
 
 #define MAX_CONCURRENT_COUNT 8
 
-static dispatch_semaphore_t WXDisplayConcurrentSemaphore;
+@interface WXDisplayQueueEntry : NSObject
+
+@property (nonatomic, copy) WXDisplayQueueBlock block;
+@property (nonatomic, strong) id key;
+@property (nonatomic, assign) WXDisplayPriority priority;
+
+@end
+
+@implementation WXDisplayQueueEntry
+
+@end
+
+// access with the lock
+static pthread_mutex_t WXDisplayQueueLock = PTHREAD_MUTEX_INITIALIZER;
+static NSMutableArray<WXDisplayQueueEntry *> *WXDisplayQueuePending[WXDisplayPriorityHigh + 1];
+static NSMapTable *WXDisplayQueueEntriesByKey;
+static NSUInteger WXDisplayQueuePendingCount;
+static NSUInteger WXDisplayQueueMaxPendingCount;
+static NSUInteger WXDisplayQueueExecutedCount;
+static NSUInteger WXDisplayQueueCoalescedCount;
+static NSUInteger WXDisplayQueueCancelledCount;
+static NSUInteger WXDisplayQueueRunningCount;
+static NSUInteger WXDisplayQueueMaxRunningCount;
 
 @implementation WXDisplayQueue
 
++ (void)initialize
+{
+    if (self != [WXDisplayQueue class]) {
+        return;
+    }
+    for (NSInteger priority = WXDisplayPriorityLow; priority <= WXDisplayPriorityHigh; priority++) {
+        WXDisplayQueuePending[priority] = [NSMutableArray array];
+    }
+    // keys are compared by identity, layers don't implement isEqual:
+    WXDisplayQueueEntriesByKey = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                                       valueOptions:NSPointerFunctionsStrongMemory];
+    NSUInteger processorCount = [NSProcessInfo processInfo].activeProcessorCount;
+    WXDisplayQueueMaxRunningCount = processorCount <= MAX_CONCURRENT_COUNT ? processorCount : MAX_CONCURRENT_COUNT;
+}
+
++ (void)addBlock:(void(^)(void))block
+{
+    if (!block) {
+        return;
+    }
+    [self addBlock:^(BOOL cancelled) {
+        block();
+    } forKey:nil priority:WXDisplayPriorityNormal];
+}
+
++ (void)addBlock:(WXDisplayQueueBlock)block forKey:(id)key priority:(WXDisplayPriority)priority
+{
+    if (!block) {
+        return;
+    }
+    WXDisplayQueueEntry *entry = [WXDisplayQueueEntry new];
+    entry.block = block;
+    entry.key = key;
+    entry.priority = MAX(WXDisplayPriorityLow, MIN(priority, WXDisplayPriorityHigh));
+    
+    WXDisplayQueueEntry *replacedEntry = nil;
+    BOOL startsWorker = NO;
+    pthread_mutex_lock(&WXDisplayQueueLock);
+    if (key) {
+        replacedEntry = [WXDisplayQueueEntriesByKey objectForKey:key];
+        if (replacedEntry) {
+            [self _removeEntry:replacedEntry];
+            WXDisplayQueueCoalescedCount++;
+        }
+        [WXDisplayQueueEntriesByKey setObject:entry forKey:key];
+    }
+    [WXDisplayQueuePending[entry.priority] addObject:entry];
+    WXDisplayQueuePendingCount++;
+    WXDisplayQueueMaxPendingCount = MAX(WXDisplayQueueMaxPendingCount, WXDisplayQueuePendingCount);
+    if (WXDisplayQueueRunningCount < WXDisplayQueueMaxRunningCount) {
+        WXDisplayQueueRunningCount++;
+        startsWorker = YES;
+    }
+    pthread_mutex_unlock(&WXDisplayQueueLock);
+    
+    if (replacedEntry) {
+        replacedEntry.block(YES);
+    }
+    if (startsWorker) {
+        dispatch_async([self displayQueue], ^{
+            [self _runPendingBlocks];
+        });
+    }
+}
+
++ (void)cancelBlockForKey:(id)key
+{
+    if (!key) {
+        return;
+    }
+    pthread_mutex_lock(&WXDisplayQueueLock);
+    WXDisplayQueueEntry *entry = [WXDisplayQueueEntriesByKey objectForKey:key];
+    if (entry) {
+        [self _removeEntry:entry];
+        [WXDisplayQueueEntriesByKey removeObjectForKey:key];
+        WXDisplayQueueCancelledCount++;
+    }
+    pthread_mutex_unlock(&WXDisplayQueueLock);
+    
+    if (entry) {
+        entry.block(YES);
+    }
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)metrics
+{
+    pthread_mutex_lock(&WXDisplayQueueLock);
+    NSDictionary *metrics = @{@"pending": @(WXDisplayQueuePendingCount),
+                              @"maxPending": @(WXDisplayQueueMaxPendingCount),
+                              @"executed": @(WXDisplayQueueExecutedCount),
+                              @"coalesced": @(WXDisplayQueueCoalescedCount),
+                              @"cancelled": @(WXDisplayQueueCancelledCount)};
+    pthread_mutex_unlock(&WXDisplayQueueLock);
+    return metrics;
+}
+
+#pragma mark Private
+
 + (dispatch_queue_t)displayQueue
 {
     static dispatch_queue_t displayQueue = NULL;
@@ -37,20 +158,41 @@ static dispatch_semaphore_t WXDisplayConcurrentSemaphore;
     return displayQueue;
 }
 
-+ (void)addBlock:(void(^)(void))block
+// with the lock
++ (void)_removeEntry:(WXDisplayQueueEntry *)entry
 {
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        NSUInteger processorCount = [NSProcessInfo processInfo].activeProcessorCount;
-        NSUInteger maxConcurrentCount = processorCount <= MAX_CONCURRENT_COUNT ? processorCount : MAX_CONCURRENT_COUNT;
-        WXDisplayConcurrentSemaphore = dispatch_semaphore_create(maxConcurrentCount);
-    });
-    
-    dispatch_async([self displayQueue], ^{
-        dispatch_semaphore_wait(WXDisplayConcurrentSemaphore, DISPATCH_TIME_FOREVER);
-        block();
-        dispatch_semaphore_signal(WXDisplayConcurrentSemaphore);
-    });
+    [WXDisplayQueuePending[entry.priority] removeObjectIdenticalTo:entry];
+    WXDisplayQueuePendingCount--;
+}
+
+// at most MAX_CONCURRENT_COUNT workers, instead of a thread blocked on a semaphore for every block
++ (void)_runPendingBlocks
+{
+    while (YES) {
+        WXDisplayQueueEntry *entry = nil;
+        pthread_mutex_lock(&WXDisplayQueueLock);
+        for (NSInteger priority = WXDisplayPriorityHigh; priority >= WXDisplayPriorityLow && !entry; priority--) {
+            entry = WXDisplayQueuePending[priority].firstObject;
+            if (entry) {
+                [WXDisplayQueuePending[priority] removeObjectAtIndex:0];
+            }
+        }
+        if (!entry) {
+            WXDisplayQueueRunningCount--;
+            pthread_mutex_unlock(&WXDisplayQueueLock);
+            return;
+        }
+        WXDisplayQueuePendingCount--;
+        WXDisplayQueueExecutedCount++;
+        if (entry.key && [WXDisplayQueueEntriesByKey objectForKey:entry.key] == entry) {
+            [WXDisplayQueueEntriesByKey removeObjectForKey:entry.key];
+        }
+        pthread_mutex_unlock(&WXDisplayQueueLock);
+        
+        @autoreleasepool {
+            entry.block(NO);
+        }
+    }
 }
 
 @end
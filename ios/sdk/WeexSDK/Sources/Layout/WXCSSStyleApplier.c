@@ -0,0 +1,258 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "WXCSSStyleApplier.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    WXCSSValueType type;
+    // of the first float of the property in css_style_t, and the number of floats, 4 for the shorthands
+    size_t offset;
+    int count;
+    float defaultValue;
+} WXCSSPropertyInfo;
+
+#define WX_CSS_KEYWORD(name, type) {name, type, 0, 0, 0}
+#define WX_CSS_FLOAT(name, type, field, count, defaultValue) {name, type, offsetof(css_style_t, field), count, defaultValue}
+
+// indexed by WXCSSProperty
+static const WXCSSPropertyInfo WXCSSProperties[WXCSSPropertyCount] = {
+    {"", WXCSSValueTypeNone, 0, 0, 0},
+    WX_CSS_FLOAT("flex", WXCSSValueTypeNumber, flex, 1, 0),
+    WX_CSS_KEYWORD("flexDirection", WXCSSValueTypeFlexDirection),
+    WX_CSS_KEYWORD("alignItems", WXCSSValueTypeAlign),
+    WX_CSS_KEYWORD("alignSelf", WXCSSValueTypeAlign),
+    WX_CSS_KEYWORD("flexWrap", WXCSSValueTypeWrap),
+    WX_CSS_KEYWORD("justifyContent", WXCSSValueTypeJustify),
+    WX_CSS_KEYWORD("position", WXCSSValueTypePosition),
+    WX_CSS_FLOAT("top", WXCSSValueTypePixel, position[CSS_TOP], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("left", WXCSSValueTypePixel, position[CSS_LEFT], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("right", WXCSSValueTypePixel, position[CSS_RIGHT], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("bottom", WXCSSValueTypePixel, position[CSS_BOTTOM], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("width", WXCSSValueTypePixel, dimensions[CSS_WIDTH], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("height", WXCSSValueTypePixel, dimensions[CSS_HEIGHT], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("minWidth", WXCSSValueTypePixel, minDimensions[CSS_WIDTH], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("minHeight", WXCSSValueTypePixel, minDimensions[CSS_HEIGHT], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("maxWidth", WXCSSValueTypePixel, maxDimensions[CSS_WIDTH], 1, CSS_UNDEFINED),
+    WX_CSS_FLOAT("maxHeight", WXCSSValueTypePixel, maxDimensions[CSS_HEIGHT], 1, CSS_UNDEFINED),
+    // CSS_LEFT, CSS_TOP, CSS_RIGHT and CSS_BOTTOM are the first 4 floats
+    WX_CSS_FLOAT("margin", WXCSSValueTypePixel, margin, 4, 0),
+    WX_CSS_FLOAT("marginTop", WXCSSValueTypePixel, margin[CSS_TOP], 1, 0),
+    WX_CSS_FLOAT("marginLeft", WXCSSValueTypePixel, margin[CSS_LEFT], 1, 0),
+    WX_CSS_FLOAT("marginRight", WXCSSValueTypePixel, margin[CSS_RIGHT], 1, 0),
+    WX_CSS_FLOAT("marginBottom", WXCSSValueTypePixel, margin[CSS_BOTTOM], 1, 0),
+    WX_CSS_FLOAT("borderWidth", WXCSSValueTypePixel, border, 4, 0),
+    WX_CSS_FLOAT("borderTopWidth", WXCSSValueTypePixel, border[CSS_TOP], 1, 0),
+    WX_CSS_FLOAT("borderLeftWidth", WXCSSValueTypePixel, border[CSS_LEFT], 1, 0),
+    WX_CSS_FLOAT("borderRightWidth", WXCSSValueTypePixel, border[CSS_RIGHT], 1, 0),
+    WX_CSS_FLOAT("borderBottomWidth", WXCSSValueTypePixel, border[CSS_BOTTOM], 1, 0),
+    WX_CSS_FLOAT("padding", WXCSSValueTypePixel, padding, 4, 0),
+    WX_CSS_FLOAT("paddingTop", WXCSSValueTypePixel, padding[CSS_TOP], 1, 0),
+    WX_CSS_FLOAT("paddingLeft", WXCSSValueTypePixel, padding[CSS_LEFT], 1, 0),
+    WX_CSS_FLOAT("paddingRight", WXCSSValueTypePixel, padding[CSS_RIGHT], 1, 0),
+    WX_CSS_FLOAT("paddingBottom", WXCSSValueTypePixel, padding[CSS_BOTTOM], 1, 0),
+};
+
+#undef WX_CSS_KEYWORD
+#undef WX_CSS_FLOAT
+
+/*
+ * The perfect hash: the slot of a key is the top 6 bits of its FNV-1a hash
+ * times WXCSSPropertyMultiplier, which was searched for offline so that no
+ * two keys share a slot. Adding a key needs a new multiplier.
+ */
+static const uint32_t WXCSSPropertyMultiplier = 0xa66abf75;
+static const size_t WXCSSPropertyMaxLength = 17;
+
+static const WXCSSProperty WXCSSPropertySlots[64] = {
+    WXCSSPropertyBorderBottomWidth,
+    WXCSSPropertyTop,
+    WXCSSPropertyMarginBottom,
+    WXCSSPropertyBorderRightWidth,
+    WXCSSPropertyNone,
+    WXCSSPropertyWidth,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyFlexDirection,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyAlignItems,
+    WXCSSPropertyMarginLeft,
+    WXCSSPropertyRight,
+    WXCSSPropertyMarginRight,
+    WXCSSPropertyNone,
+    WXCSSPropertyPosition,
+    WXCSSPropertyPaddingTop,
+    WXCSSPropertyNone,
+    WXCSSPropertyPadding,
+    WXCSSPropertyNone,
+    WXCSSPropertyPaddingBottom,
+    WXCSSPropertyJustifyContent,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyAlignSelf,
+    WXCSSPropertyMinWidth,
+    WXCSSPropertyBottom,
+    WXCSSPropertyNone,
+    WXCSSPropertyBorderTopWidth,
+    WXCSSPropertyBorderLeftWidth,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyHeight,
+    WXCSSPropertyNone,
+    WXCSSPropertyMaxWidth,
+    WXCSSPropertyNone,
+    WXCSSPropertyFlexWrap,
+    WXCSSPropertyNone,
+    WXCSSPropertyBorderWidth,
+    WXCSSPropertyPaddingLeft,
+    WXCSSPropertyMinHeight,
+    WXCSSPropertyMaxHeight,
+    WXCSSPropertyNone,
+    WXCSSPropertyMargin,
+    WXCSSPropertyFlex,
+    WXCSSPropertyNone,
+    WXCSSPropertyLeft,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyMarginTop,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyNone,
+    WXCSSPropertyPaddingRight,
+};
+
+static uint32_t WXCSSPropertySlot(const char *key, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)key[i]) * 16777619u;
+    }
+    return (hash * WXCSSPropertyMultiplier) >> 26;
+}
+
+WXCSSProperty WXCSSPropertyLookup(const char *key, size_t length)
+{
+    if (length == 0 || length > WXCSSPropertyMaxLength) {
+        return WXCSSPropertyNone;
+    }
+    WXCSSProperty property = WXCSSPropertySlots[WXCSSPropertySlot(key, length)];
+    const char *name = WXCSSProperties[property].name;
+    if (property == WXCSSPropertyNone || strlen(name) != length || memcmp(name, key, length) != 0) {
+        return WXCSSPropertyNone;
+    }
+    return property;
+}
+
+const char *WXCSSPropertyName(WXCSSProperty property)
+{
+    return property < WXCSSPropertyCount ? WXCSSProperties[property].name : "";
+}
+
+WXCSSValueType WXCSSPropertyValueType(WXCSSProperty property)
+{
+    return property < WXCSSPropertyCount ? WXCSSProperties[property].type : WXCSSValueTypeNone;
+}
+
+static bool WXCSSFloatEqual(float a, float b)
+{
+    return a == b || (isnan(a) && isnan(b));
+}
+
+bool WXCSSStyleSetFloat(css_style_t *style, WXCSSProperty property, float value)
+{
+    if (property >= WXCSSPropertyCount || WXCSSProperties[property].count == 0) {
+        return false;
+    }
+    const WXCSSPropertyInfo *info = &WXCSSProperties[property];
+    float *fields = (float *)((char *)style + info->offset);
+    bool changed = false;
+    for (int i = 0; i < info->count; i++) {
+        if (!WXCSSFloatEqual(fields[i], value)) {
+            fields[i] = value;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+#define WX_CSS_SET_ENUM(field, type)\
+do {\
+    if (style->field != (type)value) {\
+        style->field = (type)value;\
+        return true;\
+    }\
+    return false;\
+} while (0)
+
+bool WXCSSStyleSetEnum(css_style_t *style, WXCSSProperty property, int value)
+{
+    switch (property) {
+        case WXCSSPropertyFlexDirection:
+            WX_CSS_SET_ENUM(flex_direction, css_flex_direction_t);
+        case WXCSSPropertyAlignItems:
+            WX_CSS_SET_ENUM(align_items, css_align_t);
+        case WXCSSPropertyAlignSelf:
+            WX_CSS_SET_ENUM(align_self, css_align_t);
+        case WXCSSPropertyFlexWrap:
+            WX_CSS_SET_ENUM(flex_wrap, css_wrap_type_t);
+        case WXCSSPropertyJustifyContent:
+            WX_CSS_SET_ENUM(justify_content, css_justify_t);
+        case WXCSSPropertyPosition:
+            WX_CSS_SET_ENUM(position_type, css_position_type_t);
+        default:
+            return false;
+    }
+}
+
+#undef WX_CSS_SET_ENUM
+
+bool WXCSSStyleReset(css_style_t *style, WXCSSProperty property)
+{
+    switch (property) {
+        case WXCSSPropertyFlexDirection:
+            return WXCSSStyleSetEnum(style, property, CSS_FLEX_DIRECTION_COLUMN);
+        case WXCSSPropertyAlignItems:
+            return WXCSSStyleSetEnum(style, property, CSS_ALIGN_STRETCH);
+        case WXCSSPropertyAlignSelf:
+            return WXCSSStyleSetEnum(style, property, CSS_ALIGN_AUTO);
+        case WXCSSPropertyFlexWrap:
+            return WXCSSStyleSetEnum(style, property, CSS_NOWRAP);
+        case WXCSSPropertyJustifyContent:
+            return WXCSSStyleSetEnum(style, property, CSS_JUSTIFY_FLEX_START);
+        case WXCSSPropertyPosition:
+            return WXCSSStyleSetEnum(style, property, CSS_POSITION_RELATIVE);
+        default:
+            return property < WXCSSPropertyCount && WXCSSStyleSetFloat(style, property, WXCSSProperties[property].defaultValue);
+    }
+}
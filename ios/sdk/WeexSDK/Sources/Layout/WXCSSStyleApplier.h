@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXCSSStyleApplier_h
+#define WXCSSStyleApplier_h
+
+/*
+ * Applies the layout styles to css_style_t, key by key.
+ *
+ * A style key is mapped to its property by a static perfect hash, so only the
+ * keys of an update are visited, instead of looking up every property in it.
+ * The setters return whether the style changed, so the layout is marked dirty
+ * only when a value actually changes.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "Layout.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// shorthands go before their longhands, so applying the properties in this order lets the longhands win
+typedef enum {
+    WXCSSPropertyNone = 0,
+    // flex
+    WXCSSPropertyFlex,
+    WXCSSPropertyFlexDirection,
+    WXCSSPropertyAlignItems,
+    WXCSSPropertyAlignSelf,
+    WXCSSPropertyFlexWrap,
+    WXCSSPropertyJustifyContent,
+    // position
+    WXCSSPropertyPosition,
+    WXCSSPropertyTop,
+    WXCSSPropertyLeft,
+    WXCSSPropertyRight,
+    WXCSSPropertyBottom,
+    // dimension
+    WXCSSPropertyWidth,
+    WXCSSPropertyHeight,
+    WXCSSPropertyMinWidth,
+    WXCSSPropertyMinHeight,
+    WXCSSPropertyMaxWidth,
+    WXCSSPropertyMaxHeight,
+    // margin
+    WXCSSPropertyMargin,
+    WXCSSPropertyMarginTop,
+    WXCSSPropertyMarginLeft,
+    WXCSSPropertyMarginRight,
+    WXCSSPropertyMarginBottom,
+    // border
+    WXCSSPropertyBorderWidth,
+    WXCSSPropertyBorderTopWidth,
+    WXCSSPropertyBorderLeftWidth,
+    WXCSSPropertyBorderRightWidth,
+    WXCSSPropertyBorderBottomWidth,
+    // padding
+    WXCSSPropertyPadding,
+    WXCSSPropertyPaddingTop,
+    WXCSSPropertyPaddingLeft,
+    WXCSSPropertyPaddingRight,
+    WXCSSPropertyPaddingBottom,
+    WXCSSPropertyCount
+} WXCSSProperty;
+
+// how the value of a property is converted
+typedef enum {
+    WXCSSValueTypeNone = 0,
+    // a number, like flex
+    WXCSSValueTypeNumber,
+    // a length, scaled by the pixel scale factor
+    WXCSSValueTypePixel,
+    WXCSSValueTypeFlexDirection,
+    WXCSSValueTypeAlign,
+    WXCSSValueTypeWrap,
+    WXCSSValueTypeJustify,
+    WXCSSValueTypePosition
+} WXCSSValueType;
+
+// the property of a style key, like "marginTop", WXCSSPropertyNone if it isn't a layout style
+WXCSSProperty WXCSSPropertyLookup(const char *key, size_t length);
+
+const char *WXCSSPropertyName(WXCSSProperty property);
+
+WXCSSValueType WXCSSPropertyValueType(WXCSSProperty property);
+
+// for the number and pixel properties, returns true if the style changed
+bool WXCSSStyleSetFloat(css_style_t *style, WXCSSProperty property, float value);
+
+// for the keyword properties, the value is one of the css_*_t enums, returns true if the style changed
+bool WXCSSStyleSetEnum(css_style_t *style, WXCSSProperty property, int value);
+
+// sets the default value of the property, returns true if the style changed
+bool WXCSSStyleReset(css_style_t *style, WXCSSProperty property);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WXCSSStyleApplier_h */
@@ -26,6 +26,7 @@
 #import "WXSDKInstance_private.h"
 #import "WXComponent+BoxShadow.h"
 #import "WXLayoutDefine.h"
+#import "WXCSSStyleApplier.h"
 
 @implementation WXComponent (Layout)
 
@@ -208,152 +209,107 @@
     [self layoutDidFinish];
 }
 
-#define WX_STYLE_FILL_CSS_NODE(key, cssProp, type)\
-do {\
-    id value = styles[@#key];\
-    if (value) {\
-        typeof(_cssNode->style.cssProp) convertedValue = (typeof(_cssNode->style.cssProp))[WXConvert type:value];\
-        _cssNode->style.cssProp = convertedValue;\
-        [self setNeedsLayout];\
-    }\
-} while(0);
-
-#define WX_STYLE_FILL_CSS_NODE_PIXEL(key, cssProp)\
-do {\
-    id value = styles[@#key];\
-    if (value) {\
-        CGFloat pixel = [self WXPixelType:value];\
-        if (isnan(pixel)) {\
-            WXLogError(@"Invalid NaN value for style:%@, ref:%@", @#key, self.ref);\
-        } else {\
-            _cssNode->style.cssProp = pixel;\
-            [self setNeedsLayout];\
-        }\
-    }\
-} while(0);
-
-#define WX_STYLE_FILL_CSS_NODE_ALL_DIRECTION(key, cssProp)\
-do {\
-    WX_STYLE_FILL_CSS_NODE_PIXEL(key, cssProp[CSS_TOP])\
-    WX_STYLE_FILL_CSS_NODE_PIXEL(key, cssProp[CSS_LEFT])\
-    WX_STYLE_FILL_CSS_NODE_PIXEL(key, cssProp[CSS_RIGHT])\
-    WX_STYLE_FILL_CSS_NODE_PIXEL(key, cssProp[CSS_BOTTOM])\
-} while(0);
-
-
 - (CGFloat)WXPixelType:(id)value
 {
     return [WXConvert WXPixelType:value scaleFactor:self.weexInstance.pixelScaleFactor];
 }
 
+static WXCSSProperty WXCSSPropertyOfKey(id key)
+{
+    if (![key isKindOfClass:[NSString class]]) {
+        return WXCSSPropertyNone;
+    }
+    CFStringRef string = (__bridge CFStringRef)key;
+    CFIndex length = CFStringGetLength(string);
+    char buffer[32];
+    CFIndex used = 0;
+    if (length > (CFIndex)sizeof(buffer) || CFStringGetBytes(string, CFRangeMake(0, length), kCFStringEncodingASCII, 0, false, (UInt8 *)buffer, sizeof(buffer), &used) != length) {
+        return WXCSSPropertyNone;
+    }
+    return WXCSSPropertyLookup(buffer, (size_t)used);
+}
+
+// the layout styles of an update, by their properties
+typedef struct {
+    __unsafe_unretained id values[WXCSSPropertyCount];
+    uint64_t properties;
+} WXCSSStyleUpdate;
+
 - (void)_fillCSSNode:(NSDictionary *)styles
 {
-    // flex
-    WX_STYLE_FILL_CSS_NODE(flex, flex, CGFloat)
-    WX_STYLE_FILL_CSS_NODE(flexDirection, flex_direction, css_flex_direction_t)
-    WX_STYLE_FILL_CSS_NODE(alignItems, align_items, css_align_t)
-    WX_STYLE_FILL_CSS_NODE(alignSelf, align_self, css_align_t)
-    WX_STYLE_FILL_CSS_NODE(flexWrap, flex_wrap, css_wrap_type_t)
-    WX_STYLE_FILL_CSS_NODE(justifyContent, justify_content, css_justify_t)
-    
-    // position
-    WX_STYLE_FILL_CSS_NODE(position, position_type, css_position_type_t)
-    WX_STYLE_FILL_CSS_NODE_PIXEL(top, position[CSS_TOP])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(left, position[CSS_LEFT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(right, position[CSS_RIGHT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(bottom, position[CSS_BOTTOM])
-    
-    // dimension
-    WX_STYLE_FILL_CSS_NODE_PIXEL(width, dimensions[CSS_WIDTH])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(height, dimensions[CSS_HEIGHT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(minWidth, minDimensions[CSS_WIDTH])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(minHeight, minDimensions[CSS_HEIGHT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(maxWidth, maxDimensions[CSS_WIDTH])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(maxHeight, maxDimensions[CSS_HEIGHT])
+    if (styles.count == 0) {
+        return;
+    }
     
-    // margin
-    WX_STYLE_FILL_CSS_NODE_ALL_DIRECTION(margin, margin)
-    WX_STYLE_FILL_CSS_NODE_PIXEL(marginTop, margin[CSS_TOP])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(marginLeft, margin[CSS_LEFT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(marginRight, margin[CSS_RIGHT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(marginBottom, margin[CSS_BOTTOM])
+    WXCSSStyleUpdate update = {{nil}, 0};
+    WXCSSStyleUpdate *collected = &update;
+    [styles enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+        WXCSSProperty property = WXCSSPropertyOfKey(key);
+        if (property != WXCSSPropertyNone) {
+            collected->values[property] = value;
+            collected->properties |= 1ULL << property;
+        }
+    }];
     
-    // border
-    WX_STYLE_FILL_CSS_NODE_ALL_DIRECTION(borderWidth, border)
-    WX_STYLE_FILL_CSS_NODE_PIXEL(borderTopWidth, border[CSS_TOP])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(borderLeftWidth, border[CSS_LEFT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(borderRightWidth, border[CSS_RIGHT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(borderBottomWidth, border[CSS_BOTTOM])
+    // in the order of the properties, so the longhands, like marginTop, win over the shorthands
+    css_style_t *style = &_cssNode->style;
+    // a shorthand and its longhand both change the style, so it's compared as a whole
+    css_style_t previous;
+    memcpy(&previous, style, sizeof(previous));
+    for (uint64_t properties = update.properties; properties; properties &= properties - 1) {
+        WXCSSProperty property = (WXCSSProperty)__builtin_ctzll(properties);
+        id value = update.values[property];
+        switch (WXCSSPropertyValueType(property)) {
+            case WXCSSValueTypeNumber:
+                WXCSSStyleSetFloat(style, property, [WXConvert CGFloat:value]);
+                break;
+            case WXCSSValueTypePixel: {
+                CGFloat pixel = [self WXPixelType:value];
+                if (isnan(pixel)) {
+                    WXLogError(@"Invalid NaN value for style:%s, ref:%@", WXCSSPropertyName(property), self.ref);
+                } else {
+                    WXCSSStyleSetFloat(style, property, pixel);
+                }
+                break;
+            }
+            case WXCSSValueTypeFlexDirection:
+                WXCSSStyleSetEnum(style, property, [WXConvert css_flex_direction_t:value]);
+                break;
+            case WXCSSValueTypeAlign:
+                WXCSSStyleSetEnum(style, property, [WXConvert css_align_t:value]);
+                break;
+            case WXCSSValueTypeWrap:
+                WXCSSStyleSetEnum(style, property, [WXConvert css_wrap_type_t:value]);
+                break;
+            case WXCSSValueTypeJustify:
+                WXCSSStyleSetEnum(style, property, [WXConvert css_justify_t:value]);
+                break;
+            case WXCSSValueTypePosition:
+                WXCSSStyleSetEnum(style, property, [WXConvert css_position_type_t:value]);
+                break;
+            default:
+                break;
+        }
+    }
     
-    // padding
-    WX_STYLE_FILL_CSS_NODE_ALL_DIRECTION(padding, padding)
-    WX_STYLE_FILL_CSS_NODE_PIXEL(paddingTop, padding[CSS_TOP])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(paddingLeft, padding[CSS_LEFT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(paddingRight, padding[CSS_RIGHT])
-    WX_STYLE_FILL_CSS_NODE_PIXEL(paddingBottom, padding[CSS_BOTTOM])
+    if (memcmp(&previous, style, sizeof(previous)) != 0) {
+        [self setNeedsLayout];
+    }
 }
 
-#define WX_STYLE_RESET_CSS_NODE(key, cssProp, defaultValue)\
-do {\
-    if (styles && [styles containsObject:@#key]) {\
-        _cssNode->style.cssProp = defaultValue;\
-        [self setNeedsLayout];\
-    }\
-} while(0);
-
-#define WX_STYLE_RESET_CSS_NODE_ALL_DIRECTION(key, cssProp, defaultValue)\
-do {\
-    WX_STYLE_RESET_CSS_NODE(key, cssProp[CSS_TOP], defaultValue)\
-    WX_STYLE_RESET_CSS_NODE(key, cssProp[CSS_LEFT], defaultValue)\
-    WX_STYLE_RESET_CSS_NODE(key, cssProp[CSS_RIGHT], defaultValue)\
-    WX_STYLE_RESET_CSS_NODE(key, cssProp[CSS_BOTTOM], defaultValue)\
-} while(0);
-
 - (void)_resetCSSNode:(NSArray *)styles;
 {
-    // flex
-    WX_STYLE_RESET_CSS_NODE(flex, flex, 0.0)
-    WX_STYLE_RESET_CSS_NODE(flexDirection, flex_direction, CSS_FLEX_DIRECTION_COLUMN)
-    WX_STYLE_RESET_CSS_NODE(alignItems, align_items, CSS_ALIGN_STRETCH)
-    WX_STYLE_RESET_CSS_NODE(alignSelf, align_self, CSS_ALIGN_AUTO)
-    WX_STYLE_RESET_CSS_NODE(flexWrap, flex_wrap, CSS_NOWRAP)
-    WX_STYLE_RESET_CSS_NODE(justifyContent, justify_content, CSS_JUSTIFY_FLEX_START)
-
-    // position
-    WX_STYLE_RESET_CSS_NODE(position, position_type, CSS_POSITION_RELATIVE)
-    WX_STYLE_RESET_CSS_NODE(top, position[CSS_TOP], CSS_UNDEFINED)
-    WX_STYLE_RESET_CSS_NODE(left, position[CSS_LEFT], CSS_UNDEFINED)
-    WX_STYLE_RESET_CSS_NODE(right, position[CSS_RIGHT], CSS_UNDEFINED)
-    WX_STYLE_RESET_CSS_NODE(bottom, position[CSS_BOTTOM], CSS_UNDEFINED)
-    
-    // dimension
-    WX_STYLE_RESET_CSS_NODE(width, dimensions[CSS_WIDTH], CSS_UNDEFINED)
-    WX_STYLE_RESET_CSS_NODE(height, dimensions[CSS_HEIGHT], CSS_UNDEFINED)
-    WX_STYLE_RESET_CSS_NODE(minWidth, minDimensions[CSS_WIDTH], CSS_UNDEFINED)
-    WX_STYLE_RESET_CSS_NODE(minHeight, minDimensions[CSS_HEIGHT], CSS_UNDEFINED)
-    WX_STYLE_RESET_CSS_NODE(maxWidth, maxDimensions[CSS_WIDTH], CSS_UNDEFINED)
-    WX_STYLE_RESET_CSS_NODE(maxHeight, maxDimensions[CSS_HEIGHT], CSS_UNDEFINED)
-    
-    // margin
-    WX_STYLE_RESET_CSS_NODE_ALL_DIRECTION(margin, margin, 0.0)
-    WX_STYLE_RESET_CSS_NODE(marginTop, margin[CSS_TOP], 0.0)
-    WX_STYLE_RESET_CSS_NODE(marginLeft, margin[CSS_LEFT], 0.0)
-    WX_STYLE_RESET_CSS_NODE(marginRight, margin[CSS_RIGHT], 0.0)
-    WX_STYLE_RESET_CSS_NODE(marginBottom, margin[CSS_BOTTOM], 0.0)
-    
-    // border
-    WX_STYLE_RESET_CSS_NODE_ALL_DIRECTION(borderWidth, border, 0.0)
-    WX_STYLE_RESET_CSS_NODE(borderTopWidth, border[CSS_TOP], 0.0)
-    WX_STYLE_RESET_CSS_NODE(borderLeftWidth, border[CSS_LEFT], 0.0)
-    WX_STYLE_RESET_CSS_NODE(borderRightWidth, border[CSS_RIGHT], 0.0)
-    WX_STYLE_RESET_CSS_NODE(borderBottomWidth, border[CSS_BOTTOM], 0.0)
+    BOOL changed = NO;
+    for (id key in styles) {
+        WXCSSProperty property = WXCSSPropertyOfKey(key);
+        if (property != WXCSSPropertyNone) {
+            changed |= WXCSSStyleReset(&_cssNode->style, property);
+        }
+    }
     
-    // padding
-    WX_STYLE_RESET_CSS_NODE_ALL_DIRECTION(padding, padding, 0.0)
-    WX_STYLE_RESET_CSS_NODE(paddingTop, padding[CSS_TOP], 0.0)
-    WX_STYLE_RESET_CSS_NODE(paddingLeft, padding[CSS_LEFT], 0.0)
-    WX_STYLE_RESET_CSS_NODE(paddingRight, padding[CSS_RIGHT], 0.0)
-    WX_STYLE_RESET_CSS_NODE(paddingBottom, padding[CSS_BOTTOM], 0.0)
+    if (changed) {
+        [self setNeedsLayout];
+    }
 }
 
 #pragma mark CSS Node Override
@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Decodes, hashes and caches a js bundle while it is downloaded, so it's ready to be executed when the
+ * last byte arrives. The data must be appended in order, it's safe to do so on any thread.
+ */
+@interface WXBundleStream : NSObject
+
+/**
+ * The md5 of the bundle, after finish.
+ */
+@property (nonatomic, copy, readonly) NSString *md5;
+
+/**
+ * The cached file of the bundle, after finish.
+ */
+@property (nonatomic, copy, readonly) NSString *cachePath;
+
+/**
+ * Bytes appended so far.
+ */
+@property (nonatomic, assign, readonly) NSUInteger length;
+
+/**
+ * The directory bundles are cached in by default.
+ */
++ (NSString *)defaultCacheDirectory;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * @param directory where the bundle is cached, nil to not cache it
+ * @param expectedLength the expected bytes of the bundle, 0 if unknown
+ */
+- (instancetype)initWithCacheDirectory:(NSString *)directory expectedLength:(NSUInteger)expectedLength NS_DESIGNATED_INITIALIZER;
+
+- (void)appendData:(NSData *)data;
+
+/**
+ * Returns the bundle string, or nil if the bytes are not valid UTF-8, it's the string
+ * `initWithData:encoding:` would make.
+ */
+- (NSString *)finish;
+
+- (void)cancel;
+
+@end
@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXBundleStream.h"
+#import "WXBundleStreamCore.h"
+#import <pthread/pthread.h>
+#import <memory>
+
+// the least recently used bundles are removed beyond this
+static const size_t WXBundleCacheLimit = 10 * 1024 * 1024;
+
+@implementation WXBundleStream
+{
+    std::unique_ptr<WXBundleStreamCore> _core;
+    pthread_mutex_t _mutex;
+}
+
++ (NSString *)defaultCacheDirectory
+{
+    NSString *cacheDirectory = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    return [cacheDirectory stringByAppendingPathComponent:@"wxbundles"];
+}
+
+- (instancetype)initWithCacheDirectory:(NSString *)directory expectedLength:(NSUInteger)expectedLength
+{
+    if (self = [super init]) {
+        _core.reset(new WXBundleStreamCore(directory ? directory.fileSystemRepresentation : "", WXBundleCacheLimit));
+        if (expectedLength > 0) {
+            _core->reserve(expectedLength);
+        }
+        pthread_mutex_init(&_mutex, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (NSUInteger)length
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger length = _core->byteCount();
+    pthread_mutex_unlock(&_mutex);
+    return length;
+}
+
+- (void)appendData:(NSData *)data
+{
+    pthread_mutex_lock(&_mutex);
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        if (!_core->append(bytes, byteRange.length)) {
+            *stop = YES;
+        }
+    }];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (NSString *)finish
+{
+    pthread_mutex_lock(&_mutex);
+    NSString *bundle = nil;
+    // NSString drops a leading byte order mark, the stream keeps it
+    if (_core->finish() && !_core->hasByteOrderMark()) {
+        const std::vector<uint16_t> &characters = _core->characters();
+        bundle = [[NSString alloc] initWithCharacters:(const unichar *)characters.data() length:characters.size()];
+        _md5 = [NSString stringWithUTF8String:_core->md5().c_str()];
+        _cachePath = _core->cachePath().empty() ? nil : [NSString stringWithUTF8String:_core->cachePath().c_str()];
+    }
+    pthread_mutex_unlock(&_mutex);
+    return bundle;
+}
+
+- (void)cancel
+{
+    pthread_mutex_lock(&_mutex);
+    _core->cancel();
+    pthread_mutex_unlock(&_mutex);
+}
+
+@end
@@ -0,0 +1,88 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <UIKit/UIKit.h>
+#import "WXImgLoaderProtocol.h"
+
+/**
+ * Schedules the image loads of all the components over the registered WXImgLoaderProtocol handler:
+ * - requests for an image which is already loading share its load
+ * - loads start by the distance of their nearest request to the viewport, a few at once
+ * - a load is dropped, or cancelled if it started, when all its requests are cancelled, like
+ *   when their cells are reused
+ * - images are decoded to the laid out size of their component at their quality, rounded up to
+ *   a size bucket, instead of their full resolution, and kept by URL and bucket in a memory cache
+ *   limited by their bytes
+ *
+ * Loaders implementing downloadImageDataWithURL:imageFrame:userInfo:completed: only fetch the bytes,
+ * the images are decoded here.
+ */
+@interface WXImageScheduler : NSObject
+
++ (instancetype)sharedScheduler;
+
+/**
+ * Loads the image, or returns nil after calling the block if it's in the memory cache.
+ * imageFrame: the laid out frame the image is decoded for, the original size is decoded if it's empty
+ * or if the imageQuality of the userInfo is WXImageQualityOriginal.
+ * priority: the distance of the image to the viewport in points, 0 if it's visible.
+ * The block may be called on any thread.
+ */
+- (id<WXImageOperationProtocol>)loadImageWithURL:(NSString *)url
+                                      imageFrame:(CGRect)imageFrame
+                                        userInfo:(NSDictionary *)userInfo
+                                        priority:(CGFloat)priority
+                                       completed:(void(^)(UIImage *image, NSError *error, BOOL finished))completedBlock;
+
+/**
+ * Moves a request returned by loadImageWithURL:, e.g. when its view is added to the window.
+ */
+- (void)setPriority:(CGFloat)priority forOperation:(id<WXImageOperationProtocol>)operation;
+
+/**
+ * The max loads running at once, 6 by default.
+ */
+- (void)setMaxConcurrentLoads:(NSUInteger)maxConcurrentLoads;
+
+/**
+ * The max bytes of the decoded images in memory, 32MB by default.
+ */
+- (void)setCostLimit:(NSUInteger)costLimit;
+
+- (void)removeAllImages;
+
+/**
+ * The size bucket in pixels an image loaded for the frame is decoded to, zero for the original size.
+ */
++ (CGSize)decodedSizeForImageFrame:(CGRect)imageFrame userInfo:(NSDictionary *)userInfo;
+
+/**
+ * The size in pixels of the source of an image loaded here, which may be decoded smaller.
+ */
++ (CGSize)naturalSizeOfImage:(UIImage *)image;
+
+/**
+ * requests, coalesced, started, succeeded, failed, cancelled, aborted, pending, maxPending,
+ * running and averageWait (milliseconds in the queue) of the loads, then cacheHits, cacheMisses,
+ * cacheEvictions, cacheCount and cacheCost (bytes) of the memory cache.
+ */
+- (NSDictionary<NSString *, NSNumber *> *)metrics;
+
+@end
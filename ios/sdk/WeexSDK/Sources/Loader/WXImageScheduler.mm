@@ -0,0 +1,511 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXImageScheduler.h"
+#import "WXHandlerFactory.h"
+#import "WXDefine.h"
+#import "WXType.h"
+#import "WXUtility.h"
+#import <ImageIO/ImageIO.h>
+#import <QuartzCore/QuartzCore.h>
+#import <objc/runtime.h>
+#import <pthread/pthread.h>
+#include "WXImageDownsampler.h"
+#include "WXImageRequestQueue.h"
+#include "WXRasterCache.h"
+#include <memory>
+
+static const NSUInteger WXImageSchedulerDefaultMaxConcurrentLoads = 6;
+static const NSUInteger WXImageSchedulerDefaultCostLimit = 32 * 1024 * 1024;
+
+static const void *WXImageNaturalSizeKey = &WXImageNaturalSizeKey;
+
+typedef void (^WXImageSchedulerCompletion)(UIImage *image, NSError *error, BOOL finished);
+
+@interface WXImageSchedulerRequest : NSObject
+
+@property (nonatomic, copy) NSString *url;
+@property (nonatomic, assign) CGRect imageFrame;
+@property (nonatomic, copy) NSDictionary *userInfo;
+@property (nonatomic, assign) WXImageSizeBucket bucket;
+
+@end
+
+@implementation WXImageSchedulerRequest
+
+@end
+
+@class WXImageSchedulerOperation;
+
+@interface WXImageScheduler ()
+
+- (void)_cancelOperation:(WXImageSchedulerOperation *)operation;
+
+@end
+
+@interface WXImageSchedulerOperation : NSObject <WXImageOperationProtocol>
+
+@property (nonatomic, assign) uint64_t ticket;
+@property (nonatomic, copy) NSString *key;
+
+@end
+
+@implementation WXImageSchedulerOperation
+
+- (void)cancel
+{
+    [[WXImageScheduler sharedScheduler] _cancelOperation:self];
+}
+
+@end
+
+// the pixels an image is decoded to for the laid out size of its component, at its quality
+static WXImageSizeBucket WXImageBucketForRequest(CGRect imageFrame, NSDictionary *userInfo)
+{
+    double pixelsPerPoint = WXScreenScale();
+    id quality = userInfo[@"imageQuality"];
+    switch (quality ? (WXImageQuality)[quality integerValue] : WXImageQualityNone) {
+        case WXImageQualityOriginal:
+            pixelsPerPoint = 0;
+            break;
+        case WXImageQualityLow:
+            pixelsPerPoint *= 0.5;
+            break;
+        case WXImageQualityNormal:
+            pixelsPerPoint *= 0.75;
+            break;
+        default:
+            break;
+    }
+    return WXImageBucketForTarget({imageFrame.size.width, imageFrame.size.height, pixelsPerPoint});
+}
+
+static UIImage *WXImageWithNaturalSize(UIImage *image, CGSize naturalSize)
+{
+    objc_setAssociatedObject(image, WXImageNaturalSizeKey, [NSValue valueWithCGSize:naturalSize], OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    return image;
+}
+
+// the size of the bitmap of the image for the bucket, in the pixels of its CGImage
+static WXImageDecodePlan WXPlanImageDraw(UIImage *image, WXImageSizeBucket bucket)
+{
+    CGImageRef cgImage = image.CGImage;
+    UIImageOrientation orientation = image.imageOrientation;
+    if (orientation == UIImageOrientationLeft || orientation == UIImageOrientationRight ||
+        orientation == UIImageOrientationLeftMirrored || orientation == UIImageOrientationRightMirrored) {
+        bucket = {bucket.height, bucket.width};
+    }
+    return WXPlanImageDecode((int)CGImageGetWidth(cgImage), (int)CGImageGetHeight(cgImage), bucket);
+}
+
+// the images are drawn into bitmaps of the planned size here, instead of on the main thread when they are displayed first
+static UIImage *WXDecodedImage(UIImage *image, WXImageSizeBucket bucket)
+{
+    CGImageRef cgImage = image.CGImage;
+    if (!cgImage || image.images) {
+        return image;
+    }
+    WXImageDecodePlan plan = WXPlanImageDraw(image, bucket);
+    size_t width = plan.width;
+    size_t height = plan.height;
+    CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(cgImage);
+    BOOL hasAlpha = !(alphaInfo == kCGImageAlphaNone || alphaInfo == kCGImageAlphaNoneSkipFirst || alphaInfo == kCGImageAlphaNoneSkipLast);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                                                 kCGBitmapByteOrder32Host | (hasAlpha ? kCGImageAlphaPremultipliedFirst : kCGImageAlphaNoneSkipFirst));
+    CGColorSpaceRelease(colorSpace);
+    if (!context) {
+        return image;
+    }
+    CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), cgImage);
+    CGImageRef decodedImage = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    if (!decodedImage) {
+        return image;
+    }
+    UIImage *result = [UIImage imageWithCGImage:decodedImage scale:image.scale orientation:image.imageOrientation];
+    CGImageRelease(decodedImage);
+    if (width < CGImageGetWidth(cgImage)) {
+        WXImageWithNaturalSize(result, CGSizeMake(image.size.width * image.scale, image.size.height * image.scale));
+    }
+    return result;
+}
+
+// ImageIO decodes the thumbnail straight from the data, subsampling JPEGs while they are decoded, so the full size bitmap is never allocated
+static UIImage *WXDownsampledImage(CGImageSourceRef source, WXImageSizeBucket bucket)
+{
+    if (CGImageSourceGetCount(source) != 1) {
+        // animated images are decoded by UIImage
+        return nil;
+    }
+    NSDictionary *properties = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+    NSInteger width = [properties[(__bridge NSString *)kCGImagePropertyPixelWidth] integerValue];
+    NSInteger height = [properties[(__bridge NSString *)kCGImagePropertyPixelHeight] integerValue];
+    NSInteger orientation = [properties[(__bridge NSString *)kCGImagePropertyOrientation] integerValue];
+    if (orientation >= 5 && orientation <= 8) {
+        // the EXIF orientations rotated by 90 degrees
+        NSInteger rotatedWidth = height;
+        height = width;
+        width = rotatedWidth;
+    }
+    WXImageDecodePlan plan = WXPlanImageDecode((int)width, (int)height, bucket);
+    if (plan.width <= 0 || plan.width >= width) {
+        return nil;
+    }
+    
+    NSDictionary *options = @{(__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+                              (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform: @YES,
+                              (__bridge NSString *)kCGImageSourceShouldCacheImmediately: @YES,
+                              (__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize: @(MAX(plan.width, plan.height))};
+    CGImageRef cgImage = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    if (!cgImage) {
+        return nil;
+    }
+    UIImage *image = [UIImage imageWithCGImage:cgImage];
+    CGImageRelease(cgImage);
+    return WXImageWithNaturalSize(image, CGSizeMake(width, height));
+}
+
+static UIImage *WXImageWithData(NSData *data, WXImageSizeBucket bucket)
+{
+    if (bucket.width > 0 && bucket.height > 0) {
+        CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, NULL);
+        UIImage *image = source ? WXDownsampledImage(source, bucket) : nil;
+        if (source) {
+            CFRelease(source);
+        }
+        if (image) {
+            return image;
+        }
+    }
+    UIImage *image = [UIImage imageWithData:data];
+    return image ? WXDecodedImage(image, bucket) : nil;
+}
+
+static size_t WXImageCost(UIImage *image)
+{
+    CGImageRef cgImage = image.CGImage ?: image.images.firstObject.CGImage;
+    if (!cgImage) {
+        return 0;
+    }
+    return CGImageGetBytesPerRow(cgImage) * CGImageGetHeight(cgImage) * MAX(image.images.count, (NSUInteger)1);
+}
+
+// everything the loaded image depends on, components of nearly the same size share the bucket
+static NSString *WXImageSchedulerKey(NSString *url, WXImageSizeBucket bucket, NSDictionary *userInfo)
+{
+    NSMutableString *key = [NSMutableString stringWithFormat:@"%@ %dx%d", url, bucket.width, bucket.height];
+    for (id name in [userInfo.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        [key appendFormat:@" %@=%@", name, userInfo[name]];
+    }
+    return key;
+}
+
+static WXRasterKey WXImageCacheKey(NSString *key)
+{
+    NSData *bytes = [key dataUsingEncoding:NSUTF8StringEncoding];
+    WXRasterKey cacheKey;
+    cacheKey.add(bytes.bytes, bytes.length);
+    return cacheKey;
+}
+
+@implementation WXImageScheduler
+{
+    std::unique_ptr<WXImageRequestQueue> _queue;
+    std::unique_ptr<WXRasterCache<UIImage *>> _cache;
+    dispatch_queue_t _decodeQueue;
+    // access with the lock
+    pthread_mutex_t _lock;
+    NSMutableDictionary<NSString *, WXImageSchedulerRequest *> *_requests;
+    NSMutableDictionary<NSNumber *, WXImageSchedulerCompletion> *_completions;
+    NSMutableSet<NSNumber *> *_runningLoads;
+    NSMutableDictionary<NSNumber *, id<WXImageOperationProtocol>> *_operations;
+}
+
++ (instancetype)sharedScheduler
+{
+    static WXImageScheduler *sharedScheduler;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedScheduler = [[WXImageScheduler alloc] init];
+    });
+    return sharedScheduler;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _queue.reset(new WXImageRequestQueue(WXImageSchedulerDefaultMaxConcurrentLoads));
+        _cache.reset(new WXRasterCache<UIImage *>(WXImageSchedulerDefaultCostLimit));
+        _decodeQueue = dispatch_queue_create("com.taobao.weex.imageDecodeQueue", DISPATCH_QUEUE_CONCURRENT);
+        pthread_mutex_init(&_lock, NULL);
+        _requests = [NSMutableDictionary dictionary];
+        _completions = [NSMutableDictionary dictionary];
+        _runningLoads = [NSMutableSet set];
+        _operations = [NSMutableDictionary dictionary];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(removeAllImages)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    pthread_mutex_destroy(&_lock);
+}
+
+- (id<WXImgLoaderProtocol>)imageLoader
+{
+    static id<WXImgLoaderProtocol> imageLoader;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        imageLoader = [WXHandlerFactory handlerForProtocol:@protocol(WXImgLoaderProtocol)];
+    });
+    return imageLoader;
+}
+
+- (id<WXImageOperationProtocol>)loadImageWithURL:(NSString *)url
+                                      imageFrame:(CGRect)imageFrame
+                                        userInfo:(NSDictionary *)userInfo
+                                        priority:(CGFloat)priority
+                                       completed:(void(^)(UIImage *image, NSError *error, BOOL finished))completedBlock
+{
+    WXImageSizeBucket bucket = WXImageBucketForRequest(imageFrame, userInfo);
+    NSString *key = WXImageSchedulerKey(url, bucket, userInfo);
+    UIImage *image = nil;
+    if (_cache->get(WXImageCacheKey(key), image)) {
+        if (completedBlock) {
+            completedBlock(image, nil, YES);
+        }
+        return nil;
+    }
+    
+    WXImageSchedulerOperation *operation = [WXImageSchedulerOperation new];
+    operation.key = key;
+    pthread_mutex_lock(&_lock);
+    operation.ticket = _queue->add(key.UTF8String, priority, CACurrentMediaTime());
+    if (!_requests[key]) {
+        WXImageSchedulerRequest *request = [WXImageSchedulerRequest new];
+        request.url = url;
+        request.imageFrame = imageFrame;
+        request.userInfo = userInfo;
+        request.bucket = bucket;
+        _requests[key] = request;
+    }
+    _completions[@(operation.ticket)] = completedBlock ?: ^(UIImage *image, NSError *error, BOOL finished) {};
+    pthread_mutex_unlock(&_lock);
+    
+    [self _startLoads];
+    return operation;
+}
+
+- (void)setPriority:(CGFloat)priority forOperation:(id<WXImageOperationProtocol>)operation
+{
+    if ([operation isKindOfClass:[WXImageSchedulerOperation class]]) {
+        _queue->update(((WXImageSchedulerOperation *)operation).ticket, priority);
+    }
+}
+
+- (void)_cancelOperation:(WXImageSchedulerOperation *)operation
+{
+    id<WXImageOperationProtocol> loadOperation = nil;
+    pthread_mutex_lock(&_lock);
+    [_completions removeObjectForKey:@(operation.ticket)];
+    uint64_t load = _queue->cancel(operation.ticket);
+    if (load) {
+        // nobody waits for the image any more
+        [_requests removeObjectForKey:operation.key];
+        [_runningLoads removeObject:@(load)];
+        loadOperation = _operations[@(load)];
+        [_operations removeObjectForKey:@(load)];
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    if (load) {
+        [loadOperation cancel];
+        [self _startLoads];
+    }
+}
+
+- (void)_startLoads
+{
+    for (const WXImageLoad &load : _queue->next(CACurrentMediaTime())) {
+        NSString *key = @(load.key.c_str());
+        NSNumber *identifier = @(load.identifier);
+        pthread_mutex_lock(&_lock);
+        WXImageSchedulerRequest *request = _requests[key];
+        if (request) {
+            [_runningLoads addObject:identifier];
+        }
+        pthread_mutex_unlock(&_lock);
+        if (!request) {
+            continue;
+        }
+        
+        id<WXImageOperationProtocol> operation = [self _fetchRequest:request key:key load:load.identifier];
+        pthread_mutex_lock(&_lock);
+        BOOL running = [_runningLoads containsObject:identifier];
+        if (running && operation) {
+            _operations[identifier] = operation;
+        }
+        pthread_mutex_unlock(&_lock);
+        if (!running) {
+            // cancelled while it was starting, cancelling an operation which already finished does nothing
+            [operation cancel];
+        }
+    }
+}
+
+- (id<WXImageOperationProtocol>)_fetchRequest:(WXImageSchedulerRequest *)request key:(NSString *)key load:(uint64_t)load
+{
+    id<WXImgLoaderProtocol> imageLoader = [self imageLoader];
+    if (!imageLoader) {
+        NSError *error = [NSError errorWithDomain:WX_ERROR_DOMAIN code:-1 userInfo:@{NSLocalizedDescriptionKey: @"no image loader is registered"}];
+        [self _finishLoad:load key:key image:nil error:error];
+        return nil;
+    }
+    
+    WXImageSizeBucket bucket = request.bucket;
+    dispatch_queue_t decodeQueue = _decodeQueue;
+    if ([imageLoader respondsToSelector:@selector(downloadImageDataWithURL:imageFrame:userInfo:completed:)]) {
+        return [imageLoader downloadImageDataWithURL:request.url imageFrame:request.imageFrame userInfo:request.userInfo completed:^(NSData *data, NSError *error) {
+            dispatch_async(decodeQueue, ^{
+                UIImage *image = nil;
+                NSError *decodeError = error;
+                if (!decodeError) {
+                    image = data.length > 0 ? WXImageWithData(data, bucket) : nil;
+                    if (!image) {
+                        decodeError = [NSError errorWithDomain:WX_ERROR_DOMAIN code:-1 userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"failed to decode the image of %@", request.url]}];
+                    }
+                }
+                [self _finishLoad:load key:key image:image error:decodeError];
+            });
+        }];
+    }
+    
+    return [imageLoader downloadImageWithURL:request.url imageFrame:request.imageFrame userInfo:request.userInfo completed:^(UIImage *image, NSError *error, BOOL finished) {
+        if (!finished && !error) {
+            // a progressive image, only the final one is delivered
+            return;
+        }
+        if (!image && !error) {
+            error = [NSError errorWithDomain:WX_ERROR_DOMAIN code:-1 userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"failed to load the image of %@", request.url]}];
+        }
+        if (image.CGImage && !image.images && WXPlanImageDraw(image, bucket).width < CGImageGetWidth(image.CGImage)) {
+            // the loader decoded it at its full size, only the downsampled one is kept
+            dispatch_async(decodeQueue, ^{
+                [self _finishLoad:load key:key image:WXDecodedImage(image, bucket) error:nil];
+            });
+            return;
+        }
+        [self _finishLoad:load key:key image:image error:error];
+    }];
+}
+
+- (void)_finishLoad:(uint64_t)load key:(NSString *)key image:(UIImage *)image error:(NSError *)error
+{
+    if (image) {
+        _cache->put(WXImageCacheKey(key), image, WXImageCost(image));
+    }
+    
+    NSMutableArray<WXImageSchedulerCompletion> *completions = [NSMutableArray array];
+    pthread_mutex_lock(&_lock);
+    NSNumber *identifier = @(load);
+    BOOL running = [_runningLoads containsObject:identifier];
+    if (running) {
+        [_runningLoads removeObject:identifier];
+        [_operations removeObjectForKey:identifier];
+        [_requests removeObjectForKey:key];
+        for (uint64_t ticket : _queue->finish(load, image != nil)) {
+            WXImageSchedulerCompletion completion = _completions[@(ticket)];
+            if (completion) {
+                [completions addObject:completion];
+                [_completions removeObjectForKey:@(ticket)];
+            }
+        }
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    if (!running) {
+        return;
+    }
+    for (WXImageSchedulerCompletion completion in completions) {
+        completion(image, error, YES);
+    }
+    [self _startLoads];
+}
+
++ (CGSize)decodedSizeForImageFrame:(CGRect)imageFrame userInfo:(NSDictionary *)userInfo
+{
+    WXImageSizeBucket bucket = WXImageBucketForRequest(imageFrame, userInfo);
+    return CGSizeMake(bucket.width, bucket.height);
+}
+
++ (CGSize)naturalSizeOfImage:(UIImage *)image
+{
+    NSValue *naturalSize = objc_getAssociatedObject(image, WXImageNaturalSizeKey);
+    return naturalSize ? naturalSize.CGSizeValue : CGSizeMake(image.size.width * image.scale, image.size.height * image.scale);
+}
+
+- (void)setMaxConcurrentLoads:(NSUInteger)maxConcurrentLoads
+{
+    _queue->setMaxRunning(MAX(maxConcurrentLoads, (NSUInteger)1));
+    [self _startLoads];
+}
+
+- (void)setCostLimit:(NSUInteger)costLimit
+{
+    _cache->setCostLimit(costLimit);
+}
+
+- (void)removeAllImages
+{
+    _cache->clear();
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)metrics
+{
+    WXImageRequestQueueMetrics queueMetrics = _queue->metrics();
+    WXRasterCacheMetrics cacheMetrics = _cache->metrics();
+    return @{
+        @"requests": @(queueMetrics.requests),
+        @"coalesced": @(queueMetrics.coalesced),
+        @"started": @(queueMetrics.started),
+        @"succeeded": @(queueMetrics.succeeded),
+        @"failed": @(queueMetrics.failed),
+        @"cancelled": @(queueMetrics.cancelled),
+        @"aborted": @(queueMetrics.aborted),
+        @"pending": @(queueMetrics.pending),
+        @"maxPending": @(queueMetrics.maxPending),
+        @"running": @(queueMetrics.running),
+        @"averageWait": @(queueMetrics.started ? queueMetrics.totalWait * 1000 / queueMetrics.started : 0),
+        @"cacheHits": @(cacheMetrics.hits),
+        @"cacheMisses": @(cacheMetrics.misses),
+        @"cacheEvictions": @(cacheMetrics.evictions),
+        @"cacheCount": @(cacheMetrics.count),
+        @"cacheCost": @(cacheMetrics.totalCost),
+    };
+}
+
+@end
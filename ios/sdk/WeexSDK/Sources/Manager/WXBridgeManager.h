@@ -165,6 +165,12 @@ extern void WXPerformBlockOnBridgeThread(void (^block)(void));
  **/
 - (void)callBack:(NSString *)instanceId funcId:(NSString *)funcId params:(id)params;
 
+/**
+ *  CallBack several callbacks at once, the ones of an instance are sent to js in one call
+ *  @param callbacks :   dictionaries of the instanceId and the funcId, and optionally the params and keepAlive
+ **/
+- (void)callBacks:(NSArray<NSDictionary *> *)callbacks;
+
 /**
  *  Connect To WebSocket for collecting log
  *  @param url       :   url to connect
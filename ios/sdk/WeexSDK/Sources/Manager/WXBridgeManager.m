@@ -326,7 +326,7 @@ void WXPerformBlockOnBridgeThread(void (^block)(void))
     [self callJsMethod:method];
 }
 
-- (void)callBack:(NSString *)instanceId funcId:(NSString *)funcId params:(id)params keepAlive:(BOOL)keepAlive
+- (WXCallJSMethod *)_callBackMethod:(NSString *)instanceId funcId:(NSString *)funcId params:(id)params keepAlive:(BOOL)keepAlive
 {
     NSArray *args = nil;
     if (keepAlive) {
@@ -336,10 +336,35 @@ void WXPerformBlockOnBridgeThread(void (^block)(void))
     }
     WXSDKInstance *instance = [WXSDKManager instanceForID:instanceId];
 
-    WXCallJSMethod *method = [[WXCallJSMethod alloc] initWithModuleName:@"jsBridge" methodName:@"callback" arguments:args instance:instance];
+    return [[WXCallJSMethod alloc] initWithModuleName:@"jsBridge" methodName:@"callback" arguments:args instance:instance];
+}
+
+- (void)callBack:(NSString *)instanceId funcId:(NSString *)funcId params:(id)params keepAlive:(BOOL)keepAlive
+{
+    WXCallJSMethod *method = [self _callBackMethod:instanceId funcId:funcId params:params keepAlive:keepAlive];
     [self callJsMethod:method];
 }
 
+- (void)callBacks:(NSArray<NSDictionary *> *)callbacks
+{
+    if (callbacks.count == 0) return;
+    
+    NSMutableArray *methods = [NSMutableArray arrayWithCapacity:callbacks.count];
+    for (NSDictionary *callback in callbacks) {
+        NSString *instanceId = callback[@"instanceId"];
+        NSString *funcId = callback[@"funcId"];
+        if (!instanceId || !funcId) {
+            continue;
+        }
+        [methods addObject:[self _callBackMethod:instanceId funcId:funcId params:callback[@"params"] keepAlive:[callback[@"keepAlive"] boolValue]]];
+    }
+    
+    __weak typeof(self) weakSelf = self;
+    WXPerformBlockOnBridgeThread(^(){
+        [weakSelf.bridgeCtx executeJsMethods:methods];
+    });
+}
+
 - (void)callBack:(NSString *)instanceId funcId:(NSString *)funcId params:(id)params
 {
     [self callBack:instanceId funcId:funcId params:params keepAlive:NO];
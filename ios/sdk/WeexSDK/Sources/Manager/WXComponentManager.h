@@ -189,6 +189,11 @@ void WXPerformBlockSyncOnComponentThread(void (^block)(void));
 
 - (void)_addUITask:(void (^)(void))block;
 
+/**
+ * @abstract Runs the block on the main thread after the UI tasks synced before it, which the frame scheduler may have deferred. Must be called on the component thread.
+ */
+- (void)performBlockOnMainThreadAfterUITasks:(dispatch_block_t)block;
+
 - (void)excutePrerenderUITask:(NSString *)url;
 
 /**
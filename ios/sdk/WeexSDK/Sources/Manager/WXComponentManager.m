@@ -37,6 +37,7 @@
 #import "WXPrerenderManager.h"
 #import "WXTracingManager.h"
 #import "WXLayoutDefine.h"
+#import "WXFrameScheduler.h"
 
 static NSThread *WXComponentThread;
 
@@ -714,7 +715,9 @@ static css_node_t * rootNodeGetChild(void *context, int i)
     [self invalidate];
     [self _stopDisplayLink];
     NSEnumerator *enumerator = [[_indexDict copy] objectEnumerator];
+    NSString *instanceId = self.weexInstance.instanceId;
     dispatch_async(dispatch_get_main_queue(), ^{
+        [[WXFrameScheduler sharedScheduler] cancelTasksForInstance:instanceId];
         WXComponent *component;
         while ((component = [enumerator nextObject])) {
             [component _unloadViewWithReusing:NO];
@@ -827,21 +830,63 @@ static css_node_t * rootNodeGetChild(void *context, int i)
     [_rootComponent _calculateFrameWithSuperAbsolutePosition:CGPointZero gatherDirtyComponents:dirtyComponents];
     [self _calculateRootFrame];
   
-    for (WXComponent *dirtyComponent in dirtyComponents) {
+    for (WXComponent *dirtyComponent in [self _sortedByVisibility:dirtyComponents]) {
         [self _addUITask:^{
             [dirtyComponent _layoutDidFinish];
         }];
     }
 }
 
+// the components in the viewport first, they are laid out in the first frame if the tasks are split across frames
+- (NSArray<WXComponent *> *)_sortedByVisibility:(NSSet<WXComponent *> *)components
+{
+    if (components.count < 2) {
+        return components.allObjects;
+    }
+    
+    CGRect viewport = CGRectMake(0, 0, _rootCSSNode->style.dimensions[CSS_WIDTH], _rootCSSNode->style.dimensions[CSS_HEIGHT]);
+    if (isnan(viewport.size.width) || isnan(viewport.size.height)) {
+        return components.allObjects;
+    }
+    
+    NSMutableArray<WXComponent *> *visibleComponents = [NSMutableArray arrayWithCapacity:components.count];
+    NSMutableArray<WXComponent *> *invisibleComponents = [NSMutableArray array];
+    for (WXComponent *component in components) {
+        // ignore the content offsets of scrollers, they are rarely scrolled before the first layout
+        CGRect frame = component.calculatedFrame;
+        for (WXComponent *supercomponent = component.supercomponent; supercomponent; supercomponent = supercomponent.supercomponent) {
+            frame.origin.x += supercomponent.calculatedFrame.origin.x;
+            frame.origin.y += supercomponent.calculatedFrame.origin.y;
+        }
+        if (CGRectIntersectsRect(frame, viewport)) {
+            [visibleComponents addObject:component];
+        } else {
+            [invisibleComponents addObject:component];
+        }
+    }
+    [visibleComponents addObjectsFromArray:invisibleComponents];
+    return visibleComponents;
+}
+
 - (void)_syncUITasks
 {
     NSArray<dispatch_block_t> *blocks = _uiTaskQueue;
     _uiTaskQueue = [NSMutableArray array];
+    NSString *instanceId = self.weexInstance.instanceId;
     dispatch_async(dispatch_get_main_queue(), ^{
-        for(dispatch_block_t block in blocks) {
-            block();
-        }
+        [[WXFrameScheduler sharedScheduler] scheduleTasks:blocks forInstance:instanceId];
+    });
+}
+
+- (void)performBlockOnMainThreadAfterUITasks:(dispatch_block_t)block
+{
+    WXAssertComponentThread();
+    
+    // the batches synced before are in the scheduler by the time this runs
+    NSString *instanceId = self.weexInstance.instanceId;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[WXFrameScheduler sharedScheduler] flushTasksForInstance:instanceId];
+        block();
     });
 }
 
@@ -869,11 +914,11 @@ static css_node_t * rootNodeGetChild(void *context, int i)
                               WXRoundPixelValue(_rootCSSNode->layout.position[CSS_TOP]),
                               WXRoundPixelValue(_rootCSSNode->layout.dimensions[CSS_WIDTH]),
                               WXRoundPixelValue(_rootCSSNode->layout.dimensions[CSS_HEIGHT]));
-    WXPerformBlockOnMainThread(^{
+    [self performBlockOnMainThreadAfterUITasks:^{
         if(!self.weexInstance.isRootViewFrozen) {
             self.weexInstance.rootView.frame = frame;
         }
-    });
+    }];
     
     resetNodeLayout(_rootCSSNode);
 }
@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Runs the UI tasks of the component managers on the main thread, within a
+ * time budget per frame. A batch which doesn't fit in the budget is split
+ * across the next frames, so that rendering a huge page doesn't stall the main
+ * thread. Tasks run in the order they were scheduled.
+ */
+@interface WXFrameScheduler : NSObject
+
++ (instancetype)sharedScheduler;
+
+/**
+ * Seconds the tasks may take in a frame, 8ms by default.
+ */
+@property (nonatomic, assign) NSTimeInterval frameBudget;
+
+/**
+ * Number of frames in which the tasks took more than twice the budget,
+ * because a single task was too slow.
+ */
+@property (nonatomic, assign, readonly) NSUInteger overrunCount;
+
+/**
+ * Number of tasks waiting for the next frames.
+ */
+@property (nonatomic, assign, readonly) NSUInteger pendingTaskCount;
+
+/**
+ * Must be called on the main thread. The tasks start running right away,
+ * unless earlier tasks are still waiting.
+ */
+- (void)scheduleTasks:(NSArray<dispatch_block_t> *)tasks forInstance:(NSString *)instanceId;
+
+/**
+ * Drops the waiting tasks of an instance, must be called on the main thread.
+ */
+- (void)cancelTasksForInstance:(NSString *)instanceId;
+
+/**
+ * Runs the waiting tasks of all instances without a budget, must be called on the main thread.
+ */
+- (void)flushTasks;
+
+/**
+ * Runs the waiting tasks of an instance without a budget, along with the tasks of other
+ * instances scheduled before them, must be called on the main thread. Main thread work
+ * which reads the views of the instance calls it first, so that it sees them as the
+ * component thread left them.
+ */
+- (void)flushTasksForInstance:(NSString *)instanceId;
+
+@end
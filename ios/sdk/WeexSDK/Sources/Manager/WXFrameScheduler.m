@@ -0,0 +1,185 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXFrameScheduler.h"
+#import <QuartzCore/QuartzCore.h>
+#import "WXAssert.h"
+#import "WXLog.h"
+
+static NSTimeInterval const WXFrameSchedulerDefaultBudget = 0.008;
+
+@interface WXFrameTaskBatch : NSObject
+
+@property (nonatomic, copy) NSString *instanceId;
+@property (nonatomic, strong) NSArray<dispatch_block_t> *tasks;
+@property (nonatomic, assign) NSUInteger nextIndex;
+
+@end
+
+@implementation WXFrameTaskBatch
+
+@end
+
+@implementation WXFrameScheduler
+{
+    // access only on main thread
+    NSMutableArray<WXFrameTaskBatch *> *_batches;
+    CADisplayLink *_displayLink;
+}
+
++ (instancetype)sharedScheduler
+{
+    static WXFrameScheduler *scheduler;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        scheduler = [[WXFrameScheduler alloc] init];
+    });
+    return scheduler;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _batches = [NSMutableArray array];
+        _frameBudget = WXFrameSchedulerDefaultBudget;
+    }
+    return self;
+}
+
+- (NSUInteger)pendingTaskCount
+{
+    WXAssertMainThread();
+    
+    NSUInteger count = 0;
+    for (WXFrameTaskBatch *batch in _batches) {
+        count += batch.tasks.count - batch.nextIndex;
+    }
+    return count;
+}
+
+- (void)scheduleTasks:(NSArray<dispatch_block_t> *)tasks forInstance:(NSString *)instanceId
+{
+    WXAssertMainThread();
+    
+    if (tasks.count == 0) {
+        return;
+    }
+    WXFrameTaskBatch *batch = [WXFrameTaskBatch new];
+    batch.instanceId = instanceId;
+    batch.tasks = tasks;
+    [_batches addObject:batch];
+    
+    if (_batches.count == 1) {
+        // nothing is waiting, keep the latency of small batches as low as before
+        [self _runTasksWithBudget:_frameBudget];
+    }
+}
+
+- (void)cancelTasksForInstance:(NSString *)instanceId
+{
+    WXAssertMainThread();
+    
+    NSIndexSet *indexes = [_batches indexesOfObjectsPassingTest:^BOOL(WXFrameTaskBatch *batch, NSUInteger idx, BOOL *stop) {
+        return [batch.instanceId isEqualToString:instanceId];
+    }];
+    [_batches removeObjectsAtIndexes:indexes];
+    [self _updateDisplayLink];
+}
+
+- (void)flushTasks
+{
+    WXAssertMainThread();
+    
+    [self _runTasksWithBudget:DBL_MAX];
+}
+
+- (void)flushTasksForInstance:(NSString *)instanceId
+{
+    WXAssertMainThread();
+    
+    if (!instanceId) {
+        return;
+    }
+    // a task may schedule or cancel tasks, so look for the instance again after each one
+    while ([self _indexOfLastBatchForInstance:instanceId] != NSNotFound) {
+        [self _runNextTask];
+    }
+    [self _updateDisplayLink];
+}
+
+#pragma mark Private
+
+- (NSUInteger)_indexOfLastBatchForInstance:(NSString *)instanceId
+{
+    return [_batches indexOfObjectWithOptions:NSEnumerationReverse passingTest:^BOOL(WXFrameTaskBatch *batch, NSUInteger idx, BOOL *stop) {
+        return [batch.instanceId isEqualToString:instanceId];
+    }];
+}
+
+- (void)_handleDisplayLink
+{
+    [self _runTasksWithBudget:_frameBudget];
+}
+
+- (void)_runTasksWithBudget:(NSTimeInterval)budget
+{
+    CFTimeInterval start = CACurrentMediaTime();
+    CFTimeInterval now = start;
+    NSUInteger count = 0;
+    // a task may schedule or cancel tasks, so don't hold the batch across tasks
+    while (_batches.count > 0 && (count == 0 || now - start < budget)) {
+        [self _runNextTask];
+        count++;
+        now = CACurrentMediaTime();
+    }
+    
+    if (budget < DBL_MAX && now - start > budget * 2) {
+        _overrunCount++;
+        WXLogWarning(@"UI tasks took %.1fms in a frame, the budget is %.1fms, %lu tasks ran and %lu are waiting",
+                     (now - start) * 1000, budget * 1000, (unsigned long)count, (unsigned long)self.pendingTaskCount);
+    }
+    [self _updateDisplayLink];
+}
+
+- (void)_runNextTask
+{
+    WXFrameTaskBatch *batch = _batches.firstObject;
+    dispatch_block_t task = batch.tasks[batch.nextIndex++];
+    if (batch.nextIndex == batch.tasks.count) {
+        [_batches removeObjectAtIndex:0];
+    }
+    task();
+}
+
+- (void)_updateDisplayLink
+{
+    if (_batches.count > 0) {
+        if (!_displayLink) {
+            // common modes, so that the tasks keep running while scrolling
+            _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(_handleDisplayLink)];
+            [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+        }
+        _displayLink.paused = NO;
+    } else if (_displayLink) {
+        _displayLink.paused = YES;
+    }
+}
+
+@end
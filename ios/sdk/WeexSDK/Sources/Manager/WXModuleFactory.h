@@ -19,6 +19,26 @@
 
 #import <Foundation/Foundation.h>
 
+/**
+ * @abstract A module method resolved at registration time. Module ids and method ids
+ * are indexes of the dispatch table, they are stable for the lifetime of the process.
+ */
+@interface WXModuleMethodDescriptor : NSObject
+
+@property (nonatomic, strong, readonly) NSString *moduleName;
+@property (nonatomic, strong, readonly) NSString *methodName;
+@property (nonatomic, assign, readonly) NSUInteger moduleId;
+@property (nonatomic, assign, readonly) NSUInteger methodId;
+@property (nonatomic, assign, readonly) Class moduleClass;
+/**
+ * NULL for the default methods(addEventListener, removeAllEventListeners) which are handled by instance.
+ */
+@property (nonatomic, assign, readonly) SEL selector;
+@property (nonatomic, assign, readonly) BOOL isSync;
+@property (nonatomic, strong, readonly) NSMethodSignature *signature;
+
+@end
+
 @interface WXModuleFactory : NSObject
 
 /**
@@ -67,6 +87,31 @@
  * @abstract Returns the registered modules.
  */
 + (NSDictionary *) moduleConfigs;
+
+/**
+ * @abstract Returns the resolved method of specific module
+ *
+ * @param name The module name
+ *
+ * @param method The module method
+ **/
++ (WXModuleMethodDescriptor *)methodDescriptorWithModuleName:(NSString *)name methodName:(NSString *)method;
+
+/**
+ * @abstract Returns the resolved method by the ids published to js framework
+ *
+ * @param moduleId The module id
+ *
+ * @param methodId The method id
+ **/
++ (WXModuleMethodDescriptor *)methodDescriptorWithModuleId:(NSUInteger)moduleId methodId:(NSUInteger)methodId;
+
+/**
+ * @abstract Returns the dispatch ids of modules, formatted as {name: {id: moduleId, methods: {method: methodId}}}
+ *
+ * @param names The module names
+ **/
++ (NSDictionary *)moduleDispatchIdsWithNames:(NSArray *)names;
        
 @end
 
@@ -27,8 +27,54 @@
 
 /************************************************************************************************/
 
+@interface WXModuleMethodDescriptor ()
+
+- (instancetype)initWithModuleName:(NSString *)moduleName
+                        methodName:(NSString *)methodName
+                          moduleId:(NSUInteger)moduleId
+                          methodId:(NSUInteger)methodId
+                       moduleClass:(Class)moduleClass
+                          selector:(SEL)selector
+                            isSync:(BOOL)isSync;
+
+@end
+
+@implementation WXModuleMethodDescriptor
+
+- (instancetype)initWithModuleName:(NSString *)moduleName
+                        methodName:(NSString *)methodName
+                          moduleId:(NSUInteger)moduleId
+                          methodId:(NSUInteger)methodId
+                       moduleClass:(Class)moduleClass
+                          selector:(SEL)selector
+                            isSync:(BOOL)isSync
+{
+    if (self = [super init]) {
+        _moduleName = moduleName;
+        _methodName = methodName;
+        _moduleId = moduleId;
+        _methodId = methodId;
+        _moduleClass = moduleClass;
+        _selector = selector;
+        _isSync = isSync;
+        if (selector && [moduleClass instancesRespondToSelector:selector]) {
+            _signature = [moduleClass instanceMethodSignatureForSelector:selector];
+        }
+    }
+    return self;
+}
+
+@end
+
 @interface WXModuleConfig : WXInvocationConfig
 
+@property (nonatomic, assign) NSUInteger moduleId;
+/**
+ * The method table, indexed by method id.
+ */
+@property (nonatomic, strong) NSArray<WXModuleMethodDescriptor *> *methodDescriptors;
+@property (nonatomic, strong) NSDictionary<NSString *, WXModuleMethodDescriptor *> *methodDescriptorMap;
+
 @end
 
 @implementation WXModuleConfig
@@ -38,6 +84,10 @@
 @interface WXModuleFactory ()
 
 @property (nonatomic, strong)  NSMutableDictionary  *moduleMap;
+/**
+ * The module table, indexed by module id.
+ */
+@property (nonatomic, strong)  NSMutableArray  *moduleTable;
 @property (nonatomic, strong)  NSLock   *moduleLock;
 
 @end
@@ -73,6 +123,7 @@ static WXModuleFactory *_sharedInstance = nil;
         self = [super init];
         if (self) {
             _moduleMap = [NSMutableDictionary dictionary];
+            _moduleTable = [NSMutableArray array];
             _moduleLock = [[NSLock alloc] init];
         }
     }
@@ -127,12 +178,102 @@ static WXModuleFactory *_sharedInstance = nil;
     config.name = name;
     config.clazz = NSStringFromClass(clazz);
     [config registerMethods];
+    // keep the id of a re-registered module, js framework may have cached it.
+    WXModuleConfig *oldConfig = [_moduleMap objectForKey:name];
+    config.moduleId = oldConfig ? oldConfig.moduleId : _moduleTable.count;
+    [self _resolveMethodsForConfig:config moduleClass:clazz];
+    if (config.moduleId < _moduleTable.count) {
+        _moduleTable[config.moduleId] = config;
+    } else {
+        [_moduleTable addObject:config];
+    }
     [_moduleMap setValue:config forKey:name];
     [_moduleLock unlock];
     
     return name;
 }
 
+- (void)_resolveMethodsForConfig:(WXModuleConfig *)config moduleClass:(Class)clazz
+{
+    NSMutableArray *descriptors = [NSMutableArray array];
+    NSMutableDictionary *descriptorMap = [NSMutableDictionary dictionary];
+    
+    void (^addDescriptor)(NSString *, NSString *, BOOL) = ^(NSString *method, NSString *selectorString, BOOL isSync) {
+        WXModuleMethodDescriptor *descriptor = [[WXModuleMethodDescriptor alloc] initWithModuleName:config.name
+                                                                                         methodName:method
+                                                                                           moduleId:config.moduleId
+                                                                                           methodId:descriptors.count
+                                                                                        moduleClass:clazz
+                                                                                           selector:selectorString ? NSSelectorFromString(selectorString) : NULL
+                                                                                             isSync:isSync];
+        [descriptors addObject:descriptor];
+        descriptorMap[method] = descriptor;
+    };
+    
+    // exported methods take precedence over the default ones with the same name.
+    for (NSString *method in [self _defaultModuleMethod]) {
+        addDescriptor(method, nil, NO);
+    }
+    [config.asyncMethods enumerateKeysAndObjectsUsingBlock:^(NSString *method, NSString *selectorString, BOOL *stop) {
+        addDescriptor(method, selectorString, NO);
+    }];
+    [config.syncMethods enumerateKeysAndObjectsUsingBlock:^(NSString *method, NSString *selectorString, BOOL *stop) {
+        addDescriptor(method, selectorString, YES);
+    }];
+    
+    config.methodDescriptors = descriptors;
+    config.methodDescriptorMap = descriptorMap;
+}
+
+- (WXModuleMethodDescriptor *)_methodDescriptorWithModuleName:(NSString *)name methodName:(NSString *)method
+{
+    WXModuleMethodDescriptor *descriptor = nil;
+    
+    [_moduleLock lock];
+    WXModuleConfig *config = [_moduleMap objectForKey:name];
+    descriptor = [config.methodDescriptorMap objectForKey:method];
+    [_moduleLock unlock];
+    
+    return descriptor;
+}
+
+- (WXModuleMethodDescriptor *)_methodDescriptorWithModuleId:(NSUInteger)moduleId methodId:(NSUInteger)methodId
+{
+    WXModuleMethodDescriptor *descriptor = nil;
+    
+    [_moduleLock lock];
+    if (moduleId < _moduleTable.count) {
+        WXModuleConfig *config = _moduleTable[moduleId];
+        if (methodId < config.methodDescriptors.count) {
+            descriptor = config.methodDescriptors[methodId];
+        }
+    }
+    [_moduleLock unlock];
+    
+    return descriptor;
+}
+
+- (NSDictionary *)_moduleDispatchIdsWithNames:(NSArray *)names
+{
+    NSMutableDictionary *dispatchIds = [NSMutableDictionary dictionary];
+    
+    [_moduleLock lock];
+    for (NSString *name in names) {
+        WXModuleConfig *config = _moduleMap[name];
+        if (!config) {
+            continue;
+        }
+        NSMutableDictionary *methodIds = [NSMutableDictionary dictionary];
+        [config.methodDescriptorMap enumerateKeysAndObjectsUsingBlock:^(NSString *method, WXModuleMethodDescriptor *descriptor, BOOL *stop) {
+            methodIds[method] = @(descriptor.methodId);
+        }];
+        dispatchIds[name] = @{@"id": @(config.moduleId), @"methods": methodIds};
+    }
+    [_moduleLock unlock];
+    
+    return dispatchIds;
+}
+
 - (NSMutableDictionary *)_moduleMethodMapsWithName:(NSString *)name
 {
     NSMutableDictionary *dict = [NSMutableDictionary dictionary];
@@ -220,4 +361,19 @@ static WXModuleFactory *_sharedInstance = nil;
     return [[self _sharedInstance] _moduleSelctorMapsWithName:name];
 }
 
++ (WXModuleMethodDescriptor *)methodDescriptorWithModuleName:(NSString *)name methodName:(NSString *)method
+{
+    return [[self _sharedInstance] _methodDescriptorWithModuleName:name methodName:method];
+}
+
++ (WXModuleMethodDescriptor *)methodDescriptorWithModuleId:(NSUInteger)moduleId methodId:(NSUInteger)methodId
+{
+    return [[self _sharedInstance] _methodDescriptorWithModuleId:moduleId methodId:methodId];
+}
+
++ (NSDictionary *)moduleDispatchIdsWithNames:(NSArray *)names
+{
+    return [[self _sharedInstance] _moduleDispatchIdsWithNames:names];
+}
+
 @end
@@ -22,6 +22,7 @@
 #import "WXSDKManager.h"
 #import "WXSDKError.h"
 #import "WXMonitor.h"
+#import "WXBundleStream.h"
 #import "WXAppMonitorProtocol.h"
 #import "WXNetworkProtocol.h"
 #import "WXModuleFactory.h"
@@ -259,8 +260,26 @@ typedef enum : NSUInteger {
     WX_MONITOR_INSTANCE_PERF_START(WXPTJSDownload, self);
     __weak typeof(self) weakSelf = self;
     _mainBundleLoader = [[WXResourceLoader alloc] initWithRequest:request];;
+    // the bundle is decoded, hashed and cached while it's downloaded
+    __block WXBundleStream *bundleStream = nil;
+    _mainBundleLoader.onResponseReceived = ^(const WXResourceResponse *response) {
+        [bundleStream cancel];
+        bundleStream = nil;
+        // local bundles are read at once and need no copy on disk
+        NSString *scheme = ((NSURLResponse *)response).URL.scheme.lowercaseString;
+        if (![scheme isEqualToString:@"http"] && ![scheme isEqualToString:@"https"]) {
+            return;
+        }
+        long long expectedLength = ((NSURLResponse *)response).expectedContentLength;
+        bundleStream = [[WXBundleStream alloc] initWithCacheDirectory:[WXBundleStream defaultCacheDirectory] expectedLength:expectedLength > 0 ? (NSUInteger)expectedLength : 0];
+    };
+    _mainBundleLoader.onDataReceived = ^(NSData *data) {
+        [bundleStream appendData:data];
+    };
     _mainBundleLoader.onFinished = ^(WXResourceResponse *response, NSData *data) {
         __strong typeof(weakSelf) strongSelf = weakSelf;
+        WXBundleStream *stream = bundleStream;
+        bundleStream = nil;
         NSError *error = nil;
         if ([response isKindOfClass:[NSHTTPURLResponse class]] && ((NSHTTPURLResponse *)response).statusCode != 200) {
             error = [NSError errorWithDomain:WX_ERROR_DOMAIN
@@ -276,6 +295,7 @@ typedef enum : NSUInteger {
         }
         
         if (error) {
+            [stream cancel];
             WXJSExceptionInfo * jsExceptionInfo = [[WXJSExceptionInfo alloc] initWithInstanceId:@"" bundleUrl:[request.URL absoluteString] errorCode:[NSString stringWithFormat:@"%d", WX_KEY_EXCEPTION_JS_DOWNLOAD] functionName:@"_renderWithRequest:options:data:" exception:[error localizedDescription]  userInfo:nil];
             [WXExceptionUtils commitCriticalExceptionRT:jsExceptionInfo];
             return;
@@ -294,7 +314,14 @@ typedef enum : NSUInteger {
             return;
         }
         
-        NSString *jsBundleString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+        // the stream only saw all the data if the handler reported every chunk
+        NSString *jsBundleString = stream.length == data.length ? [stream finish] : nil;
+        NSString *jsBundleMd5 = stream.md5;
+        if (!jsBundleString) {
+            [stream cancel];
+            jsBundleString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+            jsBundleMd5 = nil;
+        }
         if (!jsBundleString) {
             WX_MONITOR_FAIL_ON_PAGE(WXMTJSDownload, WX_ERR_JSBUNDLE_STRING_CONVERT, @"data converting to string failed.", strongSelf.pageName)
             return;
@@ -303,7 +330,10 @@ typedef enum : NSUInteger {
             strongSelf.userInfo = [NSMutableDictionary new];
         }
         strongSelf.userInfo[@"jsMainBundleStringContentLength"] = @([jsBundleString length]);
-        strongSelf.userInfo[@"jsMainBundleStringContentMd5"] = [WXUtility md5:jsBundleString];
+        strongSelf.userInfo[@"jsMainBundleStringContentMd5"] = jsBundleMd5 ?: [WXUtility md5:jsBundleString];
+        if (stream.cachePath) {
+            strongSelf.userInfo[@"jsMainBundleCachePath"] = stream.cachePath;
+        }
 
         WX_MONITOR_SUCCESS_ON_PAGE(WXMTJSDownload, strongSelf.pageName);
         WX_MONITOR_INSTANCE_PERF_END(WXPTJSDownload, strongSelf);
@@ -313,6 +343,8 @@ typedef enum : NSUInteger {
     };
     
     _mainBundleLoader.onFailed = ^(NSError *loadError) {
+        [bundleStream cancel];
+        bundleStream = nil;
         NSString *errorMessage = [NSString stringWithFormat:@"Request to %@ occurs an error:%@", request.URL, loadError.localizedDescription];
         
         WX_MONITOR_FAIL_ON_PAGE(WXMTJSDownload, [loadError.domain isEqualToString:NSURLErrorDomain] && loadError.code == NSURLErrorNotConnectedToInternet ? WX_ERR_NOT_CONNECTED_TO_INTERNET : WX_ERR_JSBUNDLE_DOWNLOAD, errorMessage, weakSelf.pageName);
@@ -353,7 +385,8 @@ typedef enum : NSUInteger {
 - (void)destroyInstance
 {
     NSString *url = @"";
-    if([WXPrerenderManager isTaskExist:[self.scriptURL absoluteString]]) {
+    // a prerendered instance is destroyed when the pool evicts it, don't prerender it again
+    if(!self.needPrerender && [WXPrerenderManager isTaskExist:[self.scriptURL absoluteString]]) {
         url = [self.scriptURL absoluteString];
     }
     if (!self.instanceId) {
@@ -366,7 +399,9 @@ typedef enum : NSUInteger {
     [WXTracingManager destroyTraincgTaskWithInstance:self.instanceId];
 
     
-    [WXPrerenderManager removePrerenderTaskforUrl:[self.scriptURL absoluteString]];
+    if (!self.needPrerender) {
+        [WXPrerenderManager removePrerenderTaskforUrl:[self.scriptURL absoluteString]];
+    }
     [WXPrerenderManager destroyTask:self.instanceId];
     
     [[WXSDKManager bridgeMgr] destroyInstance:self.instanceId];
@@ -160,9 +160,9 @@ WX_EXPORT_METHOD(@selector(transition:args:callback:))
             }
             return;
         }
-        WXPerformBlockOnMainThread(^{
+        [self.weexInstance.componentManager performBlockOnMainThreadAfterUITasks:^{
             [self animation:targetComponent args:args callback:callback];
-        });
+        }];
     });
 }
 
@@ -184,7 +184,7 @@ WX_EXPORT_METHOD(@selector(getComponentRect:callback:))
     [self performBlockOnComponentManager:^(WXComponentManager * manager) {
         UIView *rootView = manager.weexInstance.rootView;
         if ([ref isEqualToString:@"viewport"]) {
-            dispatch_async(dispatch_get_main_queue(), ^{
+            [manager performBlockOnMainThreadAfterUITasks:^{
                 NSMutableDictionary * callbackRsp = nil;
                 CGRect rootRect = [rootView.superview convertRect:rootView.frame toView:rootView];
                 callbackRsp = [self _componentRectInfoWithViewFrame:rootRect];
@@ -192,11 +192,11 @@ WX_EXPORT_METHOD(@selector(getComponentRect:callback:))
                 if (callback) {
                     callback(callbackRsp, false);
                 }
-            });
+            }];
         } else {
             WXComponent *component = [manager componentForRef:ref];
             __weak typeof (self) weakSelf = self;
-            dispatch_async(dispatch_get_main_queue(), ^{
+            [manager performBlockOnMainThreadAfterUITasks:^{
                 __strong typeof (weakSelf) strongSelf = weakSelf;
                 NSMutableDictionary * callbackRsp = nil;
                 if (!component) {
@@ -217,7 +217,7 @@ WX_EXPORT_METHOD(@selector(getComponentRect:callback:))
                 if (callback) {
                     callback(callbackRsp, false);
                 }
-            });
+            }];
 
         }
     }];
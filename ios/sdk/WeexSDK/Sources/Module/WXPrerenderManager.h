@@ -107,4 +107,21 @@
  *
  **/
 + (void)destroyTask:(NSString *)parentInstanceId;
+
+/**
+ *  @abstract set the budget of the prerender pool, the least recently used tasks are evicted when it is exceeded.
+ *  @discussion the config center values iOS_weex_prerender_config.max_cache_num and max_cache_bytes override it.
+ *
+ *  @param number  the max count of prerendered instances, 5 by default
+ *
+ *  @param bytes  the max estimated memory of prerendered instances, 30MB by default
+ *
+ **/
++ (void)setMaxCacheNumber:(NSUInteger)number maxCacheBytes:(NSUInteger)bytes;
+
+/**
+ *  @abstract Returns the metrics of the prerender pool: hits, misses, hitRate, evictions, count and bytes.
+ *
+ **/
++ (NSDictionary *)metrics;
 @end
@@ -26,10 +26,16 @@
 #import "WXSDKEngine.h"
 #import "WXUtility.h"
 #import "WXTracingManager.h"
+#import <pthread/pthread.h>
 
 static NSString *const MSG_PRERENDER_INTERNAL_ERROR = @"internal_error";
 static NSString *const MSG_PRERENDER_SUCCESS = @"success";
 
+static const NSUInteger WXPrerenderDefaultMaxCacheNumber = 5;
+static const NSUInteger WXPrerenderDefaultMaxCacheBytes = 30 * 1024 * 1024;
+// a component with its view, layer and css node, without the bitmaps it draws
+static const NSUInteger WXPrerenderComponentCost = 2 * 1024;
+
 @interface WXPrerenderTask:NSObject
 
 @property (nonatomic, strong) WXSDKInstance *instance;
@@ -42,6 +48,8 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
 @property (nonatomic, strong) NSDate *beginDate;
 @property (nonatomic) long long cacheTime;
 @property (nonatomic) BOOL isCache;  // if set cache , the cachetime is no use.
+@property (nonatomic) NSUInteger cost;  // estimated bytes, known when the render finishes
+@property (nonatomic) BOOL isRendered;  // shown by a page, it is no longer in the pool
 
 @end
 @implementation WXPrerenderTask
@@ -49,11 +57,21 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
 
 
 @interface WXPrerenderManager()
+{
+    // guards the tasks, their order and the metrics
+    pthread_mutex_t _mutex;
+}
 
-@property (nonatomic, strong) NSMutableArray *cachedUrlList;
+@property (nonatomic, strong) NSMutableArray *cachedUrlList;    // keys of the pooled tasks, from the least recently used
 @property (nonatomic, strong) dispatch_queue_t queue;
 @property (nonatomic, strong) NSMutableDictionary<NSString *, WXPrerenderTask*> *prerenderTasks;
 @property (nonatomic) NSInteger maxCacheNumber;
+@property (nonatomic) NSUInteger maxCacheBytes;
+@property (nonatomic) NSUInteger defaultMaxCacheNumber;
+@property (nonatomic) NSUInteger defaultMaxCacheBytes;
+@property (nonatomic) NSUInteger hits;
+@property (nonatomic) NSUInteger misses;
+@property (nonatomic) NSUInteger evictions;
 
 @end
 
@@ -77,6 +95,16 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
         self.cachedUrlList = [[NSMutableArray alloc] init];
         self.queue = dispatch_queue_create("Prerender", DISPATCH_QUEUE_SERIAL);
         self.prerenderTasks = [[NSMutableDictionary alloc] init];
+        self.defaultMaxCacheNumber = WXPrerenderDefaultMaxCacheNumber;
+        self.defaultMaxCacheBytes = WXPrerenderDefaultMaxCacheBytes;
+        self.maxCacheNumber = self.defaultMaxCacheNumber;
+        self.maxCacheBytes = self.defaultMaxCacheBytes;
+        pthread_mutex_init(&_mutex, NULL);
+        
+        __weak typeof(self) weakSelf = self;
+        [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification object:nil queue:nil usingBlock:^(NSNotification *note) {
+            [weakSelf trimToCount:0 bytes:0];
+        }];
     }
     
     return self;
@@ -85,8 +113,144 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
 - (void) dealloc{
     self.cachedUrlList = nil;
     self.prerenderTasks = nil;
+    pthread_mutex_destroy(&_mutex);
+}
+
+#pragma mark - Pool
+
+- (WXPrerenderTask *)taskForUrl:(NSString *)url
+{
+    pthread_mutex_lock(&_mutex);
+    WXPrerenderTask *task = [self.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
+    pthread_mutex_unlock(&_mutex);
+    return task;
+}
+
+// moves the task to the most recently used end
+- (void)touchTaskLocked:(WXPrerenderTask *)task key:(NSString *)key
+{
+    if (task.isRendered) {
+        return;
+    }
+    [self.cachedUrlList removeObject:key];
+    [self.cachedUrlList addObject:key];
+}
+
+- (void)removeTaskLocked:(NSString *)key
+{
+    [self.prerenderTasks removeObjectForKey:key];
+    [self.cachedUrlList removeObject:key];
+}
+
+/**
+ *  Evicts the least recently used tasks of the pool until it fits the budget, and destroys
+ *  their instances. The tasks shown by pages are not in the pool, and are never evicted.
+ */
+- (void)trimToCount:(NSUInteger)count bytes:(NSUInteger)bytes
+{
+    NSMutableArray<WXPrerenderTask *> *evicted = [NSMutableArray array];
+    
+    pthread_mutex_lock(&_mutex);
+    NSUInteger totalBytes = 0;
+    for (NSString *key in self.cachedUrlList) {
+        totalBytes += self.prerenderTasks[key].cost;
+    }
+    while ((self.cachedUrlList.count > count || totalBytes > bytes) && self.cachedUrlList.count > 0) {
+        NSString *key = self.cachedUrlList.firstObject;
+        WXPrerenderTask *task = self.prerenderTasks[key];
+        totalBytes -= task.cost;
+        [self removeTaskLocked:key];
+        [evicted addObject:task];
+    }
+    self.evictions += evicted.count;
+    pthread_mutex_unlock(&_mutex);
+    
+    // the instances are not shown, so destroying them doesn't prerender them again
+    [WXPrerenderManager destroyInstancesOfTasks:evicted];
 }
 
++ (void)destroyInstancesOfTasks:(NSArray<WXPrerenderTask *> *)tasks
+{
+    if (tasks.count == 0) {
+        return;
+    }
+    WXPerformBlockOnMainThread(^{
+        for (WXPrerenderTask *task in tasks) {
+            [task.instance destroyInstance];
+        }
+    });
+}
+
+- (void)updateCostOfTask:(WXPrerenderTask *)task
+{
+    WXSDKInstance *instance = task.instance;
+    __weak typeof(self) weakSelf = self;
+    WXPerformBlockOnComponentThread(^{
+        NSUInteger components = [instance numberOfComponents];
+        WXPerformBlockOnMainThread(^{
+            __strong typeof(self) strongSelf = weakSelf;
+            if (!strongSelf) {
+                return;
+            }
+            NSUInteger cost = components * WXPrerenderComponentCost + [WXPrerenderManager bitmapBytesOfLayer:task.view.layer];
+            pthread_mutex_lock(&strongSelf->_mutex);
+            task.cost = cost;
+            pthread_mutex_unlock(&strongSelf->_mutex);
+            // a task larger than the whole budget is not kept either
+            [strongSelf trimToCount:strongSelf.maxCacheNumber bytes:strongSelf.maxCacheBytes];
+        });
+    });
+}
+
++ (NSUInteger)bitmapBytesOfLayer:(CALayer *)layer
+{
+    if (!layer) {
+        return 0;
+    }
+    NSUInteger bytes = 0;
+    id contents = layer.contents;
+    if (contents && CFGetTypeID((__bridge CFTypeRef)contents) == CGImageGetTypeID()) {
+        CGImageRef image = (__bridge CGImageRef)contents;
+        bytes += CGImageGetBytesPerRow(image) * CGImageGetHeight(image);
+    }
+    for (CALayer *sublayer in layer.sublayers) {
+        bytes += [self bitmapBytesOfLayer:sublayer];
+    }
+    return bytes;
+}
+
++ (void)setMaxCacheNumber:(NSUInteger)number maxCacheBytes:(NSUInteger)bytes
+{
+    WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
+    manager.defaultMaxCacheNumber = number;
+    manager.defaultMaxCacheBytes = bytes;
+    manager.maxCacheNumber = number;
+    manager.maxCacheBytes = bytes;
+    [manager trimToCount:number bytes:bytes];
+}
+
++ (NSDictionary *)metrics
+{
+    WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
+    pthread_mutex_t *mutex = &manager->_mutex;
+    pthread_mutex_lock(mutex);
+    NSUInteger bytes = 0;
+    for (NSString *key in manager.cachedUrlList) {
+        bytes += manager.prerenderTasks[key].cost;
+    }
+    NSUInteger lookups = manager.hits + manager.misses;
+    NSDictionary *metrics = @{@"hits": @(manager.hits),
+                              @"misses": @(manager.misses),
+                              @"hitRate": @(lookups ? (double)manager.hits / lookups : 0),
+                              @"evictions": @(manager.evictions),
+                              @"count": @(manager.cachedUrlList.count),
+                              @"bytes": @(bytes)};
+    pthread_mutex_unlock(mutex);
+    return metrics;
+}
+
+#pragma mark - Task
+
 + (void) addTask:(NSString *)url instanceId:(NSString *)instanceId callback:(WXModuleCallback)callback{
     NSURL *newUrl = [NSURL URLWithString:url];
     if(!newUrl){
@@ -161,56 +325,109 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
             task.cacheTime = time;
         }
     }
-    self.maxCacheNumber = 5;
+    self.maxCacheNumber = self.defaultMaxCacheNumber;
+    self.maxCacheBytes = self.defaultMaxCacheBytes;
     if ([configCenter respondsToSelector:@selector(configForKey:defaultValue:isDefault:)]) {
-        NSInteger max = [[configCenter configForKey:@"iOS_weex_prerender_config.max_cache_num" defaultValue:@5 isDefault:NULL] integerValue];
+        NSInteger max = [[configCenter configForKey:@"iOS_weex_prerender_config.max_cache_num" defaultValue:@(self.defaultMaxCacheNumber) isDefault:NULL] integerValue];
         if(max){
             self.maxCacheNumber = max;
         }
+        long long maxBytes = [[configCenter configForKey:@"iOS_weex_prerender_config.max_cache_bytes" defaultValue:@(self.defaultMaxCacheBytes) isDefault:NULL] longLongValue];
+        if(maxBytes > 0){
+            self.maxCacheBytes = (NSUInteger)maxBytes;
+        }
     }
-    if(self.prerenderTasks && self.prerenderTasks.count<self.maxCacheNumber){
-        [self.prerenderTasks setObject:task forKey:[WXPrerenderManager getTaskKeyFromUrl:url.absoluteString]];
-        WXPerformBlockOnMainThread(^{
-            WXSDKInstance *instance = [[WXSDKInstance alloc] init];
-            instance.needPrerender = YES;
+    if(self.maxCacheNumber <= 0){
+        return;
+    }
+    
+    // the least recently used tasks make room for the new one
+    NSString *key = [WXPrerenderManager getTaskKeyFromUrl:url.absoluteString];
+    pthread_mutex_lock(&_mutex);
+    WXPrerenderTask *oldTask = self.prerenderTasks[key];
+    if (oldTask && !oldTask.isRendered) {
+        [self removeTaskLocked:key];
+    } else {
+        oldTask = nil;
+    }
+    pthread_mutex_unlock(&_mutex);
+    if (oldTask) {
+        [WXPrerenderManager destroyInstancesOfTasks:@[oldTask]];
+    }
+    [self trimToCount:self.maxCacheNumber - 1 bytes:self.maxCacheBytes];
+    
+    pthread_mutex_lock(&_mutex);
+    [self.prerenderTasks setObject:task forKey:key];
+    [self touchTaskLocked:task key:key];
+    pthread_mutex_unlock(&_mutex);
+    
+    WXPerformBlockOnMainThread(^{
+        // the task may be evicted before it gets here, its instance is set in the same critical
+        // section as the check so an eviction afterwards destroys it
+        WXSDKInstance *instance = [[WXSDKInstance alloc] init];
+        pthread_mutex_lock(&self->_mutex);
+        BOOL pooled = self.prerenderTasks[key] == task;
+        if (pooled) {
             task.instance = instance;
-            task.parentInstanceId = instanceId;
-            task.url = url.absoluteString;
-            task.isCache = isCache;
-            WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
-            __weak typeof(self) weakSelf = manager;
-            instance.onCreate = ^(UIView *view) {
-                WXPrerenderTask *task = [weakSelf.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url.absoluteString]];
-                task.view = view;
-                if(task){
-                    [weakSelf.prerenderTasks setObject:task forKey:[WXPrerenderManager getTaskKeyFromUrl:url.absoluteString]];
-                }
-            };
-            
-            instance.onFailed = ^(NSError *error) {
-                WXPrerenderTask *task  = [weakSelf.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url.absoluteString]];
-                task.error = error;
-                if(task){
-                    [weakSelf.prerenderTasks setObject:task forKey:[WXPrerenderManager getTaskKeyFromUrl:url.absoluteString]];
-                }
-            };
-            [instance renderWithURL:url options:@{@"bundleUrl":url.absoluteString} data:nil];
-        });
-        if(callback){
-            callback(@{@"url":url.absoluteString,@"message":MSG_PRERENDER_SUCCESS,@"result":@"success"});
         }
+        pthread_mutex_unlock(&self->_mutex);
+        if (!pooled) {
+            return;
+        }
+        instance.needPrerender = YES;
+        task.parentInstanceId = instanceId;
+        task.url = url.absoluteString;
+        task.isCache = isCache;
+        WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
+        __weak typeof(self) weakSelf = manager;
+        __weak WXPrerenderTask *weakTask = task;
+        instance.onCreate = ^(UIView *view) {
+            WXPrerenderTask *task = [weakSelf taskForUrl:url.absoluteString];
+            task.view = view;
+        };
+        
+        instance.onFailed = ^(NSError *error) {
+            WXPrerenderTask *task  = [weakSelf taskForUrl:url.absoluteString];
+            task.error = error;
+        };
+        
+        instance.renderFinish = ^(UIView *view) {
+            WXPrerenderTask *task = weakTask;
+            if (task && !task.isRendered) {
+                [weakSelf updateCostOfTask:task];
+            }
+        };
+        [instance renderWithURL:url options:@{@"bundleUrl":url.absoluteString} data:nil];
+    });
+    if(callback){
+        callback(@{@"url":url.absoluteString,@"message":MSG_PRERENDER_SUCCESS,@"result":@"success"});
     }
 }
 
 + (BOOL)isTaskReady:(NSString *)url{
-    return [[WXPrerenderManager sharedInstance]isTaskReady:url];
+    WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
+    BOOL ready = [manager isTaskReady:url];
+    pthread_mutex_lock(&manager->_mutex);
+    if (ready) {
+        manager.hits++;
+        // a hit makes the task the most recently used
+        NSString *key = [WXPrerenderManager getTaskKeyFromUrl:url];
+        WXPrerenderTask *task = manager.prerenderTasks[key];
+        if (task) {
+            [manager touchTaskLocked:task key:key];
+        }
+    } else {
+        manager.misses++;
+    }
+    pthread_mutex_unlock(&manager->_mutex);
+    return ready;
 }
 - (BOOL)isTaskReady:(NSString *)url
 {
     if( !url ||url.length == 0){
         return NO;
     }
-    WXPrerenderTask *task  = [self.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
+    WXPrerenderTask *task  = [self taskForUrl:url];
     if(!task ){
         return NO;
     }
@@ -232,7 +449,6 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
     }
     return NO;
 }
-
 + (BOOL)isTaskExist:(NSString *)url{
     if( !url ||url.length == 0){
         return NO;
@@ -273,7 +489,7 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
     if( !url ||url.length == 0){
         return NO;
     }
-    WXPrerenderTask *task  = [self.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
+    WXPrerenderTask *task  = [self taskForUrl:url];
     if(task ){
         return YES;
     }
@@ -285,10 +501,16 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
     WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
     if([manager isTaskReady:url])
     {
-        WXPrerenderTask *task  = [manager.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
+        WXPrerenderTask *task  = [manager taskForUrl:url];
+        
+        // the page owns the task now, it leaves the pool
+        pthread_mutex_lock(&manager->_mutex);
+        task.isRendered = YES;
+        [manager.cachedUrlList removeObject:[WXPrerenderManager getTaskKeyFromUrl:url]];
+        pthread_mutex_unlock(&manager->_mutex);
         
-        UIView *view = [self viewFromUrl:url];
-        NSError *error = [self errorFromUrl:url];
+        UIView *view = task.view;
+        NSError *error = task.error;
         if(task.instance.onCreate){
             task.instance.onCreate(view);
         }
@@ -308,60 +530,50 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
 
 + (UIView *)viewFromUrl:(NSString *)url
 {
-    WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
-    WXPrerenderTask *task  = [manager.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
-    return task.view;
+    return [[WXPrerenderManager sharedInstance] taskForUrl:url].view;
 }
 
 + (NSError *)errorFromUrl:(NSString *)url
 {
-    WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
-    WXPrerenderTask *task  = [manager.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
-    return task.error;
+    return [[WXPrerenderManager sharedInstance] taskForUrl:url].error;
 }
 
 + (id )instanceFromUrl:(NSString *)url
 {
-    WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
-    WXPrerenderTask *task  = [manager.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
-    return task.instance;
+    return [[WXPrerenderManager sharedInstance] taskForUrl:url].instance;
 }
 
 + (void)removePrerenderTaskforUrl:(NSString *)url
 {
     if (url.length > 0) {
         WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
-        if(manager.prerenderTasks && [manager.prerenderTasks count]>0){
-            WXPrerenderTask *task  = [manager.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
-            if(task){
-                [manager.prerenderTasks removeObjectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
-            }
-        }
+        pthread_mutex_lock(&manager->_mutex);
+        [manager removeTaskLocked:[WXPrerenderManager getTaskKeyFromUrl:url]];
+        pthread_mutex_unlock(&manager->_mutex);
     }
 }
 
 + (void)storePrerenderModuleTasks:(WXModuleMethod *)method forUrl:(NSString *)url
 {
     WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
+    pthread_mutex_lock(&manager->_mutex);
     WXPrerenderTask *task = [manager.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
-    if (!task.moduleTasks){
+    if (task && !task.moduleTasks){
         task.moduleTasks = [NSMutableArray new];
     }
     [task.moduleTasks addObject:method];
-    if(task){
-        [manager.prerenderTasks setObject:task forKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
-    }
+    pthread_mutex_unlock(&manager->_mutex);
 }
 
 + (void)excuteModuleTasksForUrl:(NSString *)url
 {
     WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
-    WXPrerenderTask *task = [manager.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]];
+    pthread_mutex_lock(&manager->_mutex);
+    NSArray *moduleTasks = [[manager.prerenderTasks objectForKey:[WXPrerenderManager getTaskKeyFromUrl:url]].moduleTasks copy];
+    pthread_mutex_unlock(&manager->_mutex);
     
-    if (task.moduleTasks && [task.moduleTasks count]>0){
-        for (WXModuleMethod *method in task.moduleTasks) {
-            [method invoke];
-        }
+    for (WXModuleMethod *method in moduleTasks) {
+        [method invoke];
     }
 }
 
@@ -379,24 +591,19 @@ static NSString *const MSG_PRERENDER_SUCCESS = @"success";
 + (void)destroyTask:(NSString *)parentInstanceId
 {
     WXPrerenderManager *manager = [WXPrerenderManager sharedInstance];
-    if(!manager.prerenderTasks || [manager.prerenderTasks count] == 0){
-        return;
-    }
+    NSMutableArray<WXPrerenderTask *> *tasks = [NSMutableArray array];
     
-    [manager.prerenderTasks enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+    pthread_mutex_lock(&manager->_mutex);
+    for (NSString *key in [manager.prerenderTasks allKeys]) {
         WXPrerenderTask *task = manager.prerenderTasks[key];
         if ([task.parentInstanceId isEqualToString:parentInstanceId]) {
-            [manager removeTask:task];
+            [manager removeTaskLocked:key];
+            [tasks addObject:task];
         }
-    }];
-}
-
-- (void)removeTask:(WXPrerenderTask *)task
-{
-    [task.instance destroyInstance];
-    if(self.prerenderTasks && [self.prerenderTasks count] > 0 && task.url.length > 0){
-        [self.prerenderTasks removeObjectForKey:[WXPrerenderManager getTaskKeyFromUrl:task.url]];
     }
+    pthread_mutex_unlock(&manager->_mutex);
+    
+    [self destroyInstancesOfTasks:tasks];
 }
 
 @end
@@ -0,0 +1,404 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ * 
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#import "WXStorageModule.h"
+#import "WXSDKManager.h"
+#import "WXUtility.h"
+#import "WXLog.h"
+#import "WXStorageEngine.h"
+
+static NSString * const WXStorageDirectory            = @"wxstorage";
+static NSString * const WXStorageLogFileName          = @"wxstorage.log";
+static NSUInteger const WXStorageLineLimit            = 1024;
+static NSUInteger const WXStorageTotalLimit           = 5 * 1024 * 1024;
+static NSString * const WXStorageThreadName           = @"com.taobao.weex.storage";
+static NSTimeInterval const WXStorageSyncDelay        = 1;
+static NSUInteger const WXStoragePendingLimit         = 256 * 1024;
+
+// the files of the plist based storage, they are migrated into the log
+static NSString * const WXStorageFileName             = @"wxstorage.plist";
+static NSString * const WXStorageInfoFileName         = @"wxstorage.info.plist";
+static NSString * const WXStorageIndexFileName        = @"wxstorage.index.plist";
+static NSString * const WXStorageNullValue            = @"#{eulaVlluNegarotSXW}";
+
+static std::string WXStorageBytes(NSString *string)
+{
+    return std::string(string.UTF8String ?: "", [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding]);
+}
+
+@implementation WXStorageModule
+
+@synthesize weexInstance;
+
+WX_EXPORT_METHOD(@selector(length:))
+WX_EXPORT_METHOD(@selector(getItem:callback:))
+WX_EXPORT_METHOD(@selector(setItem:value:callback:))
+WX_EXPORT_METHOD(@selector(setItemPersistent:value:callback:))
+WX_EXPORT_METHOD(@selector(getAllKeys:))
+WX_EXPORT_METHOD(@selector(removeItem:callback:))
+
+#pragma mark - Export
+
+- (dispatch_queue_t)targetExecuteQueue {
+    return [WXStorageModule storageQueue];
+}
+
+- (void)length:(WXModuleCallback)callback
+{
+    if (callback) {
+        callback(@{@"result":@"success",@"data":@([WXStorageModule engine]->count())});
+    }
+}
+
+- (void)getAllKeys:(WXModuleCallback)callback
+{
+    if (callback) {
+        callback(@{@"result":@"success",@"data":[self indexs]});
+    }
+}
+
+- (void)getItem:(NSString *)key callback:(WXModuleCallback)callback
+{
+    if ([self checkInput:key]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"key must a string or number!"}); // forgive my english
+        }
+        return;
+    }
+    
+    if ([key isKindOfClass:[NSNumber class]]) {
+        key = [((NSNumber *)key) stringValue]; // oh no!
+    }
+    
+    if ([WXUtility isBlankString:key]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"invalid_param"});
+        }
+        return ;
+    }
+    
+    NSString *value = [self storedValueForKey:key];
+    if (!value) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"undefined"});
+        }
+        return;
+    }
+    [WXStorageModule engine]->touch(WXStorageBytes(key), [[NSDate date] timeIntervalSince1970]);
+    [self scheduleSync];
+    if (callback) {
+        callback(@{@"result":@"success",@"data":value});
+    }
+}
+
+- (void)setItem:(NSString *)key value:(NSString *)value callback:(WXModuleCallback)callback
+{
+    if ([self checkInput:key]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"key must a string or number!"});
+        }
+        return;
+    }
+    if ([self checkInput:value]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"value must a string or number!"});
+        }
+        return;
+    }
+    
+    if ([key isKindOfClass:[NSNumber class]]) {
+        key = [((NSNumber *)key) stringValue];
+    }
+    
+    if ([value isKindOfClass:[NSNumber class]]) {
+        value = [((NSNumber *)value) stringValue];
+    }
+    
+    if ([WXUtility isBlankString:key]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"invalid_param"});
+        }
+        return ;
+    }
+    [self setObject:value forKey:key persistent:NO callback:callback];
+}
+
+- (void)setItemPersistent:(NSString *)key value:(NSString *)value callback:(WXModuleCallback)callback
+{
+    if ([self checkInput:key]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"key must a string or number!"});
+        }
+        return;
+    }
+    if ([self checkInput:value]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"value must a string or number!"});
+        }
+        return;
+    }
+    
+    if ([key isKindOfClass:[NSNumber class]]) {
+        key = [((NSNumber *)key) stringValue];
+    }
+    
+    if ([value isKindOfClass:[NSNumber class]]) {
+        value = [((NSNumber *)value) stringValue];
+    }
+    
+    if ([WXUtility isBlankString:key]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"invalid_param"});
+        }
+        return ;
+    }
+    [self setObject:value forKey:key persistent:YES callback:callback];
+}
+
+- (void)removeItem:(NSString *)key callback:(WXModuleCallback)callback
+{
+    if ([self checkInput:key]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"key must a string or number!"});
+        }
+        return;
+    }
+    
+    if ([key isKindOfClass:[NSNumber class]]) {
+        key = [((NSNumber *)key) stringValue];
+    }
+    
+    if ([WXUtility isBlankString:key]) {
+        if (callback) {
+            callback(@{@"result":@"failed",@"data":@"invalid_param"});
+        }
+        return ;
+    }
+    BOOL removed = [self executeRemoveItem:key];
+    if (removed) {
+        if (callback) {
+            callback(@{@"result":@"success"});
+        }
+    } else {
+        if (callback) {
+            callback(@{@"result":@"failed"});
+        }
+    }
+}
+
+- (BOOL)executeRemoveItem:(NSString *)key {
+    BOOL removed = [WXStorageModule engine]->remove(WXStorageBytes(key));
+    if (removed) {
+        [self scheduleSync];
+    }
+    return removed;
+}
+
+#pragma mark - Utils
+- (void)setObject:(NSString *)obj forKey:(NSString *)key persistent:(BOOL)persistent callback:(WXModuleCallback)callback {
+    // the least recently used items are evicted to make room, values which can't fit in the total limit are rejected
+    BOOL succeeded = [WXStorageModule engine]->put(WXStorageBytes(key), WXStorageBytes(obj), persistent, [[NSDate date] timeIntervalSince1970]);
+    [self scheduleSync];
+    if (callback) {
+        callback(succeeded ? @{@"result":@"success"} : @{@"result":@"failed"});
+    }
+}
+
+- (NSString *)storedValueForKey:(NSString *)key {
+    std::string value;
+    if (![WXStorageModule engine]->get(WXStorageBytes(key), value)) {
+        return nil;
+    }
+    return [[NSString alloc] initWithBytes:value.data() length:value.size() encoding:NSUTF8StringEncoding];
+}
+
+// the mutations within the delay are written and flushed to the disk in one commit,
+// until then they are read from the pending records of the engine
+- (void)scheduleSync {
+    static BOOL scheduled = NO;
+    if (scheduled) {
+        return;
+    }
+    scheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(WXStorageSyncDelay * NSEC_PER_SEC)), [WXStorageModule storageQueue], ^{
+        scheduled = NO;
+        [WXStorageModule engine]->sync();
+    });
+}
+
++ (WXStorageEngine *)engine {
+    static WXStorageEngine *engine;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        [WXStorageModule setupDirectory];
+        
+        NSString *path = [[WXStorageModule directory] stringByAppendingPathComponent:WXStorageLogFileName];
+        engine = new WXStorageEngine(path.fileSystemRepresentation, WXStorageTotalLimit, WXStorageLineLimit, WXStoragePendingLimit);
+        if (engine->open()) {
+            [WXStorageModule migrateLegacyStorage:engine];
+        } else {
+            // the legacy files are kept until a log is there to take them
+            WXLogError(@"Failed to open storage at %@", path);
+        }
+        
+        for (NSString *name in @[UIApplicationDidEnterBackgroundNotification, UIApplicationWillTerminateNotification]) {
+            [[NSNotificationCenter defaultCenter] addObserver:[WXStorageModule class] selector:@selector(flushPendingMutations:) name:name object:nil];
+        }
+    });
+    return engine;
+}
+
+// the app may be killed in the background, don't wait for the delay
++ (void)flushPendingMutations:(NSNotification *)notification {
+    WXStorageEngine *engine = [WXStorageModule engine];
+    if (engine->pendingSize() == 0) {
+        return;
+    }
+    if ([notification.name isEqualToString:UIApplicationWillTerminateNotification]) {
+        engine->sync();
+        return;
+    }
+    UIApplication *application = [UIApplication sharedApplication];
+    __block UIBackgroundTaskIdentifier task = [application beginBackgroundTaskWithExpirationHandler:^{
+        [application endBackgroundTask:task];
+        task = UIBackgroundTaskInvalid;
+    }];
+    dispatch_async([WXStorageModule storageQueue], ^{
+        engine->sync();
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (task != UIBackgroundTaskInvalid) {
+                [application endBackgroundTask:task];
+                task = UIBackgroundTaskInvalid;
+            }
+        });
+    });
+}
+
++ (void)migrateLegacyStorage:(WXStorageEngine *)engine {
+    NSString *directory = [WXStorageModule directory];
+    NSString *filePath = [directory stringByAppendingPathComponent:WXStorageFileName];
+    NSString *infoFilePath = [directory stringByAppendingPathComponent:WXStorageInfoFileName];
+    NSString *indexFilePath = [directory stringByAppendingPathComponent:WXStorageIndexFileName];
+    NSDictionary *memory = [NSDictionary dictionaryWithContentsOfFile:filePath];
+    if (!memory) {
+        return;
+    }
+    
+    NSDictionary *info = [NSDictionary dictionaryWithContentsOfFile:infoFilePath];
+    NSArray *indexs = [NSArray arrayWithContentsOfFile:indexFilePath];
+    // from the least recently used
+    NSMutableOrderedSet *keys = [NSMutableOrderedSet orderedSetWithArray:indexs ?: @[]];
+    [keys addObjectsFromArray:memory.allKeys];
+    NSTimeInterval now = [[NSDate date] timeIntervalSince1970];
+    NSMutableArray<NSString *> *valuePaths = [NSMutableArray array];
+    BOOL migrated = YES;
+    for (NSString *key in keys) {
+        NSString *value = memory[key];
+        if (![key isKindOfClass:[NSString class]] || ![value isKindOfClass:[NSString class]]) {
+            continue;
+        }
+        if ([WXStorageNullValue isEqualToString:value]) {
+            NSString *valuePath = [directory stringByAppendingPathComponent:[WXUtility md5:key]];
+            value = [WXUtility stringWithContentsOfFile:valuePath];
+            [valuePaths addObject:valuePath];
+        }
+        if (value) {
+            NSDictionary *itemInfo = info[key];
+            NSTimeInterval timestamp = itemInfo[@"ts"] ? [itemInfo[@"ts"] doubleValue] : now;
+            if (!engine->put(WXStorageBytes(key), WXStorageBytes(value), [itemInfo[@"persistent"] boolValue], timestamp)) {
+                WXLogError(@"Failed to migrate the storage item %@", key);
+                migrated = NO;
+            }
+        }
+    }
+    
+    // the legacy files are only removed once all of their items are on the disk, otherwise
+    // the migration is tried again on the next launch
+    if (!migrated || !engine->sync()) {
+        return;
+    }
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSString *valuePath in valuePaths) {
+        [fileManager removeItemAtPath:valuePath error:nil];
+    }
+    [fileManager removeItemAtPath:filePath error:nil];
+    [fileManager removeItemAtPath:infoFilePath error:nil];
+    [fileManager removeItemAtPath:indexFilePath error:nil];
+}
+
++ (void)setupDirectory{
+    BOOL isDirectory = NO;
+    BOOL fileExists = [[NSFileManager defaultManager] fileExistsAtPath:[WXStorageModule directory] isDirectory:&isDirectory];
+    if (!isDirectory && !fileExists) {
+        [[NSFileManager defaultManager] createDirectoryAtPath:[WXStorageModule directory]
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:NULL];
+    }
+}
+
++ (NSString *)directory {
+    static NSString *storageDirectory = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        storageDirectory = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES).firstObject;
+        storageDirectory = [storageDirectory stringByAppendingPathComponent:WXStorageDirectory];
+    });
+    return storageDirectory;
+}
+
++ (dispatch_queue_t)storageQueue {
+    static dispatch_queue_t storageQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        storageQueue = dispatch_queue_create("com.taobao.weex.storage", DISPATCH_QUEUE_SERIAL);
+    });
+    return storageQueue;
+}
+
+- (BOOL)checkInput:(id)input{
+    return !([input isKindOfClass:[NSString class]] || [input isKindOfClass:[NSNumber class]]);
+}
+
+#pragma mark
+#pragma mark - Storage Info method
+- (NSDictionary *)getInfoForKey:(NSString *)key {
+    WXStorageItemInfo info;
+    if (![WXStorageModule engine]->info(WXStorageBytes(key), info)) {
+        return nil;
+    }
+    return @{@"persistent":@(info.persistent),@"size":@(info.size),@"ts":@(info.timestamp)};
+}
+
+#pragma mark
+#pragma mark - Storage Index method
+// keys from the least recently used to the most recently used
+- (NSArray<NSString *> *)indexs {
+    std::vector<std::string> keys = [WXStorageModule engine]->keys();
+    NSMutableArray *indexs = [NSMutableArray arrayWithCapacity:keys.size()];
+    for (const std::string &key : keys) {
+        NSString *string = [[NSString alloc] initWithBytes:key.data() length:key.size() encoding:NSUTF8StringEncoding];
+        if (string) {
+            [indexs addObject:string];
+        }
+    }
+    return indexs;
+}
+
+@end
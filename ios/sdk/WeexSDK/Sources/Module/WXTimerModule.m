@@ -21,11 +21,23 @@
 #import "WXSDKManager.h"
 #import "WXLog.h"
 #import "WXAssert.h"
+#import "WXUtility.h"
+#import "WXTimerScheduler.h"
+
+@interface WXTimerModule ()
+
+- (void)timerDidFire:(NSString *)callbackID;
+
+@end
 
 @interface WXTimerTarget : NSObject
 
+@property (nonatomic, weak) WXTimerModule *timerModule;
+
 - (instancetype)initWithCallback:(NSString *)callbackID shouldRepeat:(BOOL)shouldRepeat weexInstance:(WXSDKInstance *)weexInstance;
 
+- (NSDictionary *)callback;
+
 @end
 
 @implementation WXTimerTarget
@@ -46,9 +58,16 @@
     return self;
 }
 
-- (void)trigger
+- (NSDictionary *)callback
 {
-    [[WXSDKManager bridgeMgr] callBack:_weexInstance.instanceId funcId:_callbackID params:nil keepAlive:_shouldRepeat];
+    NSString *instanceId = _weexInstance.instanceId;
+    if (!_shouldRepeat) {
+        [_timerModule timerDidFire:_callbackID];
+    }
+    if (!instanceId) {
+        return nil;
+    }
+    return @{@"instanceId": instanceId, @"funcId": _callbackID, @"keepAlive": @(_shouldRepeat)};
 }
 
 @end
@@ -65,6 +84,29 @@ WX_EXPORT_METHOD(@selector(clearTimeout:))
 WX_EXPORT_METHOD(@selector(setInterval:time:))
 WX_EXPORT_METHOD(@selector(clearInterval:))
 
++ (WXTimerScheduler *)timerScheduler
+{
+    WXAssertMainThread();
+    
+    // the timers of all the instances fire from one timer on the main run loop,
+    // the ones which fire together are sent to js in one call for each instance
+    static WXTimerScheduler *scheduler;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        scheduler = [[WXTimerScheduler alloc] initWithRunLoop:[NSRunLoop mainRunLoop] handler:^(NSArray *targets) {
+            NSMutableArray *callbacks = [NSMutableArray arrayWithCapacity:targets.count];
+            for (WXTimerTarget *target in targets) {
+                NSDictionary *callback = [target callback];
+                if (callback) {
+                    [callbacks addObject:callback];
+                }
+            }
+            [[WXSDKManager bridgeMgr] callBacks:callbacks];
+        }];
+    });
+    return scheduler;
+}
+
 - (instancetype)init
 {
     if (self = [super init]) {
@@ -83,8 +125,17 @@ WX_EXPORT_METHOD(@selector(clearInterval:))
     }
     
     WXTimerTarget *target = [[WXTimerTarget alloc] initWithCallback:callbackID shouldRepeat:shouldRepeat weexInstance:self.weexInstance];
+    target.timerModule = self;
     
-    [self createTimerWithCallback:callbackID time:milliseconds target:target selector:@selector(trigger) shouldRepeat:shouldRepeat];
+    uint64_t identifier = [[WXTimerModule timerScheduler] scheduleTarget:target milliseconds:milliseconds repeats:shouldRepeat];
+    if (!_timers[callbackID]) {
+        _timers[callbackID] = @(identifier);
+    }
+}
+
+- (void)timerDidFire:(NSString *)callbackID
+{
+    [_timers removeObjectForKey:callbackID];
 }
 
 # pragma mark Timer API
@@ -106,13 +157,17 @@ WX_EXPORT_METHOD(@selector(clearInterval:))
         return;
     }
     
-    NSTimer *timer = _timers[callbackID];
+    id timer = _timers[callbackID];
     if (!timer) {
         WXLogWarning(@"no timer found for callbackID:%@", callbackID);
         return;
     }
 
-    [timer invalidate];
+    if ([timer isKindOfClass:[NSTimer class]]) {
+        [timer invalidate];
+    } else {
+        [[WXTimerModule timerScheduler] cancel:[timer unsignedLongLongValue]];
+    }
     [_timers removeObjectForKey:callbackID];
 }
 
@@ -124,9 +179,21 @@ WX_EXPORT_METHOD(@selector(clearInterval:))
 - (void)dealloc
 {
     if (_timers) {
+        NSMutableArray *identifiers = [NSMutableArray array];
         for (NSString *callbackID in _timers) {
-            NSTimer *timer = _timers[callbackID];
-            [timer invalidate];
+            id timer = _timers[callbackID];
+            if ([timer isKindOfClass:[NSTimer class]]) {
+                [timer invalidate];
+            } else {
+                [identifiers addObject:timer];
+            }
+        }
+        if (identifiers.count > 0) {
+            WXPerformBlockOnMainThread(^{
+                for (NSNumber *identifier in identifiers) {
+                    [[WXTimerModule timerScheduler] cancel:[identifier unsignedLongLongValue]];
+                }
+            });
         }
         if([_timers count]>0){
              [_timers removeAllObjects];
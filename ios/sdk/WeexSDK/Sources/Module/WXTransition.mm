@@ -0,0 +1,476 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#import <QuartzCore/CATransaction.h>
+#import <QuartzCore/CADisplayLink.h>
+#import "WXComponentManager.h"
+#import "WXSDKInstance.h"
+#import "WXComponent+Layout.h"
+#import "WXComponent_internal.h"
+#import "WXTransition.h"
+#import "WXUtility.h"
+#import "WXAssert.h"
+#import "WXSDKInstance_private.h"
+#import "WXLength.h"
+#import "WXCSSStyleApplier.h"
+#import "WXTransitionEngine.h"
+
+@implementation WXTransitionInfo
+
+@end
+
+@interface WXTransition()
+{
+    WXComponent *_targetComponent;
+    
+    float _transitionDuration;
+    float _transitionDelay;
+    uint32_t _transitionIdentifier;
+    WXTimingCurve _transitionCurve;
+    BOOL _transitionNeedsLayout;
+
+    NSMutableDictionary *_toStyles;
+    NSMutableDictionary *_fromStyles;
+    NSMutableDictionary *_addStyles;
+}
+
+- (WXComponent *)targetComponent;
+- (BOOL)_applyTransitionValues:(const float *)values finished:(BOOL)finished viewUpdates:(NSMutableArray *)viewUpdates;
+
+@end
+
+/**
+ *  Drives all the transitions from one display link on the component thread.
+ *  Each frame interpolates them together, updates the views in one block on
+ *  the main thread, and only asks the instances with transitioned layout
+ *  properties for a layout.
+ */
+@interface WXTransitionDriver : NSObject
+{
+    WXTransitionEngine _engine;
+    std::vector<WXTransitionFrame> _frames;
+    NSMutableDictionary<NSNumber *, WXTransition *> *_transitions;
+    CADisplayLink *_displayLink;
+}
+
++ (instancetype)sharedDriver;
+- (uint32_t)addTransition:(WXTransition *)transition curve:(const WXTimingCurve &)curve delay:(double)delay duration:(double)duration from:(const float *)from to:(const float *)to count:(size_t)count;
+- (void)removeTransition:(uint32_t)identifier;
+- (BOOL)isRunning:(uint32_t)identifier;
+
+@end
+
+@implementation WXTransitionDriver
+
++ (instancetype)sharedDriver
+{
+    static WXTransitionDriver *driver;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        driver = [WXTransitionDriver new];
+    });
+    return driver;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _transitions = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (uint32_t)addTransition:(WXTransition *)transition curve:(const WXTimingCurve &)curve delay:(double)delay duration:(double)duration from:(const float *)from to:(const float *)to count:(size_t)count
+{
+    WXAssertComponentThread();
+    uint32_t identifier = _engine.add(curve, CACurrentMediaTime() + delay, duration, from, to, count);
+    _transitions[@(identifier)] = transition;
+    
+    if (!_displayLink) {
+        _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(_handleDisplayLink)];
+        [_displayLink addToRunLoop:[NSRunLoop currentRunLoop] forMode:NSDefaultRunLoopMode];
+    } else if (_displayLink.paused) {
+        _displayLink.paused = NO;
+    }
+    return identifier;
+}
+
+- (void)removeTransition:(uint32_t)identifier
+{
+    WXAssertComponentThread();
+    _engine.remove(identifier);
+    [_transitions removeObjectForKey:@(identifier)];
+}
+
+- (BOOL)isRunning:(uint32_t)identifier
+{
+    WXAssertComponentThread();
+    return identifier && _engine.contains(identifier);
+}
+
+- (void)_handleDisplayLink
+{
+    WXAssertComponentThread();
+    _engine.tick(CACurrentMediaTime(), _frames);
+    
+    NSMutableArray *viewUpdates = [NSMutableArray arrayWithCapacity:_frames.size()];
+    NSMutableSet *layoutInstances = [NSMutableSet set];
+    for (const WXTransitionFrame &frame : _frames) {
+        NSNumber *key = @(frame.identifier);
+        WXTransition *transition = _transitions[key];
+        if (frame.finished) {
+            [_transitions removeObjectForKey:key];
+        }
+        WXSDKInstance *instance = transition.targetComponent.weexInstance;
+        if ([transition _applyTransitionValues:frame.values finished:frame.finished viewUpdates:viewUpdates] && instance) {
+            [layoutInstances addObject:instance];
+        }
+    }
+    
+    if (viewUpdates.count > 0) {
+        WXPerformBlockOnMainThread(^{
+            for (dispatch_block_t update in viewUpdates) {
+                update();
+            }
+        });
+    }
+    for (WXSDKInstance *instance in layoutInstances) {
+        [instance.componentManager startComponentTasks];
+    }
+    
+    if (_engine.count() == 0) {
+        _displayLink.paused = YES;
+    }
+}
+
+@end
+
+@implementation WXTransition
+
+- (instancetype)initWithStyles:(NSDictionary *)styles
+{
+    if (self = [super init]) {
+        NSString *property = styles[kWXTransitionProperty];
+        _transitionOptions |= [property containsString:@"width"]? WXTransitionOptionsWidth:0;
+        _transitionOptions |= [property containsString:@"height"]? WXTransitionOptionsHeight:0;
+        _transitionOptions |= [property containsString:@"right"]? WXTransitionOptionsRight:0;
+        _transitionOptions |= [property containsString:@"left"]? WXTransitionOptionsLeft:0;
+        _transitionOptions |= [property containsString:@"bottom"]? WXTransitionOptionsBottom:0;
+        _transitionOptions |= [property containsString:@"top"]? WXTransitionOptionsTop:0;
+        _transitionOptions |= [property containsString:@"backgroundColor"]? WXTransitionOptionsBackgroundColor:0;
+        _transitionOptions |= [property containsString:@"transform"]? WXTransitionOptionsTransform:0;
+        _transitionOptions |= [property containsString:@"opacity"]? WXTransitionOptionsOpacity:0;
+    }
+    return self;
+}
+
+- (WXComponent *)targetComponent
+{
+    return _targetComponent;
+}
+
+#pragma mark - HandleStyle
+- (void)_handleTransitionWithStyles:(NSDictionary *)styles resetStyles:(NSMutableArray *)resetStyles target:(WXComponent *)targetComponent
+{
+    // a running transition restarts from its current values, which it keeps in _fromStyles
+    if ([self _isTransitionRunning]) {
+        [self _rollBackTransitionWithStyles:styles];
+    }
+    
+    _targetComponent = targetComponent;
+    if (!_fromStyles) {
+        _fromStyles = [NSMutableDictionary dictionaryWithDictionary:targetComponent.styles];
+        _addStyles = [NSMutableDictionary dictionaryWithDictionary:styles];
+    }
+    else
+    {
+        [_addStyles addEntriesFromDictionary:styles];
+    }
+    _toStyles = [NSMutableDictionary dictionaryWithDictionary:_fromStyles];
+    [_toStyles addEntriesFromDictionary:_addStyles];
+    
+    _transitionDuration = _fromStyles[kWXTransitionDuration] ? [WXConvert CGFloat:_fromStyles[kWXTransitionDuration]] : 0;
+    _transitionDelay = _fromStyles[kWXTransitionDelay] ? [WXConvert CGFloat:_fromStyles[kWXTransitionDelay]] : 0;
+    
+    if (_transitionDuration == 0 ) {
+        [targetComponent _updateCSSNodeStyles:styles];
+        [targetComponent _resetCSSNodeStyles:resetStyles];
+        WXPerformBlockOnMainThread(^{
+            [targetComponent _updateViewStyles:styles];
+        });
+        [self _resetProcessAnimationParameter];
+        return;
+    }
+    
+    CAMediaTimingFunction *timingFunction = [WXConvert CAMediaTimingFunction:_fromStyles[kWXTransitionTimingFunction]];
+    float vec[4] = {0.};
+    [timingFunction getControlPointAtIndex:1 values:&vec[0]];
+    [timingFunction getControlPointAtIndex:2 values:&vec[2]];
+    _transitionCurve = WXTimingCurve(vec[0], vec[1], vec[2], vec[3]);
+    
+    NSString *transitionProperty = _fromStyles[kWXTransitionProperty];
+    [self _resloveTransitionProperty:transitionProperty withStyles:styles];
+    [_targetComponent _resetCSSNodeStyles:resetStyles];
+    [self _startTransition];
+}
+
+- (void)_rollBackTransitionWithStyles:(NSDictionary *)styles
+{
+    [[WXTransitionDriver sharedDriver] removeTransition:_transitionIdentifier];
+    _transitionIdentifier = 0;
+    _transitionNeedsLayout = NO;
+    _propertyArray = nil;
+}
+
+- (void)_resloveTransitionProperty:(NSString *)propertyNames withStyles:(NSDictionary *)styles
+{
+    if (styles.count == 0) {
+        return;
+    }
+    
+    // every transitioned property of the update, and the others right away
+    NSMutableDictionary *immediateStyles = [NSMutableDictionary dictionary];
+    for (NSString *singleProperty in _addStyles) {
+        if ([singleProperty isEqualToString:@"transform"] && !styles[singleProperty]) {
+            // the component already holds the transform it was heading to, so it can't restart
+            immediateStyles[singleProperty] = _toStyles[singleProperty];
+        } else if ([propertyNames containsString:singleProperty]) {
+            [self _dealTransitionWithProperty:singleProperty styles:_addStyles];
+        } else if (styles[singleProperty]) {
+            immediateStyles[singleProperty] = styles[singleProperty];
+        }
+    }
+    if (immediateStyles.count > 0) {
+        [_fromStyles addEntriesFromDictionary:immediateStyles];
+        [_targetComponent _updateCSSNodeStyles:immediateStyles];
+        WXComponent *targetComponent = _targetComponent;
+        WXPerformBlockOnMainThread(^{
+            [targetComponent _updateViewStyles:immediateStyles];
+        });
+    }
+}
+
+- (void)_dealTransitionWithProperty:(NSString *)singleProperty styles:(NSDictionary *)styles
+{
+    if (styles[singleProperty])
+    {
+        if (!_propertyArray) {
+            _propertyArray = [NSMutableArray new];
+        }
+        if ([singleProperty isEqualToString:@"backgroundColor"]) {
+            WXTransitionInfo *info = [WXTransitionInfo new];
+            info.fromValue = [self _dealWithColor:[WXConvert UIColor:_fromStyles[singleProperty]]];
+            info.toValue = [self _dealWithColor:[WXConvert UIColor:_toStyles[singleProperty]]];
+            info.perValue = [self _calculatePerColorRGB1:info.toValue RGB2:info.fromValue];
+            info.propertyName = singleProperty;
+            [_propertyArray addObject:info];
+        }
+        else if ([singleProperty isEqualToString:@"transform"]) {
+            NSString *transformOrigin = styles[@"transformOrigin"];
+            WXTransform *wxTransform = [[WXTransform alloc] initWithCSSValue:_toStyles[singleProperty] origin:transformOrigin instance:_targetComponent.weexInstance];
+            WXTransform *oldTransform = _targetComponent->_transform;
+            if (wxTransform.rotateAngle != oldTransform.rotateAngle) {
+                [self _addTransformInfo:@"transform.rotation" from:oldTransform.rotateAngle to:wxTransform.rotateAngle];
+            }
+            if (wxTransform.rotateX != oldTransform.rotateX) {
+                [self _addTransformInfo:@"transform.rotation.x" from:oldTransform.rotateX to:wxTransform.rotateX];
+            }
+            if (wxTransform.rotateY != oldTransform.rotateY) {
+                [self _addTransformInfo:@"transform.rotation.y" from:oldTransform.rotateY to:wxTransform.rotateY];
+            }
+            if (wxTransform.rotateZ != oldTransform.rotateZ) {
+                [self _addTransformInfo:@"transform.rotation.z" from:oldTransform.rotateZ to:wxTransform.rotateZ];
+            }
+            if (wxTransform.scaleX != oldTransform.scaleX) {
+                [self _addTransformInfo:@"transform.scale.x" from:oldTransform.scaleX to:wxTransform.scaleX];
+            }
+            if (wxTransform.scaleY != oldTransform.scaleY) {
+                [self _addTransformInfo:@"transform.scale.y" from:oldTransform.scaleY to:wxTransform.scaleY];
+            }
+            if (wxTransform.translateX && [wxTransform.translateX floatValue] != [oldTransform.translateX floatValue]) {
+                [self _addTransformInfo:@"transform.translation.x" from:[oldTransform.translateX floatValue] to:[wxTransform.translateX floatValue]];
+            }
+            if (wxTransform.translateY && [wxTransform.translateY floatValue] != [oldTransform.translateY floatValue]) {
+                [self _addTransformInfo:@"transform.translation.y" from:[oldTransform.translateY floatValue] to:[wxTransform.translateY floatValue]];
+            }
+            _targetComponent->_transform = wxTransform;
+        }
+        else
+        {
+            WXTransitionInfo *info = [WXTransitionInfo new];
+            info.fromValue = @(_fromStyles[singleProperty] ? [WXConvert CGFloat:_fromStyles[singleProperty]] : 0);
+            info.toValue = @(_toStyles[singleProperty] ? [WXConvert CGFloat:_toStyles[singleProperty]] : 0 );
+            info.perValue = @([info.toValue doubleValue] - [info.fromValue doubleValue]);
+            info.propertyName = singleProperty;
+            [_propertyArray addObject:info];
+            
+            // only the properties of css_style_t need a layout, the others are drawn by the view
+            const char *key = [singleProperty UTF8String];
+            if (WXCSSPropertyLookup(key, strlen(key)) != WXCSSPropertyNone) {
+                _transitionNeedsLayout = YES;
+            }
+        }
+    }
+}
+
+- (void)_addTransformInfo:(NSString *)propertyName from:(double)fromValue to:(double)toValue
+{
+    WXTransitionInfo *info = [WXTransitionInfo new];
+    info.propertyName = propertyName;
+    info.fromValue = @(fromValue);
+    info.toValue = @(toValue);
+    info.perValue = @(toValue - fromValue);
+    [_propertyArray addObject:info];
+}
+
+- (NSArray *)_dealWithColor:(UIColor *)color
+{
+    CGFloat R, G, B, A;
+    [color getRed:&R green:&G blue:&B alpha:&A];
+    return @[@(R),@(G),@(B),@(A)];
+}
+
+- (NSArray *)_calculatePerColorRGB1:(NSArray *)RGB1 RGB2:(NSArray *)RGB2
+{
+    CGFloat R = [RGB1[0] doubleValue] - [RGB2[0] doubleValue];
+    CGFloat G = [RGB1[1] doubleValue] - [RGB2[1] doubleValue];
+    CGFloat B = [RGB1[2] doubleValue] - [RGB2[2] doubleValue];
+    CGFloat A = [RGB1[3] doubleValue] - [RGB2[3] doubleValue];
+    return @[@(R),@(G),@(B),@(A)];
+}
+
+#pragma mark Engine
+- (void)_startTransition
+{
+    WXAssertComponentThread();
+    if (_propertyArray.count == 0) {
+        return;
+    }
+    
+    // a color takes four channels, the other properties one
+    std::vector<float> from;
+    std::vector<float> to;
+    for (WXTransitionInfo *info in _propertyArray) {
+        if ([info.fromValue isKindOfClass:[NSArray class]]) {
+            for (NSUInteger i = 0; i < 4; i++) {
+                from.push_back([info.fromValue[i] floatValue]);
+                to.push_back([info.toValue[i] floatValue]);
+            }
+        } else {
+            from.push_back([info.fromValue floatValue]);
+            to.push_back([info.toValue floatValue]);
+        }
+    }
+    _transitionIdentifier = [[WXTransitionDriver sharedDriver] addTransition:self curve:_transitionCurve delay:_transitionDelay / 1000 duration:_transitionDuration / 1000 from:from.data() to:to.data() count:from.size()];
+}
+
+- (BOOL)_applyTransitionValues:(const float *)values finished:(BOOL)finished viewUpdates:(NSMutableArray *)viewUpdates
+{
+    WXComponent *targetComponent = _targetComponent;
+    NSMutableDictionary *frameStyles = [NSMutableDictionary dictionaryWithCapacity:_propertyArray.count];
+    NSMutableDictionary *layoutStyles = _transitionNeedsLayout ? [NSMutableDictionary dictionary] : nil;
+    NSString *transformString = nil;
+    UIColor *backgroundColor = nil;
+    
+    for (WXTransitionInfo *info in _propertyArray) {
+        if ([info.propertyName isEqualToString:@"backgroundColor"]) {
+            backgroundColor = [UIColor colorWithRed:values[0] green:values[1] blue:values[2] alpha:values[3]];
+            frameStyles[info.propertyName] = backgroundColor;
+            values += 4;
+            continue;
+        }
+        
+        double currentValue = *values++;
+        if ([info.propertyName hasPrefix:@"transform"]) {
+            NSString *newString = nil;
+            if ([info.propertyName isEqualToString:@"transform.rotation"]) {
+                newString = [NSString stringWithFormat:@"rotate(%lfdeg)",currentValue * 180.0 / M_PI];
+            } else if ([info.propertyName isEqualToString:@"transform.rotation.x"]) {
+                newString = [NSString stringWithFormat:@"rotateX(%lfdeg)",currentValue * 180.0 / M_PI];
+            } else if ([info.propertyName isEqualToString:@"transform.rotation.y"]) {
+                newString = [NSString stringWithFormat:@"rotateY(%lfdeg)",currentValue * 180.0 / M_PI];
+            } else if ([info.propertyName isEqualToString:@"transform.rotation.z"]) {
+                newString = [NSString stringWithFormat:@"rotateZ(%lfdeg)",currentValue * 180.0 / M_PI];
+            } else if ([info.propertyName isEqualToString:@"transform.scale.x"]) {
+                newString = [NSString stringWithFormat:@"scaleX(%lf)",currentValue];
+            } else if ([info.propertyName isEqualToString:@"transform.scale.y"]) {
+                newString = [NSString stringWithFormat:@"scaleY(%lf)",currentValue];
+            } else if ([info.propertyName isEqualToString:@"transform.translation.x"]) {
+                newString = [NSString stringWithFormat:@"translateX(%lfpx)",currentValue / targetComponent.weexInstance.pixelScaleFactor];
+            } else if ([info.propertyName isEqualToString:@"transform.translation.y"]) {
+                newString = [NSString stringWithFormat:@"translateY(%lfpx)",currentValue / targetComponent.weexInstance.pixelScaleFactor];
+            }
+            transformString = transformString ? [transformString stringByAppendingFormat:@" %@",newString] : newString;
+            frameStyles[@"transform"] = transformString;
+        } else {
+            frameStyles[info.propertyName] = @(currentValue);
+            const char *key = [info.propertyName UTF8String];
+            if (layoutStyles && WXCSSPropertyLookup(key, strlen(key)) != WXCSSPropertyNone) {
+                layoutStyles[info.propertyName] = @(currentValue);
+            }
+        }
+    }
+    
+    // the current values are where the next update starts from
+    [_fromStyles addEntriesFromDictionary:frameStyles];
+    [viewUpdates addObject:^{
+        if (backgroundColor) {
+            targetComponent.view.backgroundColor = backgroundColor;
+            [targetComponent.view setNeedsDisplay];
+        }
+        [targetComponent _updateViewStyles:frameStyles];
+    }];
+    if (layoutStyles.count > 0) {
+        [targetComponent _updateCSSNodeStyles:layoutStyles];
+    }
+    
+    if (finished) {
+        [self _resetProcessAnimationParameter];
+    }
+    return layoutStyles.count > 0;
+}
+
+- (BOOL)_isTransitionRunning
+{
+    return [[WXTransitionDriver sharedDriver] isRunning:_transitionIdentifier];
+}
+
+- (void)_resetProcessAnimationParameter
+{
+    _transitionIdentifier = 0;
+    _transitionDuration = 0;
+    _transitionNeedsLayout = NO;
+    _propertyArray = nil;
+
+    _addStyles = nil;
+    _fromStyles = nil;
+    _toStyles = nil;
+}
+
+- (NSMutableDictionary *)_addStyles
+{
+    return self.addStyles;
+}
+
+- (NSMutableDictionary *)_fromStyles
+{
+    return self.fromStyles;
+}
+
+@end
@@ -0,0 +1,93 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "WXResourceResponse.h"
+
+typedef NS_ENUM(NSInteger, WXNetworkCacheState) {
+    WXNetworkCacheStateMiss,
+    // the response can be used as it is
+    WXNetworkCacheStateFresh,
+    // the response can be used, and should be revalidated in the background
+    WXNetworkCacheStateStaleWhileRevalidate,
+    // the response has to be revalidated before it's used
+    WXNetworkCacheStateStale,
+};
+
+@interface WXNetworkCacheEntry : NSObject
+
+@property (nonatomic, assign, readonly) WXNetworkCacheState state;
+@property (nonatomic, strong, readonly) WXResourceResponse *response;
+// mapped from the cached body file
+@property (nonatomic, strong, readonly) NSData *data;
+// If-None-Match or If-Modified-Since, empty if the response has no validators
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, NSString *> *validators;
+
+@end
+
+/**
+ * The HTTP cache of the default resource request handler, on top of the portable WXHTTPCache:
+ * responses are kept on disk by their URL and selecting headers following their Cache-Control,
+ * Expires and validators, and identical requests in flight can share one load.
+ */
+@interface WXNetworkCache : NSObject
+
++ (instancetype)sharedCache;
+
+/**
+ * The key of a GET request which may use the cache, nil if the request shouldn't. Requests only
+ * share a key if their URLs and the headers which select a response, such as Authorization and
+ * Accept, are the same.
+ */
+- (NSString *)keyForRequest:(NSURLRequest *)request;
+
+- (WXNetworkCacheEntry *)entryForKey:(NSString *)key;
+
+/**
+ * Stores the response if it's cacheable.
+ */
+- (void)storeResponse:(NSHTTPURLResponse *)response data:(NSData *)data forKey:(NSString *)key requestDate:(NSDate *)requestDate responseDate:(NSDate *)responseDate;
+
+/**
+ * Updates the entry with a 304 response, and returns it, nil if the entry is gone.
+ */
+- (WXNetworkCacheEntry *)revalidateKey:(NSString *)key withResponse:(NSHTTPURLResponse *)response requestDate:(NSDate *)requestDate responseDate:(NSDate *)responseDate;
+
+/**
+ * Adds a waiter for the load of the key, returns YES if it's the first one, which should start the load.
+ */
+- (BOOL)joinLoadForKey:(NSString *)key waiter:(id)waiter;
+
+/**
+ * Removes a waiter of the load, returns the number of the waiters left.
+ */
+- (NSUInteger)leaveLoadForKey:(NSString *)key waiter:(id)waiter;
+
+/**
+ * Ends the load of the key, and returns its waiters in the order they joined.
+ */
+- (NSArray *)finishLoadForKey:(NSString *)key;
+
+/**
+ * fresh, staleWhileRevalidate, stale, misses, revalidations, stores, evictions, count and bytes of the cache.
+ */
+- (NSDictionary *)metrics;
+
+@end
@@ -0,0 +1,242 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXNetworkCache.h"
+#import "WXHTTPCache.h"
+#import "WXBundleStreamCore.h"
+#import "WXLog.h"
+#import <UIKit/UIKit.h>
+#import <memory>
+
+// the least recently used responses are removed beyond this
+static const size_t WXNetworkCacheCapacity = 20 * 1024 * 1024;
+
+@implementation WXNetworkCacheEntry
+
+- (instancetype)initWithState:(WXNetworkCacheState)state response:(WXResourceResponse *)response data:(NSData *)data validators:(NSDictionary *)validators
+{
+    if (self = [super init]) {
+        _state = state;
+        _response = response;
+        _data = data;
+        _validators = validators;
+    }
+    return self;
+}
+
+@end
+
+static WXHTTPHeaders WXHeadersOfResponse(NSHTTPURLResponse *response)
+{
+    WXHTTPHeaders headers;
+    [response.allHeaderFields enumerateKeysAndObjectsUsingBlock:^(id name, id value, BOOL *stop) {
+        if ([name isKindOfClass:[NSString class]] && [value isKindOfClass:[NSString class]]) {
+            headers.emplace_back([name UTF8String] ?: "", [value UTF8String] ?: "");
+        }
+    }];
+    return headers;
+}
+
+// the digest of the request headers which select a different response follows the URL in a key,
+// so credentials aren't written to the index. The others, such as the Referer of the page, would
+// only keep equal requests from sharing a load.
+static NSString *WXKeyOfRequest(NSURLRequest *request)
+{
+    WXMD5 digest;
+    BOOL hasHeaders = NO;
+    for (NSString *name in @[@"Accept", @"Accept-Language", @"Authorization", @"Cookie", @"Range"]) {
+        NSString *value = [request valueForHTTPHeaderField:name];
+        if (!value) {
+            continue;
+        }
+        hasHeaders = YES;
+        NSData *line = [[NSString stringWithFormat:@"%@: %@\n", name.lowercaseString, value] dataUsingEncoding:NSUTF8StringEncoding];
+        digest.update(line.bytes, line.length);
+    }
+    if (!hasHeaders) {
+        return request.URL.absoluteString;
+    }
+    return [NSString stringWithFormat:@"%@ %s", request.URL.absoluteString, digest.finish().c_str()];
+}
+
+static NSURL *WXURLOfKey(NSString *key)
+{
+    // a URL never contains a space
+    NSRange end = [key rangeOfString:@" "];
+    return [NSURL URLWithString:end.location == NSNotFound ? key : [key substringToIndex:end.location]];
+}
+
+@implementation WXNetworkCache
+{
+    std::unique_ptr<WXHTTPCache> _cache;
+    BOOL _opened;
+    WXInflightRequests<id> _inflight;
+}
+
++ (instancetype)sharedCache
+{
+    static WXNetworkCache *sharedCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[WXNetworkCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        NSString *cacheDirectory = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        NSString *directory = [cacheDirectory stringByAppendingPathComponent:@"wxhttpcache"];
+        _cache.reset(new WXHTTPCache(directory.fileSystemRepresentation, WXNetworkCacheCapacity));
+        _opened = _cache->open();
+        if (!_opened) {
+            WXLogError(@"Failed to open the http cache in %@", directory);
+        }
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidEnterBackground:)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification
+{
+    _cache->sync();
+}
+
+- (NSString *)keyForRequest:(NSURLRequest *)request
+{
+    NSString *scheme = request.URL.scheme.lowercaseString;
+    if (!_opened || ![request.HTTPMethod ?: @"GET" isEqualToString:@"GET"] || request.HTTPBody || request.HTTPBodyStream
+        || !([scheme isEqualToString:@"http"] || [scheme isEqualToString:@"https"])) {
+        return nil;
+    }
+    if (request.cachePolicy == NSURLRequestReloadIgnoringLocalCacheData
+        || request.cachePolicy == NSURLRequestReloadIgnoringLocalAndRemoteCacheData) {
+        return nil;
+    }
+    NSString *cacheControl = [request valueForHTTPHeaderField:@"Cache-Control"];
+    if ([cacheControl rangeOfString:@"no-cache"].location != NSNotFound || [cacheControl rangeOfString:@"no-store"].location != NSNotFound) {
+        return nil;
+    }
+    // requests with different credentials or content negotiation get different responses
+    return WXKeyOfRequest(request);
+}
+
+- (WXNetworkCacheEntry *)entryForLookup:(const WXHTTPCacheLookup &)lookup key:(NSString *)key
+{
+    if (lookup.state == WXHTTPCacheState::Miss) {
+        return nil;
+    }
+    NSData *data = [NSData dataWithContentsOfFile:@(lookup.bodyPath.c_str()) options:NSDataReadingMappedIfSafe error:nil];
+    if (!data) {
+        _cache->remove(key.UTF8String);
+        return nil;
+    }
+    
+    NSMutableDictionary *headerFields = [NSMutableDictionary dictionary];
+    for (const auto &header : lookup.entry.headers) {
+        NSString *name = @(header.first.c_str());
+        NSString *value = @(header.second.c_str());
+        if (name && value) {
+            headerFields[name] = value;
+        }
+    }
+    WXResourceResponse *response = [[WXResourceResponse alloc] initWithURL:WXURLOfKey(key)
+                                                                statusCode:lookup.entry.status
+                                                               HTTPVersion:@"HTTP/1.1"
+                                                              headerFields:headerFields];
+    NSMutableDictionary *validators = [NSMutableDictionary dictionary];
+    if (!lookup.etag.empty()) {
+        validators[@"If-None-Match"] = @(lookup.etag.c_str());
+    } else if (!lookup.lastModified.empty()) {
+        validators[@"If-Modified-Since"] = @(lookup.lastModified.c_str());
+    }
+    
+    WXNetworkCacheState state = WXNetworkCacheStateStale;
+    if (lookup.state == WXHTTPCacheState::Fresh) {
+        state = WXNetworkCacheStateFresh;
+    } else if (lookup.state == WXHTTPCacheState::StaleWhileRevalidate) {
+        state = WXNetworkCacheStateStaleWhileRevalidate;
+    }
+    return [[WXNetworkCacheEntry alloc] initWithState:state response:response data:data validators:validators];
+}
+
+- (WXNetworkCacheEntry *)entryForKey:(NSString *)key
+{
+    WXHTTPCacheLookup lookup = _cache->lookup(key.UTF8String, [NSDate date].timeIntervalSince1970);
+    return [self entryForLookup:lookup key:key];
+}
+
+- (void)storeResponse:(NSHTTPURLResponse *)response data:(NSData *)data forKey:(NSString *)key requestDate:(NSDate *)requestDate responseDate:(NSDate *)responseDate
+{
+    _cache->store(key.UTF8String, (int)response.statusCode, WXHeadersOfResponse(response), data.bytes, data.length,
+                  requestDate.timeIntervalSince1970, responseDate.timeIntervalSince1970);
+}
+
+- (WXNetworkCacheEntry *)revalidateKey:(NSString *)key withResponse:(NSHTTPURLResponse *)response requestDate:(NSDate *)requestDate responseDate:(NSDate *)responseDate
+{
+    if (!_cache->revalidate(key.UTF8String, WXHeadersOfResponse(response), requestDate.timeIntervalSince1970, responseDate.timeIntervalSince1970)) {
+        return nil;
+    }
+    return [self entryForKey:key];
+}
+
+- (BOOL)joinLoadForKey:(NSString *)key waiter:(id)waiter
+{
+    return _inflight.add(key.UTF8String, waiter);
+}
+
+- (NSUInteger)leaveLoadForKey:(NSString *)key waiter:(id)waiter
+{
+    return _inflight.remove(key.UTF8String, waiter);
+}
+
+- (NSArray *)finishLoadForKey:(NSString *)key
+{
+    NSMutableArray *waiters = [NSMutableArray array];
+    for (id waiter : _inflight.finish(key.UTF8String)) {
+        [waiters addObject:waiter];
+    }
+    return waiters;
+}
+
+- (NSDictionary *)metrics
+{
+    WXHTTPCacheMetrics metrics = _cache->metrics();
+    return @{@"fresh": @(metrics.fresh),
+             @"staleWhileRevalidate": @(metrics.staleWhileRevalidate),
+             @"stale": @(metrics.stale),
+             @"misses": @(metrics.misses),
+             @"revalidations": @(metrics.revalidations),
+             @"stores": @(metrics.stores),
+             @"evictions": @(metrics.evictions),
+             @"count": @(metrics.count),
+             @"bytes": @(metrics.bytes)};
+}
+
+@end
@@ -6,9 +6,9 @@
  * to you under the Apache License, Version 2.0 (the
  * "License"); you may not use this file except in compliance
  * with the License.  You may obtain a copy of the License at
- * 
+ *
  *   http://www.apache.org/licenses/LICENSE-2.0
- * 
+ *
  * Unless required by applicable law or agreed to in writing,
  * software distributed under the License is distributed on an
  * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
@@ -21,6 +21,38 @@
 #import "WXResourceRequestHandlerDefaultImpl.h"
 #import "WXThreadSafeMutableDictionary.h"
 #import "WXAppConfiguration.h"
+#import "WXNetworkCache.h"
+
+// a request waiting for a load, with its delegate
+@interface WXResourceLoadWaiter : NSObject
+
+@property (nonatomic, strong) WXResourceRequest *request;
+// released when the request finishes or is cancelled
+@property (nonatomic, strong) id<WXResourceRequestDelegate> delegate;
+@property (nonatomic, copy) NSString *cacheKey;
+
+@end
+
+@implementation WXResourceLoadWaiter
+@end
+
+// a session task, and what's needed to cache its response and hand it to the other waiters
+@interface WXResourceLoad : NSObject
+
+@property (nonatomic, strong) WXResourceLoadWaiter *waiter;
+@property (nonatomic, copy) NSString *cacheKey;
+@property (nonatomic, strong) WXNetworkCacheEntry *cachedEntry;
+// the cached entry, once a conditional request got 304
+@property (nonatomic, strong) WXNetworkCacheEntry *revalidatedEntry;
+@property (nonatomic, strong) NSHTTPURLResponse *response;
+@property (nonatomic, strong) NSMutableData *data;
+@property (nonatomic, strong) NSDate *requestDate;
+@property (nonatomic, strong) NSDate *responseDate;
+
+@end
+
+@implementation WXResourceLoad
+@end
 
 @interface WXResourceRequestHandlerDefaultImpl () <NSURLSessionDataDelegate>
 
@@ -29,37 +61,153 @@
 @implementation WXResourceRequestHandlerDefaultImpl
 {
     NSURLSession *_session;
-    WXThreadSafeMutableDictionary<NSURLSessionDataTask *, id<WXResourceRequestDelegate>> *_delegates;
+    WXThreadSafeMutableDictionary<NSURLSessionDataTask *, WXResourceLoad *> *_loads;
 }
 
 #pragma mark - WXResourceRequestHandler
 
 - (void)sendRequest:(WXResourceRequest *)request withDelegate:(id<WXResourceRequestDelegate>)delegate
 {
-    if (!_session) {
-        NSURLSessionConfiguration *urlSessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
-        if ([WXAppConfiguration customizeProtocolClasses].count > 0) {
-            NSArray *defaultProtocols = urlSessionConfig.protocolClasses;
-            urlSessionConfig.protocolClasses = [[WXAppConfiguration customizeProtocolClasses] arrayByAddingObjectsFromArray:defaultProtocols];
+    @synchronized (self) {
+        if (!_session) {
+            NSURLSessionConfiguration *urlSessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
+            if ([WXAppConfiguration customizeProtocolClasses].count > 0) {
+                NSArray *defaultProtocols = urlSessionConfig.protocolClasses;
+                urlSessionConfig.protocolClasses = [[WXAppConfiguration customizeProtocolClasses] arrayByAddingObjectsFromArray:defaultProtocols];
+            }
+            // responses are cached by WXNetworkCache
+            urlSessionConfig.URLCache = nil;
+            _session = [NSURLSession sessionWithConfiguration:urlSessionConfig
+                                                     delegate:self
+                                                delegateQueue:[NSOperationQueue mainQueue]];
+            _loads = [WXThreadSafeMutableDictionary new];
         }
-        _session = [NSURLSession sessionWithConfiguration:urlSessionConfig
-                                                 delegate:self
-                                            delegateQueue:[NSOperationQueue mainQueue]];
-        _delegates = [WXThreadSafeMutableDictionary new];
     }
     
-    NSURLSessionDataTask *task = [_session dataTaskWithRequest:request];
-    request.taskIdentifier = task;
-    [_delegates setObject:delegate forKey:task];
-    [task resume];
+    WXResourceLoadWaiter *waiter = [WXResourceLoadWaiter new];
+    waiter.request = request;
+    waiter.delegate = delegate;
+    
+    WXNetworkCache *cache = [WXNetworkCache sharedCache];
+    NSString *key = [cache keyForRequest:request];
+    if (!key) {
+        [self startLoadWithWaiter:waiter cachedEntry:nil];
+        return;
+    }
+    
+    waiter.cacheKey = key;
+    WXNetworkCacheEntry *entry = [cache entryForKey:key];
+    if (entry.state == WXNetworkCacheStateFresh || entry.state == WXNetworkCacheStateStaleWhileRevalidate) {
+        request.taskIdentifier = waiter;
+        [[NSOperationQueue mainQueue] addOperationWithBlock:^{
+            [self deliverResponse:entry.response data:entry.data toWaiter:waiter];
+        }];
+        if (entry.state == WXNetworkCacheStateStaleWhileRevalidate) {
+            WXResourceLoadWaiter *revalidation = [WXResourceLoadWaiter new];
+            revalidation.request = request;
+            revalidation.cacheKey = key;
+            if ([cache joinLoadForKey:key waiter:revalidation]) {
+                [self startLoadWithWaiter:revalidation cachedEntry:entry];
+            }
+        }
+        return;
+    }
+    
+    // identical requests in flight share the first one's load
+    request.taskIdentifier = waiter;
+    if ([cache joinLoadForKey:key waiter:waiter]) {
+        [self startLoadWithWaiter:waiter cachedEntry:entry];
+    }
 }
 
 - (void)cancelRequest:(WXResourceRequest *)request
 {
-    if ([request.taskIdentifier isKindOfClass:[NSURLSessionTask class]]) {
+    if ([request.taskIdentifier isKindOfClass:[WXResourceLoadWaiter class]]) {
+        // waiting for the load of another request
+        WXResourceLoadWaiter *waiter = (WXResourceLoadWaiter *)request.taskIdentifier;
+        [[WXNetworkCache sharedCache] leaveLoadForKey:waiter.cacheKey waiter:waiter];
+        waiter.delegate = nil;
+    } else if ([request.taskIdentifier isKindOfClass:[NSURLSessionTask class]]) {
         NSURLSessionTask *task = (NSURLSessionTask *)request.taskIdentifier;
+        WXResourceLoad *load = [_loads objectForKey:task];
+        // the load goes on for the requests which joined it
+        load.waiter.delegate = nil;
+        if (load.cacheKey) {
+            WXNetworkCache *cache = [WXNetworkCache sharedCache];
+            if ([cache leaveLoadForKey:load.cacheKey waiter:load.waiter] > 0) {
+                return;
+            }
+            [cache finishLoadForKey:load.cacheKey];
+        }
         [task cancel];
-        [_delegates removeObjectForKey:task];
+        [_loads removeObjectForKey:task];
+    }
+}
+
+#pragma mark - Loading
+
+- (void)startLoadWithWaiter:(WXResourceLoadWaiter *)waiter cachedEntry:(WXNetworkCacheEntry *)entry
+{
+    NSURLRequest *request = waiter.request;
+    if (entry.validators.count > 0) {
+        NSMutableURLRequest *conditionalRequest = [request mutableCopy];
+        [entry.validators enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSString *value, BOOL *stop) {
+            [conditionalRequest setValue:value forHTTPHeaderField:name];
+        }];
+        request = conditionalRequest;
+    }
+    
+    WXResourceLoad *load = [WXResourceLoad new];
+    load.waiter = waiter;
+    load.cacheKey = waiter.cacheKey;
+    load.cachedEntry = entry.validators.count > 0 ? entry : nil;
+    load.requestDate = [NSDate date];
+    
+    NSURLSessionDataTask *task = [_session dataTaskWithRequest:request];
+    if (waiter.delegate) {
+        waiter.request.taskIdentifier = task;
+    }
+    [_loads setObject:load forKey:task];
+    [task resume];
+}
+
+- (void)deliverResponse:(NSURLResponse *)response data:(NSData *)data toWaiter:(WXResourceLoadWaiter *)waiter
+{
+    id<WXResourceRequestDelegate> delegate = waiter.delegate;
+    if (!delegate) {
+        return;
+    }
+    [delegate request:waiter.request didReceiveResponse:(WXResourceResponse *)response];
+    if (data.length > 0) {
+        [delegate request:waiter.request didReceiveData:data];
+    }
+    [delegate requestDidFinishLoading:waiter.request];
+    waiter.delegate = nil;
+}
+
+- (void)finishLoad:(WXResourceLoad *)load error:(NSError *)error
+{
+    if (!load.cacheKey) {
+        return;
+    }
+    
+    WXNetworkCache *cache = [WXNetworkCache sharedCache];
+    NSHTTPURLResponse *response = load.revalidatedEntry.response ?: load.response;
+    NSData *data = load.revalidatedEntry.data ?: load.data;
+    if (!error && !load.revalidatedEntry && load.response) {
+        [cache storeResponse:load.response data:load.data forKey:load.cacheKey requestDate:load.requestDate responseDate:load.responseDate];
+    }
+    
+    for (WXResourceLoadWaiter *waiter in [cache finishLoadForKey:load.cacheKey]) {
+        if (waiter == load.waiter) {
+            continue;
+        }
+        if (error) {
+            [waiter.delegate request:waiter.request didFailWithError:error];
+            waiter.delegate = nil;
+        } else {
+            [self deliverResponse:response data:data toWaiter:waiter];
+        }
     }
 }
 
@@ -71,41 +219,70 @@
     totalBytesSent:(int64_t)totalBytesSent
 totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
 {
-    id<WXResourceRequestDelegate> delegate = [_delegates objectForKey:task];
-    [delegate request:(WXResourceRequest *)task.originalRequest didSendData:bytesSent totalBytesToBeSent:totalBytesExpectedToSend];
+    WXResourceLoadWaiter *waiter = [_loads objectForKey:task].waiter;
+    [waiter.delegate request:waiter.request didSendData:bytesSent totalBytesToBeSent:totalBytesExpectedToSend];
 }
 
 - (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)task
 didReceiveResponse:(NSURLResponse *)response
  completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
 {
-    id<WXResourceRequestDelegate> delegate = [_delegates objectForKey:task];
-    [delegate request:(WXResourceRequest *)task.originalRequest didReceiveResponse:(WXResourceResponse *)response];
+    WXResourceLoad *load = [_loads objectForKey:task];
+    load.responseDate = [NSDate date];
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        load.response = (NSHTTPURLResponse *)response;
+    }
+    if (load.cachedEntry && load.response.statusCode == 304) {
+        load.revalidatedEntry = [[WXNetworkCache sharedCache] revalidateKey:load.cacheKey withResponse:load.response requestDate:load.requestDate responseDate:load.responseDate];
+        if (!load.revalidatedEntry) {
+            // the entry is gone since the lookup, so the 304 has no body to deliver, load it
+            // again without the validators, the waiters stay joined to the key
+            [_loads removeObjectForKey:task];
+            [self startLoadWithWaiter:load.waiter cachedEntry:nil];
+            completionHandler(NSURLSessionResponseCancel);
+            return;
+        }
+        response = load.revalidatedEntry.response;
+    } else if (load.cacheKey) {
+        load.data = [NSMutableData data];
+    }
+    
+    WXResourceLoadWaiter *waiter = load.waiter;
+    [waiter.delegate request:waiter.request didReceiveResponse:(WXResourceResponse *)response];
     completionHandler(NSURLSessionResponseAllow);
 }
 
 - (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)task didReceiveData:(NSData *)data
 {
-    id<WXResourceRequestDelegate> delegate = [_delegates objectForKey:task];
-    [delegate request:(WXResourceRequest *)task.originalRequest didReceiveData:data];
+    WXResourceLoad *load = [_loads objectForKey:task];
+    [load.data appendData:data];
+    if (!load.revalidatedEntry) {
+        [load.waiter.delegate request:load.waiter.request didReceiveData:data];
+    }
 }
 
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error
 {
-    id<WXResourceRequestDelegate> delegate = [_delegates objectForKey:task];
+    WXResourceLoad *load = [_loads objectForKey:task];
+    WXResourceLoadWaiter *waiter = load.waiter;
     if (error) {
-        [delegate request:(WXResourceRequest *)task.originalRequest didFailWithError:error];
-    }else {
-        [delegate requestDidFinishLoading:(WXResourceRequest *)task.originalRequest];
+        [waiter.delegate request:waiter.request didFailWithError:error];
+    } else {
+        if (load.revalidatedEntry.data.length > 0) {
+            [waiter.delegate request:waiter.request didReceiveData:load.revalidatedEntry.data];
+        }
+        [waiter.delegate requestDidFinishLoading:waiter.request];
     }
-    [_delegates removeObjectForKey:task];
+    waiter.delegate = nil;
+    [self finishLoad:load error:error];
+    [_loads removeObjectForKey:task];
 }
 
 #ifdef __IPHONE_10_0
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
 {
-    id<WXResourceRequestDelegate> delegate = [_delegates objectForKey:task];
-    [delegate request:(WXResourceRequest *)task.originalRequest didFinishCollectingMetrics:metrics];
+    WXResourceLoadWaiter *waiter = [_loads objectForKey:task].waiter;
+    [waiter.delegate request:waiter.request didFinishCollectingMetrics:metrics];
 }
 #endif
 @end
@@ -30,6 +30,7 @@ typedef NSInteger(^WXJSCallAddEvent)(NSString *instanceId,NSString *ref,NSString
 typedef NSInteger(^WXJSCallRemoveEvent)(NSString *instanceId,NSString *ref,NSString *event);
 typedef NSInteger(^WXJSCallCreateFinish)(NSString *instanceId);
 typedef NSInvocation *(^WXJSCallNativeModule)(NSString *instanceId, NSString *moduleName, NSString *methodName, NSArray *args, NSDictionary *options);
+typedef NSInvocation *(^WXJSCallNativeModuleById)(NSString *instanceId, NSUInteger moduleId, NSUInteger methodId, NSArray *args, NSDictionary *options);
 typedef void (^WXJSCallNativeComponent)(NSString *instanceId, NSString *componentRef, NSString *methodName, NSArray *args, NSDictionary *options);
 
 @protocol WXBridgeProtocol <NSObject>
@@ -119,10 +120,35 @@ typedef void (^WXJSCallNativeComponent)(NSString *instanceId, NSString *componen
  */
 - (void)registerCallNativeModule:(WXJSCallNativeModule)callNativeModuleBlock;
 
+/**
+ * Register callback for global js function `callNativeModule` called with module id and method id,
+ * the ids are published to js framework along with `registerModules` if this method is implemented.
+ */
+- (void)registerCallNativeModuleById:(WXJSCallNativeModuleById)callNativeModuleByIdBlock;
+
 /**
  * Register callback for global js function `callNativeComponent`
  */
 - (void)registerCallNativeComponent:(WXJSCallNativeComponent)callNativeComponentBlock;
 
+/**
+ * Returns the version of the bytecode the engine produces, bytecode cached by other versions is not used.
+ * Implement it with the two methods below to let the sdk cache the bytecode of the js framework and services
+ * on disk, they are executed with `executeJavascript:sourceURL:codeCache:` then.
+ */
+- (NSString *)codeCacheVersion;
+
+/**
+ * Executes the js code, from the bytecode produced for it by a previous run if codeCache is not nil.
+ * The bytecode is mapped from disk and only valid during the call, returns NO without executing
+ * the code if the engine rejects it.
+ */
+- (BOOL)executeJavascript:(NSString *)script sourceURL:(NSURL *)sourceURL codeCache:(NSData *)codeCache;
+
+/**
+ * Returns the bytecode of the js code executed last, nil if the engine can't produce it.
+ */
+- (NSData *)codeCacheForJavascript:(NSString *)script sourceURL:(NSURL *)sourceURL;
+
 
 @end
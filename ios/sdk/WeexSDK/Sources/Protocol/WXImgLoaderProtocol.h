@@ -44,4 +44,21 @@
  */
 - (id<WXImageOperationProtocol>)downloadImageWithURL:(NSString *)url imageFrame:(CGRect)imageFrame userInfo:(NSDictionary *)options completed:(void(^)(UIImage *image,  NSError *error, BOOL finished))completedBlock;
 
+@optional
+
+/**
+ * @abstract Downloads the bytes of an image, which the SDK decodes and keeps in its memory cache.
+ * Loaders implementing it are called instead of downloadImageWithURL:imageFrame:userInfo:completed:,
+ * and don't have to decode images or cache decoded ones.
+ *
+ * @param url The URL of the image to download
+ *
+ * @param imageFrame  The frame of the image you want to set
+ *
+ * @param options : The options to be used for this download
+ *
+ * @param completedBlock : A block called once the download is completed, with the bytes of the image or the error.
+ */
+- (id<WXImageOperationProtocol>)downloadImageDataWithURL:(NSString *)url imageFrame:(CGRect)imageFrame userInfo:(NSDictionary *)options completed:(void(^)(NSData *data, NSError *error))completedBlock;
+
 @end
@@ -0,0 +1,384 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "WXBundleStreamCore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+static const char kExtension[] = ".js";
+
+static inline uint32_t rotateLeft(uint32_t value, int bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+WXMD5::WXMD5() : _length(0)
+{
+    _state[0] = 0x67452301;
+    _state[1] = 0xefcdab89;
+    _state[2] = 0x98badcfe;
+    _state[3] = 0x10325476;
+}
+
+void WXMD5::transform(const uint8_t *block)
+{
+    static const uint32_t k[64] = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391,
+    };
+    static const int shifts[16] = {7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21};
+
+    uint32_t words[16];
+    for (int i = 0; i < 16; i++) {
+        words[i] = (uint32_t)block[i * 4] | (uint32_t)block[i * 4 + 1] << 8 | (uint32_t)block[i * 4 + 2] << 16 | (uint32_t)block[i * 4 + 3] << 24;
+    }
+    uint32_t a = _state[0], b = _state[1], c = _state[2], d = _state[3];
+    for (int i = 0; i < 64; i++) {
+        uint32_t f;
+        int g;
+        int round = i / 16;
+        if (round == 0) {
+            f = (b & c) | (~b & d);
+            g = i;
+        } else if (round == 1) {
+            f = (d & b) | (~d & c);
+            g = (5 * i + 1) % 16;
+        } else if (round == 2) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) % 16;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) % 16;
+        }
+        uint32_t next = d;
+        d = c;
+        c = b;
+        b = b + rotateLeft(a + f + k[i] + words[g], shifts[round * 4 + i % 4]);
+        a = next;
+    }
+    _state[0] += a;
+    _state[1] += b;
+    _state[2] += c;
+    _state[3] += d;
+}
+
+void WXMD5::update(const void *bytes, size_t length)
+{
+    const uint8_t *data = (const uint8_t *)bytes;
+    size_t used = (size_t)(_length % 64);
+    _length += length;
+    if (used > 0) {
+        size_t count = std::min(length, 64 - used);
+        memcpy(_buffer + used, data, count);
+        data += count;
+        length -= count;
+        if (used + count < 64) {
+            return;
+        }
+        transform(_buffer);
+    }
+    for (; length >= 64; data += 64, length -= 64) {
+        transform(data);
+    }
+    memcpy(_buffer, data, length);
+}
+
+std::string WXMD5::finish()
+{
+    uint64_t bits = _length * 8;
+    static const uint8_t padding[64] = {0x80};
+    size_t used = (size_t)(_length % 64);
+    update(padding, used < 56 ? 56 - used : 120 - used);
+    uint8_t encodedLength[8];
+    for (int i = 0; i < 8; i++) {
+        encodedLength[i] = (uint8_t)(bits >> (i * 8));
+    }
+    update(encodedLength, 8);
+
+    char digest[33];
+    for (int i = 0; i < 16; i++) {
+        snprintf(digest + i * 2, 3, "%02x", (_state[i / 4] >> ((i % 4) * 8)) & 0xff);
+    }
+    return std::string(digest, 32);
+}
+
+// the length of the sequence a lead byte starts, 0 if it can't start one
+static inline size_t sequenceLength(uint8_t lead)
+{
+    if (lead >= 0xc2 && lead <= 0xdf) {
+        return 2;
+    } else if (lead >= 0xe0 && lead <= 0xef) {
+        return 3;
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        return 4;
+    }
+    return 0;
+}
+
+// rejects overlong forms, surrogates and code points above U+10FFFF, like NSString does
+static inline bool decodeSequence(const uint8_t *bytes, size_t length, uint32_t &codePoint)
+{
+    uint8_t lead = bytes[0];
+    uint8_t second = bytes[1];
+    if ((lead == 0xe0 && second < 0xa0) || (lead == 0xed && second > 0x9f)
+        || (lead == 0xf0 && second < 0x90) || (lead == 0xf4 && second > 0x8f)) {
+        return false;
+    }
+    codePoint = lead & (0x7f >> length);
+    for (size_t i = 1; i < length; i++) {
+        if ((bytes[i] & 0xc0) != 0x80) {
+            return false;
+        }
+        codePoint = codePoint << 6 | (bytes[i] & 0x3f);
+    }
+    return true;
+}
+
+static inline void appendCodePoint(std::vector<uint16_t> &characters, uint32_t codePoint)
+{
+    if (codePoint < 0x10000) {
+        characters.push_back((uint16_t)codePoint);
+    } else {
+        codePoint -= 0x10000;
+        characters.push_back((uint16_t)(0xd800 + (codePoint >> 10)));
+        characters.push_back((uint16_t)(0xdc00 + (codePoint & 0x3ff)));
+    }
+}
+
+WXBundleStreamCore::WXBundleStreamCore(const std::string &directory, size_t cacheLimit)
+: _directory(directory), _cacheLimit(cacheLimit), _fd(-1), _byteCount(0), _valid(true), _finished(false), _partialLength(0)
+{
+}
+
+WXBundleStreamCore::~WXBundleStreamCore()
+{
+    if (!_finished) {
+        cancel();
+    }
+}
+
+void WXBundleStreamCore::reserve(size_t length)
+{
+    // a character takes one UTF-16 unit for every byte at most
+    _characters.reserve(length);
+}
+
+bool WXBundleStreamCore::append(const void *bytes, size_t length)
+{
+    if (!_valid || _finished) {
+        return false;
+    }
+    const uint8_t *data = (const uint8_t *)bytes;
+    _byteCount += length;
+    _hash.update(data, length);
+
+    if (!_directory.empty() && _byteCount == length) {
+        static std::atomic<unsigned> counter(0);
+        mkdir(_directory.c_str(), 0755);
+        _temporaryPath = _directory + "/stream" + std::to_string(getpid()) + "_" + std::to_string(counter++) + ".tmp";
+        _fd = ::open(_temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (_fd >= 0) {
+        const uint8_t *remaining = data;
+        size_t remainingLength = length;
+        while (remainingLength > 0) {
+            ssize_t written = ::write(_fd, remaining, remainingLength);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written < 0) {
+                // the bundle is still executed, just not cached
+                closeFile(false);
+                break;
+            }
+            remaining += written;
+            remainingLength -= written;
+        }
+    }
+
+    if (!decode(data, length)) {
+        _valid = false;
+        closeFile(false);
+    }
+    return _valid;
+}
+
+bool WXBundleStreamCore::decode(const uint8_t *bytes, size_t length)
+{
+    size_t index = 0;
+    if (_partialLength > 0) {
+        size_t needed = sequenceLength(_partial[0]);
+        while (_partialLength < needed && index < length) {
+            _partial[_partialLength++] = bytes[index++];
+        }
+        if (_partialLength < needed) {
+            return true;
+        }
+        uint32_t codePoint;
+        if (!decodeSequence(_partial, needed, codePoint)) {
+            return false;
+        }
+        appendCodePoint(_characters, codePoint);
+        _partialLength = 0;
+    }
+
+    while (index < length) {
+        uint8_t lead = bytes[index];
+        if (lead < 0x80) {
+            size_t end = index + 1;
+            while (end < length && bytes[end] < 0x80) {
+                end++;
+            }
+            _characters.insert(_characters.end(), bytes + index, bytes + end);
+            index = end;
+            continue;
+        }
+        size_t needed = sequenceLength(lead);
+        if (needed == 0) {
+            return false;
+        }
+        if (index + needed > length) {
+            // validate what there is, the rest comes with the next chunk
+            for (size_t i = index + 1; i < length; i++) {
+                if ((bytes[i] & 0xc0) != 0x80) {
+                    return false;
+                }
+            }
+            memcpy(_partial, bytes + index, length - index);
+            _partialLength = length - index;
+            return true;
+        }
+        uint32_t codePoint;
+        if (!decodeSequence(bytes + index, needed, codePoint)) {
+            return false;
+        }
+        appendCodePoint(_characters, codePoint);
+        index += needed;
+    }
+    return true;
+}
+
+bool WXBundleStreamCore::finish()
+{
+    if (_finished) {
+        return _valid;
+    }
+    _finished = true;
+    if (_partialLength > 0) {
+        _valid = false;
+    }
+    if (!_valid) {
+        closeFile(false);
+        return false;
+    }
+    _md5 = _hash.finish();
+    closeFile(true);
+    return true;
+}
+
+void WXBundleStreamCore::cancel()
+{
+    _finished = true;
+    _valid = false;
+    closeFile(false);
+}
+
+void WXBundleStreamCore::closeFile(bool keep)
+{
+    if (_fd < 0) {
+        return;
+    }
+    ::close(_fd);
+    _fd = -1;
+    if (!keep) {
+        ::unlink(_temporaryPath.c_str());
+        return;
+    }
+
+    std::string path = _directory + "/" + _md5 + kExtension;
+    if (access(path.c_str(), F_OK) == 0) {
+        // the same bundle is cached already, mark it as recently used
+        ::unlink(_temporaryPath.c_str());
+        utimes(path.c_str(), nullptr);
+    } else if (rename(_temporaryPath.c_str(), path.c_str()) != 0) {
+        ::unlink(_temporaryPath.c_str());
+        return;
+    }
+    _cachePath = path;
+    if (_cacheLimit > 0) {
+        trimCache();
+    }
+}
+
+void WXBundleStreamCore::trimCache()
+{
+    struct CachedFile {
+        std::string path;
+        size_t size;
+        time_t time;
+    };
+    std::vector<CachedFile> files;
+    size_t total = 0;
+    DIR *dir = opendir(_directory.c_str());
+    if (!dir) {
+        return;
+    }
+    size_t extensionLength = sizeof(kExtension) - 1;
+    while (struct dirent *item = readdir(dir)) {
+        size_t nameLength = strlen(item->d_name);
+        if (nameLength <= extensionLength || strcmp(item->d_name + nameLength - extensionLength, kExtension) != 0) {
+            continue;
+        }
+        std::string path = _directory + "/" + item->d_name;
+        struct stat info;
+        if (stat(path.c_str(), &info) == 0) {
+            files.push_back({path, (size_t)info.st_size, info.st_mtime});
+            total += (size_t)info.st_size;
+        }
+    }
+    closedir(dir);
+
+    std::sort(files.begin(), files.end(), [](const CachedFile &a, const CachedFile &b) {
+        return a.time < b.time;
+    });
+    for (const CachedFile &file : files) {
+        if (total <= _cacheLimit) {
+            break;
+        }
+        // never the bundle which was just cached
+        if (file.path != _cachePath && ::unlink(file.path.c_str()) == 0) {
+            total -= file.size;
+        }
+    }
+}
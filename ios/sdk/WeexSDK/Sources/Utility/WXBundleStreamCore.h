@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXBundleStreamCore_h
+#define WXBundleStreamCore_h
+
+/*
+ * Processes a JS bundle while it's downloaded, instead of after the last
+ * byte: every chunk is decoded from UTF-8 to UTF-16, added to the MD5 of
+ * the bundle and written to the disk. So when the download finishes, the
+ * bundle is ready to be executed, its hash is known, and it's cached.
+ *
+ * Chunks may split multibyte characters. Malformed UTF-8 invalidates the
+ * stream, like it fails to convert to a string. The cached file is written
+ * to a temporary name, and renamed after the MD5 of the bundle when it
+ * finishes, so equal bundles share one file. When the cached bundles
+ * outgrow the limit, the least recently used ones are removed.
+ *
+ * It's not thread safe, chunks must be appended in order.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class WXMD5 {
+public:
+    WXMD5();
+    void update(const void *bytes, size_t length);
+    // the lowercase hex digest, it can't be updated after
+    std::string finish();
+
+private:
+    uint32_t _state[4];
+    uint64_t _length;
+    uint8_t _buffer[64];
+
+    void transform(const uint8_t *block);
+};
+
+class WXBundleStreamCore {
+public:
+    /*
+     * directory: where the bundle is cached, empty to not cache it.
+     * cacheLimit: the max bytes of the cached bundles, 0 means no limit.
+     */
+    WXBundleStreamCore(const std::string &directory, size_t cacheLimit);
+    ~WXBundleStreamCore();
+
+    // the expected length, to allocate the characters once
+    void reserve(size_t length);
+    // returns false once the stream is invalid
+    bool append(const void *bytes, size_t length);
+    // returns false if the stream is invalid, or ends in the middle of a character
+    bool finish();
+    // drop the stream and its cached file
+    void cancel();
+
+    bool valid() const { return _valid; }
+    // the bundle starts with a byte order mark, which is kept in the characters
+    bool hasByteOrderMark() const { return !_characters.empty() && _characters[0] == 0xfeff; }
+    size_t byteCount() const { return _byteCount; }
+    const std::vector<uint16_t> &characters() const { return _characters; }
+    // available after finish
+    const std::string &md5() const { return _md5; }
+    // the cached file, available after finish, empty if it isn't cached
+    const std::string &cachePath() const { return _cachePath; }
+
+private:
+    std::string _directory;
+    size_t _cacheLimit;
+    std::vector<uint16_t> _characters;
+    WXMD5 _hash;
+    std::string _md5;
+    int _fd;
+    std::string _temporaryPath;
+    std::string _cachePath;
+    size_t _byteCount;
+    bool _valid;
+    bool _finished;
+    // the bytes of a character split by the chunks
+    uint8_t _partial[4];
+    size_t _partialLength;
+
+    bool decode(const uint8_t *bytes, size_t length);
+    void closeFile(bool keep);
+    void trimCache();
+};
+
+#endif /* WXBundleStreamCore_h */
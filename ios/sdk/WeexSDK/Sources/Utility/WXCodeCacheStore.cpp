@@ -0,0 +1,341 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "WXCodeCacheStore.h"
+#include "WXHashCore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * An entry file is the header followed by the payload:
+ *
+ *   char[4] magic          "WXCC"
+ *   u32     format         kFormatVersion
+ *   u64     version hash   of the engine version
+ *   u64     source hash    which names the file
+ *   u64     source check   hash of the source with another seed
+ *   u64     source length
+ *   u64     payload length
+ *   u64     payload hash
+ */
+static const char kMagic[4] = {'W', 'X', 'C', 'C'};
+static const uint32_t kFormatVersion = 1;
+static const size_t kHeaderSize = 56;
+static const uint64_t kCheckSeed = 0x5743434b;
+static const char kExtension[] = ".wxcc";
+
+struct WXCodeCacheHeader {
+    uint64_t versionHash;
+    uint64_t sourceHash;
+    uint64_t sourceCheck;
+    uint64_t sourceLength;
+    uint64_t payloadLength;
+    uint64_t payloadHash;
+};
+
+static void encodeHeader(uint8_t *buffer, const WXCodeCacheHeader &header)
+{
+    memcpy(buffer, kMagic, 4);
+    memcpy(buffer + 4, &kFormatVersion, 4);
+    memcpy(buffer + 8, &header, sizeof(header));
+}
+
+static bool decodeHeader(const uint8_t *buffer, WXCodeCacheHeader &header)
+{
+    uint32_t format;
+    memcpy(&format, buffer + 4, 4);
+    if (memcmp(buffer, kMagic, 4) != 0 || format != kFormatVersion) {
+        return false;
+    }
+    memcpy(&header, buffer + 8, sizeof(header));
+    return true;
+}
+
+static WXCodeCacheHeader headerForSource(const std::string &version, const char *source, size_t length)
+{
+    WXCodeCacheHeader header;
+    header.versionHash = WXHashBytes(version.data(), version.size());
+    header.sourceHash = WXHashBytes(source, length);
+    header.sourceCheck = WXHashBytes(source, length, kCheckSeed);
+    header.sourceLength = length;
+    header.payloadLength = 0;
+    header.payloadHash = 0;
+    return header;
+}
+
+static bool writeFully(int fd, const uint8_t *bytes, size_t length)
+{
+    while (length > 0) {
+        ssize_t written = ::write(fd, bytes, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        length -= written;
+    }
+    return true;
+}
+
+static double modificationTime(const struct stat &info)
+{
+#ifdef __APPLE__
+    return info.st_mtimespec.tv_sec + info.st_mtimespec.tv_nsec / 1e9;
+#else
+    return info.st_mtim.tv_sec + info.st_mtim.tv_nsec / 1e9;
+#endif
+}
+
+WXCodeCacheEntry::WXCodeCacheEntry(void *mapping, size_t mappingLength, size_t offset)
+: _mapping(mapping), _mappingLength(mappingLength), _offset(offset)
+{
+}
+
+WXCodeCacheEntry::~WXCodeCacheEntry()
+{
+    munmap(_mapping, _mappingLength);
+}
+
+WXCodeCacheStore::WXCodeCacheStore(const std::string &directory, size_t capacity)
+: _directory(directory), _capacity(capacity), _metrics()
+{
+}
+
+bool WXCodeCacheStore::ensureDirectory()
+{
+    return mkdir(_directory.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+std::string WXCodeCacheStore::pathForSource(const char *source, size_t length)
+{
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)WXHashBytes(source, length));
+    return _directory + "/" + name + kExtension;
+}
+
+bool WXCodeCacheStore::execute(WXCodeCacheEngine &engine, const char *source, size_t length)
+{
+    std::string version = engine.version();
+    std::unique_ptr<WXCodeCacheEntry> entry = load(version, source, length);
+    if (entry) {
+        if (engine.execute(source, length, entry->data(), entry->size())) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _metrics.hits++;
+            return true;
+        }
+        entry.reset();
+        remove(source, length);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _metrics.rejections++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _metrics.misses++;
+    }
+
+    engine.execute(source, length, nullptr, 0);
+    std::vector<uint8_t> payload;
+    if (engine.produce(source, length, payload) && !payload.empty()) {
+        store(version, source, length, payload.data(), payload.size());
+    }
+    return false;
+}
+
+std::unique_ptr<WXCodeCacheEntry> WXCodeCacheStore::load(const std::string &version, const char *source, size_t length)
+{
+    std::string path = pathForSource(source, length);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat info;
+    void *mapping = MAP_FAILED;
+    size_t mappingLength = 0;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size > kHeaderSize) {
+        mappingLength = (size_t)info.st_size;
+        mapping = mmap(nullptr, mappingLength, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    if (mapping == MAP_FAILED) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const uint8_t *bytes = (const uint8_t *)mapping;
+    WXCodeCacheHeader expected = headerForSource(version, source, length);
+    WXCodeCacheHeader header;
+    bool valid = decodeHeader(bytes, header)
+        && header.versionHash == expected.versionHash
+        && header.sourceHash == expected.sourceHash
+        && header.sourceCheck == expected.sourceCheck
+        && header.sourceLength == expected.sourceLength
+        && header.payloadLength == mappingLength - kHeaderSize
+        // the file may be cut or zero filled if the device lost power after it was renamed
+        && header.payloadHash == WXHashBytes(bytes + kHeaderSize, (size_t)header.payloadLength);
+    if (!valid) {
+        munmap(mapping, mappingLength);
+        ::close(fd);
+        ::unlink(path.c_str());
+        std::lock_guard<std::mutex> lock(_mutex);
+        _metrics.rejections++;
+        return nullptr;
+    }
+
+    // mark it as recently used
+    futimens(fd, nullptr);
+    ::close(fd);
+    return std::unique_ptr<WXCodeCacheEntry>(new WXCodeCacheEntry(mapping, mappingLength, kHeaderSize));
+}
+
+bool WXCodeCacheStore::store(const std::string &version, const char *source, size_t length, const uint8_t *payload, size_t payloadLength)
+{
+    if (!ensureDirectory()) {
+        return false;
+    }
+
+    WXCodeCacheHeader header = headerForSource(version, source, length);
+    header.payloadLength = payloadLength;
+    header.payloadHash = WXHashBytes(payload, payloadLength);
+    uint8_t buffer[kHeaderSize];
+    encodeHeader(buffer, header);
+
+    // a temporary file of its own, so concurrent stores of the same script don't mix
+    static std::atomic<unsigned> counter(0);
+    std::string path = pathForSource(source, length);
+    std::string temporary = path + ".tmp" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool succeeded = writeFully(fd, buffer, kHeaderSize) && writeFully(fd, payload, payloadLength);
+    ::close(fd);
+    if (!succeeded || rename(temporary.c_str(), path.c_str()) != 0) {
+        ::unlink(temporary.c_str());
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _metrics.stores++;
+    }
+    if (_capacity > 0) {
+        trim();
+    }
+    return true;
+}
+
+void WXCodeCacheStore::remove(const char *source, size_t length)
+{
+    ::unlink(pathForSource(source, length).c_str());
+}
+
+struct WXCodeCacheFile {
+    std::string path;
+    size_t size;
+    double time;
+};
+
+static std::vector<WXCodeCacheFile> entryFiles(const std::string &directory)
+{
+    std::vector<WXCodeCacheFile> files;
+    DIR *dir = opendir(directory.c_str());
+    if (!dir) {
+        return files;
+    }
+    size_t extensionLength = sizeof(kExtension) - 1;
+    while (struct dirent *item = readdir(dir)) {
+        size_t nameLength = strlen(item->d_name);
+        if (nameLength <= extensionLength || strcmp(item->d_name + nameLength - extensionLength, kExtension) != 0) {
+            continue;
+        }
+        WXCodeCacheFile file;
+        file.path = directory + "/" + item->d_name;
+        struct stat info;
+        if (stat(file.path.c_str(), &info) != 0) {
+            continue;
+        }
+        file.size = (size_t)info.st_size;
+        file.time = modificationTime(info);
+        files.push_back(file);
+    }
+    closedir(dir);
+    return files;
+}
+
+void WXCodeCacheStore::clear()
+{
+    for (const WXCodeCacheFile &file : entryFiles(_directory)) {
+        ::unlink(file.path.c_str());
+    }
+}
+
+void WXCodeCacheStore::trim()
+{
+    std::vector<WXCodeCacheFile> files = entryFiles(_directory);
+    size_t total = 0;
+    for (const WXCodeCacheFile &file : files) {
+        total += file.size;
+    }
+    if (_capacity == 0 || total <= _capacity) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const WXCodeCacheFile &a, const WXCodeCacheFile &b) {
+        return a.time < b.time;
+    });
+    size_t evictions = 0;
+    for (const WXCodeCacheFile &file : files) {
+        if (total <= _capacity) {
+            break;
+        }
+        if (::unlink(file.path.c_str()) == 0) {
+            total -= file.size;
+            evictions++;
+        }
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _metrics.evictions += evictions;
+}
+
+size_t WXCodeCacheStore::totalSize()
+{
+    size_t total = 0;
+    for (const WXCodeCacheFile &file : entryFiles(_directory)) {
+        total += file.size;
+    }
+    return total;
+}
+
+WXCodeCacheMetrics WXCodeCacheStore::metrics()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _metrics;
+}
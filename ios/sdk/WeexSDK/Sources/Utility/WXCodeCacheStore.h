@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXCodeCacheStore_h
+#define WXCodeCacheStore_h
+
+/*
+ * An on-disk cache of the code a JS engine compiles scripts to, so the next
+ * run executes the bytecode instead of parsing the script again. It only
+ * depends on POSIX file APIs, the engine is plugged in as a
+ * WXCodeCacheEngine.
+ *
+ * Every entry is one file in the directory, named by the hash of the script,
+ * with a versioned header which holds the hashes of the engine version, the
+ * script and the payload. Entries are mapped read only, and a header that
+ * doesn't match, a payload that doesn't match its hash, or a payload the
+ * engine rejects drops the entry, so the script is compiled again. Entries
+ * are written to a temporary file and renamed, so readers never see half of
+ * one. When the entries outgrow the capacity, the least recently used ones
+ * are removed.
+ *
+ * All the methods are thread safe.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class WXCodeCacheEngine {
+public:
+    virtual ~WXCodeCacheEngine() {}
+
+    // identifies the engine and its bytecode format, entries of other versions are not used
+    virtual std::string version() = 0;
+    /*
+     * Executes the script. cache is the payload produced by a previous run, or
+     * null. Returns false if the engine rejected the cache, the script must be
+     * executed anyway then.
+     */
+    virtual bool execute(const char *source, size_t length, const uint8_t *cache, size_t cacheLength) = 0;
+    // the payload for the script executed last, returns false if the engine can't produce it
+    virtual bool produce(const char *source, size_t length, std::vector<uint8_t> &cache) = 0;
+};
+
+// a mapped entry, it's unmapped when destroyed
+class WXCodeCacheEntry {
+public:
+    WXCodeCacheEntry(void *mapping, size_t mappingLength, size_t offset);
+    ~WXCodeCacheEntry();
+    WXCodeCacheEntry(const WXCodeCacheEntry &) = delete;
+    WXCodeCacheEntry &operator=(const WXCodeCacheEntry &) = delete;
+
+    const uint8_t *data() const { return (const uint8_t *)_mapping + _offset; }
+    size_t size() const { return _mappingLength - _offset; }
+
+private:
+    void *_mapping;
+    size_t _mappingLength;
+    size_t _offset;
+};
+
+struct WXCodeCacheMetrics {
+    // the scripts executed with a cached payload
+    size_t hits;
+    // the scripts without a usable entry
+    size_t misses;
+    // entries dropped because they were broken, or the engine rejected them
+    size_t rejections;
+    size_t stores;
+    size_t evictions;
+};
+
+class WXCodeCacheStore {
+public:
+    // capacity: the max bytes of all entries, 0 means no limit
+    WXCodeCacheStore(const std::string &directory, size_t capacity);
+
+    /*
+     * Executes the script with the engine, from the cached payload when there
+     * is a valid one. Otherwise the payload is produced and stored after
+     * the script is executed. Returns true if the cache was hit.
+     */
+    bool execute(WXCodeCacheEngine &engine, const char *source, size_t length);
+
+    // the entry of the script, null if there is none or it's invalid
+    std::unique_ptr<WXCodeCacheEntry> load(const std::string &version, const char *source, size_t length);
+    bool store(const std::string &version, const char *source, size_t length, const uint8_t *payload, size_t payloadLength);
+    void remove(const char *source, size_t length);
+    // remove all the entries
+    void clear();
+    // remove the least recently used entries until they fit the capacity
+    void trim();
+
+    // bytes of all the entry files
+    size_t totalSize();
+    WXCodeCacheMetrics metrics();
+
+    // the file of the script's entry
+    std::string pathForSource(const char *source, size_t length);
+
+private:
+    std::string _directory;
+    size_t _capacity;
+    WXCodeCacheMetrics _metrics;
+    std::mutex _mutex;
+
+    bool ensureDirectory();
+};
+
+#endif /* WXCodeCacheStore_h */
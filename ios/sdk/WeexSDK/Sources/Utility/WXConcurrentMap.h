@@ -0,0 +1,306 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXConcurrentMap_h
+#define WXConcurrentMap_h
+
+/*
+ * A hash map for read-mostly registries, whose reads never take a lock.
+ *
+ * The keys are spread over shards by their hashes. Each shard publishes an
+ * immutable table through an atomic pointer. A write copies the table of its
+ * shard under the lock of the shard, publishes the copy and retires the old
+ * table, which is deleted once no reader may still see it, like RCU does.
+ *
+ * Each thread announces the epoch it reads in with a store to a record of its
+ * own, so readers never write to shared cache lines. Writers don't wait for
+ * them: a retired table is tagged with the epoch it was replaced in, and the
+ * retired tables older than every announced epoch are deleted by the writes
+ * which come later. So lookups cost about one uncontended store and scale
+ * with threads, while a write costs a copy of its shard.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <pthread.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "WXHashCore.h"
+
+class WXReadSideDomain {
+public:
+    // the read side record of a thread
+    struct Reader {
+        // the epoch the thread reads in, 0 outside of reads
+        std::atomic<uint64_t> epoch;
+        // reads of the thread nested in each other, only the outermost announces itself
+        unsigned depth;
+        std::atomic<bool> used;
+        Reader *next;
+        // a cache line each, so that readers don't contend
+        char padding[64];
+    };
+
+    static WXReadSideDomain &shared()
+    {
+        static WXReadSideDomain *domain = new WXReadSideDomain();
+        return *domain;
+    }
+
+    // returns the record to pass to unlock
+    Reader *lock()
+    {
+        Reader *reader = static_cast<Reader *>(pthread_getspecific(_key));
+        if (!reader) {
+            reader = acquireReader();
+        }
+        if (reader->depth++ == 0) {
+            // sequentially consistent, so the tables are loaded after the announcement
+            reader->epoch.store(_epoch.load());
+        }
+        return reader;
+    }
+
+    void unlock(Reader *reader)
+    {
+        if (--reader->depth == 0) {
+            reader->epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    // deletes the data once the readers which may see it have left, it must
+    // be unpublished already. It doesn't wait, what can't be deleted yet is
+    // deleted by a later call.
+    void retire(std::function<void()> deleter)
+    {
+        std::vector<std::function<void()>> deleters;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            // the readers which announce a later epoch load the data after it was unpublished
+            _retired.emplace_back(_epoch.fetch_add(1), std::move(deleter));
+            uint64_t oldest = UINT64_MAX;
+            for (Reader *reader = _readers.load(); reader; reader = reader->next) {
+                uint64_t epoch = reader->epoch.load();
+                if (epoch != 0 && epoch < oldest) {
+                    oldest = epoch;
+                }
+            }
+            auto kept = _retired.begin();
+            for (auto it = _retired.begin(); it != _retired.end(); ++it) {
+                if (it->first < oldest) {
+                    deleters.push_back(std::move(it->second));
+                } else {
+                    *kept++ = std::move(*it);
+                }
+            }
+            _retired.erase(kept, _retired.end());
+        }
+        // the data may release objects which write to the maps
+        for (auto &deleter : deleters) {
+            deleter();
+        }
+    }
+
+private:
+    std::atomic<uint64_t> _epoch;
+    std::atomic<Reader *> _readers;
+    pthread_key_t _key;
+    std::mutex _mutex;
+    std::vector<std::pair<uint64_t, std::function<void()>>> _retired;
+
+    WXReadSideDomain() : _epoch(1), _readers(nullptr)
+    {
+        pthread_key_create(&_key, releaseReader);
+    }
+
+    // the records of exited threads are reused, they are never freed
+    Reader *acquireReader()
+    {
+        Reader *reader = _readers.load();
+        for (; reader; reader = reader->next) {
+            bool used = false;
+            if (!reader->used.load() && reader->used.compare_exchange_strong(used, true)) {
+                break;
+            }
+        }
+        if (!reader) {
+            reader = new Reader();
+            reader->epoch.store(0);
+            reader->depth = 0;
+            reader->used.store(true);
+            reader->next = _readers.load();
+            while (!_readers.compare_exchange_weak(reader->next, reader)) {
+            }
+        }
+        pthread_setspecific(_key, reader);
+        return reader;
+    }
+
+    static void releaseReader(void *value)
+    {
+        Reader *reader = static_cast<Reader *>(value);
+        reader->depth = 0;
+        reader->epoch.store(0);
+        reader->used.store(false);
+    }
+};
+
+template <class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>, size_t ShardCount = 8>
+class WXConcurrentMap {
+public:
+    typedef std::unordered_map<Key, Value, Hash, Equal> Table;
+
+    WXConcurrentMap() : _domain(WXReadSideDomain::shared())
+    {
+        for (Shard &shard : _shards) {
+            shard.table.store(nullptr);
+            shard.size.store(0);
+        }
+    }
+
+    ~WXConcurrentMap()
+    {
+        for (Shard &shard : _shards) {
+            delete shard.table.load();
+        }
+    }
+
+    WXConcurrentMap(const WXConcurrentMap &) = delete;
+    WXConcurrentMap &operator=(const WXConcurrentMap &) = delete;
+
+    bool find(const Key &key, Value &value) const
+    {
+        const Shard &shard = shardOf(key);
+        WXReadSideDomain::Reader *reader = _domain.lock();
+        const Table *table = shard.table.load();
+        bool found = false;
+        if (table) {
+            auto it = table->find(key);
+            if (it != table->end()) {
+                value = it->second;
+                found = true;
+            }
+        }
+        _domain.unlock(reader);
+        return found;
+    }
+
+    void set(const Key &key, const Value &value)
+    {
+        update(key, [&](Table &table) {
+            table[key] = value;
+            return true;
+        });
+    }
+
+    bool erase(const Key &key)
+    {
+        return update(key, [&](Table &table) {
+            return table.erase(key) > 0;
+        });
+    }
+
+    void clear()
+    {
+        for (Shard &shard : _shards) {
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            const Table *table = shard.table.exchange(nullptr);
+            shard.size.store(0);
+            lock.unlock();
+            retire(table);
+        }
+    }
+
+    size_t size() const
+    {
+        size_t size = 0;
+        for (const Shard &shard : _shards) {
+            size += shard.size.load();
+        }
+        return size;
+    }
+
+    // calls function(key, value) for the entries of a snapshot of each shard
+    template <class Function>
+    void forEach(Function function) const
+    {
+        for (const Shard &shard : _shards) {
+            WXReadSideDomain::Reader *reader = _domain.lock();
+            const Table *table = shard.table.load();
+            if (table) {
+                for (const auto &entry : *table) {
+                    function(entry.first, entry.second);
+                }
+            }
+            _domain.unlock(reader);
+        }
+    }
+
+private:
+    struct Shard {
+        std::atomic<const Table *> table;
+        std::atomic<size_t> size;
+        std::mutex mutex;
+    };
+
+    WXReadSideDomain &_domain;
+    Shard _shards[ShardCount];
+
+    const Shard &shardOf(const Key &key) const
+    {
+        return _shards[WXHashMix(Hash()(key)) % ShardCount];
+    }
+
+    template <class Mutation>
+    bool update(const Key &key, Mutation mutation)
+    {
+        Shard &shard = const_cast<Shard &>(shardOf(key));
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        const Table *table = shard.table.load();
+        Table *copy = table ? new Table(*table) : new Table();
+        if (!mutation(*copy)) {
+            lock.unlock();
+            delete copy;
+            return false;
+        }
+        shard.size.store(copy->size());
+        shard.table.store(copy);
+        // destroying the values may release objects which write to this map,
+        // so the old table is only retired once the shard is unlocked
+        lock.unlock();
+        retire(table);
+        return true;
+    }
+
+    void retire(const Table *table)
+    {
+        if (table) {
+            _domain.retire([table] {
+                delete table;
+            });
+        }
+    }
+};
+
+#endif /* WXConcurrentMap_h */
@@ -29,6 +29,8 @@
 
 + (BOOL)BOOL:(id)value;
 + (CGFloat)CGFloat:(id)value;
+// top, right, bottom or left, the inset of the safe area of the top instance
++ (CGFloat)safeAreaInset:(NSString *)value;
 + (NSUInteger)NSUInteger:(id)value;
 + (NSInteger)NSInteger:(id)value;
 + (NSString *)NSString:(id)value;
@@ -0,0 +1,364 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef WXDiffCore_h
+#define WXDiffCore_h
+
+/*
+ * A portable list diff, it doesn't depend on Foundation so it can be built
+ * and benchmarked on any platform.
+ *
+ * The longest common subsequence of the two lists is found in linear space:
+ *  - the common prefix and suffix are skipped first;
+ *  - if the items have hashes and the matching pairs are sparse (keyed
+ *    items, as most list data), Hunt-Szymanski is used, O((n + r) log n);
+ *  - otherwise Myers' bisection, O((n + m) * d) time and O(n + m) space.
+ * The unmatched items between two matches are paired as updates, equal
+ * items which changed position are reported as moves.
+ *
+ * Without hashes the diff is a degraded fallback: Myers' bisection is still
+ * quadratic when the lists barely match, and moves are only searched while
+ * the unmatched old items times the unmatched new items stay within
+ * kMaxMoveComparisons (65536), beyond that moved items are reported as
+ * deletes and inserts. The same lists may therefore give a different edit
+ * script with and without hashes, pass them whenever the items have one.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+struct WXDiffCorePair {
+    size_t oldIndex;
+    size_t newIndex;
+};
+
+struct WXDiffCoreResult {
+    // indexes in the new list
+    std::vector<size_t> inserts;
+    // indexes in the old list
+    std::vector<size_t> deletes;
+    // items replaced in place
+    std::vector<WXDiffCorePair> updates;
+    // equal items which changed position, they are in deletes and inserts too
+    std::vector<WXDiffCorePair> moves;
+};
+
+template <class Equal>
+class WXDiffCore {
+public:
+    /*
+     * equal(oldIndex, newIndex) compares two items. The hashes are optional,
+     * equal items must have equal hashes. Without them moves are only found
+     * in small lists, see kMaxMoveComparisons.
+     */
+    WXDiffCore(size_t oldCount, size_t newCount, Equal equal, const uint64_t *oldHashes = NULL, const uint64_t *newHashes = NULL)
+    : _oldCount(oldCount), _newCount(newCount), _equal(equal), _oldHashes(oldHashes), _newHashes(newHashes) {}
+
+    WXDiffCoreResult diff()
+    {
+        _matches.clear();
+        diffRange(0, _oldCount, 0, _newCount);
+
+        WXDiffCoreResult result;
+        std::vector<bool> oldMatched(_oldCount, false);
+        std::vector<bool> newMatched(_newCount, false);
+        for (const WXDiffCorePair &match : _matches) {
+            oldMatched[match.oldIndex] = newMatched[match.newIndex] = true;
+        }
+        findMoves(oldMatched, newMatched, result.moves);
+        for (const WXDiffCorePair &move : result.moves) {
+            result.deletes.push_back(move.oldIndex);
+            result.inserts.push_back(move.newIndex);
+        }
+
+        // pair the remaining items between two matches
+        size_t oldIndex = 0, newIndex = 0;
+        for (size_t i = 0; i <= _matches.size(); i++) {
+            size_t oldEnd = i < _matches.size() ? _matches[i].oldIndex : _oldCount;
+            size_t newEnd = i < _matches.size() ? _matches[i].newIndex : _newCount;
+            while (oldIndex < oldEnd || newIndex < newEnd) {
+                while (oldIndex < oldEnd && oldMatched[oldIndex]) {
+                    oldIndex++;
+                }
+                while (newIndex < newEnd && newMatched[newIndex]) {
+                    newIndex++;
+                }
+                if (oldIndex < oldEnd && newIndex < newEnd) {
+                    result.updates.push_back({oldIndex++, newIndex++});
+                } else if (oldIndex < oldEnd) {
+                    result.deletes.push_back(oldIndex++);
+                } else if (newIndex < newEnd) {
+                    result.inserts.push_back(newIndex++);
+                }
+            }
+            oldIndex = oldEnd + 1;
+            newIndex = newEnd + 1;
+        }
+        std::sort(result.deletes.begin(), result.deletes.end());
+        std::sort(result.inserts.begin(), result.inserts.end());
+        return result;
+    }
+
+    // the longest common subsequence found by the last diff
+    const std::vector<WXDiffCorePair> &matches() const { return _matches; }
+
+private:
+    // Hunt-Szymanski is only used when the matching pairs are this sparse
+    static const size_t kSparseFactor = 4;
+    // moves of items without hashes are only searched in small lists, the
+    // nested search is quadratic in the unmatched items
+    static const size_t kMaxMoveComparisons = 1 << 16;
+
+    size_t _oldCount;
+    size_t _newCount;
+    Equal _equal;
+    const uint64_t *_oldHashes;
+    const uint64_t *_newHashes;
+    std::vector<WXDiffCorePair> _matches;
+
+    bool isEqual(size_t oldIndex, size_t newIndex)
+    {
+        if (_oldHashes && _oldHashes[oldIndex] != _newHashes[newIndex]) {
+            return false;
+        }
+        return _equal(oldIndex, newIndex);
+    }
+
+    void diffRange(size_t oldBegin, size_t oldEnd, size_t newBegin, size_t newEnd)
+    {
+        while (oldBegin < oldEnd && newBegin < newEnd && isEqual(oldBegin, newBegin)) {
+            _matches.push_back({oldBegin++, newBegin++});
+        }
+        size_t suffix = 0;
+        while (oldBegin < oldEnd - suffix && newBegin < newEnd - suffix && isEqual(oldEnd - suffix - 1, newEnd - suffix - 1)) {
+            suffix++;
+        }
+        oldEnd -= suffix;
+        newEnd -= suffix;
+
+        if (oldBegin < oldEnd && newBegin < newEnd) {
+            if (!(_oldHashes && diffSparse(oldBegin, oldEnd, newBegin, newEnd))) {
+                bisect(oldBegin, oldEnd, newBegin, newEnd);
+            }
+        }
+
+        for (size_t i = 0; i < suffix; i++) {
+            _matches.push_back({oldEnd + i, newEnd + i});
+        }
+    }
+
+    /*
+     * Hunt-Szymanski: the longest common subsequence is the longest strictly
+     * increasing subsequence of the matching new indexes, listed in reverse
+     * order for each old item. Returns false if the matches are too dense.
+     */
+    bool diffSparse(size_t oldBegin, size_t oldEnd, size_t newBegin, size_t newEnd)
+    {
+        std::unordered_map<uint64_t, std::vector<size_t>> positions;
+        positions.reserve(newEnd - newBegin);
+        for (size_t newIndex = newBegin; newIndex < newEnd; newIndex++) {
+            positions[_newHashes[newIndex]].push_back(newIndex);
+        }
+
+        size_t budget = kSparseFactor * (oldEnd - oldBegin + newEnd - newBegin);
+        size_t candidates = 0;
+        for (size_t oldIndex = oldBegin; oldIndex < oldEnd; oldIndex++) {
+            auto found = positions.find(_oldHashes[oldIndex]);
+            if (found != positions.end() && (candidates += found->second.size()) > budget) {
+                return false;
+            }
+        }
+
+        struct Node {
+            WXDiffCorePair pair;
+            ptrdiff_t previous;
+        };
+        std::vector<Node> nodes;
+        nodes.reserve(candidates);
+        std::vector<size_t> tails;
+        std::vector<ptrdiff_t> tailNodes;
+        for (size_t oldIndex = oldBegin; oldIndex < oldEnd; oldIndex++) {
+            auto found = positions.find(_oldHashes[oldIndex]);
+            if (found == positions.end()) {
+                continue;
+            }
+            const std::vector<size_t> &list = found->second;
+            for (auto it = list.rbegin(); it != list.rend(); ++it) {
+                if (!_equal(oldIndex, *it)) {
+                    continue;
+                }
+                size_t length = std::lower_bound(tails.begin(), tails.end(), *it) - tails.begin();
+                nodes.push_back({{oldIndex, *it}, length > 0 ? tailNodes[length - 1] : -1});
+                if (length == tails.size()) {
+                    tails.push_back(*it);
+                    tailNodes.push_back(nodes.size() - 1);
+                } else {
+                    tails[length] = *it;
+                    tailNodes[length] = nodes.size() - 1;
+                }
+            }
+        }
+
+        size_t start = _matches.size();
+        for (ptrdiff_t node = tailNodes.empty() ? -1 : tailNodes.back(); node >= 0; node = nodes[node].previous) {
+            _matches.push_back(nodes[node].pair);
+        }
+        std::reverse(_matches.begin() + start, _matches.end());
+        return true;
+    }
+
+    /*
+     * Myers' bisection, find the middle of the shortest edit path, and diff
+     * the two halves separately.
+     * "An O(ND) Difference Algorithm and Its Variations", Eugene W. Myers
+     */
+    void bisect(size_t oldBegin, size_t oldEnd, size_t newBegin, size_t newEnd)
+    {
+        const ptrdiff_t n = oldEnd - oldBegin;
+        const ptrdiff_t m = newEnd - newBegin;
+        const ptrdiff_t maxD = (n + m + 1) / 2;
+        const ptrdiff_t offset = maxD;
+        const ptrdiff_t delta = n - m;
+        const bool front = (delta & 1) != 0;
+        std::vector<ptrdiff_t> forward(2 * maxD + 2, -1);
+        std::vector<ptrdiff_t> backward(2 * maxD + 2, -1);
+        forward[offset + 1] = backward[offset + 1] = 0;
+
+        // trim the diagonals which run out of the edit graph
+        ptrdiff_t k1Start = 0, k1End = 0, k2Start = 0, k2End = 0;
+        for (ptrdiff_t d = 0; d < maxD; d++) {
+            for (ptrdiff_t k1 = -d + k1Start; k1 <= d - k1End; k1 += 2) {
+                ptrdiff_t k1Offset = offset + k1;
+                ptrdiff_t x1 = (k1 == -d || (k1 != d && forward[k1Offset - 1] < forward[k1Offset + 1])) ? forward[k1Offset + 1] : forward[k1Offset - 1] + 1;
+                ptrdiff_t y1 = x1 - k1;
+                while (x1 < n && y1 < m && isEqual(oldBegin + x1, newBegin + y1)) {
+                    x1++;
+                    y1++;
+                }
+                forward[k1Offset] = x1;
+                if (x1 > n) {
+                    k1End += 2;
+                } else if (y1 > m) {
+                    k1Start += 2;
+                } else if (front) {
+                    ptrdiff_t k2Offset = offset + delta - k1;
+                    if (k2Offset >= 0 && k2Offset < 2 * maxD + 2 && backward[k2Offset] != -1 && x1 >= n - backward[k2Offset]) {
+                        split(oldBegin, oldEnd, newBegin, newEnd, x1, y1);
+                        return;
+                    }
+                }
+            }
+
+            for (ptrdiff_t k2 = -d + k2Start; k2 <= d - k2End; k2 += 2) {
+                ptrdiff_t k2Offset = offset + k2;
+                ptrdiff_t x2 = (k2 == -d || (k2 != d && backward[k2Offset - 1] < backward[k2Offset + 1])) ? backward[k2Offset + 1] : backward[k2Offset - 1] + 1;
+                ptrdiff_t y2 = x2 - k2;
+                while (x2 < n && y2 < m && isEqual(oldEnd - x2 - 1, newEnd - y2 - 1)) {
+                    x2++;
+                    y2++;
+                }
+                backward[k2Offset] = x2;
+                if (x2 > n) {
+                    k2End += 2;
+                } else if (y2 > m) {
+                    k2Start += 2;
+                } else if (!front) {
+                    ptrdiff_t k1Offset = offset + delta - k2;
+                    if (k1Offset >= 0 && k1Offset < 2 * maxD + 2 && forward[k1Offset] != -1) {
+                        ptrdiff_t x1 = forward[k1Offset];
+                        ptrdiff_t y1 = offset + x1 - k1Offset;
+                        if (x1 >= n - x2) {
+                            split(oldBegin, oldEnd, newBegin, newEnd, x1, y1);
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+        // no common item
+    }
+
+    void split(size_t oldBegin, size_t oldEnd, size_t newBegin, size_t newEnd, ptrdiff_t x, ptrdiff_t y)
+    {
+        diffRange(oldBegin, oldBegin + x, newBegin, newBegin + y);
+        diffRange(oldBegin + x, oldEnd, newBegin + y, newEnd);
+    }
+
+    void findMoves(std::vector<bool> &oldMatched, std::vector<bool> &newMatched, std::vector<WXDiffCorePair> &moves)
+    {
+        std::vector<size_t> oldRest, newRest;
+        for (size_t i = 0; i < _oldCount; i++) {
+            if (!oldMatched[i]) {
+                oldRest.push_back(i);
+            }
+        }
+        for (size_t i = 0; i < _newCount; i++) {
+            if (!newMatched[i]) {
+                newRest.push_back(i);
+            }
+        }
+        if (oldRest.empty() || newRest.empty()) {
+            return;
+        }
+
+        if (_oldHashes) {
+            std::unordered_multimap<uint64_t, size_t> positions;
+            for (size_t newIndex : newRest) {
+                positions.insert({_newHashes[newIndex], newIndex});
+            }
+            for (size_t oldIndex : oldRest) {
+                auto range = positions.equal_range(_oldHashes[oldIndex]);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (_equal(oldIndex, it->second)) {
+                        moves.push_back({oldIndex, it->second});
+                        positions.erase(it);
+                        break;
+                    }
+                }
+            }
+        } else if (oldRest.size() * newRest.size() <= kMaxMoveComparisons) {
+            std::vector<bool> newMoved(_newCount, false);
+            for (size_t oldIndex : oldRest) {
+                for (size_t newIndex : newRest) {
+                    if (!newMoved[newIndex] && _equal(oldIndex, newIndex)) {
+                        newMoved[newIndex] = true;
+                        moves.push_back({oldIndex, newIndex});
+                        break;
+                    }
+                }
+            }
+        }
+
+        // moved items are not paired as updates
+        for (const WXDiffCorePair &move : moves) {
+            oldMatched[move.oldIndex] = newMatched[move.newIndex] = true;
+        }
+    }
+};
+
+template <class Equal>
+WXDiffCoreResult WXDiffCompute(size_t oldCount, size_t newCount, Equal equal, const uint64_t *oldHashes = NULL, const uint64_t *newHashes = NULL)
+{
+    return WXDiffCore<Equal>(oldCount, newCount, equal, oldHashes, newHashes).diff();
+}
+
+#endif /* WXDiffCore_h */
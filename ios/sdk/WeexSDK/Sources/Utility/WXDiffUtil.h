@@ -23,6 +23,15 @@
 
 - (BOOL)weex_isEqualTo:(id<WXDiffable>)object;
 
+@optional
+
+/**
+ * A hash to reject unequal items quickly, equal items must have equal hashes.
+ * Lists are diffed in near linear time if all of their items implement it,
+ * otherwise the diff may be quadratic and only finds moves in small lists.
+ */
+- (NSUInteger)weex_diffHash;
+
 @end
 
 @interface WXDiffUpdateIndex : NSObject
@@ -37,6 +46,10 @@
 @property (nonatomic, strong, readonly) NSIndexSet *inserts;
 @property (nonatomic, strong, readonly) NSIndexSet *deletes;
 @property (nonatomic, strong, readonly) NSArray<WXDiffUpdateIndex *> *updates;
+/**
+ * Equal items which changed their positions, they are in inserts and deletes as well.
+ */
+@property (nonatomic, strong, readonly) NSArray<WXDiffUpdateIndex *> *moves;
 
 - (BOOL)hasChanges;
 
@@ -44,6 +57,11 @@
                         deletes:(NSIndexSet *)deletes
                         updates:(NSArray<WXDiffUpdateIndex *> *)updates;
 
+- (instancetype)initWithInserts:(NSIndexSet *)inserts
+                        deletes:(NSIndexSet *)deletes
+                        updates:(NSArray<WXDiffUpdateIndex *> *)updates
+                          moves:(NSArray<WXDiffUpdateIndex *> *)moves;
+
 @end
 
 @interface WXDiffUtil : NSObject
@@ -0,0 +1,310 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ * 
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#import "WXDiffUtil.h"
+#import "WXDiffCore.h"
+#import "WXHashCore.h"
+#import <objc/runtime.h>
+#include <vector>
+
+@implementation WXDiffUpdateIndex
+
+- (instancetype)initWithOldIndex:(NSUInteger)oldIndex newIndex:(NSUInteger)newIndex
+{
+    if (self = [super init]) {
+        _oldIndex = oldIndex;
+        _newIndex = newIndex;
+    }
+    
+    return self;
+}
+
+@end
+
+@implementation WXDiffResult
+
+- (instancetype)initWithInserts:(NSIndexSet *)inserts
+                        deletes:(NSIndexSet *)deletes
+                        updates:(NSArray<WXDiffUpdateIndex *> *)updates
+{
+    return [self initWithInserts:inserts deletes:deletes updates:updates moves:nil];
+}
+
+- (instancetype)initWithInserts:(NSIndexSet *)inserts
+                        deletes:(NSIndexSet *)deletes
+                        updates:(NSArray<WXDiffUpdateIndex *> *)updates
+                          moves:(NSArray<WXDiffUpdateIndex *> *)moves
+{
+    if (self = [super init]) {
+        _inserts = [inserts copy];
+        _deletes = [deletes copy];
+        _updates = [updates copy];
+        _moves = [moves copy];
+    }
+    
+    return self;
+}
+
+- (BOOL)hasChanges
+{
+    return _updates.count > 0 || _inserts.count > 0 || _deletes.count > 0;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; %zi inserts; %zi deletes; %zi updates; %zi moves", NSStringFromClass([self class]), self, _inserts.count, _deletes.count, _updates.count, _moves.count];
+}
+
+
+@end
+
+@implementation WXDiffUtil
+
++ (WXDiffResult *)diffWithMinimumDistance:(NSArray<id<WXDiffable>> *)newArray oldArray:(NSArray<id<WXDiffable>> *)oldArray
+{
+    // Find the longest common subsequence in linear space instead of filling
+    // a levenshtein matrix, see WXDiffCore.h
+    NSUInteger oldCount = oldArray.count;
+    NSUInteger newCount = newArray.count;
+    
+    std::vector<uint64_t> oldHashes;
+    std::vector<uint64_t> newHashes;
+    BOOL hashed = [self _hashes:oldHashes ofArray:oldArray] && [self _hashes:newHashes ofArray:newArray];
+    
+    // the arrays retain the items during the diff
+    std::vector<__unsafe_unretained id<WXDiffable>> oldItems(oldCount);
+    std::vector<__unsafe_unretained id<WXDiffable>> newItems(newCount);
+    [oldArray getObjects:oldItems.data() range:NSMakeRange(0, oldCount)];
+    [newArray getObjects:newItems.data() range:NSMakeRange(0, newCount)];
+    
+    auto equal = [&oldItems, &newItems](size_t oldIndex, size_t newIndex) -> bool {
+        return [oldItems[oldIndex] weex_isEqualTo:newItems[newIndex]];
+    };
+    WXDiffCoreResult coreResult = WXDiffCompute(oldCount, newCount, equal, hashed ? oldHashes.data() : NULL, hashed ? newHashes.data() : NULL);
+    
+    NSMutableIndexSet *inserts = [NSMutableIndexSet indexSet];
+    for (size_t index : coreResult.inserts) {
+        [inserts addIndex:index];
+    }
+    NSMutableIndexSet *deletes = [NSMutableIndexSet indexSet];
+    for (size_t index : coreResult.deletes) {
+        [deletes addIndex:index];
+    }
+    NSMutableArray *updates = [NSMutableArray arrayWithCapacity:coreResult.updates.size()];
+    for (const WXDiffCorePair &update : coreResult.updates) {
+        [updates addObject:[[WXDiffUpdateIndex alloc] initWithOldIndex:update.oldIndex newIndex:update.newIndex]];
+    }
+    NSMutableArray *moves = [NSMutableArray arrayWithCapacity:coreResult.moves.size()];
+    for (const WXDiffCorePair &move : coreResult.moves) {
+        [moves addObject:[[WXDiffUpdateIndex alloc] initWithOldIndex:move.oldIndex newIndex:move.newIndex]];
+    }
+    
+    WXDiffResult *result = [[WXDiffResult alloc] initWithInserts:inserts deletes:deletes updates:updates moves:moves];
+    return result;
+}
+
++ (BOOL)_hashes:(std::vector<uint64_t> &)hashes ofArray:(NSArray<id<WXDiffable>> *)array
+{
+    hashes.reserve(array.count);
+    for (id<WXDiffable> item in array) {
+        if (![item respondsToSelector:@selector(weex_diffHash)]) {
+            return NO;
+        }
+        hashes.push_back([item weex_diffHash]);
+    }
+    return YES;
+}
+
+@end
+
+static const void *WXDiffHashKey = &WXDiffHashKey;
+
+static NSUInteger WXDiffHashOfObject(id object)
+{
+    if ([object respondsToSelector:@selector(weex_diffHash)]) {
+        return [object weex_diffHash];
+    }
+    return [object hash];
+}
+
+// hashes an item of a container, which is only frozen if the containers nested in it are frozen too
+static NSUInteger WXDiffHashOfItem(id item, BOOL *frozen)
+{
+    NSUInteger hash = WXDiffHashOfObject(item);
+    if (([item isKindOfClass:[NSArray class]] || [item isKindOfClass:[NSDictionary class]]) && !objc_getAssociatedObject(item, WXDiffHashKey)) {
+        *frozen = NO;
+    }
+    return hash;
+}
+
+// the hashes of frozen containers, immutable ones without mutable containers nested in them,
+// are computed once and kept with them
+static NSUInteger WXCachedDiffHash(id container, BOOL isMutable, NSUInteger (^compute)(BOOL *frozen))
+{
+    BOOL frozen = !isMutable;
+    if (frozen) {
+        NSNumber *cached = objc_getAssociatedObject(container, WXDiffHashKey);
+        if (cached) {
+            return [cached unsignedIntegerValue];
+        }
+    }
+    NSUInteger hash = compute(&frozen);
+    if (frozen) {
+        objc_setAssociatedObject(container, WXDiffHashKey, @(hash), OBJC_ASSOCIATION_RETAIN);
+    }
+    return hash;
+}
+
+// compare the cached hashes only, never compute them here
+static BOOL WXDiffHashesDiffer(id object1, id object2)
+{
+    NSNumber *hash1 = objc_getAssociatedObject(object1, WXDiffHashKey);
+    NSNumber *hash2 = hash1 ? objc_getAssociatedObject(object2, WXDiffHashKey) : nil;
+    return hash1 && hash2 && ![hash1 isEqualToNumber:hash2];
+}
+
+@implementation NSNumber (WXDiffable)
+
+- (BOOL)weex_isEqualTo:(id<WXDiffable>)object
+{
+    return [self isEqual:object];
+}
+
+- (NSUInteger)weex_diffHash
+{
+    return (NSUInteger)WXHashMix(WXHashTypeNumber ^ [self hash]);
+}
+
+@end
+
+@implementation NSString (WXDiffable)
+
+- (BOOL)weex_isEqualTo:(id<WXDiffable>)object
+{
+    return [self isEqual:object];
+}
+
+- (NSUInteger)weex_diffHash
+{
+    // -[NSString hash] only looks at the beginning and the end of long strings
+    NSUInteger length = self.length;
+    const UniChar *characters = CFStringGetCharactersPtr((__bridge CFStringRef)self);
+    if (characters) {
+        return (NSUInteger)WXHashBytes(characters, length * sizeof(UniChar), WXHashTypeString);
+    }
+    std::vector<UniChar> buffer(length);
+    [self getCharacters:buffer.data() range:NSMakeRange(0, length)];
+    return (NSUInteger)WXHashBytes(buffer.data(), length * sizeof(UniChar), WXHashTypeString);
+}
+
+@end
+
+@implementation NSArray (WXDiffable)
+
+- (BOOL)weex_isEqualTo:(id<WXDiffable>)object
+{
+    if (self == object) {
+        return YES;
+    }
+    
+    if (![object isKindOfClass:[NSArray class]]) {
+        return NO;
+    }
+    
+    NSArray *array = (NSArray *)object;
+    if (self.count != array.count || WXDiffHashesDiffer(self, array)) {
+        return NO;
+    }
+    
+    __block BOOL isEqual = YES;
+    [array enumerateObjectsUsingBlock:^(id  _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
+        id obj2 = [self objectAtIndex:idx];
+        if ([obj conformsToProtocol:@protocol(WXDiffable)] && [obj2 conformsToProtocol:@protocol(WXDiffable)]) {
+            if (![obj weex_isEqualTo:obj2]) {
+                isEqual = NO;
+                *stop = YES;
+            }
+        } else {
+            isEqual = NO;
+            *stop = YES;
+        }
+    }];
+    
+    return isEqual;
+}
+
+- (NSUInteger)weex_diffHash
+{
+    return WXCachedDiffHash(self, [self isKindOfClass:[NSMutableArray class]], ^NSUInteger(BOOL *frozen) {
+        WXHasher hasher(WXHashTypeArray);
+        for (id item in self) {
+            hasher.add(WXDiffHashOfItem(item, frozen));
+        }
+        return (NSUInteger)hasher.finish();
+    });
+}
+
+@end
+
+@implementation NSDictionary (WXDiffable)
+
+- (BOOL)weex_isEqualTo:(id<WXDiffable>)object
+{
+    if (self == object) {
+        return YES;
+    }
+    
+    if (![object isKindOfClass:[NSDictionary class]]) {
+        return NO;
+    }
+    
+    NSDictionary *dictionary = (NSDictionary *)object;
+    if (self.count != dictionary.count || WXDiffHashesDiffer(self, dictionary)) {
+        return NO;
+    }
+    
+    __block BOOL isEqual = YES;
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+        id obj2 = [self objectForKey:key];
+        if (obj2 && [obj2 conformsToProtocol:@protocol(WXDiffable)] && [obj conformsToProtocol:@protocol(WXDiffable)]) {
+            if (![obj weex_isEqualTo:obj2]) {
+                isEqual = NO;
+                *stop = YES;
+            }
+        } else {
+            isEqual = NO;
+            *stop = YES;
+        }
+    }];
+    
+    return isEqual;
+}
+
+- (NSUInteger)weex_diffHash
+{
+    return WXCachedDiffHash(self, [self isKindOfClass:[NSMutableDictionary class]], ^NSUInteger(BOOL *frozen) {
+        __block WXHasher hasher(WXHashTypeDictionary);
+        [self enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+            hasher.addEntry(WXDiffHashOfObject(key), WXDiffHashOfItem(obj, frozen));
+        }];
+        return (NSUInteger)hasher.finish();
+    });
+}
+
+@end
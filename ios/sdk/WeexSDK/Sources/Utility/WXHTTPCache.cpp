@@ -0,0 +1,468 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "WXHTTPCache.h"
+#include "WXBundleStreamCore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+static const int kFormatVersion = 1;
+// the heuristic lifetime of responses with Last-Modified only is capped to a day
+static const double kMaxHeuristicLifetime = 24 * 60 * 60;
+
+const std::string *WXHTTPHeaderValue(const WXHTTPHeaders &headers, const char *name)
+{
+    for (const auto &header : headers) {
+        if (strcasecmp(header.first.c_str(), name) == 0) {
+            return &header.second;
+        }
+    }
+    return nullptr;
+}
+
+static std::string trim(const std::string &value)
+{
+    size_t start = value.find_first_not_of(" \t");
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = value.find_last_not_of(" \t");
+    return value.substr(start, end - start + 1);
+}
+
+static double parseSeconds(const std::string &value)
+{
+    char *end = nullptr;
+    double seconds = strtod(value.c_str(), &end);
+    return end != value.c_str() && seconds >= 0 ? seconds : -1;
+}
+
+WXCacheControl WXParseCacheControl(const std::string &value)
+{
+    WXCacheControl control = {false, false, false, false, -1, -1};
+    size_t start = 0;
+    while (start <= value.size()) {
+        size_t end = value.find(',', start);
+        if (end == std::string::npos) {
+            end = value.size();
+        }
+        std::string directive = trim(value.substr(start, end - start));
+        std::string argument;
+        size_t equal = directive.find('=');
+        if (equal != std::string::npos) {
+            argument = trim(directive.substr(equal + 1));
+            if (argument.size() >= 2 && argument.front() == '"' && argument.back() == '"') {
+                argument = argument.substr(1, argument.size() - 2);
+            }
+            directive = trim(directive.substr(0, equal));
+        }
+
+        const char *name = directive.c_str();
+        if (strcasecmp(name, "no-store") == 0) {
+            control.noStore = true;
+        } else if (strcasecmp(name, "no-cache") == 0) {
+            control.noCache = true;
+        } else if (strcasecmp(name, "must-revalidate") == 0 || strcasecmp(name, "proxy-revalidate") == 0) {
+            control.mustRevalidate = true;
+        } else if (strcasecmp(name, "immutable") == 0) {
+            control.immutable = true;
+        } else if (strcasecmp(name, "max-age") == 0) {
+            control.maxAge = parseSeconds(argument);
+        } else if (strcasecmp(name, "stale-while-revalidate") == 0) {
+            control.staleWhileRevalidate = parseSeconds(argument);
+        }
+        start = end + 1;
+    }
+    return control;
+}
+
+bool WXParseHTTPDate(const std::string &value, double &time)
+{
+    static const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    char weekday[4], month[4], zone[4];
+    struct tm components = {};
+    if (sscanf(value.c_str(), "%3s, %d %3s %d %d:%d:%d %3s", weekday, &components.tm_mday, month,
+               &components.tm_year, &components.tm_hour, &components.tm_min, &components.tm_sec, zone) != 8
+        || strcmp(zone, "GMT") != 0) {
+        return false;
+    }
+    components.tm_mon = -1;
+    for (int i = 0; i < 12; i++) {
+        if (strcmp(month, months[i]) == 0) {
+            components.tm_mon = i;
+        }
+    }
+    if (components.tm_mon < 0) {
+        return false;
+    }
+    components.tm_year -= 1900;
+    time = (double)timegm(&components);
+    return true;
+}
+
+static double headerDate(const WXHTTPHeaders &headers, const char *name, double fallback)
+{
+    const std::string *value = WXHTTPHeaderValue(headers, name);
+    double time;
+    return value && WXParseHTTPDate(*value, time) ? time : fallback;
+}
+
+static WXCacheControl cacheControl(const WXHTTPHeaders &headers)
+{
+    const std::string *value = WXHTTPHeaderValue(headers, "Cache-Control");
+    WXCacheControl control = WXParseCacheControl(value ? *value : "");
+    const std::string *pragma = WXHTTPHeaderValue(headers, "Pragma");
+    if (!value && pragma && strcasecmp(trim(*pragma).c_str(), "no-cache") == 0) {
+        control.noCache = true;
+    }
+    return control;
+}
+
+bool WXHTTPCache::isCacheable(int status, const WXHTTPHeaders &headers)
+{
+    if (status != 200) {
+        return false;
+    }
+    WXCacheControl control = cacheControl(headers);
+    if (control.noStore) {
+        return false;
+    }
+    // the request headers aren't kept, so responses varying on them can't be matched
+    const std::string *vary = WXHTTPHeaderValue(headers, "Vary");
+    if (vary && !trim(*vary).empty() && strcasecmp(trim(*vary).c_str(), "Accept-Encoding") != 0) {
+        return false;
+    }
+    WXHTTPCacheEntry entry = {status, headers, "", 0, 0, 0};
+    return freshnessLifetime(entry) > 0 || control.staleWhileRevalidate > 0
+        || WXHTTPHeaderValue(headers, "ETag") || WXHTTPHeaderValue(headers, "Last-Modified");
+}
+
+double WXHTTPCache::freshnessLifetime(const WXHTTPCacheEntry &entry)
+{
+    WXCacheControl control = cacheControl(entry.headers);
+    if (control.noCache) {
+        return 0;
+    }
+    if (control.maxAge >= 0) {
+        return control.maxAge;
+    }
+    double date = headerDate(entry.headers, "Date", entry.responseTime);
+    const std::string *expires = WXHTTPHeaderValue(entry.headers, "Expires");
+    if (expires) {
+        double time;
+        // an invalid Expires means it has expired
+        return WXParseHTTPDate(*expires, time) ? std::max(0.0, time - date) : 0;
+    }
+    double lastModified;
+    const std::string *value = WXHTTPHeaderValue(entry.headers, "Last-Modified");
+    if (value && WXParseHTTPDate(*value, lastModified) && lastModified < date) {
+        return std::min((date - lastModified) / 10, kMaxHeuristicLifetime);
+    }
+    return 0;
+}
+
+double WXHTTPCache::currentAge(const WXHTTPCacheEntry &entry, double now)
+{
+    double date = headerDate(entry.headers, "Date", entry.responseTime);
+    double apparentAge = std::max(0.0, entry.responseTime - date);
+    const std::string *ageValue = WXHTTPHeaderValue(entry.headers, "Age");
+    double age = ageValue ? std::max(0.0, parseSeconds(*ageValue)) : 0;
+    double correctedAge = age + (entry.responseTime - entry.requestTime);
+    return std::max(apparentAge, correctedAge) + std::max(0.0, now - entry.responseTime);
+}
+
+WXHTTPCache::WXHTTPCache(const std::string &directory, size_t capacity)
+: _directory(directory), _capacity(capacity), _index(directory + "/index", 0, 64 * 1024, 16 * 1024), _totalSize(0), _metrics()
+{
+}
+
+std::string WXHTTPCache::bodyPath(const std::string &hash) const
+{
+    return _directory + "/bodies/" + hash;
+}
+
+bool WXHTTPCache::open()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    mkdir(_directory.c_str(), 0755);
+    mkdir((_directory + "/bodies").c_str(), 0755);
+    if (!_index.open()) {
+        return false;
+    }
+
+    _items.clear();
+    _order.clear();
+    _bodyReferences.clear();
+    _totalSize = 0;
+    for (const std::string &key : _index.keys()) {
+        WXHTTPCacheEntry entry;
+        struct stat info;
+        if (!readEntry(key, entry) || stat(bodyPath(entry.bodyHash).c_str(), &info) != 0 || (size_t)info.st_size != entry.bodySize) {
+            _index.remove(key);
+            continue;
+        }
+        link(key, entry.bodyHash, entry.bodySize);
+    }
+
+    // bodies of entries lost with the pending index records, and interrupted writes
+    if (DIR *dir = opendir((_directory + "/bodies").c_str())) {
+        while (struct dirent *item = readdir(dir)) {
+            if (item->d_name[0] != '.' && _bodyReferences.count(item->d_name) == 0) {
+                ::unlink(bodyPath(item->d_name).c_str());
+            }
+        }
+        closedir(dir);
+    }
+    evict(std::string());
+    _metrics.count = _items.size();
+    _metrics.bytes = _totalSize;
+    return true;
+}
+
+bool WXHTTPCache::readEntry(const std::string &key, WXHTTPCacheEntry &entry)
+{
+    std::string value;
+    if (!_index.get(key, value)) {
+        return false;
+    }
+    size_t lineEnd = value.find('\n');
+    if (lineEnd == std::string::npos) {
+        return false;
+    }
+    int version;
+    unsigned long long bodySize;
+    char hash[33];
+    if (sscanf(value.c_str(), "%d %d %llu %lf %lf %32s", &version, &entry.status, &bodySize,
+               &entry.requestTime, &entry.responseTime, hash) != 6 || version != kFormatVersion) {
+        return false;
+    }
+    entry.bodySize = (size_t)bodySize;
+    entry.bodyHash = hash;
+    entry.headers.clear();
+    size_t start = lineEnd + 1;
+    while (start < value.size()) {
+        size_t end = value.find('\n', start);
+        if (end == std::string::npos) {
+            end = value.size();
+        }
+        size_t colon = value.find(": ", start);
+        if (colon != std::string::npos && colon < end) {
+            entry.headers.emplace_back(value.substr(start, colon - start), value.substr(colon + 2, end - colon - 2));
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+void WXHTTPCache::writeEntry(const std::string &key, const WXHTTPCacheEntry &entry, double now)
+{
+    char line[256];
+    snprintf(line, sizeof(line), "%d %d %llu %.3f %.3f %s\n", kFormatVersion, entry.status,
+             (unsigned long long)entry.bodySize, entry.requestTime, entry.responseTime, entry.bodyHash.c_str());
+    std::string value = line;
+    for (const auto &header : entry.headers) {
+        // a header value can't contain a line break, but a broken server could send one
+        if (header.first.find('\n') == std::string::npos && header.second.find('\n') == std::string::npos) {
+            value += header.first + ": " + header.second + "\n";
+        }
+    }
+    _index.put(key, value, false, now);
+}
+
+void WXHTTPCache::link(const std::string &key, const std::string &hash, size_t size)
+{
+    _order.push_back(key);
+    _items[key] = {hash, size, std::prev(_order.end())};
+    if (_bodyReferences[hash]++ == 0) {
+        _totalSize += size;
+    }
+}
+
+void WXHTTPCache::unlinkItem(const std::string &key)
+{
+    auto found = _items.find(key);
+    if (found == _items.end()) {
+        return;
+    }
+    Item item = found->second;
+    _order.erase(item.order);
+    _items.erase(found);
+    if (--_bodyReferences[item.bodyHash] == 0) {
+        _bodyReferences.erase(item.bodyHash);
+        _totalSize -= item.bodySize;
+        ::unlink(bodyPath(item.bodyHash).c_str());
+    }
+}
+
+void WXHTTPCache::evict(const std::string &keep)
+{
+    while (_capacity > 0 && _totalSize > _capacity && !_order.empty()) {
+        std::string key = _order.front();
+        if (key == keep) {
+            if (_order.size() == 1) {
+                break;
+            }
+            // it's the most recently used, it can't be first unless it's alone
+            _order.splice(_order.end(), _order, _order.begin());
+            continue;
+        }
+        unlinkItem(key);
+        _index.remove(key);
+        _metrics.evictions++;
+    }
+}
+
+WXHTTPCacheLookup WXHTTPCache::lookup(const std::string &key, double now)
+{
+    WXHTTPCacheLookup result;
+    result.state = WXHTTPCacheState::Miss;
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _items.find(key);
+    if (found == _items.end() || !readEntry(key, result.entry)) {
+        _metrics.misses++;
+        return result;
+    }
+    _order.splice(_order.end(), _order, found->second.order);
+    _index.touch(key, now);
+    result.bodyPath = bodyPath(result.entry.bodyHash);
+    const std::string *etag = WXHTTPHeaderValue(result.entry.headers, "ETag");
+    const std::string *lastModified = WXHTTPHeaderValue(result.entry.headers, "Last-Modified");
+    result.etag = etag ? *etag : "";
+    result.lastModified = lastModified ? *lastModified : "";
+
+    WXCacheControl control = cacheControl(result.entry.headers);
+    double lifetime = freshnessLifetime(result.entry);
+    double age = currentAge(result.entry, now);
+    if (age < lifetime || (control.immutable && lifetime > 0)) {
+        result.state = WXHTTPCacheState::Fresh;
+        _metrics.fresh++;
+    } else if (!control.noCache && !control.mustRevalidate && control.staleWhileRevalidate > 0 && age < lifetime + control.staleWhileRevalidate) {
+        result.state = WXHTTPCacheState::StaleWhileRevalidate;
+        _metrics.staleWhileRevalidate++;
+    } else {
+        result.state = WXHTTPCacheState::Stale;
+        _metrics.stale++;
+    }
+    return result;
+}
+
+bool WXHTTPCache::store(const std::string &key, int status, const WXHTTPHeaders &headers, const void *body, size_t length, double requestTime, double responseTime)
+{
+    if (!isCacheable(status, headers) || (_capacity > 0 && length > _capacity)) {
+        return false;
+    }
+
+    WXMD5 hash;
+    hash.update(body, length);
+    WXHTTPCacheEntry entry = {status, headers, hash.finish(), length, requestTime, responseTime};
+
+    // write the body outside the lock, once per content
+    std::string path = bodyPath(entry.bodyHash);
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || (size_t)info.st_size != length) {
+        static std::atomic<unsigned> counter(0);
+        std::string temporary = _directory + "/bodies/.tmp" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+        FILE *file = fopen(temporary.c_str(), "wb");
+        bool written = file && fwrite(body, 1, length, file) == length;
+        written = file && fclose(file) == 0 && written;
+        if (!written || rename(temporary.c_str(), path.c_str()) != 0) {
+            ::unlink(temporary.c_str());
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _items.find(key);
+    if (found != _items.end() && found->second.bodyHash == entry.bodyHash) {
+        _order.splice(_order.end(), _order, found->second.order);
+    } else {
+        unlinkItem(key);
+        link(key, entry.bodyHash, entry.bodySize);
+    }
+    writeEntry(key, entry, responseTime);
+    _metrics.stores++;
+    evict(key);
+    _metrics.count = _items.size();
+    _metrics.bytes = _totalSize;
+    return true;
+}
+
+bool WXHTTPCache::revalidate(const std::string &key, const WXHTTPHeaders &headers, double requestTime, double responseTime)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    WXHTTPCacheEntry entry;
+    if (_items.count(key) == 0 || !readEntry(key, entry)) {
+        return false;
+    }
+    for (const auto &header : headers) {
+        // a 304 has no body, its Content-Length would be wrong for the stored one
+        if (strcasecmp(header.first.c_str(), "Content-Length") == 0) {
+            continue;
+        }
+        bool replaced = false;
+        for (auto &stored : entry.headers) {
+            if (strcasecmp(stored.first.c_str(), header.first.c_str()) == 0) {
+                stored.second = header.second;
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced) {
+            entry.headers.push_back(header);
+        }
+    }
+    entry.requestTime = requestTime;
+    entry.responseTime = responseTime;
+    writeEntry(key, entry, responseTime);
+    _order.splice(_order.end(), _order, _items[key].order);
+    _metrics.revalidations++;
+    return true;
+}
+
+void WXHTTPCache::remove(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    unlinkItem(key);
+    _index.remove(key);
+    _metrics.count = _items.size();
+    _metrics.bytes = _totalSize;
+}
+
+void WXHTTPCache::sync()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _index.sync();
+}
+
+WXHTTPCacheMetrics WXHTTPCache::metrics()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _metrics;
+}
@@ -0,0 +1,217 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXHTTPCache_h
+#define WXHTTPCache_h
+
+/*
+ * A portable HTTP cache for GET responses, which only depends on POSIX file
+ * APIs, so the network handlers of both platforms can sit on top of it.
+ *
+ * Bodies are stored once per content, in files named by their MD5, and
+ * entries point at them from an index kept in a WXStorageEngine log. When the
+ * bodies outgrow the capacity, the least recently used entries are removed.
+ *
+ * Freshness follows RFC 7234: the age of a response is corrected with its
+ * Date and Age headers, its lifetime comes from Cache-Control max-age, then
+ * Expires, then 10% of the time since Last-Modified. A stale entry may still
+ * be used while it's revalidated within its stale-while-revalidate window,
+ * otherwise it's revalidated with If-None-Match or If-Modified-Since first.
+ *
+ * All the methods are thread safe.
+ */
+
+#include "WXStorageEngine.h"
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+typedef std::vector<std::pair<std::string, std::string>> WXHTTPHeaders;
+
+// the value of the header, matched case insensitively, null if there is none
+const std::string *WXHTTPHeaderValue(const WXHTTPHeaders &headers, const char *name);
+
+struct WXCacheControl {
+    bool noStore;
+    bool noCache;
+    bool mustRevalidate;
+    bool immutable;
+    // seconds, negative if absent
+    double maxAge;
+    double staleWhileRevalidate;
+};
+
+WXCacheControl WXParseCacheControl(const std::string &value);
+// parses an IMF-fixdate, like "Sun, 06 Nov 1994 08:49:37 GMT", to seconds since 1970
+bool WXParseHTTPDate(const std::string &value, double &time);
+
+enum class WXHTTPCacheState {
+    Miss,
+    // use the entry
+    Fresh,
+    // use the entry, and revalidate it in the background
+    StaleWhileRevalidate,
+    // revalidate the entry before using it, or request it again if it has no validators
+    Stale,
+};
+
+struct WXHTTPCacheEntry {
+    int status;
+    WXHTTPHeaders headers;
+    std::string bodyHash;
+    size_t bodySize;
+    // seconds since 1970, when the request was sent and the response received
+    double requestTime;
+    double responseTime;
+};
+
+struct WXHTTPCacheLookup {
+    WXHTTPCacheState state;
+    WXHTTPCacheEntry entry;
+    std::string bodyPath;
+    // the validators for a conditional request, empty if there are none
+    std::string etag;
+    std::string lastModified;
+};
+
+struct WXHTTPCacheMetrics {
+    size_t fresh;
+    size_t staleWhileRevalidate;
+    size_t stale;
+    size_t misses;
+    // stale entries refreshed by a 304
+    size_t revalidations;
+    size_t stores;
+    size_t evictions;
+    size_t count;
+    // bytes of the bodies, shared bodies are counted once
+    size_t bytes;
+};
+
+class WXHTTPCache {
+public:
+    // capacity: the max bytes of all bodies, 0 means no limit
+    WXHTTPCache(const std::string &directory, size_t capacity);
+
+    // load the index, and remove the bodies it doesn't reference
+    bool open();
+
+    WXHTTPCacheLookup lookup(const std::string &key, double now);
+    // store the response if it's cacheable, returns false if it isn't
+    bool store(const std::string &key, int status, const WXHTTPHeaders &headers, const void *body, size_t length, double requestTime, double responseTime);
+    // update the entry with the headers of a 304 response, returns false if there is no entry
+    bool revalidate(const std::string &key, const WXHTTPHeaders &headers, double requestTime, double responseTime);
+    void remove(const std::string &key);
+    // write the pending index records
+    void sync();
+
+    WXHTTPCacheMetrics metrics();
+
+    static bool isCacheable(int status, const WXHTTPHeaders &headers);
+    // seconds the response is fresh for since it was generated
+    static double freshnessLifetime(const WXHTTPCacheEntry &entry);
+    static double currentAge(const WXHTTPCacheEntry &entry, double now);
+
+private:
+    struct Item {
+        std::string bodyHash;
+        size_t bodySize;
+        std::list<std::string>::iterator order;
+    };
+
+    std::string _directory;
+    size_t _capacity;
+    WXStorageEngine _index;
+    std::unordered_map<std::string, Item> _items;
+    // from the least recently used
+    std::list<std::string> _order;
+    std::unordered_map<std::string, size_t> _bodyReferences;
+    size_t _totalSize;
+    WXHTTPCacheMetrics _metrics;
+    std::mutex _mutex;
+
+    std::string bodyPath(const std::string &hash) const;
+    bool readEntry(const std::string &key, WXHTTPCacheEntry &entry);
+    void writeEntry(const std::string &key, const WXHTTPCacheEntry &entry, double now);
+    void link(const std::string &key, const std::string &hash, size_t size);
+    void unlinkItem(const std::string &key);
+    void evict(const std::string &keep);
+};
+
+/*
+ * Requests in flight by key, so the identical ones share one load: the
+ * first waiter of a key starts it, and finishing it returns all the waiters.
+ */
+template <typename Waiter>
+class WXInflightRequests {
+public:
+    // returns true if the waiter is the first one of the key
+    bool add(const std::string &key, const Waiter &waiter)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<Waiter> &waiters = _waiters[key];
+        waiters.push_back(waiter);
+        return waiters.size() == 1;
+    }
+
+    std::vector<Waiter> finish(const std::string &key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<Waiter> waiters;
+        auto found = _waiters.find(key);
+        if (found != _waiters.end()) {
+            waiters.swap(found->second);
+            _waiters.erase(found);
+        }
+        return waiters;
+    }
+
+    // returns the number of the waiters left
+    size_t remove(const std::string &key, const Waiter &waiter)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _waiters.find(key);
+        if (found == _waiters.end()) {
+            return 0;
+        }
+        std::vector<Waiter> &waiters = found->second;
+        waiters.erase(std::remove(waiters.begin(), waiters.end(), waiter), waiters.end());
+        return waiters.size();
+    }
+
+    bool contains(const std::string &key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _waiters.count(key) > 0;
+    }
+
+private:
+    std::unordered_map<std::string, std::vector<Waiter>> _waiters;
+    std::mutex _mutex;
+};
+
+#endif /* WXHTTPCache_h */
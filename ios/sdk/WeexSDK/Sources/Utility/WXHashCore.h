@@ -0,0 +1,95 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef WXHashCore_h
+#define WXHashCore_h
+
+/*
+ * Structural hashes of decoded data: numbers, strings, arrays and
+ * dictionaries. Arrays are hashed in order, dictionaries regardless of the
+ * order of their entries, so equal data always has equal hashes.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+enum WXHashType : uint64_t {
+    WXHashTypeNumber = 1,
+    WXHashTypeString,
+    WXHashTypeArray,
+    WXHashTypeDictionary,
+};
+
+// the finalizer of MurmurHash3
+inline uint64_t WXHashMix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+inline uint64_t WXHashBytes(const void *bytes, size_t length, uint64_t seed = 0)
+{
+    const unsigned char *data = (const unsigned char *)bytes;
+    uint64_t hash = WXHashMix(seed ^ length);
+    size_t index = 0;
+    for (; index + 8 <= length; index += 8) {
+        uint64_t word;
+        memcpy(&word, data + index, 8);
+        hash = (hash ^ WXHashMix(word)) * 0x9e3779b97f4a7c15ULL;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, data + index, length - index);
+    return WXHashMix(hash ^ tail);
+}
+
+class WXHasher {
+public:
+    explicit WXHasher(WXHashType type) : _state(WXHashMix(type)), _entries(0), _count(0) {}
+
+    // for the items of arrays, the order matters
+    void add(uint64_t hash)
+    {
+        _state = (_state ^ WXHashMix(hash + _count)) * 0x9e3779b97f4a7c15ULL;
+        _count++;
+    }
+
+    // for the entries of dictionaries, the order doesn't matter
+    void addEntry(uint64_t keyHash, uint64_t valueHash)
+    {
+        _entries += WXHashMix(keyHash * 0x9e3779b97f4a7c15ULL + valueHash);
+        _count++;
+    }
+
+    uint64_t finish() const
+    {
+        return WXHashMix(_state ^ _entries ^ WXHashMix(_count));
+    }
+
+private:
+    uint64_t _state;
+    uint64_t _entries;
+    uint64_t _count;
+};
+
+#endif /* WXHashCore_h */
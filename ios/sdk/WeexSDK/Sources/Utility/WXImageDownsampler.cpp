@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "WXImageDownsampler.h"
+
+#include <algorithm>
+#include <math.h>
+
+// smaller images are not worth bucketing finer
+static const int kMinBucketStep = 8;
+
+int WXImageBucketPixels(double pixels)
+{
+    if (!(pixels > 0)) {
+        return 0;
+    }
+    if (pixels > (1 << 24)) {
+        pixels = 1 << 24;
+    }
+    int size = (int)ceil(pixels);
+    int powerOfTwo = 1;
+    while (powerOfTwo < size) {
+        powerOfTwo <<= 1;
+    }
+    int step = std::max(kMinBucketStep, powerOfTwo / 8);
+    return (size + step - 1) / step * step;
+}
+
+WXImageSizeBucket WXImageBucketForTarget(const WXImageDecodeTarget &target)
+{
+    if (!(target.pixelsPerPoint > 0) || !(target.width > 0) || !(target.height > 0)) {
+        return {0, 0};
+    }
+    return {WXImageBucketPixels(target.width * target.pixelsPerPoint), WXImageBucketPixels(target.height * target.pixelsPerPoint)};
+}
+
+WXImageDecodePlan WXPlanImageDecode(int sourceWidth, int sourceHeight, const WXImageSizeBucket &bucket)
+{
+    if (sourceWidth <= 0 || sourceHeight <= 0 || bucket.width <= 0 || bucket.height <= 0) {
+        return {std::max(sourceWidth, 0), std::max(sourceHeight, 0), 1};
+    }
+    // cover the bucket, whatever the resize mode is
+    double scale = std::max((double)bucket.width / sourceWidth, (double)bucket.height / sourceHeight);
+    if (scale >= 1) {
+        return {sourceWidth, sourceHeight, 1};
+    }
+    int width = std::max(1, std::min(sourceWidth, (int)ceil(sourceWidth * scale)));
+    int height = std::max(1, std::min(sourceHeight, (int)ceil(sourceHeight * scale)));
+    int sampleSize = 1;
+    while (sourceWidth / (sampleSize * 2) >= width && sourceHeight / (sampleSize * 2) >= height) {
+        sampleSize *= 2;
+    }
+    return {width, height, sampleSize};
+}
@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXImageDownsampler_h
+#define WXImageDownsampler_h
+
+/*
+ * Decides the size images are decoded to from the laid out size of their
+ * component, instead of their full resolution, so a feed of photos shown as
+ * thumbnails holds thumbnails in memory and only decodes that many pixels.
+ *
+ * Targets are rounded up to size buckets, and the decoded images are cached
+ * by their URL and bucket, so components of nearly the same size share them.
+ * The decoded image covers its bucket, keeps the aspect ratio of the source
+ * and is never larger than the source. Decoders which can subsample, like
+ * JPEG ones by 1/2, 1/4 and 1/8, decode at the sample size and scale the
+ * rest of the way.
+ */
+
+struct WXImageDecodeTarget {
+    // the laid out size of the image in points, zero if it's unknown
+    double width;
+    double height;
+    // pixels per point: the scale of the screen times the quality, 0 to decode the original size
+    double pixelsPerPoint;
+};
+
+// pixels, both zero for the original size
+struct WXImageSizeBucket {
+    int width;
+    int height;
+};
+
+struct WXImageDecodePlan {
+    int width;
+    int height;
+    // the power of two the source can be subsampled by before scaling it to the size
+    int sampleSize;
+};
+
+// rounds up to a multiple of 1/8 of the next power of two, so buckets are at most 1/4 larger than the size
+int WXImageBucketPixels(double pixels);
+
+WXImageSizeBucket WXImageBucketForTarget(const WXImageDecodeTarget &target);
+
+WXImageDecodePlan WXPlanImageDecode(int sourceWidth, int sourceHeight, const WXImageSizeBucket &bucket);
+
+#endif /* WXImageDownsampler_h */
@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "WXImageRequestQueue.h"
+
+WXImageRequestQueue::WXImageRequestQueue(size_t maxRunning)
+: _maxRunning(maxRunning), _lastIdentifier(0), _metrics()
+{
+}
+
+uint64_t WXImageRequestQueue::add(const std::string &key, double priority, double now)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint64_t ticket = ++_lastIdentifier;
+    _metrics.requests++;
+
+    uint64_t identifier;
+    auto found = _loadsByKey.find(key);
+    if (found != _loadsByKey.end()) {
+        identifier = found->second;
+        _metrics.coalesced++;
+    } else {
+        identifier = ++_lastIdentifier;
+        Load &load = _loads[identifier];
+        load.key = key;
+        load.running = false;
+        load.addedTime = now;
+        load.rank = Rank(priority, identifier);
+        _loadsByKey[key] = identifier;
+        _pending.insert(load.rank);
+        _metrics.pending = _pending.size();
+        _metrics.maxPending = std::max(_metrics.maxPending, _metrics.pending);
+    }
+
+    Load &load = _loads[identifier];
+    load.tickets[ticket] = priority;
+    _loadsByTicket[ticket] = identifier;
+    rerank(identifier, load);
+    return ticket;
+}
+
+void WXImageRequestQueue::rerank(uint64_t identifier, Load &load)
+{
+    if (load.running || load.tickets.empty()) {
+        return;
+    }
+    double priority = load.tickets.begin()->second;
+    for (const auto &ticket : load.tickets) {
+        priority = std::min(priority, ticket.second);
+    }
+    if (priority != load.rank.first) {
+        _pending.erase(load.rank);
+        load.rank = Rank(priority, identifier);
+        _pending.insert(load.rank);
+    }
+}
+
+bool WXImageRequestQueue::update(uint64_t ticket, double priority)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _loadsByTicket.find(ticket);
+    if (found == _loadsByTicket.end()) {
+        return false;
+    }
+    Load &load = _loads[found->second];
+    load.tickets[ticket] = priority;
+    rerank(found->second, load);
+    return true;
+}
+
+void WXImageRequestQueue::remove(uint64_t identifier)
+{
+    auto found = _loads.find(identifier);
+    if (found == _loads.end()) {
+        return;
+    }
+    Load &load = found->second;
+    for (const auto &ticket : load.tickets) {
+        _loadsByTicket.erase(ticket.first);
+    }
+    if (load.running) {
+        _metrics.running--;
+    } else {
+        _pending.erase(load.rank);
+        _metrics.pending = _pending.size();
+    }
+    _loadsByKey.erase(load.key);
+    _loads.erase(found);
+}
+
+uint64_t WXImageRequestQueue::cancel(uint64_t ticket)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _loadsByTicket.find(ticket);
+    if (found == _loadsByTicket.end()) {
+        return 0;
+    }
+    uint64_t identifier = found->second;
+    _loadsByTicket.erase(found);
+    _metrics.cancelled++;
+
+    Load &load = _loads[identifier];
+    load.tickets.erase(ticket);
+    if (!load.tickets.empty()) {
+        rerank(identifier, load);
+        return 0;
+    }
+    remove(identifier);
+    _metrics.aborted++;
+    return identifier;
+}
+
+std::vector<WXImageLoad> WXImageRequestQueue::next(double now)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<WXImageLoad> loads;
+    while (_metrics.running < _maxRunning && !_pending.empty()) {
+        uint64_t identifier = _pending.begin()->second;
+        _pending.erase(_pending.begin());
+        Load &load = _loads[identifier];
+        load.running = true;
+        _metrics.running++;
+        _metrics.started++;
+        _metrics.totalWait += std::max(0.0, now - load.addedTime);
+        loads.push_back({identifier, load.key});
+    }
+    _metrics.pending = _pending.size();
+    return loads;
+}
+
+std::vector<uint64_t> WXImageRequestQueue::finish(uint64_t load, bool succeeded)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<uint64_t> tickets;
+    auto found = _loads.find(load);
+    if (found == _loads.end() || !found->second.running) {
+        return tickets;
+    }
+    for (const auto &ticket : found->second.tickets) {
+        tickets.push_back(ticket.first);
+    }
+    if (succeeded) {
+        _metrics.succeeded++;
+    } else {
+        _metrics.failed++;
+    }
+    remove(load);
+    return tickets;
+}
+
+void WXImageRequestQueue::setMaxRunning(size_t maxRunning)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxRunning = maxRunning;
+}
+
+WXImageRequestQueueMetrics WXImageRequestQueue::metrics()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _metrics;
+}
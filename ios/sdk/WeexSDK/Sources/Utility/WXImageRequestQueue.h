@@ -0,0 +1,117 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXImageRequestQueue_h
+#define WXImageRequestQueue_h
+
+/*
+ * Schedules image loads for all the image components, without knowing how
+ * images are fetched, so both platforms can use it.
+ *
+ * Each request of a component is a ticket waiting for the load of its key,
+ * usually its URL and the options it's decoded with. Requests for a key
+ * which is already waiting or loading join that load, so a list of identical
+ * placeholders loads its image once. Loads start by priority, the distance of
+ * their nearest waiter to the viewport, and at most maxRunning at once.
+ * Cancelling the last waiter of a load drops it, or aborts it if it started,
+ * like when a cell scrolls off the screen and is reused.
+ *
+ * All the methods are thread safe.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct WXImageLoad {
+    uint64_t identifier;
+    std::string key;
+};
+
+struct WXImageRequestQueueMetrics {
+    size_t requests;
+    // requests which joined the load of another one
+    size_t coalesced;
+    size_t started;
+    size_t succeeded;
+    size_t failed;
+    // requests cancelled before their load finished
+    size_t cancelled;
+    // loads dropped or aborted because no request waits for them any more
+    size_t aborted;
+    size_t pending;
+    size_t maxPending;
+    size_t running;
+    // seconds the started loads waited in the queue
+    double totalWait;
+};
+
+class WXImageRequestQueue {
+public:
+    explicit WXImageRequestQueue(size_t maxRunning);
+
+    // returns the ticket of the request, priority: lower loads sooner
+    uint64_t add(const std::string &key, double priority, double now);
+    // returns false if the request is gone
+    bool update(uint64_t ticket, double priority);
+    // returns the load if the request was the last one waiting for it, which is dropped, or has to be aborted if it started, 0 otherwise
+    uint64_t cancel(uint64_t ticket);
+    // the loads to start now, the most urgent first
+    std::vector<WXImageLoad> next(double now);
+    // returns the tickets waiting for the load, empty if it was aborted
+    std::vector<uint64_t> finish(uint64_t load, bool succeeded);
+
+    void setMaxRunning(size_t maxRunning);
+    WXImageRequestQueueMetrics metrics();
+
+private:
+    // the priority and the identifier of a load
+    typedef std::pair<double, uint64_t> Rank;
+
+    struct Load {
+        std::string key;
+        std::map<uint64_t, double> tickets;
+        bool running;
+        double addedTime;
+        Rank rank;
+    };
+
+    size_t _maxRunning;
+    uint64_t _lastIdentifier;
+    std::unordered_map<uint64_t, Load> _loads;
+    std::unordered_map<std::string, uint64_t> _loadsByKey;
+    std::unordered_map<uint64_t, uint64_t> _loadsByTicket;
+    // the pending loads by priority, then by identifier, which is in order
+    std::set<Rank> _pending;
+    WXImageRequestQueueMetrics _metrics;
+    std::mutex _mutex;
+
+    void rerank(uint64_t identifier, Load &load);
+    void remove(uint64_t identifier);
+};
+
+#endif /* WXImageRequestQueue_h */
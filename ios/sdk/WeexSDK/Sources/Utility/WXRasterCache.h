@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXRasterCache_h
+#define WXRasterCache_h
+
+/*
+ * A least-recently-used cache of rasterized artwork, like the borders and
+ * backgrounds of components, or of other results expensive to compute, like
+ * text layouts, keyed by everything they depend on. Lists of identical cards
+ * draw identical artwork, so they share one image instead of rasterizing it
+ * for every cell.
+ *
+ * The cache is capped by the cost of its values, usually their bytes, and
+ * counts hits, misses and evictions. All the methods are thread safe.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// builds a key from the values the drawing depends on
+class WXRasterKey {
+public:
+    WXRasterKey &add(double value)
+    {
+        // -0 and 0 draw the same
+        if (value == 0) {
+            value = 0;
+        }
+        _bytes.append((const char *)&value, sizeof(value));
+        return *this;
+    }
+
+    WXRasterKey &add(int64_t value)
+    {
+        _bytes.append((const char *)&value, sizeof(value));
+        return *this;
+    }
+
+    WXRasterKey &add(const void *bytes, size_t length)
+    {
+        add((int64_t)length);
+        _bytes.append((const char *)bytes, length);
+        return *this;
+    }
+
+    const std::string &bytes() const
+    {
+        return _bytes;
+    }
+
+private:
+    std::string _bytes;
+};
+
+struct WXRasterCacheMetrics {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t count;
+    size_t totalCost;
+};
+
+template <class Value>
+class WXRasterCache {
+public:
+    explicit WXRasterCache(size_t costLimit) : _costLimit(costLimit), _totalCost(0), _hits(0), _misses(0), _evictions(0) {}
+
+    bool get(const WXRasterKey &key, Value &value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _entries.find(key.bytes());
+        if (found == _entries.end()) {
+            _misses++;
+            return false;
+        }
+        _hits++;
+        _order.splice(_order.end(), _order, found->second.order);
+        value = found->second.value;
+        return true;
+    }
+
+    // values costlier than the limit are not kept
+    void put(const WXRasterKey &key, const Value &value, size_t cost)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        removeLocked(key.bytes());
+        if (cost > _costLimit) {
+            return;
+        }
+        _order.push_back(key.bytes());
+        Entry &entry = _entries[key.bytes()];
+        entry.value = value;
+        entry.cost = cost;
+        entry.order = std::prev(_order.end());
+        _totalCost += cost;
+        trimLocked(_costLimit);
+    }
+
+    void setCostLimit(size_t costLimit)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _costLimit = costLimit;
+        trimLocked(_costLimit);
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        trimLocked(0);
+    }
+
+    WXRasterCacheMetrics metrics()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return WXRasterCacheMetrics{_hits, _misses, _evictions, _entries.size(), _totalCost};
+    }
+
+private:
+    struct Entry {
+        Value value;
+        size_t cost;
+        std::list<std::string>::iterator order;
+    };
+
+    size_t _costLimit;
+    size_t _totalCost;
+    size_t _hits;
+    size_t _misses;
+    size_t _evictions;
+    std::unordered_map<std::string, Entry> _entries;
+    // from the least recently used
+    std::list<std::string> _order;
+    std::mutex _mutex;
+
+    void removeLocked(const std::string &key)
+    {
+        auto found = _entries.find(key);
+        if (found != _entries.end()) {
+            _totalCost -= found->second.cost;
+            _order.erase(found->second.order);
+            _entries.erase(found);
+        }
+    }
+
+    void trimLocked(size_t costLimit)
+    {
+        while (_totalCost > costLimit || (costLimit == 0 && !_order.empty())) {
+            removeLocked(std::string(_order.front()));
+            _evictions++;
+        }
+    }
+};
+
+#endif /* WXRasterCache_h */
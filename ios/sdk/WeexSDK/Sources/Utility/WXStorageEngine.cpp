@@ -0,0 +1,524 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "WXStorageEngine.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <iterator>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * The log starts with the magic, followed by the records:
+ *
+ *   u32 crc        crc32 of the rest of the record
+ *   u8  type       put, remove or touch
+ *   u8  flags      persistent
+ *   u16 reserved
+ *   u32 key size
+ *   u32 value size
+ *   f64 timestamp
+ *   key, value
+ */
+static const char kMagic[8] = {'W', 'X', 'S', 'T', 'L', 'O', 'G', '1'};
+static const size_t kHeaderSize = 24;
+static const uint8_t kTypePut = 1;
+static const uint8_t kTypeRemove = 2;
+static const uint8_t kTypeTouch = 3;
+static const uint8_t kFlagPersistent = 1;
+// logs smaller than this are never compacted
+static const uint64_t kMinCompactSize = 64 * 1024;
+
+static uint32_t crc32Update(uint32_t crc, const void *bytes, size_t length)
+{
+    static uint32_t table[256];
+    static std::once_flag once;
+    std::call_once(once, [] {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++) {
+                value = (value & 1) ? 0xedb88320 ^ (value >> 1) : value >> 1;
+            }
+            table[i] = value;
+        }
+    });
+
+    const unsigned char *data = (const unsigned char *)bytes;
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void encodeRecord(std::string &buffer, uint8_t type, uint8_t flags, const std::string &key, const char *value, uint32_t valueSize, double timestamp)
+{
+    size_t start = buffer.size();
+    buffer.resize(start + kHeaderSize);
+    char *header = &buffer[start];
+    uint32_t keySize = (uint32_t)key.size();
+    uint16_t reserved = 0;
+    header[4] = (char)type;
+    header[5] = (char)flags;
+    memcpy(header + 6, &reserved, 2);
+    memcpy(header + 8, &keySize, 4);
+    memcpy(header + 12, &valueSize, 4);
+    memcpy(header + 16, &timestamp, 8);
+    buffer.append(key);
+    buffer.append(value, valueSize);
+
+    uint32_t crc = crc32Update(0, buffer.data() + start + 4, buffer.size() - start - 4);
+    memcpy(&buffer[start], &crc, 4);
+}
+
+static bool writeFully(int fd, const char *bytes, size_t length)
+{
+    while (length > 0) {
+        ssize_t written = ::write(fd, bytes, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        length -= written;
+    }
+    return true;
+}
+
+WXStorageEngine::WXStorageEngine(const std::string &path, size_t totalLimit, size_t inlineLimit, size_t pendingLimit)
+: _path(path), _totalLimit(totalLimit), _inlineLimit(inlineLimit), _pendingLimit(pendingLimit), _fd(-1), _fileSize(0), _writtenSize(0), _liveSize(0), _totalSize(0), _dirty(false)
+{
+}
+
+WXStorageEngine::~WXStorageEngine()
+{
+    close();
+}
+
+bool WXStorageEngine::open()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_fd >= 0) {
+        return true;
+    }
+    _fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (_fd < 0) {
+        return false;
+    }
+    if (!load()) {
+        ::close(_fd);
+        _fd = -1;
+        return false;
+    }
+    return true;
+}
+
+void WXStorageEngine::close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_fd >= 0) {
+        writePending();
+        if (_dirty) {
+            fsync(_fd);
+        }
+        ::close(_fd);
+        _fd = -1;
+    }
+    _items.clear();
+    _order.clear();
+    _pending.clear();
+    _fileSize = _writtenSize = _liveSize = 0;
+    _totalSize = 0;
+    _dirty = false;
+}
+
+bool WXStorageEngine::load()
+{
+    struct stat status;
+    if (fstat(_fd, &status) != 0) {
+        return false;
+    }
+
+    std::string contents((size_t)status.st_size, '\0');
+    size_t read = 0;
+    while (read < contents.size()) {
+        ssize_t count = pread(_fd, &contents[read], contents.size() - read, read);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        read += count;
+    }
+    contents.resize(read);
+
+    if (contents.size() < sizeof(kMagic) || memcmp(contents.data(), kMagic, sizeof(kMagic)) != 0) {
+        // a new log, or not a log at all
+        if (ftruncate(_fd, 0) != 0 || !writeFully(_fd, kMagic, sizeof(kMagic))) {
+            return false;
+        }
+        _fileSize = _writtenSize = sizeof(kMagic);
+        _dirty = true;
+        return true;
+    }
+
+    uint64_t offset = sizeof(kMagic);
+    while (offset + kHeaderSize <= contents.size()) {
+        const char *header = contents.data() + offset;
+        uint32_t crc, keySize, valueSize;
+        double timestamp;
+        memcpy(&crc, header, 4);
+        memcpy(&keySize, header + 8, 4);
+        memcpy(&valueSize, header + 12, 4);
+        memcpy(&timestamp, header + 16, 8);
+        uint64_t recordSize = kHeaderSize + (uint64_t)keySize + valueSize;
+        if (offset + recordSize > contents.size() || crc32Update(0, header + 4, recordSize - 4) != crc) {
+            break;
+        }
+        std::string key(header + kHeaderSize, keySize);
+        apply((uint8_t)header[4], (uint8_t)header[5], key, header + kHeaderSize + keySize, valueSize, timestamp, offset, (uint32_t)recordSize);
+        offset += recordSize;
+    }
+
+    if (offset < contents.size()) {
+        // drop the record which was being written when the app was killed
+        if (ftruncate(_fd, offset) != 0) {
+            return false;
+        }
+        _dirty = true;
+    }
+    _fileSize = _writtenSize = offset;
+    return true;
+}
+
+void WXStorageEngine::apply(uint8_t type, uint8_t flags, const std::string &key, const char *value, uint32_t valueSize, double timestamp, uint64_t offset, uint32_t recordSize)
+{
+    if (type == kTypePut) {
+        unlink(key);
+        _order.push_back(key);
+        Item &item = _items[key];
+        item.persistent = (flags & kFlagPersistent) != 0;
+        item.timestamp = timestamp;
+        item.offset = offset + kHeaderSize + key.size();
+        item.size = valueSize;
+        item.recordSize = recordSize;
+        item.hasValue = valueSize <= _inlineLimit;
+        if (item.hasValue) {
+            item.value.assign(value, valueSize);
+        }
+        item.order = std::prev(_order.end());
+        _liveSize += recordSize;
+        _totalSize += valueSize;
+    } else if (type == kTypeRemove) {
+        unlink(key);
+    } else if (type == kTypeTouch) {
+        auto found = _items.find(key);
+        if (found != _items.end()) {
+            found->second.timestamp = timestamp;
+            _order.splice(_order.end(), _order, found->second.order);
+        }
+    }
+}
+
+void WXStorageEngine::unlink(const std::string &key)
+{
+    auto found = _items.find(key);
+    if (found == _items.end()) {
+        return;
+    }
+    _liveSize -= found->second.recordSize;
+    _totalSize -= found->second.size;
+    _order.erase(found->second.order);
+    _items.erase(found);
+}
+
+bool WXStorageEngine::append(uint8_t type, uint8_t flags, const std::string &key, const char *value, uint32_t valueSize, double timestamp)
+{
+    if (_fd < 0) {
+        return false;
+    }
+    size_t start = _pending.size();
+    encodeRecord(_pending, type, flags, key, value, valueSize, timestamp);
+    uint32_t recordSize = (uint32_t)(_pending.size() - start);
+    if (_pending.size() > _pendingLimit && !writePending()) {
+        _pending.resize(start);
+        return false;
+    }
+    uint64_t offset = _fileSize;
+    _fileSize += recordSize;
+    apply(type, flags, key, value, valueSize, timestamp, offset, recordSize);
+    return true;
+}
+
+bool WXStorageEngine::writePending()
+{
+    if (_pending.empty()) {
+        return true;
+    }
+    if (!writeFully(_fd, _pending.data(), _pending.size())) {
+        // don't leave a broken record behind the next ones
+        ftruncate(_fd, _writtenSize);
+        return false;
+    }
+    _writtenSize += _pending.size();
+    _pending.clear();
+    _dirty = true;
+    return true;
+}
+
+bool WXStorageEngine::readValue(const Item &item, std::string &value)
+{
+    if (item.hasValue) {
+        value = item.value;
+        return true;
+    }
+    if (item.offset >= _writtenSize) {
+        value.assign(_pending, (size_t)(item.offset - _writtenSize), item.size);
+        return true;
+    }
+    value.resize(item.size);
+    size_t read = 0;
+    while (read < item.size) {
+        ssize_t count = pread(_fd, &value[read], item.size - read, item.offset + read);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        read += count;
+    }
+    return true;
+}
+
+bool WXStorageEngine::get(const std::string &key, std::string &value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _items.find(key);
+    return found != _items.end() && readValue(found->second, value);
+}
+
+bool WXStorageEngine::put(const std::string &key, const std::string &value, bool persistent, double timestamp)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    // a value which can never fit is rejected before it evicts anything
+    if (_totalLimit > 0 && value.size() > _totalLimit) {
+        return false;
+    }
+    if (!append(kTypePut, persistent ? kFlagPersistent : 0, key, value.data(), (uint32_t)value.size(), timestamp)) {
+        return false;
+    }
+    bool kept = evict(key);
+    compactIfNeeded();
+    return kept;
+}
+
+bool WXStorageEngine::remove(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_items.find(key) == _items.end()) {
+        return false;
+    }
+    bool removed = append(kTypeRemove, 0, key, NULL, 0, 0);
+    compactIfNeeded();
+    return removed;
+}
+
+bool WXStorageEngine::touch(const std::string &key, double timestamp)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_items.find(key) == _items.end()) {
+        return false;
+    }
+    bool touched = append(kTypeTouch, 0, key, NULL, 0, timestamp);
+    compactIfNeeded();
+    return touched;
+}
+
+bool WXStorageEngine::contains(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _items.find(key) != _items.end();
+}
+
+bool WXStorageEngine::info(const std::string &key, WXStorageItemInfo &info)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _items.find(key);
+    if (found == _items.end()) {
+        return false;
+    }
+    info.persistent = found->second.persistent;
+    info.size = found->second.size;
+    info.timestamp = found->second.timestamp;
+    return true;
+}
+
+size_t WXStorageEngine::count()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _items.size();
+}
+
+size_t WXStorageEngine::totalSize()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _totalSize;
+}
+
+std::vector<std::string> WXStorageEngine::keys()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::vector<std::string>(_order.begin(), _order.end());
+}
+
+size_t WXStorageEngine::fileSize()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (size_t)_fileSize;
+}
+
+size_t WXStorageEngine::pendingSize()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending.size();
+}
+
+bool WXStorageEngine::sync()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_fd < 0) {
+        return true;
+    }
+    if (!writePending()) {
+        return false;
+    }
+    if (!_dirty) {
+        return true;
+    }
+    if (fsync(_fd) != 0) {
+        return false;
+    }
+    _dirty = false;
+    return true;
+}
+
+bool WXStorageEngine::evict(const std::string &keep)
+{
+    if (_totalLimit == 0) {
+        return true;
+    }
+    auto it = _order.begin();
+    while (_totalSize > _totalLimit && it != _order.end()) {
+        std::string key = *it++;
+        if (_items[key].persistent || key == keep) {
+            continue;
+        }
+        if (!append(kTypeRemove, 0, key, NULL, 0, 0)) {
+            break;
+        }
+    }
+    // the persistent items leave no room for it, so it's evicted as well
+    if (_totalSize > _totalLimit && !_items[keep].persistent) {
+        append(kTypeRemove, 0, keep, NULL, 0, 0);
+        return false;
+    }
+    return true;
+}
+
+bool WXStorageEngine::compact()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return compactLocked();
+}
+
+void WXStorageEngine::compactIfNeeded()
+{
+    uint64_t deadSize = _fileSize - sizeof(kMagic) - _liveSize;
+    if (_fileSize > kMinCompactSize && deadSize > _liveSize) {
+        compactLocked();
+    }
+}
+
+bool WXStorageEngine::compactLocked()
+{
+    if (_fd < 0) {
+        return false;
+    }
+
+    std::string path = _path + ".compact";
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    // write the items in the order of use, so the order is kept on replay
+    std::string buffer(kMagic, sizeof(kMagic));
+    std::vector<uint64_t> offsets;
+    offsets.reserve(_items.size());
+    std::string value;
+    bool succeeded = true;
+    uint64_t written = 0;
+    for (const std::string &key : _order) {
+        const Item &item = _items[key];
+        if (!readValue(item, value)) {
+            succeeded = false;
+            break;
+        }
+        offsets.push_back(written + buffer.size() + kHeaderSize + key.size());
+        encodeRecord(buffer, kTypePut, item.persistent ? kFlagPersistent : 0, key, value.data(), (uint32_t)value.size(), item.timestamp);
+        if (buffer.size() >= 64 * 1024) {
+            succeeded = writeFully(fd, buffer.data(), buffer.size());
+            written += buffer.size();
+            buffer.clear();
+            if (!succeeded) {
+                break;
+            }
+        }
+    }
+    succeeded = succeeded && writeFully(fd, buffer.data(), buffer.size()) && fsync(fd) == 0;
+    written += buffer.size();
+    ::close(fd);
+
+    if (!succeeded || rename(path.c_str(), _path.c_str()) != 0) {
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    ::close(_fd);
+    _fd = ::open(_path.c_str(), O_RDWR | O_APPEND, 0644);
+    size_t index = 0;
+    _liveSize = 0;
+    for (const std::string &key : _order) {
+        Item &item = _items[key];
+        item.offset = offsets[index++];
+        item.recordSize = (uint32_t)(kHeaderSize + key.size() + item.size);
+        _liveSize += item.recordSize;
+    }
+    // the pending records are in the new log already
+    _pending.clear();
+    _fileSize = _writtenSize = written;
+    _dirty = false;
+    return _fd >= 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef WXStorageEngine_h
+#define WXStorageEngine_h
+
+/*
+ * A portable key-value store in one append-only log file, it only depends
+ * on POSIX file APIs.
+ *
+ * Every mutation appends one checksummed record, so a write costs
+ * O(key + value) instead of rewriting the whole store. An in-memory hash
+ * index maps keys to their latest record, small values are kept in memory
+ * and large ones are read from the log on demand. The log is replayed on
+ * open and cut at the first broken record, which is what a crash leaves.
+ * It's compacted when the dead records outweigh the live ones.
+ *
+ * With a pending limit, records are buffered in memory, and reads are served
+ * from the buffer, until sync() writes them and flushes them to the disk in
+ * one commit, or the buffer outgrows the limit. So a burst of writes costs
+ * one write and one fsync, and only the records since the last sync are
+ * lost if the app is killed.
+ *
+ * Keys are kept in least-recently-used order, when the total size of the
+ * values exceeds the limit, the least recently used non-persistent items are
+ * evicted. A value which doesn't fit in the limit is never stored.
+ *
+ * All the methods are thread safe.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct WXStorageItemInfo {
+    bool persistent;
+    // bytes of the value
+    size_t size;
+    // seconds since 1970, of the last write or read
+    double timestamp;
+};
+
+class WXStorageEngine {
+public:
+    /*
+     * totalLimit: the max bytes of all values, 0 means no limit.
+     * inlineLimit: values up to this size are kept in memory.
+     * pendingLimit: bytes of records buffered before they are written, 0 means
+     * every record is written right away.
+     */
+    WXStorageEngine(const std::string &path, size_t totalLimit, size_t inlineLimit = 1024, size_t pendingLimit = 0);
+    ~WXStorageEngine();
+
+    // open or create the log, and load the index from it
+    bool open();
+    void close();
+
+    bool get(const std::string &key, std::string &value);
+    // write the value, then evict items if the total limit is exceeded. Returns
+    // false if the value can't fit in the limit, it's not stored then.
+    bool put(const std::string &key, const std::string &value, bool persistent, double timestamp);
+    // returns false if the key doesn't exist
+    bool remove(const std::string &key);
+    // mark the item as recently used
+    bool touch(const std::string &key, double timestamp);
+
+    bool contains(const std::string &key);
+    bool info(const std::string &key, WXStorageItemInfo &info);
+    size_t count();
+    size_t totalSize();
+    // from the least recently used to the most recently used
+    std::vector<std::string> keys();
+
+    // write the pending records and flush them to the disk, returns true if nothing is pending
+    bool sync();
+    // rewrite the log with the live items only
+    bool compact();
+
+    // bytes of the log file, including the dead and the pending records
+    size_t fileSize();
+    // bytes of the records which are not written yet
+    size_t pendingSize();
+
+private:
+    struct Item {
+        bool persistent;
+        double timestamp;
+        // offset of the value in the log
+        uint64_t offset;
+        uint32_t size;
+        // bytes of the record which holds the value
+        uint32_t recordSize;
+        bool hasValue;
+        std::string value;
+        std::list<std::string>::iterator order;
+    };
+
+    std::string _path;
+    size_t _totalLimit;
+    size_t _inlineLimit;
+    size_t _pendingLimit;
+    int _fd;
+    uint64_t _fileSize;
+    // bytes which are written to the file, the pending records follow them
+    uint64_t _writtenSize;
+    std::string _pending;
+    uint64_t _liveSize;
+    size_t _totalSize;
+    bool _dirty;
+    std::unordered_map<std::string, Item> _items;
+    std::list<std::string> _order;
+    std::mutex _mutex;
+
+    bool load();
+    void apply(uint8_t type, uint8_t flags, const std::string &key, const char *value, uint32_t valueSize, double timestamp, uint64_t offset, uint32_t recordSize);
+    void unlink(const std::string &key);
+    bool append(uint8_t type, uint8_t flags, const std::string &key, const char *value, uint32_t valueSize, double timestamp);
+    bool writePending();
+    bool readValue(const Item &item, std::string &value);
+    // returns false if the kept item is evicted too
+    bool evict(const std::string &keep);
+    void compactIfNeeded();
+    bool compactLocked();
+};
+
+#endif /* WXStorageEngine_h */
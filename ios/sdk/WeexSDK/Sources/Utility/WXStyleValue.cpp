@@ -0,0 +1,592 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "WXStyleValue.h"
+#include "WXHashCore.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+struct WXStyleName {
+    const char *name;
+    WXStyleKeyword keyword;
+    // 0xrrggbbaa, 0 if it isn't a color, and 1 for transparent, whose alpha is 0
+    uint32_t rgba;
+};
+
+static const WXStyleName WXStyleNames[] = {
+    {"auto", WXStyleKeyword::Auto, 0},
+    {"row", WXStyleKeyword::Row, 0},
+    {"row-reverse", WXStyleKeyword::RowReverse, 0},
+    {"column", WXStyleKeyword::Column, 0},
+    {"column-reverse", WXStyleKeyword::ColumnReverse, 0},
+    {"flex-start", WXStyleKeyword::FlexStart, 0},
+    {"flex-end", WXStyleKeyword::FlexEnd, 0},
+    {"center", WXStyleKeyword::Center, 0},
+    {"stretch", WXStyleKeyword::Stretch, 0},
+    {"space-between", WXStyleKeyword::SpaceBetween, 0},
+    {"space-around", WXStyleKeyword::SpaceAround, 0},
+    {"wrap", WXStyleKeyword::Wrap, 0},
+    {"nowrap", WXStyleKeyword::Nowrap, 0},
+    {"relative", WXStyleKeyword::Relative, 0},
+    {"absolute", WXStyleKeyword::Absolute, 0},
+    {"fixed", WXStyleKeyword::Fixed, 0},
+    {"sticky", WXStyleKeyword::Sticky, 0},
+    // https://www.w3.org/TR/css3-color/#transparent
+    {"transparent", WXStyleKeyword::None, 0x00000001},
+    // https://www.w3.org/TR/css3-color/#svg-color
+#define WX_STYLE_COLOR(name, rgb) {name, WXStyleKeyword::None, ((uint32_t)rgb << 8) | 0xff},
+    WX_STYLE_COLOR("aliceblue", 0xf0f8ff)
+    WX_STYLE_COLOR("antiquewhite", 0xfaebd7)
+    WX_STYLE_COLOR("aqua", 0x00ffff)
+    WX_STYLE_COLOR("aquamarine", 0x7fffd4)
+    WX_STYLE_COLOR("azure", 0xf0ffff)
+    WX_STYLE_COLOR("beige", 0xf5f5dc)
+    WX_STYLE_COLOR("bisque", 0xffe4c4)
+    WX_STYLE_COLOR("black", 0x000000)
+    WX_STYLE_COLOR("blanchedalmond", 0xffebcd)
+    WX_STYLE_COLOR("blue", 0x0000ff)
+    WX_STYLE_COLOR("blueviolet", 0x8a2be2)
+    WX_STYLE_COLOR("brown", 0xa52a2a)
+    WX_STYLE_COLOR("burlywood", 0xdeb887)
+    WX_STYLE_COLOR("cadetblue", 0x5f9ea0)
+    WX_STYLE_COLOR("chartreuse", 0x7fff00)
+    WX_STYLE_COLOR("chocolate", 0xd2691e)
+    WX_STYLE_COLOR("coral", 0xff7f50)
+    WX_STYLE_COLOR("cornflowerblue", 0x6495ed)
+    WX_STYLE_COLOR("cornsilk", 0xfff8dc)
+    WX_STYLE_COLOR("crimson", 0xdc143c)
+    WX_STYLE_COLOR("cyan", 0x00ffff)
+    WX_STYLE_COLOR("darkblue", 0x00008b)
+    WX_STYLE_COLOR("darkcyan", 0x008b8b)
+    WX_STYLE_COLOR("darkgoldenrod", 0xb8860b)
+    WX_STYLE_COLOR("darkgray", 0xa9a9a9)
+    WX_STYLE_COLOR("darkgrey", 0xa9a9a9)
+    WX_STYLE_COLOR("darkgreen", 0x006400)
+    WX_STYLE_COLOR("darkkhaki", 0xbdb76b)
+    WX_STYLE_COLOR("darkmagenta", 0x8b008b)
+    WX_STYLE_COLOR("darkolivegreen", 0x556b2f)
+    WX_STYLE_COLOR("darkorange", 0xff8c00)
+    WX_STYLE_COLOR("darkorchid", 0x9932cc)
+    WX_STYLE_COLOR("darkred", 0x8b0000)
+    WX_STYLE_COLOR("darksalmon", 0xe9967a)
+    WX_STYLE_COLOR("darkseagreen", 0x8fbc8f)
+    WX_STYLE_COLOR("darkslateblue", 0x483d8b)
+    WX_STYLE_COLOR("darkslategray", 0x2f4f4f)
+    WX_STYLE_COLOR("darkslategrey", 0x2f4f4f)
+    WX_STYLE_COLOR("darkturquoise", 0x00ced1)
+    WX_STYLE_COLOR("darkviolet", 0x9400d3)
+    WX_STYLE_COLOR("deeppink", 0xff1493)
+    WX_STYLE_COLOR("deepskyblue", 0x00bfff)
+    WX_STYLE_COLOR("dimgray", 0x696969)
+    WX_STYLE_COLOR("dimgrey", 0x696969)
+    WX_STYLE_COLOR("dodgerblue", 0x1e90ff)
+    WX_STYLE_COLOR("firebrick", 0xb22222)
+    WX_STYLE_COLOR("floralwhite", 0xfffaf0)
+    WX_STYLE_COLOR("forestgreen", 0x228b22)
+    WX_STYLE_COLOR("fuchsia", 0xff00ff)
+    WX_STYLE_COLOR("gainsboro", 0xdcdcdc)
+    WX_STYLE_COLOR("ghostwhite", 0xf8f8ff)
+    WX_STYLE_COLOR("gold", 0xffd700)
+    WX_STYLE_COLOR("goldenrod", 0xdaa520)
+    WX_STYLE_COLOR("gray", 0x808080)
+    WX_STYLE_COLOR("grey", 0x808080)
+    WX_STYLE_COLOR("green", 0x008000)
+    WX_STYLE_COLOR("greenyellow", 0xadff2f)
+    WX_STYLE_COLOR("honeydew", 0xf0fff0)
+    WX_STYLE_COLOR("hotpink", 0xff69b4)
+    WX_STYLE_COLOR("indianred", 0xcd5c5c)
+    WX_STYLE_COLOR("indigo", 0x4b0082)
+    WX_STYLE_COLOR("ivory", 0xfffff0)
+    WX_STYLE_COLOR("khaki", 0xf0e68c)
+    WX_STYLE_COLOR("lavender", 0xe6e6fa)
+    WX_STYLE_COLOR("lavenderblush", 0xfff0f5)
+    WX_STYLE_COLOR("lawngreen", 0x7cfc00)
+    WX_STYLE_COLOR("lemonchiffon", 0xfffacd)
+    WX_STYLE_COLOR("lightblue", 0xadd8e6)
+    WX_STYLE_COLOR("lightcoral", 0xf08080)
+    WX_STYLE_COLOR("lightcyan", 0xe0ffff)
+    WX_STYLE_COLOR("lightgoldenrodyellow", 0xfafad2)
+    WX_STYLE_COLOR("lightgray", 0xd3d3d3)
+    WX_STYLE_COLOR("lightgrey", 0xd3d3d3)
+    WX_STYLE_COLOR("lightgreen", 0x90ee90)
+    WX_STYLE_COLOR("lightpink", 0xffb6c1)
+    WX_STYLE_COLOR("lightsalmon", 0xffa07a)
+    WX_STYLE_COLOR("lightseagreen", 0x20b2aa)
+    WX_STYLE_COLOR("lightskyblue", 0x87cefa)
+    WX_STYLE_COLOR("lightslategray", 0x778899)
+    WX_STYLE_COLOR("lightslategrey", 0x778899)
+    WX_STYLE_COLOR("lightsteelblue", 0xb0c4de)
+    WX_STYLE_COLOR("lightyellow", 0xffffe0)
+    WX_STYLE_COLOR("lime", 0x00ff00)
+    WX_STYLE_COLOR("limegreen", 0x32cd32)
+    WX_STYLE_COLOR("linen", 0xfaf0e6)
+    WX_STYLE_COLOR("magenta", 0xff00ff)
+    WX_STYLE_COLOR("maroon", 0x800000)
+    WX_STYLE_COLOR("mediumaquamarine", 0x66cdaa)
+    WX_STYLE_COLOR("mediumblue", 0x0000cd)
+    WX_STYLE_COLOR("mediumorchid", 0xba55d3)
+    WX_STYLE_COLOR("mediumpurple", 0x9370db)
+    WX_STYLE_COLOR("mediumseagreen", 0x3cb371)
+    WX_STYLE_COLOR("mediumslateblue", 0x7b68ee)
+    WX_STYLE_COLOR("mediumspringgreen", 0x00fa9a)
+    WX_STYLE_COLOR("mediumturquoise", 0x48d1cc)
+    WX_STYLE_COLOR("mediumvioletred", 0xc71585)
+    WX_STYLE_COLOR("midnightblue", 0x191970)
+    WX_STYLE_COLOR("mintcream", 0xf5fffa)
+    WX_STYLE_COLOR("mistyrose", 0xffe4e1)
+    WX_STYLE_COLOR("moccasin", 0xffe4b5)
+    WX_STYLE_COLOR("navajowhite", 0xffdead)
+    WX_STYLE_COLOR("navy", 0x000080)
+    WX_STYLE_COLOR("oldlace", 0xfdf5e6)
+    WX_STYLE_COLOR("olive", 0x808000)
+    WX_STYLE_COLOR("olivedrab", 0x6b8e23)
+    WX_STYLE_COLOR("orange", 0xffa500)
+    WX_STYLE_COLOR("orangered", 0xff4500)
+    WX_STYLE_COLOR("orchid", 0xda70d6)
+    WX_STYLE_COLOR("palegoldenrod", 0xeee8aa)
+    WX_STYLE_COLOR("palegreen", 0x98fb98)
+    WX_STYLE_COLOR("paleturquoise", 0xafeeee)
+    WX_STYLE_COLOR("palevioletred", 0xdb7093)
+    WX_STYLE_COLOR("papayawhip", 0xffefd5)
+    WX_STYLE_COLOR("peachpuff", 0xffdab9)
+    WX_STYLE_COLOR("peru", 0xcd853f)
+    WX_STYLE_COLOR("pink", 0xffc0cb)
+    WX_STYLE_COLOR("plum", 0xdda0dd)
+    WX_STYLE_COLOR("powderblue", 0xb0e0e6)
+    WX_STYLE_COLOR("purple", 0x800080)
+    WX_STYLE_COLOR("rebeccapurple", 0x663399)
+    WX_STYLE_COLOR("red", 0xff0000)
+    WX_STYLE_COLOR("rosybrown", 0xbc8f8f)
+    WX_STYLE_COLOR("royalblue", 0x4169e1)
+    WX_STYLE_COLOR("saddlebrown", 0x8b4513)
+    WX_STYLE_COLOR("salmon", 0xfa8072)
+    WX_STYLE_COLOR("sandybrown", 0xf4a460)
+    WX_STYLE_COLOR("seagreen", 0x2e8b57)
+    WX_STYLE_COLOR("seashell", 0xfff5ee)
+    WX_STYLE_COLOR("sienna", 0xa0522d)
+    WX_STYLE_COLOR("silver", 0xc0c0c0)
+    WX_STYLE_COLOR("skyblue", 0x87ceeb)
+    WX_STYLE_COLOR("slateblue", 0x6a5acd)
+    WX_STYLE_COLOR("slategray", 0x708090)
+    WX_STYLE_COLOR("slategrey", 0x708090)
+    WX_STYLE_COLOR("snow", 0xfffafa)
+    WX_STYLE_COLOR("springgreen", 0x00ff7f)
+    WX_STYLE_COLOR("steelblue", 0x4682b4)
+    WX_STYLE_COLOR("tan", 0xd2b48c)
+    WX_STYLE_COLOR("teal", 0x008080)
+    WX_STYLE_COLOR("thistle", 0xd8bfd8)
+    WX_STYLE_COLOR("tomato", 0xff6347)
+    WX_STYLE_COLOR("turquoise", 0x40e0d0)
+    WX_STYLE_COLOR("violet", 0xee82ee)
+    WX_STYLE_COLOR("wheat", 0xf5deb3)
+    WX_STYLE_COLOR("white", 0xffffff)
+    WX_STYLE_COLOR("whitesmoke", 0xf5f5f5)
+    WX_STYLE_COLOR("yellow", 0xffff00)
+    WX_STYLE_COLOR("yellowgreen", 0x9acd32)
+#undef WX_STYLE_COLOR
+};
+
+static const size_t WXStyleNameCount = sizeof(WXStyleNames) / sizeof(WXStyleNames[0]);
+
+/*
+ * A perfect hash of the names, built by hash and displace: the names are
+ * spread over buckets by the high bits of their hashes, then each bucket,
+ * the largest first, looks for a displacement which puts all of its names
+ * into free slots. A lookup is one hash, one displacement and one comparison.
+ */
+class WXStyleNameTable {
+public:
+    WXStyleNameTable()
+    {
+        memset(_slots, -1, sizeof(_slots));
+        memset(_displacements, 0, sizeof(_displacements));
+
+        std::vector<size_t> buckets[BucketCount];
+        for (size_t index = 0; index < WXStyleNameCount; index++) {
+            _lengths[index] = strlen(WXStyleNames[index].name);
+            buckets[bucketOf(hashOf(WXStyleNames[index].name, _lengths[index]))].push_back(index);
+        }
+
+        size_t order[BucketCount];
+        for (size_t bucket = 0; bucket < BucketCount; bucket++) {
+            order[bucket] = bucket;
+        }
+        std::sort(order, order + BucketCount, [&buckets](size_t a, size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        for (size_t bucket : order) {
+            std::vector<size_t> &names = buckets[bucket];
+            if (names.empty()) {
+                break;
+            }
+            for (uint32_t displacement = 0; ; displacement++) {
+                std::vector<size_t> slots;
+                bool fits = true;
+                for (size_t index : names) {
+                    size_t slot = slotOf(hashOf(WXStyleNames[index].name, _lengths[index]), displacement);
+                    if (_slots[slot] >= 0 || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                        fits = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+                if (fits) {
+                    for (size_t i = 0; i < names.size(); i++) {
+                        _slots[slots[i]] = (int16_t)names[i];
+                    }
+                    _displacements[bucket] = displacement;
+                    break;
+                }
+            }
+        }
+    }
+
+    const WXStyleName *find(const char *string, size_t length) const
+    {
+        uint64_t hash = hashOf(string, length);
+        int16_t index = _slots[slotOf(hash, _displacements[bucketOf(hash)])];
+        if (index < 0 || _lengths[index] != length || memcmp(WXStyleNames[index].name, string, length) != 0) {
+            return nullptr;
+        }
+        return &WXStyleNames[index];
+    }
+
+private:
+    static const size_t BucketCount = 64;
+    static const size_t SlotCount = 512;
+
+    int16_t _slots[SlotCount];
+    uint32_t _displacements[BucketCount];
+    size_t _lengths[WXStyleNameCount];
+
+    static uint64_t hashOf(const char *string, size_t length)
+    {
+        return WXHashBytes(string, length);
+    }
+
+    static size_t bucketOf(uint64_t hash)
+    {
+        return (size_t)(hash >> 58);
+    }
+
+    static size_t slotOf(uint64_t hash, uint32_t displacement)
+    {
+        return (size_t)(WXHashMix(hash ^ displacement) & (SlotCount - 1));
+    }
+};
+
+static const WXStyleNameTable &WXSharedStyleNameTable()
+{
+    static const WXStyleNameTable table;
+    return table;
+}
+
+static bool hasPrefix(const char *string, const char *end, const char *prefix)
+{
+    size_t length = strlen(prefix);
+    return (size_t)(end - string) >= length && memcmp(string, prefix, length) == 0;
+}
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static int hexValue(char c)
+{
+    if (isDigit(c)) {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// the end of the decimal number at the start of the string, or the string if there isn't one
+static const char *decimalEnd(const char *string, const char *end)
+{
+    const char *p = string;
+    if (p < end && (*p == '+' || *p == '-')) {
+        p++;
+    }
+    const char *digits = p;
+    while (p < end && isDigit(*p)) {
+        p++;
+    }
+    bool hasDigits = p > digits;
+    if (p < end && *p == '.') {
+        const char *fraction = ++p;
+        while (p < end && isDigit(*p)) {
+            p++;
+        }
+        hasDigits = hasDigits || p > fraction;
+    }
+    if (!hasDigits) {
+        return string;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *exponent = p + 1;
+        if (exponent < end && (*exponent == '+' || *exponent == '-')) {
+            exponent++;
+        }
+        if (exponent < end && isDigit(*exponent)) {
+            p = exponent;
+            while (p < end && isDigit(*p)) {
+                p++;
+            }
+        }
+    }
+    return p;
+}
+
+// like scanf %lf, the string isn't null terminated
+static bool scanDouble(const char *&p, const char *end, double &value)
+{
+    while (p < end && isSpace(*p)) {
+        p++;
+    }
+    const char *numberEnd = decimalEnd(p, end);
+    if (numberEnd == p) {
+        return false;
+    }
+    std::string number(p, numberEnd);
+    value = strtod(number.c_str(), nullptr);
+    p = numberEnd;
+    return true;
+}
+
+// like scanf %d
+static bool scanInt(const char *&p, const char *end, int &value)
+{
+    while (p < end && isSpace(*p)) {
+        p++;
+    }
+    const char *start = p;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end || !isDigit(*p)) {
+        p = start;
+        return false;
+    }
+    long long number = 0;
+    for (; p < end && isDigit(*p); p++) {
+        if (number < INT32_MAX) {
+            number = number * 10 + (*p - '0');
+        }
+    }
+    value = (int)(negative ? -std::min(number, (long long)INT32_MAX) : std::min(number, (long long)INT32_MAX));
+    return true;
+}
+
+static bool expect(const char *&p, const char *end, char c)
+{
+    if (p < end && *p == c) {
+        p++;
+        return true;
+    }
+    return false;
+}
+
+static WXStyleColor colorOfRGB(uint32_t rgb, double alpha)
+{
+    return {((rgb >> 16) & 0xff) / 255.0, ((rgb >> 8) & 0xff) / 255.0, (rgb & 0xff) / 255.0, alpha};
+}
+
+static WXStyleColor colorOfName(const WXStyleName &name)
+{
+    return colorOfRGB(name.rgba >> 8, (name.rgba & 0xff) == 0xff ? 1.0 : 0.0);
+}
+
+static bool parseColor(const char *string, const char *end, WXStyleColor &color)
+{
+    if (hasPrefix(string, end, "#")) {
+        // #fff
+        char expanded[6];
+        const char *digits = string + 1;
+        if (end - string == 4) {
+            for (int i = 0; i < 3; i++) {
+                expanded[i * 2] = expanded[i * 2 + 1] = string[i + 1];
+            }
+            digits = expanded;
+            end = expanded + 6;
+        }
+        // #rrggbb
+        uint32_t rgb = 0;
+        for (; digits < end && hexValue(*digits) >= 0; digits++) {
+            rgb = (rgb << 4) | (uint32_t)hexValue(*digits);
+        }
+        color = colorOfRGB(rgb, 1.0);
+        return true;
+    }
+
+    bool hasAlpha = hasPrefix(string, end, "rgba(");
+    if (!hasAlpha && !hasPrefix(string, end, "rgb(")) {
+        return false;
+    }
+    // rgb(r,g,b) and rgba(r,g,b,a), the components which can't be scanned are 0
+    const char *p = string + (hasAlpha ? 5 : 4);
+    int components[3] = {0, 0, 0};
+    double alpha = 1.0;
+    bool scanned = scanInt(p, end, components[0]) && expect(p, end, ',')
+        && scanInt(p, end, components[1]) && expect(p, end, ',')
+        && scanInt(p, end, components[2]);
+    if (scanned && hasAlpha && expect(p, end, ',')) {
+        scanDouble(p, end, alpha);
+    }
+    color = {components[0] / 255.0, components[1] / 255.0, components[2] / 255.0, alpha};
+    return true;
+}
+
+static void parseNumber(const char *string, const char *end, WXStyleValue &value)
+{
+    value.unit = WXStyleUnit::None;
+    value.number = 0;
+
+    if (hasPrefix(string, end, "env(safe-area-inset-") && end[-1] == ')') {
+        static const struct {
+            const char *side;
+            WXStyleUnit unit;
+        } sides[] = {
+            {"top", WXStyleUnit::SafeAreaInsetTop},
+            {"right", WXStyleUnit::SafeAreaInsetRight},
+            {"bottom", WXStyleUnit::SafeAreaInsetBottom},
+            {"left", WXStyleUnit::SafeAreaInsetLeft},
+        };
+        const char *side = string + strlen("env(safe-area-inset-");
+        size_t length = end - 1 - side;
+        for (const auto &entry : sides) {
+            if (strlen(entry.side) == length && memcmp(entry.side, side, length) == 0) {
+                value.unit = entry.unit;
+            }
+        }
+        return;
+    }
+
+    if (end - string >= 2 && end[-1] == 'x' && (end[-2] == 'p' || end[-2] == 'w')) {
+        value.unit = end[-2] == 'p' ? WXStyleUnit::Px : WXStyleUnit::Wx;
+        end -= 2;
+    }
+    const char *p = string;
+    scanDouble(p, end, value.number);
+}
+
+WXStyleKeyword WXStyleKeywordLookup(const char *string, size_t length)
+{
+    const WXStyleName *name = WXSharedStyleNameTable().find(string, length);
+    return name ? name->keyword : WXStyleKeyword::None;
+}
+
+bool WXStyleNamedColorLookup(const char *string, size_t length, WXStyleColor &color)
+{
+    const WXStyleName *name = WXSharedStyleNameTable().find(string, length);
+    if (!name || !name->rgba) {
+        return false;
+    }
+    color = colorOfName(*name);
+    return true;
+}
+
+WXStyleValue WXStyleValueParse(const char *string, size_t length)
+{
+    WXStyleValue value;
+    const char *end = string + length;
+    const WXStyleName *name = WXSharedStyleNameTable().find(string, length);
+    value.keyword = name ? name->keyword : WXStyleKeyword::None;
+    if (name && name->rgba) {
+        value.hasColor = true;
+        value.color = colorOfName(*name);
+    } else {
+        value.hasColor = parseColor(string, end, value.color);
+    }
+    if (!value.hasColor) {
+        value.color = {0, 0, 0, 0};
+    }
+    parseNumber(string, end, value);
+    return value;
+}
+
+WXStyleValueTable::WXStyleValueTable(size_t capacity) : _capacity(capacity)
+{
+}
+
+uint32_t WXStyleValueTable::internLocked(const char *string, size_t length)
+{
+    std::string key(string, length);
+    auto found = _identifiers.find(key);
+    if (found != _identifiers.end()) {
+        return found->second;
+    }
+    if (_values.size() >= _capacity) {
+        return 0;
+    }
+    _values.push_back(WXStyleValueParse(string, length));
+    uint32_t identifier = (uint32_t)_values.size();
+    _identifiers.emplace(std::move(key), identifier);
+    return identifier;
+}
+
+uint32_t WXStyleValueTable::intern(const char *string, size_t length)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return internLocked(string, length);
+}
+
+WXStyleValue WXStyleValueTable::value(uint32_t identifier)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (identifier == 0 || identifier > _values.size()) {
+        return WXStyleValueParse("", 0);
+    }
+    return _values[identifier - 1];
+}
+
+WXStyleValue WXStyleValueTable::lookup(const char *string, size_t length, uint32_t *identifier)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint32_t interned = internLocked(string, length);
+        if (identifier) {
+            *identifier = interned;
+        }
+        if (interned) {
+            return _values[interned - 1];
+        }
+    }
+    return WXStyleValueParse(string, length);
+}
+
+size_t WXStyleValueTable::count()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _values.size();
+}
@@ -0,0 +1,134 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXStyleValue_h
+#define WXStyleValue_h
+
+/*
+ * A portable parser of CSS values, it only depends on the C++ standard library.
+ *
+ * Style values arrive as strings, like "#ffffff", "750px" and "row", and a
+ * page sends the same few strings again and again. WXStyleValueTable parses
+ * each distinct string once, gives it an ID and hands out its value by the
+ * string or by the ID. Keywords and named colors are looked up in a perfect
+ * hash table, so a lookup is one hash and one comparison.
+ *
+ * The parsing follows WXConvert: a string which isn't a number parses as 0,
+ * like -[NSString doubleValue], and the color syntax is "#rgb", "#rrggbb",
+ * "rgb(r,g,b)", "rgba(r,g,b,a)" or a named color.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class WXStyleKeyword : uint8_t {
+    None,
+    Auto,
+    Row,
+    RowReverse,
+    Column,
+    ColumnReverse,
+    FlexStart,
+    FlexEnd,
+    Center,
+    Stretch,
+    SpaceBetween,
+    SpaceAround,
+    Wrap,
+    Nowrap,
+    Relative,
+    Absolute,
+    Fixed,
+    Sticky,
+};
+
+enum class WXStyleUnit : uint8_t {
+    None,
+    Px,
+    Wx,
+    // env(safe-area-inset-top) and so on, the number is 0
+    SafeAreaInsetTop,
+    SafeAreaInsetRight,
+    SafeAreaInsetBottom,
+    SafeAreaInsetLeft,
+};
+
+struct WXStyleColor {
+    // 0 to 1, the components of rgb() aren't clamped
+    double red;
+    double green;
+    double blue;
+    double alpha;
+};
+
+struct WXStyleValue {
+    WXStyleKeyword keyword;
+    // false if the string isn't a color
+    bool hasColor;
+    WXStyleColor color;
+    WXStyleUnit unit;
+    // the leading number, without the unit
+    double number;
+};
+
+WXStyleValue WXStyleValueParse(const char *string, size_t length);
+
+// WXStyleKeyword::None if it isn't a keyword
+WXStyleKeyword WXStyleKeywordLookup(const char *string, size_t length);
+
+// false if it isn't a named color
+bool WXStyleNamedColorLookup(const char *string, size_t length, WXStyleColor &color);
+
+/*
+ * Interns style strings, IDs start from 1 and stay valid for the lifetime of
+ * the table. Beyond the capacity, new strings are parsed but not interned, so
+ * strings which are computed on the fly, like the frames of an animation,
+ * can't grow the table without a limit.
+ *
+ * All the methods are thread safe.
+ */
+class WXStyleValueTable {
+public:
+    explicit WXStyleValueTable(size_t capacity = 4096);
+
+    // the ID of the string, 0 if the table is full
+    uint32_t intern(const char *string, size_t length);
+    // the value of an interned string
+    WXStyleValue value(uint32_t identifier);
+    // the value of the string, and its ID, which is 0 if the table is full
+    WXStyleValue lookup(const char *string, size_t length, uint32_t *identifier = nullptr);
+
+    size_t count();
+
+private:
+    size_t _capacity;
+    std::unordered_map<std::string, uint32_t> _identifiers;
+    // indexed by the ID - 1
+    std::vector<WXStyleValue> _values;
+    std::mutex _mutex;
+
+    uint32_t internLocked(const char *string, size_t length);
+};
+
+#endif /* WXStyleValue_h */
@@ -0,0 +1,52 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <UIKit/UIKit.h>
+#import "WXLayoutDefine.h"
+
+/**
+ * Parses the style strings for WXConvert with WXStyleValue. Each distinct
+ * string is parsed once for all the instances, and a color is created once.
+ */
+@interface WXStyleValueCache : NSObject
+
+/**
+ * Returns nil if the string isn't a color.
+ */
++ (UIColor *)colorWithString:(NSString *)string;
+
+/**
+ * px and unitless values are multiplied by the scale factor, wx values and
+ * safe area insets aren't.
+ */
++ (CGFloat)pixelWithString:(NSString *)string scaleFactor:(CGFloat)scaleFactor;
+
++ (css_position_type_t)positionTypeWithString:(NSString *)string;
++ (css_flex_direction_t)flexDirectionWithString:(NSString *)string;
++ (css_align_t)alignWithString:(NSString *)string;
++ (css_wrap_type_t)wrapTypeWithString:(NSString *)string;
++ (css_justify_t)justifyWithString:(NSString *)string;
+
+/**
+ * The number of the strings which are interned.
+ */
++ (NSUInteger)count;
+
+@end
@@ -0,0 +1,173 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXStyleValueCache.h"
+#import "WXConvert.h"
+#include "WXStyleValue.h"
+#include <mutex>
+#include <vector>
+
+static WXStyleValueTable &WXSharedStyleValueTable()
+{
+    static WXStyleValueTable *table;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        table = new WXStyleValueTable();
+    });
+    return *table;
+}
+
+static WXStyleValue WXStyleValueOfString(NSString *string, uint32_t *identifier)
+{
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    const char *bytes = CFStringGetCStringPtr(cfString, kCFStringEncodingUTF8);
+    if (bytes) {
+        return WXSharedStyleValueTable().lookup(bytes, strlen(bytes), identifier);
+    }
+    
+    // style strings are short, most of them fit in the buffer
+    char buffer[128];
+    CFIndex length = CFStringGetLength(cfString);
+    CFIndex used = 0;
+    if (CFStringGetBytes(cfString, CFRangeMake(0, length), kCFStringEncodingUTF8, 0, false, (UInt8 *)buffer, sizeof(buffer), &used) == length) {
+        return WXSharedStyleValueTable().lookup(buffer, (size_t)used, identifier);
+    }
+    const char *utf8 = string.UTF8String ?: "";
+    return WXSharedStyleValueTable().lookup(utf8, strlen(utf8), identifier);
+}
+
+@implementation WXStyleValueCache
+
+static std::mutex colorsMutex;
+// indexed by the IDs of the strings
+static std::vector<UIColor *> colors;
+
++ (UIColor *)colorWithString:(NSString *)string
+{
+    uint32_t identifier = 0;
+    WXStyleValue value = WXStyleValueOfString(string, &identifier);
+    if (!value.hasColor) {
+        return nil;
+    }
+    
+    if (identifier) {
+        std::lock_guard<std::mutex> lock(colorsMutex);
+        if (identifier < colors.size() && colors[identifier]) {
+            return colors[identifier];
+        }
+    }
+    UIColor *color = [UIColor colorWithRed:value.color.red green:value.color.green blue:value.color.blue alpha:value.color.alpha];
+    if (identifier) {
+        std::lock_guard<std::mutex> lock(colorsMutex);
+        if (identifier >= colors.size()) {
+            colors.resize(identifier + 1);
+        }
+        colors[identifier] = color;
+    }
+    return color;
+}
+
++ (CGFloat)pixelWithString:(NSString *)string scaleFactor:(CGFloat)scaleFactor
+{
+    WXStyleValue value = WXStyleValueOfString(string, nullptr);
+    switch (value.unit) {
+        case WXStyleUnit::Wx:
+            return value.number;
+        case WXStyleUnit::SafeAreaInsetTop:
+            return [WXConvert safeAreaInset:@"top"];
+        case WXStyleUnit::SafeAreaInsetRight:
+            return [WXConvert safeAreaInset:@"right"];
+        case WXStyleUnit::SafeAreaInsetBottom:
+            return [WXConvert safeAreaInset:@"bottom"];
+        case WXStyleUnit::SafeAreaInsetLeft:
+            return [WXConvert safeAreaInset:@"left"];
+        default:
+            return value.number * scaleFactor;
+    }
+}
+
++ (css_position_type_t)positionTypeWithString:(NSString *)string
+{
+    switch (WXStyleValueOfString(string, nullptr).keyword) {
+        case WXStyleKeyword::Absolute:
+        case WXStyleKeyword::Fixed:
+            return CSS_POSITION_ABSOLUTE;
+        default:
+            return CSS_POSITION_RELATIVE;
+    }
+}
+
++ (css_flex_direction_t)flexDirectionWithString:(NSString *)string
+{
+    switch (WXStyleValueOfString(string, nullptr).keyword) {
+        case WXStyleKeyword::ColumnReverse:
+            return CSS_FLEX_DIRECTION_COLUMN_REVERSE;
+        case WXStyleKeyword::Row:
+            return CSS_FLEX_DIRECTION_ROW;
+        case WXStyleKeyword::RowReverse:
+            return CSS_FLEX_DIRECTION_ROW_REVERSE;
+        default:
+            return CSS_FLEX_DIRECTION_COLUMN;
+    }
+}
+
++ (css_align_t)alignWithString:(NSString *)string
+{
+    switch (WXStyleValueOfString(string, nullptr).keyword) {
+        case WXStyleKeyword::FlexStart:
+            return CSS_ALIGN_FLEX_START;
+        case WXStyleKeyword::FlexEnd:
+            return CSS_ALIGN_FLEX_END;
+        case WXStyleKeyword::Center:
+            return CSS_ALIGN_CENTER;
+        case WXStyleKeyword::Auto:
+            return CSS_ALIGN_AUTO;
+        default:
+            return CSS_ALIGN_STRETCH;
+    }
+}
+
++ (css_wrap_type_t)wrapTypeWithString:(NSString *)string
+{
+    return WXStyleValueOfString(string, nullptr).keyword == WXStyleKeyword::Wrap ? CSS_WRAP : CSS_NOWRAP;
+}
+
++ (css_justify_t)justifyWithString:(NSString *)string
+{
+    switch (WXStyleValueOfString(string, nullptr).keyword) {
+        case WXStyleKeyword::Center:
+            return CSS_JUSTIFY_CENTER;
+        case WXStyleKeyword::FlexEnd:
+            return CSS_JUSTIFY_FLEX_END;
+        case WXStyleKeyword::SpaceBetween:
+            return CSS_JUSTIFY_SPACE_BETWEEN;
+        case WXStyleKeyword::SpaceAround:
+            return CSS_JUSTIFY_SPACE_AROUND;
+        default:
+            return CSS_JUSTIFY_FLEX_START;
+    }
+}
+
++ (NSUInteger)count
+{
+    return WXSharedStyleValueTable().count();
+}
+
+@end
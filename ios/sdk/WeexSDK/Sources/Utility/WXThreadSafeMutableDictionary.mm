@@ -0,0 +1,160 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXThreadSafeMutableDictionary.h"
+#import "WXConcurrentMap.h"
+
+struct WXObjectHash {
+    size_t operator()(id object) const
+    {
+        return [object hash];
+    }
+};
+
+struct WXObjectEqual {
+    bool operator()(id object, id other) const
+    {
+        return object == other || [object isEqual:other];
+    }
+};
+
+typedef WXConcurrentMap<id, id, WXObjectHash, WXObjectEqual> WXObjectMap;
+
+@implementation WXThreadSafeMutableDictionary
+{
+    // lookups don't lock, they are far more frequent than writes in the registries
+    WXObjectMap *_map;
+}
+
+- (instancetype)initCommon
+{
+    self = [super init];
+    if (self) {
+        _map = new WXObjectMap();
+    }
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initCommon];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)numItems
+{
+    return [self initCommon];
+}
+
+- (NSDictionary *)initWithContentsOfFile:(NSString *)path
+{
+    self = [self initCommon];
+    if (self) {
+        [[NSDictionary dictionaryWithContentsOfFile:path] enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+            _map->set(key, obj);
+        }];
+    }
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [self initCommon];
+    if (self) {
+        [[[NSDictionary alloc] initWithCoder:aDecoder] enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+            _map->set(key, obj);
+        }];
+    }
+    return self;
+}
+
+- (instancetype)initWithObjects:(const id [])objects forKeys:(const id<NSCopying> [])keys count:(NSUInteger)cnt
+{
+    self = [self initCommon];
+    if (self) {
+        for (NSUInteger i = 0; i < cnt; ++i) {
+            _map->set([keys[i] copyWithZone:NULL], objects[i]);
+        }
+    }
+    return self;
+}
+
+- (NSUInteger)count
+{
+    return _map->size();
+}
+
+- (id)objectForKey:(id)aKey
+{
+    id obj = nil;
+    if (aKey) {
+        _map->find(aKey, obj);
+    }
+    return obj;
+}
+
+- (NSEnumerator *)keyEnumerator
+{
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:_map->size()];
+    _map->forEach([keys](id key, id obj) {
+        [keys addObject:key];
+    });
+    return [keys objectEnumerator];
+}
+
+- (void)setObject:(id)anObject forKey:(id<NSCopying>)aKey
+{
+    if (!aKey) {
+        return;
+    }
+    if (!anObject) {
+        // like a subscript, which the locked dictionary used
+        _map->erase(aKey);
+        return;
+    }
+    _map->set([aKey copyWithZone:NULL], anObject);
+}
+
+- (void)removeObjectForKey:(id)aKey
+{
+    if (aKey) {
+        _map->erase(aKey);
+    }
+}
+
+- (void)removeAllObjects
+{
+    _map->clear();
+}
+
+- (id)copy
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:_map->size()];
+    _map->forEach([dictionary](id key, id obj) {
+        dictionary[key] = obj;
+    });
+    return [dictionary copy];
+}
+
+- (void)dealloc
+{
+    delete _map;
+}
+
+@end
@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  Called with the targets of the timers which fired together, in the order of their deadlines.
+ */
+typedef void (^WXTimerSchedulerHandler)(NSArray *targets);
+
+/**
+ *  Keeps many timers in a timer wheel, and fires them from one NSTimer moved to
+ *  the next deadline, instead of scheduling a timer on the run loop for each of them.
+ *  The timers which fire together are handed over at once, so they can be sent to js
+ *  in one call.
+ *
+ *  It isn't thread safe, use it on the thread of its run loop.
+ */
+@interface WXTimerScheduler : NSObject
+
+/**
+ *  @param runLoop   :   the run loop which fires the timers
+ *  @param handler   :   called with the targets of the timers which fired
+ **/
+- (instancetype)initWithRunLoop:(NSRunLoop *)runLoop handler:(WXTimerSchedulerHandler)handler;
+
+/**
+ *  Schedules a timer, its target is handed to the handler each time it fires.
+ *  @param milliseconds  :   the delay, and the interval of a repeating timer
+ *  @return the identifier of the timer, which isn't 0
+ **/
+- (uint64_t)scheduleTarget:(id)target milliseconds:(NSTimeInterval)milliseconds repeats:(BOOL)repeats;
+
+/**
+ *  Cancels a timer, returns NO if it had already fired or been cancelled.
+ **/
+- (BOOL)cancel:(uint64_t)identifier;
+
+/**
+ *  Cancels all the timers, and stops the NSTimer so the scheduler can be released.
+ **/
+- (void)invalidate;
+
+@property (nonatomic, readonly) NSUInteger count;
+
+@end
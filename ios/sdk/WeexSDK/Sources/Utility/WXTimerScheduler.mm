@@ -0,0 +1,186 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import "WXTimerScheduler.h"
+#import <QuartzCore/QuartzCore.h>
+#import "WXTimerWheel.h"
+
+@interface WXTimerScheduler ()
+
+- (void)_fire;
+
+@end
+
+/**
+ *  The target of the NSTimer, which doesn't retain the scheduler
+ */
+@interface WXTimerSchedulerTarget : NSObject
+
+@property (nonatomic, weak) WXTimerScheduler *scheduler;
+
+@end
+
+@implementation WXTimerSchedulerTarget
+
+- (void)fire:(NSTimer *)timer
+{
+    WXTimerScheduler *scheduler = _scheduler;
+    if (scheduler) {
+        [scheduler _fire];
+    } else {
+        [timer invalidate];
+    }
+}
+
+@end
+
+@implementation WXTimerScheduler
+{
+    WXTimerWheel _wheel;
+    std::vector<uint64_t> _expired;
+    CFTimeInterval _startTime;
+    NSMutableDictionary<NSNumber *, id> *_targets;
+    WXTimerSchedulerHandler _handler;
+    NSRunLoop *_runLoop;
+    NSTimer *_timer;
+    uint64_t _timerDeadline;
+}
+
+- (instancetype)initWithRunLoop:(NSRunLoop *)runLoop handler:(WXTimerSchedulerHandler)handler
+{
+    if (self = [super init]) {
+        _runLoop = runLoop;
+        _handler = [handler copy];
+        _targets = [NSMutableDictionary dictionary];
+        _startTime = CACurrentMediaTime();
+        _timerDeadline = UINT64_MAX;
+    }
+    
+    return self;
+}
+
+- (uint64_t)_now
+{
+    // in milliseconds, as the wheel ticks
+    return (uint64_t)((CACurrentMediaTime() - _startTime) * 1000);
+}
+
+- (uint64_t)scheduleTarget:(id)target milliseconds:(NSTimeInterval)milliseconds repeats:(BOOL)repeats
+{
+    uint64_t delay = milliseconds > 0 ? (uint64_t)ceil(milliseconds) : 0;
+    if (repeats && delay == 0) {
+        // a repeating timer without interval would fire on every tick
+        delay = 1;
+    }
+    
+    // the wheel only moves when it fires, catch it up if no timer is due, so the delay counts from now
+    uint64_t now = [self _now];
+    uint64_t deadline;
+    if (!_wheel.nextDeadline(deadline) || deadline > now) {
+        _expired.clear();
+        _wheel.advance(now, _expired);
+    }
+    uint64_t identifier = _wheel.add(now - _wheel.now() + delay, repeats ? delay : 0);
+    _targets[@(identifier)] = target;
+    [self _rescheduleTimer];
+    return identifier;
+}
+
+- (BOOL)cancel:(uint64_t)identifier
+{
+    [_targets removeObjectForKey:@(identifier)];
+    // the NSTimer is left where it is, waking up once for nothing is cheaper than moving it
+    return _wheel.cancel(identifier);
+}
+
+- (NSUInteger)count
+{
+    return _wheel.count();
+}
+
+- (void)invalidate
+{
+    [_timer invalidate];
+    _timer = nil;
+    _timerDeadline = UINT64_MAX;
+    for (NSNumber *identifier in _targets) {
+        _wheel.cancel([identifier unsignedLongLongValue]);
+    }
+    [_targets removeAllObjects];
+}
+
+- (void)dealloc
+{
+    [_timer invalidate];
+}
+
+- (void)_rescheduleTimer
+{
+    uint64_t deadline;
+    if (!_wheel.nextDeadline(deadline)) {
+        _timerDeadline = UINT64_MAX;
+        _timer.fireDate = [NSDate distantFuture];
+        return;
+    }
+    if (_timer && deadline == _timerDeadline) {
+        return;
+    }
+    
+    _timerDeadline = deadline;
+    uint64_t now = [self _now];
+    NSTimeInterval delay = deadline > now ? (deadline - now) / 1000.0 : 0;
+    NSDate *fireDate = [NSDate dateWithTimeIntervalSinceNow:delay];
+    if (!_timer) {
+        // repeats, so that it stays on the run loop when it is moved
+        WXTimerSchedulerTarget *target = [WXTimerSchedulerTarget new];
+        target.scheduler = self;
+        _timer = [[NSTimer alloc] initWithFireDate:fireDate interval:3600 * 24 target:target selector:@selector(fire:) userInfo:nil repeats:YES];
+        [_runLoop addTimer:_timer forMode:NSRunLoopCommonModes];
+    } else {
+        _timer.fireDate = fireDate;
+    }
+}
+
+- (void)_fire
+{
+    _expired.clear();
+    _wheel.advance([self _now], _expired);
+    _timerDeadline = UINT64_MAX;
+    
+    NSMutableArray *targets = [NSMutableArray arrayWithCapacity:_expired.size()];
+    for (uint64_t identifier : _expired) {
+        NSNumber *key = @(identifier);
+        id target = _targets[key];
+        if (!target) {
+            continue;
+        }
+        [targets addObject:target];
+        if (!_wheel.contains(identifier)) {
+            [_targets removeObjectForKey:key];
+        }
+    }
+    [self _rescheduleTimer];
+    
+    if (targets.count > 0 && _handler) {
+        _handler(targets);
+    }
+}
+
+@end
@@ -0,0 +1,237 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "WXTimerWheel.h"
+
+#include <algorithm>
+
+WXTimerWheel::WXTimerWheel(uint64_t now) : _now(now), _count(0)
+{
+    for (uint32_t list = 0; list <= ReadyList; list++) {
+        _heads[list] = Nil;
+    }
+    for (int level = 0; level < LevelCount; level++) {
+        _occupied[level] = 0;
+    }
+}
+
+void WXTimerWheel::link(uint32_t index, uint32_t list)
+{
+    Timer &timer = _timers[index];
+    timer.list = list;
+    timer.previous = Nil;
+    timer.next = _heads[list];
+    if (timer.next != Nil) {
+        _timers[timer.next].previous = index;
+    }
+    _heads[list] = index;
+    if (list < ReadyList) {
+        _occupied[list / SlotCount] |= 1ULL << (list & SlotMask);
+    }
+}
+
+void WXTimerWheel::unlink(uint32_t index)
+{
+    Timer &timer = _timers[index];
+    if (timer.previous != Nil) {
+        _timers[timer.previous].next = timer.next;
+    } else {
+        _heads[timer.list] = timer.next;
+    }
+    if (timer.next != Nil) {
+        _timers[timer.next].previous = timer.previous;
+    }
+    if (timer.list < ReadyList && _heads[timer.list] == Nil) {
+        _occupied[timer.list / SlotCount] &= ~(1ULL << (timer.list & SlotMask));
+    }
+    timer.list = NoList;
+}
+
+void WXTimerWheel::schedule(uint32_t index)
+{
+    uint64_t deadline = _timers[index].deadline;
+    if (deadline <= _now) {
+        link(index, ReadyList);
+        return;
+    }
+
+    // the level of the highest bit where the deadline differs from now
+    uint64_t difference = deadline ^ _now;
+    int level = 0;
+    while (level < LevelCount - 1 && (difference >> (LevelBits * (level + 1))) != 0) {
+        level++;
+    }
+    // beyond the last level, the timer goes round it until it gets closer
+    uint32_t slot = (uint32_t)(deadline >> (LevelBits * level)) & SlotMask;
+    link(index, level * SlotCount + slot);
+}
+
+void WXTimerWheel::release(uint32_t index)
+{
+    _timers[index].generation++;
+    _free.push_back(index);
+    _count--;
+}
+
+uint32_t WXTimerWheel::indexOf(uint64_t identifier) const
+{
+    uint32_t index = (uint32_t)identifier;
+    if (index >= _timers.size() || _timers[index].generation != (uint32_t)(identifier >> 32) || _timers[index].list == NoList) {
+        return Nil;
+    }
+    return index;
+}
+
+uint64_t WXTimerWheel::add(uint64_t delay, uint64_t interval)
+{
+    uint32_t index;
+    if (!_free.empty()) {
+        index = _free.back();
+        _free.pop_back();
+    } else {
+        index = (uint32_t)_timers.size();
+        // generations start at 1, so identifiers aren't 0
+        _timers.push_back(Timer{0, 0, 1, NoList, Nil, Nil});
+    }
+    Timer &timer = _timers[index];
+    timer.deadline = _now + delay;
+    timer.interval = interval;
+    schedule(index);
+    _count++;
+    return identifierOf(index);
+}
+
+bool WXTimerWheel::cancel(uint64_t identifier)
+{
+    uint32_t index = indexOf(identifier);
+    if (index == Nil) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+bool WXTimerWheel::contains(uint64_t identifier) const
+{
+    return indexOf(identifier) != Nil;
+}
+
+void WXTimerWheel::advance(uint64_t now, std::vector<uint64_t> &expired)
+{
+    _pending.clear();
+    for (uint32_t index = _heads[ReadyList]; index != Nil; index = _timers[index].next) {
+        _pending.push_back(index);
+    }
+
+    if (now > _now) {
+        // takes the timers of every slot the wheel passes, level by level
+        for (int level = 0; level < LevelCount; level++) {
+            int shift = LevelBits * level;
+            uint64_t passed = (now >> shift) - (_now >> shift);
+            if (passed == 0) {
+                break;
+            }
+            uint32_t first = (uint32_t)((_now >> shift) + 1) & SlotMask;
+            uint32_t slots = passed < SlotCount ? (uint32_t)passed : SlotCount;
+            for (uint32_t i = 0; i < slots; i++) {
+                uint32_t list = level * SlotCount + ((first + i) & SlotMask);
+                for (uint32_t index = _heads[list]; index != Nil; index = _timers[index].next) {
+                    _pending.push_back(index);
+                }
+            }
+        }
+        _now = now;
+    }
+
+    size_t begin = expired.size();
+    for (uint32_t index : _pending) {
+        unlink(index);
+        if (_timers[index].deadline <= _now) {
+            expired.push_back(identifierOf(index));
+        } else {
+            schedule(index);
+        }
+    }
+
+    // in the order of the deadlines, then of the identifiers
+    std::sort(expired.begin() + begin, expired.end(), [this](uint64_t a, uint64_t b) {
+        const Timer &first = _timers[(uint32_t)a];
+        const Timer &second = _timers[(uint32_t)b];
+        return first.deadline != second.deadline ? first.deadline < second.deadline : (uint32_t)a < (uint32_t)b;
+    });
+
+    for (size_t i = begin; i < expired.size(); i++) {
+        uint32_t index = (uint32_t)expired[i];
+        Timer &timer = _timers[index];
+        if (timer.interval > 0) {
+            // skips the intervals which have already passed, like NSTimer does
+            timer.deadline += timer.interval;
+            if (timer.deadline <= _now) {
+                timer.deadline = _now + timer.interval;
+            }
+            schedule(index);
+        } else {
+            release(index);
+        }
+    }
+}
+
+bool WXTimerWheel::nextDeadline(uint64_t &deadline) const
+{
+    if (_heads[ReadyList] != Nil) {
+        deadline = _now;
+        return true;
+    }
+
+    // the first level with a timer has the earliest one, as the levels don't overlap
+    for (int level = 0; level < LevelCount; level++) {
+        uint64_t occupied = _occupied[level];
+        if (!occupied) {
+            continue;
+        }
+        int shift = LevelBits * level;
+        uint32_t position = (uint32_t)(_now >> shift) & SlotMask;
+        // the distance to the next non-empty slot, a full turn for the slot of now
+        uint64_t rotated = occupied;
+        if (position + 1 < SlotCount) {
+            rotated = occupied >> (position + 1) | occupied << (SlotCount - position - 1);
+        }
+        uint64_t distance = (uint64_t)__builtin_ctzll(rotated) + 1;
+        uint64_t start = ((_now >> shift) + distance) << shift;
+
+        deadline = start;
+        if (level > 0 && level < LevelCount - 1) {
+            // the slot is moved down at start, but its timers may all expire later
+            uint32_t list = level * SlotCount + (uint32_t)((position + distance) & SlotMask);
+            uint64_t earliest = UINT64_MAX;
+            uint32_t visited = 0;
+            for (uint32_t index = _heads[list]; index != Nil && visited < 16; index = _timers[index].next) {
+                earliest = std::min(earliest, _timers[index].deadline);
+                visited++;
+            }
+            if (visited < 16) {
+                deadline = earliest;
+            }
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,110 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXTimerWheel_h
+#define WXTimerWheel_h
+
+/*
+ * A hierarchical timer wheel, it only depends on the C++ standard library.
+ *
+ * Time is counted in ticks. The wheel has four levels of 64 slots, a timer
+ * is kept in the level matching how far its deadline is, and moves down to
+ * a finer level when the wheel reaches its slot. Adding and cancelling a
+ * timer are O(1), and advancing the wheel only visits the slots it passes.
+ *
+ * The deadline of the next timer is known, so the owner needs one system
+ * timer, moved to that deadline, whatever the number of timers is.
+ *
+ * It isn't thread safe, use it from one thread.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class WXTimerWheel {
+public:
+    explicit WXTimerWheel(uint64_t now = 0);
+
+    /*
+     * Adds a timer which expires delay ticks from now, and every interval
+     * ticks after that if the interval isn't 0. Returns its identifier,
+     * which isn't 0.
+     */
+    uint64_t add(uint64_t delay, uint64_t interval = 0);
+    // returns false if the timer has expired or was cancelled
+    bool cancel(uint64_t identifier);
+    bool contains(uint64_t identifier) const;
+
+    /*
+     * Moves the wheel to now, and appends the timers which expired, ordered
+     * by deadline. A repeating timer stays in the wheel until it is cancelled,
+     * and expires once even if several of its intervals have passed.
+     */
+    void advance(uint64_t now, std::vector<uint64_t> &expired);
+
+    /*
+     * The tick the wheel should be advanced to, which is the deadline of the
+     * next timer, or earlier when that timer has to move down to a finer
+     * level first. Returns false if there are no timers.
+     */
+    bool nextDeadline(uint64_t &deadline) const;
+
+    uint64_t now() const { return _now; }
+    size_t count() const { return _count; }
+
+private:
+    static const int LevelBits = 6;
+    static const int LevelCount = 4;
+    static const uint32_t SlotCount = 1 << LevelBits;
+    static const uint32_t SlotMask = SlotCount - 1;
+    // the list of the timers which expired when they were added
+    static const uint32_t ReadyList = LevelCount * SlotCount;
+    static const uint32_t NoList = ReadyList + 1;
+    static const uint32_t Nil = UINT32_MAX;
+
+    struct Timer {
+        uint64_t deadline;
+        uint64_t interval;
+        // increments when the timer is reused, so stale identifiers don't match
+        uint32_t generation;
+        uint32_t list;
+        uint32_t previous;
+        uint32_t next;
+    };
+
+    uint64_t _now;
+    size_t _count;
+    std::vector<Timer> _timers;
+    std::vector<uint32_t> _free;
+    uint32_t _heads[ReadyList + 1];
+    // the non-empty slots of each level
+    uint64_t _occupied[LevelCount];
+    std::vector<uint32_t> _pending;
+
+    void link(uint32_t index, uint32_t list);
+    void unlink(uint32_t index);
+    void schedule(uint32_t index);
+    void release(uint32_t index);
+    uint32_t indexOf(uint64_t identifier) const;
+    uint64_t identifierOf(uint32_t index) const { return (uint64_t)_timers[index].generation << 32 | index; }
+};
+
+#endif /* WXTimerWheel_h */
@@ -0,0 +1,225 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "WXTransitionEngine.h"
+
+#include <algorithm>
+#include <math.h>
+
+WXTimingCurve::WXTimingCurve() : _linear(true), _ax(0), _bx(0), _cx(1), _ay(0), _by(0), _cy(1)
+{
+    for (int i = 0; i <= SampleCount; i++) {
+        _samples[i] = (float)i / SampleCount;
+    }
+}
+
+WXTimingCurve::WXTimingCurve(double x1, double y1, double x2, double y2) : _linear(x1 == y1 && x2 == y2)
+{
+    _cx = 3.0 * x1;
+    _bx = 3.0 * (x2 - x1) - _cx;
+    _ax = 1.0 - _cx - _bx;
+
+    _cy = 3.0 * y1;
+    _by = 3.0 * (y2 - y1) - _cy;
+    _ay = 1.0 - _cy - _by;
+
+    for (int i = 0; i <= SampleCount; i++) {
+        _samples[i] = _linear ? (float)i / SampleCount : (float)solve((double)i / SampleCount);
+    }
+}
+
+float WXTimingCurve::progress(float x) const
+{
+    if (!(x > 0)) {
+        return _samples[0];
+    }
+    if (x >= 1) {
+        return _samples[SampleCount];
+    }
+    float position = x * SampleCount;
+    int index = (int)position;
+    float fraction = position - index;
+    return _samples[index] + (_samples[index + 1] - _samples[index]) * fraction;
+}
+
+double WXTimingCurve::solve(double x) const
+{
+    if (_linear) {
+        return x;
+    }
+
+    const double epsilon = 1e-7;
+    // Newton's method first, it converges fast where the slope isn't flat
+    double t = x;
+    for (int i = 0; i < 8; i++) {
+        double error = sampleX(t) - x;
+        if (fabs(error) < epsilon) {
+            return sampleY(t);
+        }
+        double derivative = sampleDerivativeX(t);
+        if (fabs(derivative) < 1e-6) {
+            break;
+        }
+        t -= error / derivative;
+    }
+
+    // then bisection, which always converges
+    double low = 0.0;
+    double high = 1.0;
+    t = std::min(std::max(x, low), high);
+    for (int i = 0; i < 64 && low < high; i++) {
+        double sample = sampleX(t);
+        if (fabs(sample - x) < epsilon) {
+            break;
+        }
+        if (x > sample) {
+            low = t;
+        } else {
+            high = t;
+        }
+        t = (high - low) * 0.5 + low;
+    }
+    return sampleY(t);
+}
+
+WXTransitionEngine::WXTransitionEngine() : _nextIdentifier(1)
+{
+}
+
+uint32_t WXTransitionEngine::add(const WXTimingCurve &curve, double start, double duration, const float *from, const float *to, size_t count)
+{
+    uint32_t identifier = _nextIdentifier++;
+    if (_nextIdentifier == 0) {
+        _nextIdentifier = 1;
+    }
+
+    Transition transition = {identifier, curve, start, duration, _from.size(), count, false};
+    _transitions.push_back(transition);
+    for (size_t i = 0; i < count; i++) {
+        _from.push_back(from[i]);
+        _delta.push_back(to[i] - from[i]);
+        _values.push_back(from[i]);
+    }
+    return identifier;
+}
+
+void WXTransitionEngine::removeAt(size_t index)
+{
+    const Transition &transition = _transitions[index];
+    size_t begin = transition.offset;
+    size_t end = begin + transition.count;
+    _from.erase(_from.begin() + begin, _from.begin() + end);
+    _delta.erase(_delta.begin() + begin, _delta.begin() + end);
+    _values.erase(_values.begin() + begin, _values.begin() + end);
+    for (size_t i = index + 1; i < _transitions.size(); i++) {
+        _transitions[i].offset -= transition.count;
+    }
+    _transitions.erase(_transitions.begin() + index);
+}
+
+void WXTransitionEngine::remove(uint32_t identifier)
+{
+    for (size_t i = 0; i < _transitions.size(); i++) {
+        if (_transitions[i].identifier == identifier) {
+            removeAt(i);
+            return;
+        }
+    }
+}
+
+bool WXTransitionEngine::contains(uint32_t identifier) const
+{
+    for (const Transition &transition : _transitions) {
+        if (transition.identifier == identifier) {
+            return !transition.finished;
+        }
+    }
+    return false;
+}
+
+double WXTransitionEngine::elapsed(uint32_t identifier, double now) const
+{
+    for (const Transition &transition : _transitions) {
+        if (transition.identifier == identifier) {
+            return now - transition.start;
+        }
+    }
+    return 0;
+}
+
+void WXTransitionEngine::removeFinished()
+{
+    // compacts the channels in one pass
+    size_t channel = 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < _transitions.size(); i++) {
+        Transition &transition = _transitions[i];
+        if (transition.finished) {
+            continue;
+        }
+        if (transition.offset != channel) {
+            std::copy(_from.begin() + transition.offset, _from.begin() + transition.offset + transition.count, _from.begin() + channel);
+            std::copy(_delta.begin() + transition.offset, _delta.begin() + transition.offset + transition.count, _delta.begin() + channel);
+            std::copy(_values.begin() + transition.offset, _values.begin() + transition.offset + transition.count, _values.begin() + channel);
+            transition.offset = channel;
+        }
+        channel += transition.count;
+        if (kept != i) {
+            _transitions[kept] = transition;
+        }
+        kept++;
+    }
+    _transitions.erase(_transitions.begin() + kept, _transitions.end());
+    _from.resize(channel);
+    _delta.resize(channel);
+    _values.resize(channel);
+}
+
+void WXTransitionEngine::tick(double now, std::vector<WXTransitionFrame> &frames)
+{
+    frames.clear();
+    removeFinished();
+
+    for (Transition &transition : _transitions) {
+        if (now < transition.start) {
+            continue;
+        }
+        float x = transition.duration > 0 ? (float)((now - transition.start) / transition.duration) : 1.0f;
+        transition.finished = x >= 1.0f;
+        float progress = transition.finished ? 1.0f : transition.curve.progress(x);
+
+        const float *from = _from.data() + transition.offset;
+        const float *delta = _delta.data() + transition.offset;
+        float *values = _values.data() + transition.offset;
+        for (size_t i = 0; i < transition.count; i++) {
+            values[i] = from[i] + delta[i] * progress;
+        }
+        frames.push_back({transition.identifier, transition.finished, values, transition.count});
+    }
+}
+
+size_t WXTransitionEngine::count() const
+{
+    size_t count = 0;
+    for (const Transition &transition : _transitions) {
+        count += transition.finished ? 0 : 1;
+    }
+    return count;
+}
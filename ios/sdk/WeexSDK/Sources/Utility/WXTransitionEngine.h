@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef WXTransitionEngine_h
+#define WXTransitionEngine_h
+
+/*
+ * A portable timing and interpolation engine for transitions, it only depends
+ * on the C++ standard library.
+ *
+ * A timing curve solves its cubic bezier once, into a lookup table, so the
+ * progress of a frame is a table lookup instead of a Newton iteration.
+ *
+ * The engine flattens the properties of all the running transitions into
+ * float channels, a length is one channel and a color is four, and keeps
+ * them in contiguous arrays, so a tick interpolates each transition in one
+ * loop the compiler vectorizes. Transitions are driven by time, not by
+ * counting frames, so a dropped frame doesn't slow them down.
+ *
+ * It isn't thread safe, all the transitions of the SDK run on the component
+ * thread.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class WXTimingCurve {
+public:
+    // linear
+    WXTimingCurve();
+    // cubic-bezier(x1, y1, x2, y2)
+    WXTimingCurve(double x1, double y1, double x2, double y2);
+
+    bool isLinear() const { return _linear; }
+
+    // the progress at the fraction x of the duration, from the lookup table
+    float progress(float x) const;
+
+    // the exact progress, by solving the curve
+    double solve(double x) const;
+
+private:
+    static const int SampleCount = 256;
+
+    bool _linear;
+    double _ax, _bx, _cx;
+    double _ay, _by, _cy;
+    float _samples[SampleCount + 1];
+
+    double sampleX(double t) const { return ((_ax * t + _bx) * t + _cx) * t; }
+    double sampleY(double t) const { return ((_ay * t + _by) * t + _cy) * t; }
+    double sampleDerivativeX(double t) const { return (3.0 * _ax * t + 2.0 * _bx) * t + _cx; }
+};
+
+struct WXTransitionFrame {
+    uint32_t identifier;
+    // the values are the final ones, and the transition is removed at the next tick
+    bool finished;
+    // valid until the engine is changed
+    const float *values;
+    size_t count;
+};
+
+class WXTransitionEngine {
+public:
+    WXTransitionEngine();
+
+    /*
+     * Adds a transition of count channels, which starts at the time, in
+     * seconds, and lasts for the duration. Returns its identifier, which
+     * isn't 0.
+     */
+    uint32_t add(const WXTimingCurve &curve, double start, double duration, const float *from, const float *to, size_t count);
+    void remove(uint32_t identifier);
+    bool contains(uint32_t identifier) const;
+
+    // seconds since the transition started, negative before it starts
+    double elapsed(uint32_t identifier, double now) const;
+
+    // interpolates the transitions which have started, and returns their frames
+    void tick(double now, std::vector<WXTransitionFrame> &frames);
+
+    // the transitions which aren't finished
+    size_t count() const;
+
+private:
+    struct Transition {
+        uint32_t identifier;
+        WXTimingCurve curve;
+        double start;
+        double duration;
+        // of the channels in the arrays
+        size_t offset;
+        size_t count;
+        bool finished;
+    };
+
+    uint32_t _nextIdentifier;
+    std::vector<Transition> _transitions;
+    std::vector<float> _from;
+    std::vector<float> _delta;
+    std::vector<float> _values;
+
+    void removeAt(size_t index);
+    void removeFinished();
+};
+
+#endif /* WXTransitionEngine_h */
@@ -25,6 +25,7 @@
 #import "WXSDKInstance_private.h"
 #import "WXTransform.h"
 #import "WXTracingManager.h"
+#import "WXDisplayQueue.h"
 
 #define WX_BOARD_RADIUS_RESET_ALL(key)\
 do {\
@@ -330,6 +331,10 @@ do {\
     
     [_view removeFromSuperview];
     _view = nil;
+    if (_layer) {
+        // the view is gone, e.g. a cell scrolled off the screen, nothing to draw for it
+        [WXDisplayQueue cancelBlockForKey:_layer];
+    }
     [_layer removeFromSuperlayer];
     _layer = nil;
     
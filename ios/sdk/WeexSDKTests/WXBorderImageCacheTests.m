@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import "WXBorderImageCache.h"
+#import "WXComponent.h"
+#import "WXSDKInstance.h"
+
+@interface WXBorderImageCacheTests : XCTestCase
+
+@end
+
+@implementation WXBorderImageCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+    [WXBorderImageCache removeAllImages];
+}
+
+- (WXComponent *)componentWithStyles:(NSDictionary *)styles
+{
+    return [[WXComponent alloc] initWithRef:@"0" type:@"div" styles:styles attributes:@{} events:@[] weexInstance:[[WXSDKInstance alloc] init]];
+}
+
+- (UIImage *)imageForComponent:(WXComponent *)component drawn:(NSUInteger *)drawn
+{
+    CGSize size = CGSizeMake(100, 50);
+    return [WXBorderImageCache imageForComponent:component size:size opaque:NO drawing:^UIImage *{
+        (*drawn)++;
+        UIGraphicsBeginImageContextWithOptions(size, NO, 0.0);
+        UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+        UIGraphicsEndImageContext();
+        return image;
+    }];
+}
+
+- (void)testSameBordersShareImage
+{
+    NSDictionary *styles = @{@"borderWidth": @"2", @"borderColor": @"#dddddd", @"borderRadius": @"8", @"borderTopStyle": @"dashed", @"backgroundColor": @"#ffffff"};
+    NSUInteger drawn = 0;
+    UIImage *image = [self imageForComponent:[self componentWithStyles:styles] drawn:&drawn];
+    UIImage *sharedImage = [self imageForComponent:[self componentWithStyles:styles] drawn:&drawn];
+    XCTAssertEqual(drawn, 1);
+    XCTAssertEqual(image, sharedImage);
+    
+    NSMutableDictionary *otherStyles = [styles mutableCopy];
+    otherStyles[@"backgroundColor"] = @"#000000";
+    [self imageForComponent:[self componentWithStyles:otherStyles] drawn:&drawn];
+    XCTAssertEqual(drawn, 2);
+    
+    NSDictionary *metrics = [WXBorderImageCache metrics];
+    XCTAssertEqualObjects(metrics[@"hits"], @1);
+    XCTAssertEqualObjects(metrics[@"misses"], @2);
+    XCTAssertEqualObjects(metrics[@"count"], @2);
+}
+
+- (void)testCostLimit
+{
+    NSUInteger drawn = 0;
+    [WXBorderImageCache setCostLimit:1];
+    [self imageForComponent:[self componentWithStyles:@{@"borderWidth": @"1"}] drawn:&drawn];
+    [self imageForComponent:[self componentWithStyles:@{@"borderWidth": @"1"}] drawn:&drawn];
+    [WXBorderImageCache setCostLimit:8 * 1024 * 1024];
+    XCTAssertEqual(drawn, 2);
+    XCTAssertEqualObjects([WXBorderImageCache metrics][@"count"], @0);
+}
+
+@end
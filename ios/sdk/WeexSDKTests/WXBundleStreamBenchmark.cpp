@@ -0,0 +1,409 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXBundleStreamCore, and benchmarks downloading a bundle from a
+ * local HTTP server, which sends it in chunks at the pace of a slow network,
+ * processing it while it streams against processing it after the last byte.
+ * It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -pthread -I../WeexSDK/Sources/Utility WXBundleStreamBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXBundleStreamCore.cpp -o bundle_stream_benchmark
+ *   ./bundle_stream_benchmark [directory]
+ */
+
+#include "WXBundleStreamCore.h"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static std::string md5Of(const std::string &text, size_t chunk)
+{
+    WXMD5 hash;
+    for (size_t i = 0; i < text.size(); i += chunk) {
+        hash.update(text.data() + i, std::min(chunk, text.size() - i));
+    }
+    return hash.finish();
+}
+
+static void checkMD5()
+{
+    CHECK(md5Of("", 1) == "d41d8cd98f00b204e9800998ecf8427e");
+    CHECK(md5Of("abc", 1) == "900150983cd24fb0d6963f7d28e17f72");
+    std::string fox = "The quick brown fox jumps over the lazy dog";
+    for (size_t chunk = 1; chunk <= fox.size(); chunk++) {
+        CHECK(md5Of(fox, chunk) == "9e107d9d372bb6826bd81d3542a419d6");
+    }
+    std::string million(1000000, 'a');
+    CHECK(md5Of(million, 1000000) == "7707d6ae4e027c70eea2a935c2296f21");
+    CHECK(md5Of(million, 63) == "7707d6ae4e027c70eea2a935c2296f21");
+}
+
+static bool stream(const std::string &bytes, size_t chunk, std::vector<uint16_t> &characters)
+{
+    WXBundleStreamCore core("", 0);
+    for (size_t i = 0; i < bytes.size(); i += chunk) {
+        core.append(bytes.data() + i, std::min(chunk, bytes.size() - i));
+    }
+    bool finished = core.finish();
+    characters = core.characters();
+    return finished;
+}
+
+static void checkDecoding()
+{
+    // a, é, €, 中, 😀 and a byte order mark
+    std::string text = "a\xc3\xa9\xe2\x82\xac\xe4\xb8\xad\xf0\x9f\x98\x80z";
+    std::vector<uint16_t> expected = {'a', 0xe9, 0x20ac, 0x4e2d, 0xd83d, 0xde00, 'z'};
+    for (size_t chunk = 1; chunk <= text.size(); chunk++) {
+        std::vector<uint16_t> characters;
+        CHECK(stream(text, chunk, characters));
+        CHECK(characters == expected);
+    }
+
+    WXBundleStreamCore core("", 0);
+    core.append("\xef\xbb", 2);
+    core.append("\xbf" "a", 2);
+    CHECK(core.finish() && core.hasByteOrderMark() && core.characters().size() == 2);
+
+    const char *invalid[] = {
+        "\xc0\x80",          // overlong
+        "\xe0\x80\x80",      // overlong
+        "\xed\xa0\x80",      // surrogate
+        "\xf4\x90\x80\x80",  // above U+10FFFF
+        "\xf5\x80\x80\x80",
+        "a\x80",             // lone continuation
+        "\xe2\x28\xa1",      // broken sequence
+        "\xe2\x82",          // cut at the end
+    };
+    for (const char *bytes : invalid) {
+        for (size_t chunk = 1; chunk <= 2; chunk++) {
+            std::vector<uint16_t> characters;
+            CHECK(!stream(bytes, chunk, characters));
+        }
+    }
+}
+
+static size_t cachedFiles(const std::string &directory)
+{
+    size_t count = 0;
+    if (DIR *dir = opendir(directory.c_str())) {
+        while (struct dirent *item = readdir(dir)) {
+            count += item->d_name[0] != '.';
+        }
+        closedir(dir);
+    }
+    return count;
+}
+
+static std::string readFile(const std::string &path)
+{
+    std::string contents;
+    if (FILE *file = fopen(path.c_str(), "rb")) {
+        char buffer[4096];
+        size_t length;
+        while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            contents.append(buffer, length);
+        }
+        fclose(file);
+    }
+    return contents;
+}
+
+static void clearDirectory(const std::string &directory)
+{
+    if (DIR *dir = opendir(directory.c_str())) {
+        while (struct dirent *item = readdir(dir)) {
+            if (item->d_name[0] != '.') {
+                ::unlink((directory + "/" + item->d_name).c_str());
+            }
+        }
+        closedir(dir);
+    }
+}
+
+static void checkCache(const std::string &directory)
+{
+    clearDirectory(directory);
+    std::string bundle = "var a = 1;\n// \xe4\xb8\xad\n";
+    {
+        WXBundleStreamCore core(directory, 0);
+        core.append(bundle.data(), 5);
+        CHECK(cachedFiles(directory) == 1);
+        core.append(bundle.data() + 5, bundle.size() - 5);
+        CHECK(core.finish());
+        CHECK(core.md5() == md5Of(bundle, 1));
+        CHECK(core.cachePath() == directory + "/" + core.md5() + ".js");
+        CHECK(readFile(core.cachePath()) == bundle);
+    }
+    {
+        // the same bundle shares the file
+        WXBundleStreamCore core(directory, 0);
+        core.append(bundle.data(), bundle.size());
+        CHECK(core.finish());
+        CHECK(cachedFiles(directory) == 1);
+    }
+    {
+        // a cancelled, an invalid and an unfinished stream leave nothing
+        WXBundleStreamCore cancelled(directory, 0);
+        cancelled.append("var b;", 6);
+        cancelled.cancel();
+        WXBundleStreamCore invalid(directory, 0);
+        invalid.append("var c = '\xff';", 12);
+        CHECK(!invalid.finish());
+        {
+            WXBundleStreamCore unfinished(directory, 0);
+            unfinished.append("var d;", 6);
+        }
+        CHECK(cachedFiles(directory) == 1);
+    }
+    {
+        // a limit of two bundles removes the oldest
+        std::string second(bundle.size(), 'x');
+        std::string third(bundle.size(), 'y');
+        WXBundleStreamCore core2(directory, 0);
+        core2.append(second.data(), second.size());
+        core2.finish();
+        struct timeval old[2] = {{1000, 0}, {1000, 0}};
+        utimes(core2.cachePath().c_str(), old);
+        WXBundleStreamCore core3(directory, bundle.size() * 2);
+        core3.append(third.data(), third.size());
+        core3.finish();
+        CHECK(cachedFiles(directory) == 2);
+        CHECK(access(core2.cachePath().c_str(), F_OK) != 0);
+        CHECK(access(core3.cachePath().c_str(), F_OK) == 0);
+    }
+    clearDirectory(directory);
+}
+
+/*
+ * The local HTTP stand-in: it answers each connection with the bundle, sent
+ * in chunks with a delay between them.
+ */
+class BundleServer {
+public:
+    BundleServer(const std::string &bundle, size_t chunk, int delayMicroseconds)
+    : _bundle(bundle), _chunk(chunk), _delay(delayMicroseconds), _stopped(false)
+    {
+        _socket = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(_socket, (sockaddr *)&address, sizeof(address));
+        socklen_t length = sizeof(address);
+        getsockname(_socket, (sockaddr *)&address, &length);
+        _port = ntohs(address.sin_port);
+        listen(_socket, 4);
+        _thread = std::thread([this] { serve(); });
+    }
+
+    ~BundleServer()
+    {
+        _stopped = true;
+        shutdown(_socket, SHUT_RDWR);
+        ::close(_socket);
+        _thread.join();
+    }
+
+    int port() const { return _port; }
+
+private:
+    std::string _bundle;
+    size_t _chunk;
+    int _delay;
+    int _socket;
+    int _port;
+    bool _stopped;
+    std::thread _thread;
+
+    void serve()
+    {
+        while (!_stopped) {
+            int connection = accept(_socket, nullptr, nullptr);
+            if (connection < 0) {
+                return;
+            }
+            std::string request;
+            char buffer[1024];
+            while (request.find("\r\n\r\n") == std::string::npos) {
+                ssize_t length = recv(connection, buffer, sizeof(buffer), 0);
+                if (length <= 0) {
+                    break;
+                }
+                request.append(buffer, length);
+            }
+            std::string header = "HTTP/1.1 200 OK\r\nContent-Type: application/javascript\r\nContent-Length: "
+                + std::to_string(_bundle.size()) + "\r\nConnection: close\r\n\r\n";
+            send(connection, header.data(), header.size(), 0);
+            for (size_t offset = 0; offset < _bundle.size(); offset += _chunk) {
+                usleep(_delay);
+                send(connection, _bundle.data() + offset, std::min(_chunk, _bundle.size() - offset), 0);
+            }
+            ::close(connection);
+        }
+    }
+};
+
+struct Download {
+    // from the request to the bundle ready to be executed
+    double totalTime;
+    // from the last byte to the bundle ready to be executed
+    double tailTime;
+    std::string md5;
+    std::vector<uint16_t> characters;
+};
+
+static double milliseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static Download download(int port, bool streaming, const std::string &directory)
+{
+    auto start = std::chrono::steady_clock::now();
+    int connection = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    connect(connection, (sockaddr *)&address, sizeof(address));
+    std::string request = "GET /bundle.js HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    send(connection, request.data(), request.size(), 0);
+
+    WXBundleStreamCore core(streaming ? directory : "", 0);
+    std::string buffered;
+    std::string header;
+    bool inBody = false;
+    char buffer[16 * 1024];
+    ssize_t length;
+    while ((length = recv(connection, buffer, sizeof(buffer), 0)) > 0) {
+        const char *body = buffer;
+        size_t bodyLength = length;
+        if (!inBody) {
+            header.append(buffer, length);
+            size_t end = header.find("\r\n\r\n");
+            if (end == std::string::npos) {
+                continue;
+            }
+            inBody = true;
+            size_t contentLength = strtoul(header.c_str() + header.find("Content-Length: ") + 16, nullptr, 10);
+            if (streaming) {
+                core.reserve(contentLength);
+            }
+            body = header.data() + end + 4;
+            bodyLength = header.size() - end - 4;
+        }
+        if (streaming) {
+            core.append(body, bodyLength);
+        } else {
+            buffered.append(body, bodyLength);
+        }
+    }
+    ::close(connection);
+    auto lastByte = std::chrono::steady_clock::now();
+
+    if (!streaming) {
+        // what converting the whole data to a string and hashing it does
+        core.reserve(buffered.size());
+        core.append(buffered.data(), buffered.size());
+    }
+    core.finish();
+    auto ready = std::chrono::steady_clock::now();
+
+    Download result;
+    result.totalTime = milliseconds(start, ready);
+    result.tailTime = milliseconds(lastByte, ready);
+    result.md5 = core.md5();
+    result.characters = core.characters();
+    return result;
+}
+
+static std::string makeBundle(size_t functions)
+{
+    std::string bundle = "// { \"framework\": \"Vue\" }\n";
+    for (size_t i = 0; i < functions; i++) {
+        bundle += "function render" + std::to_string(i) + "(h) { return h('div', { staticClass: 'item' }, ['\xe5\x95\x86\xe5\x93\x81 " + std::to_string(i) + "']) }\n";
+    }
+    return bundle;
+}
+
+static void checkDownload(const std::string &directory)
+{
+    clearDirectory(directory);
+    std::string bundle = makeBundle(2000);
+    BundleServer server(bundle, 7000, 0);
+    Download streamed = download(server.port(), true, directory);
+    Download buffered = download(server.port(), false, directory);
+    CHECK(streamed.md5 == md5Of(bundle, bundle.size()));
+    CHECK(streamed.md5 == buffered.md5);
+    CHECK(streamed.characters == buffered.characters);
+    CHECK(readFile(directory + "/" + streamed.md5 + ".js") == bundle);
+    clearDirectory(directory);
+}
+
+static void benchmark(const std::string &directory, size_t functions, size_t chunk, int delayMicroseconds)
+{
+    std::string bundle = makeBundle(functions);
+    BundleServer server(bundle, chunk, delayMicroseconds);
+    Download buffered = download(server.port(), false, directory);
+    Download streamed = download(server.port(), true, directory);
+    printf("%5zu KB in %3zu KB chunks every %2d ms: after the last byte %6.2f ms -> %5.2f ms, total %7.2f ms -> %7.2f ms\n",
+           bundle.size() / 1024, chunk / 1024, delayMicroseconds / 1000,
+           buffered.tailTime, streamed.tailTime, buffered.totalTime, streamed.totalTime);
+    clearDirectory(directory);
+}
+
+int main(int argc, const char *argv[])
+{
+    std::string directory = std::string(argc > 1 ? argv[1] : "/tmp") + "/wxbundle_check";
+    mkdir(directory.c_str(), 0755);
+
+    checkMD5();
+    checkDecoding();
+    checkCache(directory);
+    checkDownload(directory);
+    printf("checks: %d failures\n\n", failures);
+
+    // 3G-like and 4G-like paces
+    benchmark(directory, 5000, 16 * 1024, 20000);
+    benchmark(directory, 20000, 64 * 1024, 10000);
+    benchmark(directory, 50000, 128 * 1024, 5000);
+
+    rmdir(directory.c_str());
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXCSSStyleApplier, and benchmarks applying style updates key by key
+ * against looking up every layout property in them, which is what the
+ * WX_STYLE_FILL_CSS_NODE macros did. It doesn't need Xcode:
+ *
+ *   cc -std=c99 -O2 -c ../WeexSDK/Sources/Layout/WXCSSStyleApplier.c -o WXCSSStyleApplier.o
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Layout -I../WeexSDK/Sources/Utility WXCSSStyleApplierBenchmark.cpp \
+ *       WXCSSStyleApplier.o ../WeexSDK/Sources/Utility/WXStyleValue.cpp -o style_applier_benchmark
+ *   ./style_applier_benchmark
+ */
+
+extern "C" {
+#include "Layout.h"
+}
+#include "WXCSSStyleApplier.h"
+#include "WXStyleValue.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+typedef std::unordered_map<std::string, std::string> Styles;
+
+static WXCSSProperty lookup(const std::string &key)
+{
+    return WXCSSPropertyLookup(key.data(), key.size());
+}
+
+static void resetStyle(css_style_t &style)
+{
+    memset(&style, 0, sizeof(style));
+    for (int property = WXCSSPropertyNone + 1; property < WXCSSPropertyCount; property++) {
+        WXCSSStyleReset(&style, (WXCSSProperty)property);
+    }
+}
+
+static float pixel(const std::string &string)
+{
+    WXStyleValue value = WXStyleValueParse(string.data(), string.size());
+    return (float)(value.unit == WXStyleUnit::Wx ? value.number : value.number * 0.5);
+}
+
+static int keyword(WXCSSValueType type, const std::string &string)
+{
+    WXStyleKeyword keyword = WXStyleKeywordLookup(string.data(), string.size());
+    switch (type) {
+        case WXCSSValueTypeFlexDirection:
+            return keyword == WXStyleKeyword::Row ? CSS_FLEX_DIRECTION_ROW : CSS_FLEX_DIRECTION_COLUMN;
+        case WXCSSValueTypeAlign:
+            return keyword == WXStyleKeyword::Center ? CSS_ALIGN_CENTER : CSS_ALIGN_STRETCH;
+        case WXCSSValueTypeJustify:
+            return keyword == WXStyleKeyword::SpaceBetween ? CSS_JUSTIFY_SPACE_BETWEEN : CSS_JUSTIFY_FLEX_START;
+        default:
+            return 0;
+    }
+}
+
+static bool apply(css_style_t &style, WXCSSProperty property, const std::string &value)
+{
+    WXCSSValueType type = WXCSSPropertyValueType(property);
+    if (type == WXCSSValueTypeNumber) {
+        return WXCSSStyleSetFloat(&style, property, (float)WXStyleValueParse(value.data(), value.size()).number);
+    } else if (type == WXCSSValueTypePixel) {
+        return WXCSSStyleSetFloat(&style, property, pixel(value));
+    }
+    return WXCSSStyleSetEnum(&style, property, keyword(type, value));
+}
+
+// key by key, the shorthands first
+static bool fill(css_style_t &style, const Styles &styles)
+{
+    const std::string *values[WXCSSPropertyCount] = {nullptr};
+    uint64_t properties = 0;
+    for (const auto &entry : styles) {
+        WXCSSProperty property = lookup(entry.first);
+        if (property != WXCSSPropertyNone) {
+            values[property] = &entry.second;
+            properties |= 1ULL << property;
+        }
+    }
+    // a shorthand and its longhand both change the style, compare it as a whole
+    css_style_t previous;
+    memcpy(&previous, &style, sizeof(previous));
+    for (; properties; properties &= properties - 1) {
+        WXCSSProperty property = (WXCSSProperty)__builtin_ctzll(properties);
+        apply(style, property, *values[property]);
+    }
+    return memcmp(&previous, &style, sizeof(previous)) != 0;
+}
+
+// every property is looked up, and every present one marks the node dirty
+static bool legacyFill(css_style_t &style, const Styles &styles)
+{
+    bool dirty = false;
+    for (int property = WXCSSPropertyNone + 1; property < WXCSSPropertyCount; property++) {
+        auto found = styles.find(WXCSSPropertyName((WXCSSProperty)property));
+        if (found != styles.end()) {
+            apply(style, (WXCSSProperty)property, found->second);
+            dirty = true;
+        }
+    }
+    return dirty;
+}
+
+static void checkLookup()
+{
+    for (int property = WXCSSPropertyNone + 1; property < WXCSSPropertyCount; property++) {
+        CHECK(lookup(WXCSSPropertyName((WXCSSProperty)property)) == property);
+    }
+    CHECK(lookup("marginTop") == WXCSSPropertyMarginTop);
+    CHECK(lookup("borderBottomWidth") == WXCSSPropertyBorderBottomWidth);
+    CHECK(lookup("color") == WXCSSPropertyNone);
+    CHECK(lookup("backgroundColor") == WXCSSPropertyNone);
+    CHECK(lookup("margintop") == WXCSSPropertyNone);
+    CHECK(lookup("marginTopX") == WXCSSPropertyNone);
+    CHECK(lookup("") == WXCSSPropertyNone);
+    CHECK(lookup(std::string("top\0", 4)) == WXCSSPropertyNone);
+    CHECK(lookup("borderBottomWidthX") == WXCSSPropertyNone);
+}
+
+static void checkApply()
+{
+    css_style_t style;
+    resetStyle(style);
+    CHECK(std::isnan(style.dimensions[CSS_WIDTH]) && style.margin[CSS_TOP] == 0 && style.align_self == CSS_ALIGN_AUTO);
+
+    Styles styles = {{"width", "750px"}, {"flexDirection", "row"}, {"margin", "20px"}, {"marginTop", "10px"}, {"color", "#fff"}};
+    CHECK(fill(style, styles));
+    CHECK(style.dimensions[CSS_WIDTH] == 375);
+    CHECK(style.flex_direction == CSS_FLEX_DIRECTION_ROW);
+    // the longhand wins, whatever the order of the keys
+    CHECK(style.margin[CSS_TOP] == 5 && style.margin[CSS_LEFT] == 10 && style.margin[CSS_RIGHT] == 10 && style.margin[CSS_BOTTOM] == 10);
+    CHECK(style.margin[CSS_START] == 0);
+
+    // the same values don't change the style
+    CHECK(!fill(style, styles));
+    CHECK(!fill(style, {{"color", "#000"}}));
+    CHECK(fill(style, {{"width", "100wx"}}) && style.dimensions[CSS_WIDTH] == 100);
+
+    CHECK(WXCSSStyleReset(&style, WXCSSPropertyWidth) && std::isnan(style.dimensions[CSS_WIDTH]));
+    CHECK(!WXCSSStyleReset(&style, WXCSSPropertyWidth));
+    CHECK(WXCSSStyleReset(&style, WXCSSPropertyMargin) && style.margin[CSS_TOP] == 0);
+    CHECK(WXCSSStyleReset(&style, WXCSSPropertyFlexDirection) && style.flex_direction == CSS_FLEX_DIRECTION_COLUMN);
+    CHECK(!WXCSSStyleSetFloat(&style, WXCSSPropertyFlexDirection, 1));
+    CHECK(!WXCSSStyleSetEnum(&style, WXCSSPropertyWidth, 1));
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void benchmark(size_t components)
+{
+    // the styles of a typical list cell, half of them aren't layout styles
+    std::vector<Styles> updates = {
+        {{"width", "750px"}, {"height", "120px"}, {"flexDirection", "row"}, {"alignItems", "center"},
+         {"paddingLeft", "24px"}, {"backgroundColor", "#ffffff"}, {"borderBottomWidth", "1px"}, {"borderBottomColor", "#eeeeee"}},
+        {{"width", "88px"}, {"height", "88px"}, {"borderRadius", "44px"}, {"marginRight", "20px"}},
+        {{"flex", "1"}, {"fontSize", "32px"}, {"color", "#333333"}, {"lines", "1"}, {"textOverflow", "ellipsis"}},
+        {{"fontSize", "24px"}, {"color", "#999999"}, {"marginTop", "8px"}},
+    };
+
+    double times[2];
+    size_t dirty[2] = {0, 0};
+    for (int legacy = 1; legacy >= 0; legacy--) {
+        std::vector<css_style_t> styles(components * updates.size());
+        for (auto &style : styles) {
+            resetStyle(style);
+        }
+        auto start = std::chrono::steady_clock::now();
+        // create the components, then update them with the same styles
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = 0; i < styles.size(); i++) {
+                const Styles &update = updates[i % updates.size()];
+                dirty[legacy] += legacy ? legacyFill(styles[i], update) : fill(styles[i], update);
+            }
+        }
+        times[legacy] = milliseconds(start);
+    }
+
+    printf("%6zu components x 2 updates: every property %8.2f ms %6zu dirty | key by key %7.2f ms %6zu dirty\n",
+           components * updates.size(), times[1], dirty[1], times[0], dirty[0]);
+}
+
+int main()
+{
+    checkLookup();
+    checkApply();
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(1000);
+    benchmark(10000);
+
+    return failures ? 1 : 0;
+}
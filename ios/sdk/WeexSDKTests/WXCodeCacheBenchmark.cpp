@@ -0,0 +1,354 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXCodeCacheStore, and benchmarks executing scripts with and without
+ * it. JavaScriptCore isn't available here, so a stand-in engine tokenizes the
+ * script as its "compilation" and caches the token table as its "bytecode".
+ * It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Utility WXCodeCacheBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXCodeCacheStore.cpp -o code_cache_benchmark
+ *   ./code_cache_benchmark [directory]
+ */
+
+#include "WXCodeCacheStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <ctype.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+struct Token {
+    uint32_t kind;
+    uint32_t offset;
+    uint32_t length;
+};
+
+enum TokenKind : uint32_t {
+    TokenIdentifier = 1,
+    TokenNumber,
+    TokenString,
+    TokenPunctuator,
+};
+
+static const char kTokenFormat[4] = {'T', 'O', 'K', '1'};
+
+/*
+ * The stand-in engine: compiling is tokenizing, executing is folding a
+ * checksum over the tokens, so both paths must give the same result.
+ */
+class TokenEngine : public WXCodeCacheEngine {
+public:
+    explicit TokenEngine(const std::string &version = "token-engine/1") : result(0), compilations(0), _version(version) {}
+
+    std::string version() override { return _version; }
+
+    bool execute(const char *source, size_t length, const uint8_t *cache, size_t cacheLength) override
+    {
+        if (cache) {
+            if (cacheLength < sizeof(kTokenFormat) || memcmp(cache, kTokenFormat, sizeof(kTokenFormat)) != 0
+                || (cacheLength - sizeof(kTokenFormat)) % sizeof(Token) != 0) {
+                return false;
+            }
+            run(source, (const Token *)(cache + sizeof(kTokenFormat)), (cacheLength - sizeof(kTokenFormat)) / sizeof(Token));
+            return true;
+        }
+        compile(source, length);
+        run(source, _tokens.data(), _tokens.size());
+        return true;
+    }
+
+    bool produce(const char *, size_t, std::vector<uint8_t> &cache) override
+    {
+        cache.assign(kTokenFormat, kTokenFormat + sizeof(kTokenFormat));
+        const uint8_t *tokens = (const uint8_t *)_tokens.data();
+        cache.insert(cache.end(), tokens, tokens + _tokens.size() * sizeof(Token));
+        return true;
+    }
+
+    uint64_t result;
+    size_t compilations;
+
+private:
+    std::string _version;
+    std::vector<Token> _tokens;
+
+    void compile(const char *source, size_t length)
+    {
+        compilations++;
+        _tokens.clear();
+        size_t index = 0;
+        while (index < length) {
+            char c = source[index];
+            size_t start = index;
+            if (isspace((unsigned char)c)) {
+                index++;
+                continue;
+            }
+            if (c == '/' && index + 1 < length && source[index + 1] == '/') {
+                while (index < length && source[index] != '\n') {
+                    index++;
+                }
+                continue;
+            }
+            if (c == '/' && index + 1 < length && source[index + 1] == '*') {
+                const char *end = strstr(source + index + 2, "*/");
+                index = end ? end - source + 2 : length;
+                continue;
+            }
+            uint32_t kind;
+            if (isalpha((unsigned char)c) || c == '_' || c == '$') {
+                while (index < length && (isalnum((unsigned char)source[index]) || source[index] == '_' || source[index] == '$')) {
+                    index++;
+                }
+                kind = TokenIdentifier;
+            } else if (isdigit((unsigned char)c)) {
+                while (index < length && (isalnum((unsigned char)source[index]) || source[index] == '.')) {
+                    index++;
+                }
+                kind = TokenNumber;
+            } else if (c == '"' || c == '\'' || c == '`') {
+                index++;
+                while (index < length && source[index] != c) {
+                    index += source[index] == '\\' ? 2 : 1;
+                }
+                index = std::min(index + 1, length);
+                kind = TokenString;
+            } else {
+                index++;
+                kind = TokenPunctuator;
+            }
+            _tokens.push_back({kind, (uint32_t)start, (uint32_t)(index - start)});
+        }
+    }
+
+    void run(const char *source, const Token *tokens, size_t count)
+    {
+        uint64_t value = count;
+        for (size_t i = 0; i < count; i++) {
+            value = (value ^ (tokens[i].kind + (uint64_t)(unsigned char)source[tokens[i].offset] * 31 + tokens[i].length)) * 0x100000001b3ULL;
+        }
+        result = value;
+    }
+};
+
+static std::string makeScript(size_t functions, int seed)
+{
+    std::string script = "/* generated framework " + std::to_string(seed) + " */\n";
+    for (size_t i = 0; i < functions; i++) {
+        std::string name = "component" + std::to_string(i);
+        script += "// renders " + name + "\n";
+        script += "function " + name + "(props, children) {\n";
+        script += "    var style = { width: 750, height: " + std::to_string(i % 300) + ", color: '#ff0000' };\n";
+        script += "    if (props.visible && children.length > " + std::to_string(i % 7) + ") {\n";
+        script += "        return createElement(\"div\", { style: style, key: `" + name + "` }, children);\n";
+        script += "    }\n";
+        script += "    return null;\n";
+        script += "}\n";
+    }
+    return script;
+}
+
+static size_t entryCount(const std::string &directory)
+{
+    size_t count = 0;
+    if (DIR *dir = opendir(directory.c_str())) {
+        while (struct dirent *item = readdir(dir)) {
+            count += strstr(item->d_name, ".wxcc") != nullptr;
+        }
+        closedir(dir);
+    }
+    return count;
+}
+
+static void setTime(const std::string &path, time_t seconds)
+{
+    struct timespec times[2] = {{seconds, 0}, {seconds, 0}};
+    utimensat(AT_FDCWD, path.c_str(), times, 0);
+}
+
+static void checkHitAndMiss(const std::string &directory)
+{
+    WXCodeCacheStore store(directory, 0);
+    store.clear();
+    std::string script = makeScript(100, 1);
+    TokenEngine engine;
+
+    CHECK(!store.execute(engine, script.data(), script.size()));
+    uint64_t result = engine.result;
+    CHECK(engine.compilations == 1);
+    CHECK(entryCount(directory) == 1);
+
+    engine.result = 0;
+    CHECK(store.execute(engine, script.data(), script.size()));
+    CHECK(engine.result == result);
+    CHECK(engine.compilations == 1);
+
+    // a changed script misses
+    std::string changed = script + "\nvar x = 1;";
+    CHECK(!store.execute(engine, changed.data(), changed.size()));
+    CHECK(engine.compilations == 2);
+    CHECK(entryCount(directory) == 2);
+
+    WXCodeCacheMetrics metrics = store.metrics();
+    CHECK(metrics.hits == 1 && metrics.misses == 2 && metrics.stores == 2 && metrics.rejections == 0);
+}
+
+static void checkInvalidEntries(const std::string &directory)
+{
+    WXCodeCacheStore store(directory, 0);
+    store.clear();
+    std::string script = makeScript(50, 2);
+    std::string path = store.pathForSource(script.data(), script.size());
+    TokenEngine engine;
+    CHECK(!store.execute(engine, script.data(), script.size()));
+    uint64_t result = engine.result;
+
+    // another engine version doesn't use it
+    TokenEngine upgraded("token-engine/2");
+    CHECK(!store.load(upgraded.version(), script.data(), script.size()));
+    CHECK(!store.execute(upgraded, script.data(), script.size()));
+    CHECK(store.execute(upgraded, script.data(), script.size()));
+    CHECK(upgraded.result == result);
+
+    // a flipped payload byte
+    FILE *file = fopen(path.c_str(), "r+b");
+    fseek(file, 100, SEEK_SET);
+    int byte = fgetc(file);
+    fseek(file, 100, SEEK_SET);
+    fputc(byte ^ 1, file);
+    fclose(file);
+    size_t rejections = store.metrics().rejections;
+    CHECK(!store.load(upgraded.version(), script.data(), script.size()));
+    CHECK(store.metrics().rejections == rejections + 1);
+    CHECK(access(path.c_str(), F_OK) != 0);
+
+    // a cut file
+    CHECK(!store.execute(upgraded, script.data(), script.size()));
+    struct stat info;
+    stat(path.c_str(), &info);
+    CHECK(truncate(path.c_str(), info.st_size - 10) == 0);
+    CHECK(!store.load(upgraded.version(), script.data(), script.size()));
+
+    // a payload the engine rejects is dropped, and produced again
+    static const uint8_t garbage[] = {'B', 'A', 'D', '!'};
+    CHECK(store.store(upgraded.version(), script.data(), script.size(), garbage, sizeof(garbage)));
+    size_t compilations = upgraded.compilations;
+    CHECK(!store.execute(upgraded, script.data(), script.size()));
+    CHECK(upgraded.compilations == compilations + 1);
+    CHECK(upgraded.result == result);
+    CHECK(store.execute(upgraded, script.data(), script.size()));
+}
+
+static void checkTrim(const std::string &directory)
+{
+    WXCodeCacheStore unlimited(directory, 0);
+    unlimited.clear();
+    std::vector<std::string> scripts;
+    std::vector<std::string> paths;
+    TokenEngine engine;
+    for (int i = 0; i < 3; i++) {
+        scripts.push_back(makeScript(20, 10 + i));
+        unlimited.execute(engine, scripts[i].data(), scripts[i].size());
+        paths.push_back(unlimited.pathForSource(scripts[i].data(), scripts[i].size()));
+        setTime(paths[i], 1000 + i);
+    }
+    size_t entrySize = unlimited.totalSize() / 3;
+
+    // using the oldest makes it the most recently used
+    CHECK(unlimited.load(engine.version(), scripts[0].data(), scripts[0].size()) != nullptr);
+
+    WXCodeCacheStore store(directory, entrySize * 3 + entrySize / 2);
+    std::string script = makeScript(20, 20);
+    CHECK(!store.execute(engine, script.data(), script.size()));
+    CHECK(store.metrics().evictions == 1);
+    CHECK(access(paths[0].c_str(), F_OK) == 0);
+    CHECK(access(paths[1].c_str(), F_OK) != 0);
+    CHECK(access(paths[2].c_str(), F_OK) == 0);
+    CHECK(store.totalSize() <= entrySize * 3 + entrySize / 2);
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void benchmark(const std::string &directory, size_t functions, int runs)
+{
+    std::string script = makeScript(functions, 100);
+    WXCodeCacheStore store(directory, 0);
+    store.clear();
+
+    TokenEngine engine;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        engine.execute(script.data(), script.size(), nullptr, 0);
+    }
+    double parseTime = milliseconds(start) / runs;
+
+    // the first run compiles and stores
+    start = std::chrono::steady_clock::now();
+    store.execute(engine, script.data(), script.size());
+    double firstTime = milliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        store.execute(engine, script.data(), script.size());
+    }
+    double cachedTime = milliseconds(start) / runs;
+
+    printf("%7zu KB script: parse %7.2f ms | first run %7.2f ms | cached %6.2f ms, %zu hits\n",
+           script.size() / 1024, parseTime, firstTime, cachedTime, store.metrics().hits);
+    store.clear();
+}
+
+int main(int argc, const char *argv[])
+{
+    std::string directory = std::string(argc > 1 ? argv[1] : "/tmp") + "/wxcodecache_check";
+    mkdir(directory.c_str(), 0755);
+
+    checkHitAndMiss(directory);
+    checkInvalidEntries(directory);
+    checkTrim(directory);
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(directory, 500, 20);
+    benchmark(directory, 5000, 20);
+    benchmark(directory, 20000, 10);
+
+    WXCodeCacheStore(directory, 0).clear();
+    rmdir(directory.c_str());
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,231 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXConcurrentMap under concurrent readers and writers, and measures
+ * lookups from many threads against one mutex, which is what
+ * WXThreadSafeMutableDictionary did before. It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -pthread -I../WeexSDK/Sources/Utility WXConcurrentMapBenchmark.cpp -o map_benchmark
+ *   ./map_benchmark [threads]
+ */
+
+#include "WXConcurrentMap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::atomic<int> failures(0);
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static void checkBasics()
+{
+    WXConcurrentMap<std::string, int> map;
+    int value = 0;
+    CHECK(!map.find("a", value));
+    map.set("a", 1);
+    map.set("b", 2);
+    map.set("a", 3);
+    CHECK(map.find("a", value) && value == 3);
+    CHECK(map.size() == 2);
+    CHECK(map.erase("b"));
+    CHECK(!map.erase("b"));
+    CHECK(map.size() == 1);
+    int count = 0;
+    map.forEach([&](const std::string &key, int value) {
+        count++;
+        CHECK(key == "a" && value == 3);
+    });
+    CHECK(count == 1);
+    map.clear();
+    CHECK(map.size() == 0 && !map.find("a", value));
+}
+
+// an object released by the map may write to it, as an ObjC dealloc does,
+// it must not run while the shard is locked
+struct WXReleaseRecorder;
+typedef WXConcurrentMap<std::string, std::shared_ptr<WXReleaseRecorder>, std::hash<std::string>, std::equal_to<std::string>, 1> WXReleaseMap;
+
+struct WXReleaseRecorder {
+    WXReleaseMap *map;
+    std::string key;
+    ~WXReleaseRecorder()
+    {
+        map->set(key, nullptr);
+    }
+};
+
+static void checkReleaseReentrancy()
+{
+    WXReleaseMap map;
+    map.set("a", std::make_shared<WXReleaseRecorder>(WXReleaseRecorder{&map, "released a"}));
+    map.set("a", nullptr);
+    map.set("b", std::make_shared<WXReleaseRecorder>(WXReleaseRecorder{&map, "released b"}));
+    map.erase("b");
+    std::shared_ptr<WXReleaseRecorder> value;
+    CHECK(map.find("released a", value) && map.find("released b", value));
+    map.set("c", std::make_shared<WXReleaseRecorder>(WXReleaseRecorder{&map, "released c"}));
+    map.clear();
+    CHECK(map.find("released c", value) && map.size() == 1);
+}
+
+// readers must always see a whole value, and never a freed one
+static void checkConcurrency()
+{
+    WXConcurrentMap<int, std::shared_ptr<std::string>> map;
+    for (int i = 0; i < 100; i++) {
+        map.set(i, std::make_shared<std::string>(std::to_string(i)));
+    }
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&, t] {
+            unsigned seed = t;
+            while (!stop.load()) {
+                int key = rand_r(&seed) % 100;
+                std::shared_ptr<std::string> value;
+                if (map.find(key, value)) {
+                    CHECK(std::stoi(*value) % 100 == key);
+                }
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; t++) {
+        writers.emplace_back([&, t] {
+            for (int i = 0; i < 2000; i++) {
+                int key = (i * 7 + t) % 100;
+                if (i % 3 == 0) {
+                    map.erase(key);
+                } else {
+                    map.set(key, std::make_shared<std::string>(std::to_string(key + 100 * i)));
+                }
+            }
+        });
+    }
+    for (std::thread &writer : writers) {
+        writer.join();
+    }
+    stop.store(true);
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+    size_t count = 0;
+    map.forEach([&](int, const std::shared_ptr<std::string> &) {
+        count++;
+    });
+    CHECK(count == map.size());
+}
+
+class MutexMap {
+public:
+    bool find(const std::string &key, int &value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _table.find(key);
+        if (it == _table.end()) {
+            return false;
+        }
+        value = it->second;
+        return true;
+    }
+
+    void set(const std::string &key, int value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _table[key] = value;
+    }
+
+private:
+    std::mutex _mutex;
+    std::unordered_map<std::string, int> _table;
+};
+
+template <class Map>
+static double measure(Map &map, int threads, int lookups)
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i < 64; i++) {
+        keys.push_back("component" + std::to_string(i));
+        map.set(keys.back(), i);
+    }
+
+    std::atomic<bool> start(false);
+    std::atomic<long> found(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            long count = 0;
+            int value;
+            for (int i = 0; i < lookups; i++) {
+                count += map.find(keys[(i + t) & 63], value);
+                if (t == 0 && i % 10000 == 0) {
+                    // a registration now and then
+                    map.set(keys[i & 63], i);
+                }
+            }
+            found += count;
+        });
+    }
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    CHECK(found.load() == (long)threads * lookups);
+    return time;
+}
+
+int main(int argc, const char *argv[])
+{
+    int maxThreads = argc > 1 ? atoi(argv[1]) : 8;
+
+    checkBasics();
+    checkConcurrency();
+    checkReleaseReentrancy();
+    printf("checks: %d failures\n\n", failures.load());
+
+    const int lookups = 1000000;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        MutexMap mutexMap;
+        WXConcurrentMap<std::string, int> concurrentMap;
+        double mutexTime = measure(mutexMap, threads, lookups);
+        double concurrentTime = measure(concurrentMap, threads, lookups);
+        printf("%2d threads x %d lookups: mutex %8.2f ms | concurrent map %8.2f ms\n",
+               threads, lookups, mutexTime, concurrentTime);
+    }
+
+    return failures.load() ? 1 : 0;
+}
@@ -80,6 +80,37 @@
     XCTAssertTrue(CGColorEqualToColor(redTestColor.CGColor, redColor.CGColor));
 }
 
+- (void) testStyleColors{
+    UIColor *redColor = [UIColor redColor];
+    XCTAssertTrue(CGColorEqualToColor([WXConvert UIColor:@"#f00"].CGColor, redColor.CGColor));
+    XCTAssertTrue(CGColorEqualToColor([WXConvert UIColor:@"red"].CGColor, redColor.CGColor));
+    XCTAssertTrue(CGColorEqualToColor([WXConvert UIColor:@"rgb(255, 0, 0)"].CGColor, redColor.CGColor));
+    XCTAssertEqual([WXConvert UIColor:@"red"], [WXConvert UIColor:@"red"]);
+
+    CGFloat red, green, blue, alpha;
+    [[WXConvert UIColor:@"rgba(0,0,255,0.5)"] getRed:&red green:&green blue:&blue alpha:&alpha];
+    XCTAssertTrue(red == 0 && green == 0 && blue == 1 && alpha == 0.5);
+    [[WXConvert UIColor:@"transparent"] getRed:&red green:&green blue:&blue alpha:&alpha];
+    XCTAssertTrue(alpha == 0);
+    XCTAssertNil([WXConvert UIColor:[NSNull null]]);
+}
+
+- (void) testStyleValues{
+    XCTAssertEqual([WXConvert CGFloat:@"750px"], 750);
+    XCTAssertEqual([WXConvert CGFloat:@"1.5"], 1.5);
+    XCTAssertEqual([WXConvert WXPixelType:@"100px" scaleFactor:0.5], 50);
+    XCTAssertEqual([WXConvert WXPixelType:@"100wx" scaleFactor:0.5], 100);
+    XCTAssertEqual([WXConvert WXPixelType:@(100) scaleFactor:0.5], 50);
+
+    XCTAssertEqual([WXConvert css_flex_direction_t:@"row"], CSS_FLEX_DIRECTION_ROW);
+    XCTAssertEqual([WXConvert css_flex_direction_t:@"rows"], CSS_FLEX_DIRECTION_COLUMN);
+    XCTAssertEqual([WXConvert css_align_t:@"center"], CSS_ALIGN_CENTER);
+    XCTAssertEqual([WXConvert css_justify_t:@"space-between"], CSS_JUSTIFY_SPACE_BETWEEN);
+    XCTAssertEqual([WXConvert css_wrap_type_t:@"wrap"], CSS_WRAP);
+    XCTAssertEqual([WXConvert css_position_type_t:@"fixed"], CSS_POSITION_ABSOLUTE);
+    XCTAssertEqual([WXConvert css_position_type_t:@"sticky"], CSS_POSITION_RELATIVE);
+}
+
 - (void) testColor2Hex{
     
     UIColor *redColor = [UIColor redColor];
@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Checks and benchmarks WXDiffCore against the levenshtein matrix which was
+ * used by WXDiffUtil before. It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Utility WXDiffCoreBenchmark.cpp -o diff_benchmark
+ *   ./diff_benchmark [count]
+ */
+
+#include "WXDiffCore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+typedef std::vector<uint64_t> WXList;
+
+struct WXCountingEqual {
+    const WXList *oldList;
+    const WXList *newList;
+    size_t *comparisons;
+
+    bool operator()(size_t oldIndex, size_t newIndex) const
+    {
+        (*comparisons)++;
+        return (*oldList)[oldIndex] == (*newList)[newIndex];
+    }
+};
+
+static uint64_t mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    return value;
+}
+
+// the levenshtein matrix, returns the edit distance
+static size_t legacyDiff(const WXList &oldList, const WXList &newList, size_t &comparisons, size_t &bytes)
+{
+    size_t oldSize = oldList.size() + 1, newSize = newList.size() + 1;
+    int **matrix = (int **)malloc(oldSize * sizeof(int *));
+    for (size_t i = 0; i < oldSize; i++) {
+        matrix[i] = (int *)malloc(newSize * sizeof(int));
+        matrix[i][0] = (int)i;
+    }
+    bytes = oldSize * sizeof(int *) + oldSize * newSize * sizeof(int);
+    for (size_t j = 0; j < newSize; j++) {
+        matrix[0][j] = (int)j;
+    }
+    for (size_t i = 1; i < oldSize; i++) {
+        for (size_t j = 1; j < newSize; j++) {
+            comparisons++;
+            if (oldList[i - 1] == newList[j - 1]) {
+                matrix[i][j] = matrix[i - 1][j - 1];
+            } else {
+                matrix[i][j] = std::min(std::min(matrix[i][j - 1], matrix[i - 1][j]), matrix[i - 1][j - 1]) + 1;
+            }
+        }
+    }
+    size_t distance = matrix[oldSize - 1][newSize - 1];
+    for (size_t i = 0; i < oldSize; i++) {
+        free(matrix[i]);
+    }
+    free(matrix);
+    return distance;
+}
+
+static size_t lcsLength(const WXList &oldList, const WXList &newList)
+{
+    std::vector<size_t> row(newList.size() + 1, 0), previous(newList.size() + 1, 0);
+    for (size_t i = 1; i <= oldList.size(); i++) {
+        for (size_t j = 1; j <= newList.size(); j++) {
+            row[j] = oldList[i - 1] == newList[j - 1] ? previous[j - 1] + 1 : std::max(previous[j], row[j - 1]);
+        }
+        std::swap(row, previous);
+    }
+    return previous[newList.size()];
+}
+
+static WXDiffCoreResult coreDiff(const WXList &oldList, const WXList &newList, bool hashed, size_t &comparisons, size_t *matches = NULL)
+{
+    WXList oldHashes, newHashes;
+    if (hashed) {
+        for (uint64_t item : oldList) {
+            oldHashes.push_back(mix(item));
+        }
+        for (uint64_t item : newList) {
+            newHashes.push_back(mix(item));
+        }
+    }
+    WXCountingEqual equal = {&oldList, &newList, &comparisons};
+    WXDiffCore<WXCountingEqual> core(oldList.size(), newList.size(), equal, hashed ? oldHashes.data() : NULL, hashed ? newHashes.data() : NULL);
+    WXDiffCoreResult result = core.diff();
+    if (matches) {
+        *matches = core.matches().size();
+    }
+    return result;
+}
+
+// the items which are neither deleted, inserted nor updated must be equal in order
+static bool isValid(const WXList &oldList, const WXList &newList, const WXDiffCoreResult &result)
+{
+    std::vector<bool> oldChanged(oldList.size(), false), newChanged(newList.size(), false);
+    for (size_t index : result.deletes) {
+        oldChanged[index] = true;
+    }
+    for (size_t index : result.inserts) {
+        newChanged[index] = true;
+    }
+    for (const WXDiffCorePair &update : result.updates) {
+        if (oldChanged[update.oldIndex] || newChanged[update.newIndex]) {
+            return false;
+        }
+        oldChanged[update.oldIndex] = newChanged[update.newIndex] = true;
+    }
+    for (const WXDiffCorePair &move : result.moves) {
+        if (oldList[move.oldIndex] != newList[move.newIndex]) {
+            return false;
+        }
+    }
+    WXList oldKept, newKept;
+    for (size_t i = 0; i < oldList.size(); i++) {
+        if (!oldChanged[i]) {
+            oldKept.push_back(oldList[i]);
+        }
+    }
+    for (size_t i = 0; i < newList.size(); i++) {
+        if (!newChanged[i]) {
+            newKept.push_back(newList[i]);
+        }
+    }
+    return oldKept == newKept;
+}
+
+static int check(std::mt19937_64 &random)
+{
+    int failures = 0;
+    for (int round = 0; round < 2000; round++) {
+        // small alphabets make a lot of duplicates
+        uint64_t alphabet = 2 + random() % 8;
+        WXList oldList(random() % 40), newList(random() % 40);
+        for (uint64_t &item : oldList) {
+            item = random() % alphabet;
+        }
+        for (uint64_t &item : newList) {
+            item = random() % alphabet;
+        }
+        size_t expected = lcsLength(oldList, newList);
+        for (int hashed = 0; hashed < 2; hashed++) {
+            size_t comparisons = 0, matches = 0;
+            WXDiffCoreResult result = coreDiff(oldList, newList, hashed, comparisons, &matches);
+            if (matches != expected || !isValid(oldList, newList, result)) {
+                fprintf(stderr, "round %d (%s): %zu matches, %zu expected\n", round, hashed ? "hashed" : "plain", matches, expected);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void run(const char *name, const WXList &oldList, const WXList &newList)
+{
+    size_t legacyComparisons = 0, bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    legacyDiff(oldList, newList, legacyComparisons, bytes);
+    double legacyTime = milliseconds(start);
+    printf("%-18s legacy        %9.2f ms %10zu compares %8zu KB\n", name, legacyTime, legacyComparisons, bytes / 1024);
+
+    for (int hashed = 0; hashed < 2; hashed++) {
+        size_t comparisons = 0;
+        start = std::chrono::steady_clock::now();
+        WXDiffCoreResult result = coreDiff(oldList, newList, hashed, comparisons);
+        double time = milliseconds(start);
+        printf("%-18s core %-8s %9.2f ms %10zu compares  %zu/%zu/%zu/%zu ins/del/upd/move%s\n", name, hashed ? "hashed" : "plain", time, comparisons,
+               result.inserts.size(), result.deletes.size(), result.updates.size(), result.moves.size(),
+               isValid(oldList, newList, result) ? "" : "  INVALID");
+    }
+}
+
+int main(int argc, const char *argv[])
+{
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000;
+    std::mt19937_64 random(42);
+
+    int failures = check(random);
+    printf("checked 2000 random lists: %d failures\n\n", failures);
+
+    WXList list(count);
+    uint64_t next = 0;
+    for (uint64_t &item : list) {
+        item = next++;
+    }
+
+    run("unchanged", list, list);
+
+    WXList edited;
+    for (uint64_t item : list) {
+        uint64_t dice = random() % 100;
+        if (dice < 2) {
+            continue;
+        } else if (dice < 4) {
+            edited.push_back(next++);
+        } else if (dice < 6) {
+            edited.push_back(next++);
+            edited.push_back(item);
+        } else {
+            edited.push_back(item);
+        }
+    }
+    run("5% edited", list, edited);
+
+    WXList moved(list);
+    for (size_t i = 0; i < count / 100; i++) {
+        std::swap(moved[random() % count], moved[random() % count]);
+    }
+    run("1% swapped", list, moved);
+
+    WXList reversed(list.rbegin(), list.rend());
+    run("reversed", list, reversed);
+
+    WXList replaced(count);
+    for (uint64_t &item : replaced) {
+        item = next++;
+    }
+    run("replaced", list, replaced);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#import <XCTest/XCTest.h>
+#import "WXDiffUtil.h"
+
+@interface WXDiffUtilTests : XCTestCase
+
+@end
+
+@implementation WXDiffUtilTests
+
+// the items which are neither deleted, inserted nor updated must be equal in order
+- (void)assertResult:(WXDiffResult *)result fromArray:(NSArray *)oldArray toArray:(NSArray *)newArray
+{
+    NSMutableIndexSet *oldChanged = [result.deletes mutableCopy];
+    NSMutableIndexSet *newChanged = [result.inserts mutableCopy];
+    for (WXDiffUpdateIndex *update in result.updates) {
+        XCTAssertFalse([oldChanged containsIndex:update.oldIndex]);
+        XCTAssertFalse([newChanged containsIndex:update.newIndex]);
+        [oldChanged addIndex:update.oldIndex];
+        [newChanged addIndex:update.newIndex];
+    }
+    NSMutableArray *oldKept = [oldArray mutableCopy];
+    [oldKept removeObjectsAtIndexes:oldChanged];
+    NSMutableArray *newKept = [newArray mutableCopy];
+    [newKept removeObjectsAtIndexes:newChanged];
+    XCTAssertEqualObjects(oldKept, newKept);
+}
+
+- (void)testUnchanged
+{
+    NSArray *array = @[@1, @2, @3];
+    WXDiffResult *result = [WXDiffUtil diffWithMinimumDistance:array oldArray:[array copy]];
+    XCTAssertFalse([result hasChanges]);
+}
+
+- (void)testInsertDeleteUpdate
+{
+    NSArray *oldArray = @[@"a", @"b", @"c", @"d"];
+    NSArray *newArray = @[@"a", @"x", @"c", @"e", @"d", @"f"];
+    WXDiffResult *result = [WXDiffUtil diffWithMinimumDistance:newArray oldArray:oldArray];
+    XCTAssertEqual(result.updates.count, 1);
+    XCTAssertEqual(result.updates[0].oldIndex, 1);
+    XCTAssertEqual(result.updates[0].newIndex, 1);
+    NSMutableIndexSet *inserts = [NSMutableIndexSet indexSetWithIndex:3];
+    [inserts addIndex:5];
+    XCTAssertEqualObjects(result.inserts, inserts);
+    XCTAssertEqual(result.deletes.count, 0);
+    [self assertResult:result fromArray:oldArray toArray:newArray];
+}
+
+- (void)testMoves
+{
+    NSArray *oldArray = @[@1, @2, @3, @4, @5];
+    NSArray *newArray = @[@5, @1, @2, @3, @4];
+    WXDiffResult *result = [WXDiffUtil diffWithMinimumDistance:newArray oldArray:oldArray];
+    XCTAssertEqual(result.moves.count, 1);
+    XCTAssertEqual(result.moves[0].oldIndex, 4);
+    XCTAssertEqual(result.moves[0].newIndex, 0);
+    XCTAssertTrue([result.deletes containsIndex:4]);
+    XCTAssertTrue([result.inserts containsIndex:0]);
+    [self assertResult:result fromArray:oldArray toArray:newArray];
+}
+
+- (void)testItemsWithoutHashes
+{
+    NSArray *oldArray = @[@{@"id": @1}, @{@"id": @2}, @[@3], @{@"id": @4}];
+    NSArray *newArray = @[@{@"id": @2}, @[@3], @{@"id": @5}, @{@"id": @1}];
+    WXDiffResult *result = [WXDiffUtil diffWithMinimumDistance:newArray oldArray:oldArray];
+    [self assertResult:result fromArray:oldArray toArray:newArray];
+    XCTAssertEqual(result.moves.count, 1);
+}
+
+- (void)testRandomChanges
+{
+    for (int round = 0; round < 100; round++) {
+        NSMutableArray *oldArray = [NSMutableArray array];
+        NSMutableArray *newArray = [NSMutableArray array];
+        for (int i = arc4random_uniform(30); i > 0; i--) {
+            [oldArray addObject:@(arc4random_uniform(5))];
+        }
+        for (int i = arc4random_uniform(30); i > 0; i--) {
+            [newArray addObject:@(arc4random_uniform(5))];
+        }
+        WXDiffResult *result = [WXDiffUtil diffWithMinimumDistance:newArray oldArray:oldArray];
+        [self assertResult:result fromArray:oldArray toArray:newArray];
+    }
+}
+
+- (void)testStructuralHash
+{
+    NSDictionary *item = @{@"id": @1, @"title": @"weex", @"tags": @[@"a", @"b"]};
+    NSDictionary *sameItem = @{@"tags": @[@"a", @"b"], @"title": @"weex", @"id": @1};
+    NSDictionary *otherItem = @{@"id": @1, @"title": @"weex", @"tags": @[@"b", @"a"]};
+    XCTAssertEqual([item weex_diffHash], [sameItem weex_diffHash]);
+    XCTAssertNotEqual([item weex_diffHash], [otherItem weex_diffHash]);
+    XCTAssertTrue([item weex_isEqualTo:sameItem]);
+    XCTAssertFalse([item weex_isEqualTo:otherItem]);
+    
+    NSMutableDictionary *mutableItem = [item mutableCopy];
+    XCTAssertEqual([mutableItem weex_diffHash], [item weex_diffHash]);
+    mutableItem[@"title"] = @"changed";
+    XCTAssertNotEqual([mutableItem weex_diffHash], [item weex_diffHash]);
+    XCTAssertFalse([mutableItem weex_isEqualTo:item]);
+}
+
+- (void)testNestedMutableContainerIsHashedOnDemand
+{
+    NSMutableArray *tags = [NSMutableArray arrayWithObjects:@"a", @"b", nil];
+    NSDictionary *item = @{@"id": @1, @"tags": tags};
+    NSDictionary *sameItem = @{@"id": @1, @"tags": @[@"a", @"b"]};
+    XCTAssertEqual([item weex_diffHash], [sameItem weex_diffHash]);
+    [tags addObject:@"c"];
+    XCTAssertNotEqual([item weex_diffHash], [sameItem weex_diffHash]);
+    XCTAssertFalse([item weex_isEqualTo:sameItem]);
+}
+
+- (void)testPerformanceOfLargeDataList
+{
+    NSMutableArray *oldArray = [NSMutableArray array];
+    NSMutableArray *newArray = [NSMutableArray array];
+    for (int i = 0; i < 2000; i++) {
+        NSDictionary *item = @{@"id": @(i), @"title": [NSString stringWithFormat:@"item %d", i], @"tags": @[@"a", @"b", @"c"]};
+        [oldArray addObject:item];
+        if (i % 20 == 0) {
+            [newArray addObject:@{@"id": @(i), @"title": @"changed", @"tags": @[@"a", @"b", @"c"]}];
+        } else if (i % 33 != 0) {
+            [newArray addObject:[item copy]];
+        }
+    }
+    
+    [self measureBlock:^{
+        WXDiffResult *result = [WXDiffUtil diffWithMinimumDistance:newArray oldArray:oldArray];
+        XCTAssertEqual(result.updates.count + result.inserts.count, 100);
+    }];
+}
+
+- (void)testPerformanceOfLargeList
+{
+    NSMutableArray *oldArray = [NSMutableArray array];
+    NSMutableArray *newArray = [NSMutableArray array];
+    for (int i = 0; i < 2000; i++) {
+        [oldArray addObject:@(i)];
+        if (i % 20 == 0) {
+            [newArray addObject:@(-i)];
+        } else if (i % 33 != 0) {
+            [newArray addObject:@(i)];
+        }
+    }
+
+    [self measureBlock:^{
+        WXDiffResult *result = [WXDiffUtil diffWithMinimumDistance:newArray oldArray:oldArray];
+        XCTAssertTrue([result hasChanges]);
+    }];
+}
+
+@end
@@ -0,0 +1,116 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import "WXDisplayQueue.h"
+
+@interface WXDisplayQueueTests : XCTestCase
+
+@end
+
+@implementation WXDisplayQueueTests
+
+- (NSUInteger)workerCount
+{
+    return MIN([NSProcessInfo processInfo].activeProcessorCount, 8);
+}
+
+// keeps the workers busy, so that the next blocks wait
+- (dispatch_semaphore_t)blockWorkers
+{
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    for (NSUInteger i = 0; i < [self workerCount]; i++) {
+        [WXDisplayQueue addBlock:^(BOOL cancelled) {
+            dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        } forKey:nil priority:WXDisplayPriorityHigh];
+    }
+    return semaphore;
+}
+
+- (void)unblockWorkers:(dispatch_semaphore_t)semaphore
+{
+    for (NSUInteger i = 0; i < [self workerCount]; i++) {
+        dispatch_semaphore_signal(semaphore);
+    }
+}
+
+- (void)testCoalescingAndCancellation
+{
+    dispatch_semaphore_t semaphore = [self blockWorkers];
+    id layer = [NSObject new];
+    id otherLayer = [NSObject new];
+    NSMutableArray *results = [NSMutableArray array];
+    NSLock *lock = [NSLock new];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"display"];
+    void (^record)(NSString *) = ^(NSString *result) {
+        [lock lock];
+        [results addObject:result];
+        if (results.count == 4) {
+            [expectation fulfill];
+        }
+        [lock unlock];
+    };
+    
+    [WXDisplayQueue addBlock:^(BOOL cancelled) {
+        record(cancelled ? @"first cancelled" : @"first");
+    } forKey:layer priority:WXDisplayPriorityNormal];
+    [WXDisplayQueue addBlock:^(BOOL cancelled) {
+        record(cancelled ? @"second cancelled" : @"second");
+    } forKey:layer priority:WXDisplayPriorityNormal];
+    [WXDisplayQueue addBlock:^(BOOL cancelled) {
+        record(cancelled ? @"other cancelled" : @"other");
+    } forKey:otherLayer priority:WXDisplayPriorityNormal];
+    [WXDisplayQueue cancelBlockForKey:otherLayer];
+    [self unblockWorkers:semaphore];
+    
+    [WXDisplayQueue addBlock:^(BOOL cancelled) {
+        record(@"last");
+    } forKey:nil priority:WXDisplayPriorityLow];
+    
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqualObjects([NSSet setWithArray:results], ([NSSet setWithObjects:@"first cancelled", @"other cancelled", @"second", @"last", nil]));
+}
+
+- (void)testPriority
+{
+    dispatch_semaphore_t semaphore = [self blockWorkers];
+    NSMutableArray *results = [NSMutableArray array];
+    NSLock *lock = [NSLock new];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"display"];
+    for (NSInteger priority = WXDisplayPriorityLow; priority <= WXDisplayPriorityHigh; priority++) {
+        [WXDisplayQueue addBlock:^(BOOL cancelled) {
+            [lock lock];
+            [results addObject:@(priority)];
+            if (results.count == 3) {
+                [expectation fulfill];
+            }
+            [lock unlock];
+        } forKey:nil priority:priority];
+    }
+    XCTAssertGreaterThanOrEqual([[WXDisplayQueue metrics][@"pending"] integerValue], 3);
+    // one worker, so that the order is kept
+    dispatch_semaphore_signal(semaphore);
+    
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqualObjects(results, (@[@(WXDisplayPriorityHigh), @(WXDisplayPriorityNormal), @(WXDisplayPriorityLow)]));
+    [self unblockWorkers:semaphore];
+}
+
+@end
@@ -0,0 +1,117 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import "WXFrameScheduler.h"
+
+@interface WXFrameSchedulerTests : XCTestCase
+
+@property (nonatomic, strong) WXFrameScheduler *scheduler;
+
+@end
+
+@implementation WXFrameSchedulerTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.scheduler = [WXFrameScheduler new];
+}
+
+- (void)tearDown
+{
+    [self.scheduler flushTasks];
+    [super tearDown];
+}
+
+- (NSArray<dispatch_block_t> *)tasksAppendingTo:(NSMutableArray *)results from:(int)from count:(int)count sleep:(useconds_t)sleep
+{
+    NSMutableArray *tasks = [NSMutableArray array];
+    for (int i = from; i < from + count; i++) {
+        [tasks addObject:^{
+            usleep(sleep);
+            [results addObject:@(i)];
+        }];
+    }
+    return tasks;
+}
+
+- (void)testSmallBatchRunsRightAway
+{
+    NSMutableArray *results = [NSMutableArray array];
+    [self.scheduler scheduleTasks:[self tasksAppendingTo:results from:0 count:10 sleep:0] forInstance:@"1"];
+    XCTAssertEqual(results.count, 10);
+    XCTAssertEqual(self.scheduler.pendingTaskCount, 0);
+}
+
+- (void)testLargeBatchIsSplitInOrder
+{
+    NSMutableArray *results = [NSMutableArray array];
+    self.scheduler.frameBudget = 0.004;
+    [self.scheduler scheduleTasks:[self tasksAppendingTo:results from:0 count:20 sleep:1000] forInstance:@"1"];
+    [self.scheduler scheduleTasks:[self tasksAppendingTo:results from:20 count:5 sleep:0] forInstance:@"2"];
+    XCTAssertLessThan(results.count, 20);
+    XCTAssertEqual(self.scheduler.pendingTaskCount, 25 - results.count);
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"frames"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        XCTAssertEqual(results.count, 25);
+        for (int i = 0; i < 25; i++) {
+            XCTAssertEqualObjects(results[i], @(i));
+        }
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+- (void)testCancelTasks
+{
+    NSMutableArray *results = [NSMutableArray array];
+    self.scheduler.frameBudget = 0.001;
+    [self.scheduler scheduleTasks:[self tasksAppendingTo:results from:0 count:10 sleep:5000] forInstance:@"1"];
+    [self.scheduler scheduleTasks:[self tasksAppendingTo:results from:10 count:5 sleep:0] forInstance:@"2"];
+    XCTAssertEqual(results.count, 1);
+    // a single task took more than twice the budget
+    XCTAssertEqual(self.scheduler.overrunCount, 1);
+    
+    [self.scheduler cancelTasksForInstance:@"1"];
+    [self.scheduler flushTasks];
+    XCTAssertEqualObjects(results, (@[@0, @10, @11, @12, @13, @14]));
+}
+
+- (void)testFlushTasksForInstance
+{
+    NSMutableArray *results = [NSMutableArray array];
+    self.scheduler.frameBudget = 0.001;
+    [self.scheduler scheduleTasks:[self tasksAppendingTo:results from:0 count:5 sleep:2000] forInstance:@"1"];
+    [self.scheduler scheduleTasks:[self tasksAppendingTo:results from:5 count:5 sleep:0] forInstance:@"2"];
+    [self.scheduler scheduleTasks:[self tasksAppendingTo:results from:10 count:5 sleep:0] forInstance:@"3"];
+    XCTAssertEqual(results.count, 1);
+    
+    // the tasks scheduled before the ones of the instance run first, the later ones keep waiting
+    [self.scheduler flushTasksForInstance:@"2"];
+    XCTAssertEqualObjects(results, (@[@0, @1, @2, @3, @4, @5, @6, @7, @8, @9]));
+    XCTAssertEqual(self.scheduler.pendingTaskCount, 5);
+    
+    [self.scheduler flushTasksForInstance:@"1"];
+    XCTAssertEqual(self.scheduler.pendingTaskCount, 5);
+}
+
+@end
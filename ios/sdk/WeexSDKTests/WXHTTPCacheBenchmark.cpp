@@ -0,0 +1,577 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXHTTPCache, then benchmarks opening a page whose bundle and API
+ * responses come from a local HTTP server with a simulated round trip, with
+ * and without the cache in front of it. It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -pthread -I../WeexSDK/Sources/Utility WXHTTPCacheBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXHTTPCache.cpp ../WeexSDK/Sources/Utility/WXStorageEngine.cpp \
+ *       ../WeexSDK/Sources/Utility/WXBundleStreamCore.cpp -o http_cache_benchmark
+ *   ./http_cache_benchmark [directory]
+ */
+
+#include "WXHTTPCache.h"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static std::string httpDate(double time)
+{
+    time_t seconds = (time_t)time;
+    struct tm components;
+    gmtime_r(&seconds, &components);
+    char buffer[64];
+    strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &components);
+    return buffer;
+}
+
+static double now()
+{
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static std::string contentsOf(const std::string &path)
+{
+    std::string contents;
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return "<none>";
+    }
+    char buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.append(buffer, length);
+    }
+    fclose(file);
+    return contents;
+}
+
+static bool exists(const std::string &path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+static void removeCache(const std::string &directory)
+{
+    std::string command = "rm -rf '" + directory + "'";
+    CHECK(system(command.c_str()) == 0);
+}
+
+static void checkParsing()
+{
+    WXCacheControl control = WXParseCacheControl("public, Max-Age=60 , stale-while-revalidate=\"30\", must-revalidate");
+    CHECK(control.maxAge == 60 && control.staleWhileRevalidate == 30 && control.mustRevalidate);
+    CHECK(!control.noStore && !control.noCache && !control.immutable);
+    control = WXParseCacheControl("no-store,no-cache,immutable");
+    CHECK(control.noStore && control.noCache && control.immutable && control.maxAge < 0);
+    CHECK(WXParseCacheControl("max-age=oops").maxAge < 0);
+
+    double time = 0;
+    CHECK(WXParseHTTPDate("Sun, 06 Nov 1994 08:49:37 GMT", time) && time == 784111777);
+    CHECK(!WXParseHTTPDate("Sunday, 06-Nov-94 08:49:37 GMT", time));
+    CHECK(!WXParseHTTPDate("Sun, 06 Nox 1994 08:49:37 GMT", time));
+    CHECK(WXParseHTTPDate(httpDate(1500000000), time) && time == 1500000000);
+
+    WXHTTPHeaders headers = {{"content-type", "text/plain"}};
+    CHECK(WXHTTPHeaderValue(headers, "Content-Type") && *WXHTTPHeaderValue(headers, "Content-Type") == "text/plain");
+    CHECK(!WXHTTPHeaderValue(headers, "ETag"));
+}
+
+static void checkFreshness()
+{
+    double date = 1500000000;
+    WXHTTPCacheEntry entry = {200, {{"Date", httpDate(date)}, {"Age", "10"}, {"Cache-Control", "max-age=60"}}, "", 0, date + 1, date + 2};
+    // the corrected age 10 + 1 wins over the apparent age 2, plus 3 seconds in the cache
+    CHECK(WXHTTPCache::currentAge(entry, date + 5) == 14);
+    CHECK(WXHTTPCache::freshnessLifetime(entry) == 60);
+
+    entry.headers = {{"Date", httpDate(date)}, {"Expires", httpDate(date + 300)}};
+    CHECK(WXHTTPCache::freshnessLifetime(entry) == 300);
+    entry.headers = {{"Date", httpDate(date)}, {"Expires", "0"}};
+    CHECK(WXHTTPCache::freshnessLifetime(entry) == 0);
+    entry.headers = {{"Date", httpDate(date)}, {"Last-Modified", httpDate(date - 1000)}};
+    CHECK(WXHTTPCache::freshnessLifetime(entry) == 100);
+    entry.headers = {{"Date", httpDate(date)}, {"Last-Modified", httpDate(date - 1000000)}};
+    CHECK(WXHTTPCache::freshnessLifetime(entry) == 24 * 60 * 60);
+    entry.headers = {{"Cache-Control", "max-age=60, no-cache"}};
+    CHECK(WXHTTPCache::freshnessLifetime(entry) == 0);
+
+    CHECK(WXHTTPCache::isCacheable(200, {{"Cache-Control", "max-age=60"}}));
+    CHECK(WXHTTPCache::isCacheable(200, {{"ETag", "\"1\""}}));
+    CHECK(WXHTTPCache::isCacheable(200, {{"Cache-Control", "max-age=60"}, {"Vary", "Accept-Encoding"}}));
+    CHECK(!WXHTTPCache::isCacheable(200, {}));
+    CHECK(!WXHTTPCache::isCacheable(404, {{"Cache-Control", "max-age=60"}}));
+    CHECK(!WXHTTPCache::isCacheable(200, {{"Cache-Control", "max-age=60, no-store"}}));
+    CHECK(!WXHTTPCache::isCacheable(200, {{"Cache-Control", "max-age=60"}, {"Vary", "Cookie"}}));
+}
+
+static void checkStates(const std::string &directory)
+{
+    removeCache(directory);
+    WXHTTPCache cache(directory, 0);
+    CHECK(cache.open());
+    double date = 1500000000;
+    std::string body = "{\"items\": []}";
+    CHECK(cache.store("swr", 200, {{"Date", httpDate(date)}, {"Cache-Control", "max-age=10, stale-while-revalidate=20"}},
+                      body.data(), body.size(), date, date));
+    CHECK(cache.store("strict", 200, {{"Date", httpDate(date)}, {"Cache-Control", "max-age=10, stale-while-revalidate=20, must-revalidate"}},
+                      body.data(), body.size(), date, date));
+    CHECK(!cache.store("private", 200, {{"Cache-Control", "no-store"}}, body.data(), body.size(), date, date));
+
+    WXHTTPCacheLookup lookup = cache.lookup("swr", date + 5);
+    CHECK(lookup.state == WXHTTPCacheState::Fresh && contentsOf(lookup.bodyPath) == body);
+    CHECK(cache.lookup("swr", date + 20).state == WXHTTPCacheState::StaleWhileRevalidate);
+    CHECK(cache.lookup("swr", date + 40).state == WXHTTPCacheState::Stale);
+    CHECK(cache.lookup("strict", date + 20).state == WXHTTPCacheState::Stale);
+    CHECK(cache.lookup("private", date).state == WXHTTPCacheState::Miss);
+
+    // a 304 refreshes the headers, but keeps the length of the stored body
+    CHECK(cache.store("etag", 200, {{"Date", httpDate(date)}, {"ETag", "\"v1\""}, {"Content-Length", std::to_string(body.size())}},
+                      body.data(), body.size(), date, date));
+    lookup = cache.lookup("etag", date + 1);
+    CHECK(lookup.state == WXHTTPCacheState::Stale && lookup.etag == "\"v1\"");
+    CHECK(cache.revalidate("etag", {{"Date", httpDate(date + 1)}, {"Cache-Control", "max-age=100"}, {"Content-Length", "0"}}, date + 1, date + 1));
+    CHECK(!cache.revalidate("none", {}, date, date));
+    lookup = cache.lookup("etag", date + 50);
+    CHECK(lookup.state == WXHTTPCacheState::Fresh && contentsOf(lookup.bodyPath) == body);
+    CHECK(*WXHTTPHeaderValue(lookup.entry.headers, "Content-Length") == std::to_string(body.size()));
+
+    WXHTTPCacheMetrics metrics = cache.metrics();
+    CHECK(metrics.fresh == 2 && metrics.staleWhileRevalidate == 1 && metrics.stale == 3 && metrics.misses == 1);
+    CHECK(metrics.revalidations == 1 && metrics.stores == 3);
+}
+
+static void checkStorage(const std::string &directory)
+{
+    removeCache(directory);
+    double date = now();
+    WXHTTPHeaders headers = {{"Date", httpDate(date)}, {"Cache-Control", "max-age=600"}};
+    std::string a(100, 'a'), b(100, 'b'), c(100, 'c'), d(100, 'd');
+    std::string bodyPath;
+    {
+        WXHTTPCache cache(directory, 300);
+        CHECK(cache.open());
+        // the same bundle under two URLs is stored once
+        CHECK(cache.store("a1", 200, headers, a.data(), a.size(), date, date));
+        CHECK(cache.store("a2", 200, headers, a.data(), a.size(), date, date));
+        CHECK(cache.metrics().bytes == 100 && cache.metrics().count == 2);
+        bodyPath = cache.lookup("a1", date).bodyPath;
+        cache.remove("a1");
+        CHECK(exists(bodyPath));
+        cache.remove("a2");
+        CHECK(!exists(bodyPath));
+
+        CHECK(cache.store("a", 200, headers, a.data(), a.size(), date, date));
+        CHECK(cache.store("b", 200, headers, b.data(), b.size(), date, date));
+        CHECK(cache.store("c", 200, headers, c.data(), c.size(), date, date));
+        CHECK(cache.lookup("a", date).state == WXHTTPCacheState::Fresh);
+        // "b" is the least recently used
+        CHECK(cache.store("d", 200, headers, d.data(), d.size(), date, date));
+        CHECK(cache.lookup("b", date).state == WXHTTPCacheState::Miss);
+        CHECK(cache.metrics().bytes == 300 && cache.metrics().evictions == 1);
+        // larger than the whole cache
+        std::string large(400, 'x');
+        CHECK(!cache.store("large", 200, headers, large.data(), large.size(), date, date));
+        // replacing an entry releases its old body
+        bodyPath = cache.lookup("c", date).bodyPath;
+        CHECK(cache.store("c", 200, headers, b.data(), b.size(), date, date));
+        CHECK(!exists(bodyPath) && cache.metrics().bytes == 300);
+    }
+
+    // a body left by an interrupted write
+    FILE *file = fopen((directory + "/bodies/orphan").c_str(), "wb");
+    fputs("orphan", file);
+    fclose(file);
+
+    WXHTTPCache cache(directory, 300);
+    CHECK(cache.open());
+    CHECK(!exists(directory + "/bodies/orphan"));
+    CHECK(cache.metrics().count == 3 && cache.metrics().bytes == 300);
+    WXHTTPCacheLookup lookup = cache.lookup("c", date + 1);
+    CHECK(lookup.state == WXHTTPCacheState::Fresh && contentsOf(lookup.bodyPath) == b);
+    CHECK(contentsOf(cache.lookup("a", date + 1).bodyPath) == a);
+    CHECK(lookup.entry.headers == headers);
+}
+
+struct Resource {
+    std::string body;
+    std::string etag;
+    std::string cacheControl;
+};
+
+// serves the resources after a simulated round trip, and answers If-None-Match with 304
+class ResourceServer {
+public:
+    ResourceServer(int latencyMicroseconds)
+    : _latency(latencyMicroseconds), _requests(0), _notModified(0), _bytes(0), _stopped(false)
+    {
+        _socket = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(_socket, (sockaddr *)&address, sizeof(address));
+        socklen_t length = sizeof(address);
+        getsockname(_socket, (sockaddr *)&address, &length);
+        _port = ntohs(address.sin_port);
+        listen(_socket, 64);
+        _thread = std::thread([this] { serve(); });
+    }
+
+    ~ResourceServer()
+    {
+        _stopped = true;
+        shutdown(_socket, SHUT_RDWR);
+        ::close(_socket);
+        _thread.join();
+        for (std::thread &worker : _workers) {
+            worker.join();
+        }
+    }
+
+    void set(const std::string &path, const Resource &resource)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _resources[path] = resource;
+    }
+
+    int port() const { return _port; }
+    size_t requests() const { return _requests; }
+    size_t notModified() const { return _notModified; }
+    size_t bytes() const { return _bytes; }
+
+private:
+    int _latency;
+    int _socket;
+    int _port;
+    std::atomic<size_t> _requests;
+    std::atomic<size_t> _notModified;
+    std::atomic<size_t> _bytes;
+    std::atomic<bool> _stopped;
+    std::thread _thread;
+    std::vector<std::thread> _workers;
+    std::map<std::string, Resource> _resources;
+    std::mutex _mutex;
+
+    void serve()
+    {
+        while (!_stopped) {
+            int connection = accept(_socket, nullptr, nullptr);
+            if (connection < 0) {
+                return;
+            }
+            _workers.emplace_back([this, connection] { respond(connection); });
+        }
+    }
+
+    void respond(int connection)
+    {
+        std::string request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            ssize_t length = recv(connection, buffer, sizeof(buffer), 0);
+            if (length <= 0) {
+                break;
+            }
+            request.append(buffer, length);
+        }
+        _requests++;
+        usleep(_latency);
+
+        size_t pathStart = request.find(' ') + 1;
+        std::string path = request.substr(pathStart, request.find(' ', pathStart) - pathStart);
+        Resource resource;
+        bool found;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            found = _resources.count(path) > 0;
+            if (found) {
+                resource = _resources[path];
+            }
+        }
+
+        std::string response;
+        if (!found) {
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n";
+        } else if (!resource.etag.empty() && request.find("If-None-Match: " + resource.etag + "\r\n") != std::string::npos) {
+            _notModified++;
+            response = "HTTP/1.1 304 Not Modified\r\nETag: " + resource.etag + "\r\n";
+        } else {
+            response = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(resource.body.size()) + "\r\n";
+            if (!resource.etag.empty()) {
+                response += "ETag: " + resource.etag + "\r\n";
+            }
+        }
+        if (found && !resource.cacheControl.empty()) {
+            response += "Cache-Control: " + resource.cacheControl + "\r\n";
+        }
+        response += "Date: " + httpDate(now()) + "\r\nConnection: close\r\n\r\n";
+        if (response.compare(9, 3, "200") == 0) {
+            response += resource.body;
+        }
+        _bytes += response.size();
+        send(connection, response.data(), response.size(), 0);
+        ::close(connection);
+    }
+};
+
+struct Response {
+    int status;
+    WXHTTPHeaders headers;
+    std::string body;
+};
+
+static Response fetch(int port, const std::string &path, const WXHTTPHeaders &headers)
+{
+    int connection = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    connect(connection, (sockaddr *)&address, sizeof(address));
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: 127.0.0.1\r\n";
+    for (const auto &header : headers) {
+        request += header.first + ": " + header.second + "\r\n";
+    }
+    request += "\r\n";
+    send(connection, request.data(), request.size(), 0);
+
+    std::string data;
+    char buffer[16 * 1024];
+    ssize_t length;
+    while ((length = recv(connection, buffer, sizeof(buffer), 0)) > 0) {
+        data.append(buffer, length);
+    }
+    ::close(connection);
+
+    Response response = {0, {}, ""};
+    size_t headerEnd = data.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+        return response;
+    }
+    response.status = atoi(data.c_str() + 9);
+    size_t start = data.find("\r\n") + 2;
+    while (start < headerEnd) {
+        size_t end = data.find("\r\n", start);
+        size_t colon = data.find(": ", start);
+        response.headers.emplace_back(data.substr(start, colon - start), data.substr(colon + 2, end - colon - 2));
+        start = end + 2;
+    }
+    response.body = data.substr(headerEnd + 4);
+    return response;
+}
+
+// what the network handlers do on top of the cache
+class CachingClient {
+public:
+    CachingClient(WXHTTPCache *cache, int port) : _cache(cache), _port(port) {}
+
+    ~CachingClient()
+    {
+        for (std::thread &revalidation : _revalidations) {
+            revalidation.join();
+        }
+    }
+
+    Response get(const std::string &path)
+    {
+        std::string key = "http://127.0.0.1:" + std::to_string(_port) + path;
+        WXHTTPCacheLookup lookup = _cache->lookup(key, now());
+        if (lookup.state == WXHTTPCacheState::Fresh) {
+            return {lookup.entry.status, lookup.entry.headers, contentsOf(lookup.bodyPath)};
+        }
+        if (lookup.state == WXHTTPCacheState::StaleWhileRevalidate) {
+            _revalidations.emplace_back([this, key, path, lookup] { load(key, path, lookup); });
+            return {lookup.entry.status, lookup.entry.headers, contentsOf(lookup.bodyPath)};
+        }
+
+        auto promise = std::make_shared<std::promise<Response>>();
+        std::future<Response> future = promise->get_future();
+        if (_inflight.add(key, promise)) {
+            Response response = load(key, path, lookup);
+            for (auto &waiter : _inflight.finish(key)) {
+                waiter->set_value(response);
+            }
+        }
+        return future.get();
+    }
+
+private:
+    WXHTTPCache *_cache;
+    int _port;
+    WXInflightRequests<std::shared_ptr<std::promise<Response>>> _inflight;
+    std::vector<std::thread> _revalidations;
+
+    Response load(const std::string &key, const std::string &path, const WXHTTPCacheLookup &lookup)
+    {
+        WXHTTPHeaders conditions;
+        if (lookup.state != WXHTTPCacheState::Miss && !lookup.etag.empty()) {
+            conditions.emplace_back("If-None-Match", lookup.etag);
+        } else if (lookup.state != WXHTTPCacheState::Miss && !lookup.lastModified.empty()) {
+            conditions.emplace_back("If-Modified-Since", lookup.lastModified);
+        }
+        double requestTime = now();
+        Response response = fetch(_port, path, conditions);
+        double responseTime = now();
+        if (response.status == 304 && _cache->revalidate(key, response.headers, requestTime, responseTime)) {
+            WXHTTPCacheLookup updated = _cache->lookup(key, responseTime);
+            return {updated.entry.status, updated.entry.headers, contentsOf(updated.bodyPath)};
+        }
+        _cache->store(key, response.status, response.headers, response.body.data(), response.body.size(), requestTime, responseTime);
+        return response;
+    }
+};
+
+static void checkNetwork(const std::string &directory)
+{
+    removeCache(directory);
+    WXHTTPCache cache(directory, 0);
+    CHECK(cache.open());
+    ResourceServer server(20 * 1000);
+    std::string bundle(10000, 'b');
+    server.set("/bundle.js", {bundle, "\"b1\"", "max-age=600"});
+    server.set("/api", {"{\"page\": 1}", "\"a1\"", "no-cache"});
+    server.set("/feed", {"{\"feed\": 1}", "", "max-age=0, stale-while-revalidate=600"});
+
+    {
+        CachingClient client(&cache, server.port());
+        Response response = client.get("/bundle.js");
+        CHECK(response.status == 200 && response.body == bundle);
+        CHECK(client.get("/bundle.js").body == bundle);
+        CHECK(server.requests() == 1);
+
+        CHECK(client.get("/api").body == "{\"page\": 1}");
+        response = client.get("/api");
+        CHECK(response.status == 200 && response.body == "{\"page\": 1}");
+        CHECK(server.requests() == 3 && server.notModified() == 1);
+        server.set("/api", {"{\"page\": 2}", "\"a2\"", "no-cache"});
+        CHECK(client.get("/api").body == "{\"page\": 2}");
+        CHECK(server.notModified() == 1);
+
+        CHECK(client.get("/feed").body == "{\"feed\": 1}");
+        server.set("/feed", {"{\"feed\": 2}", "", "max-age=0, stale-while-revalidate=600"});
+        // served from the cache, and refreshed in the background
+        CHECK(client.get("/feed").body == "{\"feed\": 1}");
+    }
+    CHECK(server.requests() == 6);
+    CachingClient client(&cache, server.port());
+    CHECK(client.get("/feed").body == "{\"feed\": 2}");
+
+    // identical requests in flight share one load
+    server.set("/slow", {"slow", "", "no-store"});
+    size_t requests = server.requests();
+    std::vector<std::thread> threads;
+    std::atomic<int> matches(0);
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&] {
+            if (client.get("/slow").body == "slow") {
+                matches++;
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    CHECK(matches == 8);
+    // the threads which came after the load finished start another one
+    CHECK(server.requests() - requests < 8);
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// open a page: its bundle, and two API calls which have to be revalidated
+static void benchmark(const std::string &directory, int latencyMilliseconds, size_t bundleSize, int opens)
+{
+    double times[2];
+    size_t requests[2], bytes[2];
+    for (int cached = 0; cached < 2; cached++) {
+        removeCache(directory);
+        WXHTTPCache cache(directory, 20 * 1024 * 1024);
+        cache.open();
+        ResourceServer server(latencyMilliseconds * 1000);
+        server.set("/bundle.js", {std::string(bundleSize, 'b'), "\"b1\"", "max-age=600"});
+        server.set("/api/user", {std::string(2000, 'u'), "\"u1\"", "no-cache"});
+        server.set("/api/feed", {std::string(8000, 'f'), "", "max-age=0, stale-while-revalidate=60"});
+
+        CachingClient client(&cache, server.port());
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < opens; i++) {
+            const char *paths[] = {"/bundle.js", "/api/user", "/api/feed"};
+            for (const char *path : paths) {
+                if (cached) {
+                    client.get(path);
+                } else {
+                    fetch(server.port(), path, {});
+                }
+            }
+        }
+        times[cached] = milliseconds(start) / opens;
+        requests[cached] = server.requests();
+        bytes[cached] = server.bytes();
+    }
+    removeCache(directory);
+
+    printf("%3d ms RTT, %7zu bytes bundle, %d opens: network %7.2f ms/open %3zu requests %9zu bytes | cache %7.2f ms/open %3zu requests %8zu bytes\n",
+           latencyMilliseconds, bundleSize, opens, times[0], requests[0], bytes[0], times[1], requests[1], bytes[1]);
+}
+
+int main(int argc, const char *argv[])
+{
+    std::string directory = std::string(argc > 1 ? argv[1] : "/tmp") + "/wxhttpcache_check";
+
+    checkParsing();
+    checkFreshness();
+    checkStates(directory);
+    checkStorage(directory);
+    checkNetwork(directory);
+    removeCache(directory);
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(directory, 5, 200 * 1024, 20);
+    benchmark(directory, 30, 200 * 1024, 20);
+    benchmark(directory, 30, 1024 * 1024, 10);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,284 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXImageDownsampler, then decodes a feed of photos shown as
+ * thumbnails with a stand-in decoder, at their full resolution against the
+ * planned size, comparing the bytes held in memory and the decoding time.
+ * The stand-in decodes every pixel at some cost, like an entropy decoder,
+ * and can subsample by powers of two, like JPEG decoders. It doesn't need
+ * Xcode:
+ *
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Utility WXImageDownsampleBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXImageDownsampler.cpp -o image_downsample_benchmark
+ *   ./image_downsample_benchmark
+ */
+
+#include "WXImageDownsampler.h"
+#include "WXRasterCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+struct Bitmap {
+    int width;
+    int height;
+    std::vector<uint32_t> pixels;
+
+    size_t bytes() const { return pixels.size() * sizeof(uint32_t); }
+};
+
+struct EncodedImage {
+    int width;
+    int height;
+    std::vector<uint32_t> data;
+};
+
+// the work of decoding a pixel
+static uint32_t keystream(uint32_t index)
+{
+    uint32_t value = index * 2654435761u;
+    for (int round = 0; round < 16; round++) {
+        value ^= value >> 15;
+        value *= 2246822519u;
+        value ^= value >> 13;
+    }
+    return value;
+}
+
+static uint32_t channel(uint32_t pixel, int shift)
+{
+    return (pixel >> shift) & 0xff;
+}
+
+// a smooth gradient, so a downsampled decode stays close to the original
+static uint32_t sourcePixel(int x, int y, int width, int height)
+{
+    uint32_t red = (uint32_t)(255.0 * x / width);
+    uint32_t green = (uint32_t)(255.0 * y / height);
+    uint32_t blue = (uint32_t)(255.0 * (x + y) / (width + height));
+    return 0xff000000u | red << 16 | green << 8 | blue;
+}
+
+static EncodedImage encode(int width, int height)
+{
+    EncodedImage image = {width, height, std::vector<uint32_t>((size_t)width * height)};
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            size_t index = (size_t)y * width + x;
+            image.data[index] = sourcePixel(x, y, width, height) ^ keystream((uint32_t)index);
+        }
+    }
+    return image;
+}
+
+// decodes one pixel of every sampleSize x sampleSize block
+static Bitmap decode(const EncodedImage &image, int sampleSize)
+{
+    Bitmap bitmap = {(image.width + sampleSize - 1) / sampleSize, (image.height + sampleSize - 1) / sampleSize, {}};
+    bitmap.pixels.resize((size_t)bitmap.width * bitmap.height);
+    for (int y = 0; y < bitmap.height; y++) {
+        for (int x = 0; x < bitmap.width; x++) {
+            size_t index = (size_t)y * sampleSize * image.width + (size_t)x * sampleSize;
+            bitmap.pixels[(size_t)y * bitmap.width + x] = image.data[index] ^ keystream((uint32_t)index);
+        }
+    }
+    return bitmap;
+}
+
+// nearest neighbour, the subsampled bitmap is at most twice the size
+static Bitmap scale(const Bitmap &source, int width, int height)
+{
+    if (source.width == width && source.height == height) {
+        return source;
+    }
+    Bitmap bitmap = {width, height, std::vector<uint32_t>((size_t)width * height)};
+    for (int y = 0; y < height; y++) {
+        int sourceY = (int)((y + 0.5) * source.height / height);
+        for (int x = 0; x < width; x++) {
+            int sourceX = (int)((x + 0.5) * source.width / width);
+            bitmap.pixels[(size_t)y * width + x] = source.pixels[(size_t)sourceY * source.width + sourceX];
+        }
+    }
+    return bitmap;
+}
+
+static Bitmap decodeForBucket(const EncodedImage &image, const WXImageSizeBucket &bucket)
+{
+    WXImageDecodePlan plan = WXPlanImageDecode(image.width, image.height, bucket);
+    return scale(decode(image, plan.sampleSize), plan.width, plan.height);
+}
+
+static void checkBuckets()
+{
+    CHECK(WXImageBucketPixels(0) == 0);
+    CHECK(WXImageBucketPixels(3) == 8);
+    CHECK(WXImageBucketPixels(64) == 64);
+    CHECK(WXImageBucketPixels(65) == 80);
+    CHECK(WXImageBucketPixels(300) == 320);
+    CHECK(WXImageBucketPixels(1000) == 1024);
+    for (int pixels = 1; pixels < 5000; pixels++) {
+        int bucket = WXImageBucketPixels(pixels);
+        CHECK(bucket >= pixels && bucket <= pixels + pixels / 4 + 8);
+    }
+
+    WXImageSizeBucket bucket = WXImageBucketForTarget({100, 50, 3});
+    CHECK(bucket.width == 320 && bucket.height == 160);
+    // a quality which isn't the original one is a smaller pixel ratio
+    bucket = WXImageBucketForTarget({100, 50, 3 * 0.5});
+    CHECK(bucket.width == 160 && bucket.height == 80);
+    bucket = WXImageBucketForTarget({100, 50, 0});
+    CHECK(bucket.width == 0 && bucket.height == 0);
+    bucket = WXImageBucketForTarget({0, 50, 2});
+    CHECK(bucket.width == 0 && bucket.height == 0);
+}
+
+static void checkPlans()
+{
+    WXImageDecodePlan plan = WXPlanImageDecode(4000, 3000, {320, 320});
+    CHECK(plan.width == 427 && plan.height == 320 && plan.sampleSize == 8);
+    // a tall frame over a wide photo, like resize="cover"
+    plan = WXPlanImageDecode(4000, 1000, {100, 400});
+    CHECK(plan.width == 1600 && plan.height == 400 && plan.sampleSize == 2);
+    // never larger than the source
+    plan = WXPlanImageDecode(100, 80, {320, 320});
+    CHECK(plan.width == 100 && plan.height == 80 && plan.sampleSize == 1);
+    plan = WXPlanImageDecode(4000, 3000, {0, 0});
+    CHECK(plan.width == 4000 && plan.height == 3000 && plan.sampleSize == 1);
+    plan = WXPlanImageDecode(0, 0, {320, 320});
+    CHECK(plan.width == 0 && plan.height == 0);
+
+    for (int width = 1; width < 3000; width += 37) {
+        plan = WXPlanImageDecode(width, 1200, {240, 160});
+        CHECK(plan.width <= width && plan.height <= 1200);
+        CHECK((plan.width >= 240 && plan.height >= 160) || plan.width == width || plan.height == 1200);
+        CHECK(width / plan.sampleSize >= plan.width && 1200 / plan.sampleSize >= plan.height);
+    }
+}
+
+static void checkDecode()
+{
+    EncodedImage image = encode(1200, 900);
+    Bitmap full = decode(image, 1);
+    CHECK(full.width == 1200 && full.pixels[(size_t)450 * 1200 + 600] == sourcePixel(600, 450, 1200, 900));
+
+    Bitmap small = decodeForBucket(image, WXImageBucketForTarget({100, 100, 2}));
+    CHECK(small.width == 299 && small.height == 224);
+    int maxDifference = 0;
+    for (int y = 0; y < small.height; y++) {
+        for (int x = 0; x < small.width; x++) {
+            uint32_t expected = sourcePixel(x * 1200 / small.width, y * 900 / small.height, 1200, 900);
+            uint32_t actual = small.pixels[(size_t)y * small.width + x];
+            for (int shift = 0; shift < 24; shift += 8) {
+                maxDifference = std::max(maxDifference, abs((int)channel(expected, shift) - (int)channel(actual, shift)));
+            }
+        }
+    }
+    CHECK(maxDifference <= 8);
+}
+
+static void checkCache()
+{
+    // decoded images cached by URL and bucket, like WXImageScheduler does
+    WXRasterCache<std::shared_ptr<Bitmap>> cache(64 * 1024 * 1024);
+    EncodedImage image = encode(800, 600);
+    int decodes = 0;
+    auto load = [&](const char *url, double width, double height) {
+        WXImageSizeBucket bucket = WXImageBucketForTarget({width, height, 2});
+        WXRasterKey key;
+        key.add(url, strlen(url)).add((int64_t)bucket.width).add((int64_t)bucket.height);
+        std::shared_ptr<Bitmap> bitmap;
+        if (!cache.get(key, bitmap)) {
+            decodes++;
+            bitmap = std::make_shared<Bitmap>(decodeForBucket(image, bucket));
+            cache.put(key, bitmap, bitmap->bytes());
+        }
+        return bitmap;
+    };
+
+    std::shared_ptr<Bitmap> first = load("a.jpg", 150, 150);
+    CHECK(load("a.jpg", 155, 152) == first);
+    CHECK(decodes == 1);
+    CHECK(load("a.jpg", 300, 300) != first && decodes == 2);
+    CHECK(load("b.jpg", 150, 150) != first && decodes == 3);
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void benchmark(int images, int sourceWidth, int sourceHeight, double frameWidth, double frameHeight, double pixelsPerPoint)
+{
+    EncodedImage image = encode(sourceWidth, sourceHeight);
+    WXImageSizeBucket bucket = WXImageBucketForTarget({frameWidth, frameHeight, pixelsPerPoint});
+
+    size_t fullBytes = 0, plannedBytes = 0;
+    uint32_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < images; i++) {
+        Bitmap bitmap = decode(image, 1);
+        fullBytes += bitmap.bytes();
+        checksum ^= bitmap.pixels[i % bitmap.pixels.size()];
+    }
+    double fullTime = milliseconds(start);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < images; i++) {
+        Bitmap bitmap = decodeForBucket(image, bucket);
+        plannedBytes += bitmap.bytes();
+        checksum ^= bitmap.pixels[i % bitmap.pixels.size()];
+    }
+    double plannedTime = milliseconds(start);
+
+    printf("%d images %dx%d in %.0fx%.0f pt @%.1f: full %8.1f ms %6.1f MB | downsampled %6.1f ms %5.1f MB (%x)\n",
+           images, sourceWidth, sourceHeight, frameWidth, frameHeight, pixelsPerPoint,
+           fullTime, fullBytes / 1048576.0, plannedTime, plannedBytes / 1048576.0, checksum & 0xf);
+}
+
+int main()
+{
+    checkBuckets();
+    checkPlans();
+    checkDecode();
+    checkCache();
+    printf("checks: %d failures\n\n", failures);
+
+    // a feed of photos in two columns, at the high and the low quality
+    benchmark(20, 2000, 1500, 170, 170, 3);
+    benchmark(20, 2000, 1500, 170, 170, 1.5);
+    // banners as wide as the screen
+    benchmark(10, 1500, 600, 375, 150, 3);
+    // icons
+    benchmark(50, 512, 512, 40, 40, 2);
+
+    return failures ? 1 : 0;
+}
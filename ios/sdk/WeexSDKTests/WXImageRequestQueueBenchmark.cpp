@@ -0,0 +1,285 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXImageRequestQueue, then simulates a fast scroll through a list of
+ * images on a fake clock: every load takes the same time, and the queue is
+ * compared with starting every request in order, as each component did. It
+ * doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Utility WXImageRequestQueueBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXImageRequestQueue.cpp -o image_queue_benchmark
+ *   ./image_queue_benchmark
+ */
+
+#include "WXImageRequestQueue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <map>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static void checkCoalescing()
+{
+    WXImageRequestQueue queue(4);
+    std::vector<uint64_t> tickets;
+    for (int i = 0; i < 50; i++) {
+        tickets.push_back(queue.add("placeholder.png", 100, 0));
+    }
+    std::vector<WXImageLoad> loads = queue.next(1);
+    CHECK(loads.size() == 1 && loads[0].key == "placeholder.png");
+    // joining a running load doesn't start another one
+    tickets.push_back(queue.add("placeholder.png", 0, 1));
+    CHECK(queue.next(1).empty());
+    CHECK(queue.finish(loads[0].identifier, true) == tickets);
+    CHECK(queue.finish(loads[0].identifier, true).empty());
+
+    WXImageRequestQueueMetrics metrics = queue.metrics();
+    CHECK(metrics.requests == 51 && metrics.coalesced == 50 && metrics.started == 1 && metrics.succeeded == 1);
+    CHECK(metrics.running == 0 && metrics.pending == 0 && metrics.maxPending == 1 && metrics.totalWait == 1);
+}
+
+static void checkPriority()
+{
+    WXImageRequestQueue queue(2);
+    queue.add("far", 2000, 0);
+    queue.add("near", 500, 0);
+    uint64_t offscreen = queue.add("offscreen", 1000, 0);
+    queue.add("later", 1000, 0);
+    queue.add("visible", 0, 0);
+
+    std::vector<WXImageLoad> loads = queue.next(0);
+    CHECK(loads.size() == 2 && loads[0].key == "visible" && loads[1].key == "near");
+    CHECK(queue.next(0).empty());
+    CHECK(queue.metrics().running == 2 && queue.metrics().pending == 3);
+
+    // the cell scrolled into the viewport
+    CHECK(queue.update(offscreen, 0));
+    // a visible request joins the far load, which takes its priority
+    queue.add("far", 10, 0);
+    queue.finish(loads[0].identifier, true);
+    queue.finish(loads[1].identifier, false);
+    loads = queue.next(0);
+    CHECK(loads.size() == 2 && loads[0].key == "offscreen" && loads[1].key == "far");
+    queue.finish(loads[0].identifier, true);
+    loads = queue.next(0);
+    CHECK(loads.size() == 1 && loads[0].key == "later");
+    CHECK(queue.metrics().failed == 1 && queue.metrics().succeeded == 2);
+
+    queue.setMaxRunning(0);
+    queue.add("blocked", 0, 0);
+    CHECK(queue.next(0).empty());
+    queue.setMaxRunning(4);
+    CHECK(queue.next(0).size() == 1);
+}
+
+static void checkCancel()
+{
+    WXImageRequestQueue queue(1);
+    uint64_t first = queue.add("a", 0, 0);
+    uint64_t second = queue.add("a", 0, 0);
+    uint64_t pending = queue.add("b", 1, 0);
+    std::vector<WXImageLoad> loads = queue.next(0);
+    CHECK(loads.size() == 1 && loads[0].key == "a");
+
+    // the load goes on for the other request
+    CHECK(queue.cancel(first) == 0);
+    // the cell is reused, nobody waits for the load any more
+    CHECK(queue.cancel(second) == loads[0].identifier);
+    CHECK(queue.cancel(second) == 0);
+    CHECK(!queue.update(second, 0));
+    CHECK(queue.finish(loads[0].identifier, true).empty());
+
+    // a new request for the key starts a new load
+    uint64_t again = queue.add("a", 0, 0);
+    // a load which didn't start is dropped
+    CHECK(queue.cancel(pending) != 0);
+    loads = queue.next(0);
+    CHECK(loads.size() == 1 && loads[0].key == "a");
+    CHECK(queue.finish(loads[0].identifier, true) == std::vector<uint64_t>{again});
+
+    WXImageRequestQueueMetrics metrics = queue.metrics();
+    CHECK(metrics.cancelled == 3 && metrics.aborted == 2 && metrics.started == 2);
+    CHECK(metrics.pending == 0 && metrics.running == 0);
+}
+
+struct SimulationResult {
+    double visibleReady;
+    size_t fetches;
+};
+
+// a list of cells, each with a shared placeholder and its own image, all
+// requested while the list is built, then the user flings to the end of it
+static SimulationResult simulate(bool scheduled, int cells, int visible, double loadTime, size_t connections)
+{
+    const double flingTime = 0.1;
+    int firstVisible = cells - visible;
+    std::map<uint64_t, int> cellOfTicket;
+    std::map<int, std::vector<uint64_t>> ticketsOfCell;
+    std::map<uint64_t, double> running;
+    std::map<int, bool> ready;
+    SimulationResult result = {0, 0};
+
+    WXImageRequestQueue queue(connections);
+    std::deque<std::pair<int, std::string>> fifo;
+    for (int cell = 0; cell < cells; cell++) {
+        // distance to the viewport, in cells, at the top of the list
+        double priority = cell < visible ? 0 : cell - visible + 1;
+        if (scheduled) {
+            for (const std::string &key : {std::string("placeholder"), "image" + std::to_string(cell)}) {
+                uint64_t ticket = queue.add(key, priority, 0);
+                cellOfTicket[ticket] = cell;
+                ticketsOfCell[cell].push_back(ticket);
+            }
+        } else {
+            fifo.emplace_back(cell, "placeholder");
+            fifo.emplace_back(cell, "image" + std::to_string(cell));
+        }
+    }
+
+    std::map<uint64_t, std::pair<int, std::string>> fifoRunning;
+    uint64_t lastFifo = 0;
+    bool flung = false;
+    for (double now = 0;; now += 0.001) {
+        if (!flung && now >= flingTime) {
+            flung = true;
+            for (int cell = 0; cell < cells && scheduled; cell++) {
+                for (uint64_t ticket : ticketsOfCell[cell]) {
+                    if (cell < firstVisible) {
+                        // the cells scrolled away are reused
+                        if (uint64_t aborted = queue.cancel(ticket)) {
+                            running.erase(aborted);
+                        }
+                    } else {
+                        queue.update(ticket, 0);
+                    }
+                }
+            }
+        }
+
+        for (auto load = running.begin(); load != running.end();) {
+            if (load->second > now) {
+                ++load;
+                continue;
+            }
+            for (uint64_t ticket : queue.finish(load->first, true)) {
+                int cell = cellOfTicket[ticket];
+                if (cell >= firstVisible && ticket == ticketsOfCell[cell].back()) {
+                    ready[cell] = true;
+                }
+            }
+            load = running.erase(load);
+        }
+        for (auto load = fifoRunning.begin(); load != fifoRunning.end();) {
+            if (running[load->first] > now) {
+                ++load;
+                continue;
+            }
+            if (load->second.first >= firstVisible && load->second.second != "placeholder") {
+                ready[load->second.first] = true;
+            }
+            running.erase(load->first);
+            load = fifoRunning.erase(load);
+        }
+
+        if (scheduled) {
+            for (const WXImageLoad &load : queue.next(now)) {
+                running[load.identifier] = now + loadTime;
+                result.fetches++;
+            }
+        } else {
+            while (fifoRunning.size() < connections && !fifo.empty()) {
+                uint64_t identifier = ++lastFifo;
+                fifoRunning[identifier] = fifo.front();
+                running[identifier] = now + loadTime;
+                fifo.pop_front();
+                result.fetches++;
+            }
+        }
+
+        if (flung && (int)ready.size() >= visible) {
+            result.visibleReady = now;
+            return result;
+        }
+    }
+}
+
+static void benchmark(int cells, int visible, double loadTime, size_t connections)
+{
+    SimulationResult ordered = simulate(false, cells, visible, loadTime, connections);
+    SimulationResult scheduled = simulate(true, cells, visible, loadTime, connections);
+    printf("%4d cells, %2d visible, %3.0f ms loads, %zu at once: in order %7.0f ms %4zu fetches | queue %5.0f ms %4zu fetches\n",
+           cells, visible, loadTime * 1000, connections, ordered.visibleReady * 1000, ordered.fetches,
+           scheduled.visibleReady * 1000, scheduled.fetches);
+}
+
+static void benchmarkThroughput(size_t requests)
+{
+    WXImageRequestQueue queue(8);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < 1000; i++) {
+        keys.push_back("https://img.example.com/" + std::to_string(i) + ".jpg");
+    }
+    size_t finished = 0;
+    for (size_t i = 0; i < requests; i++) {
+        queue.add(keys[i % keys.size()], (double)(i % 97), 0);
+        if (i % 4 == 0) {
+            for (const WXImageLoad &load : queue.next(0)) {
+                finished += queue.finish(load.identifier, true).size();
+            }
+        }
+    }
+    while (true) {
+        std::vector<WXImageLoad> loads = queue.next(0);
+        if (loads.empty()) {
+            break;
+        }
+        for (const WXImageLoad &load : loads) {
+            finished += queue.finish(load.identifier, true).size();
+        }
+    }
+    double time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    printf("%zu requests: %.3f us per request, %zu finished\n", requests, time / requests, finished);
+}
+
+int main()
+{
+    checkCoalescing();
+    checkPriority();
+    checkCancel();
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(50, 6, 0.05, 6);
+    benchmark(200, 6, 0.05, 6);
+    benchmark(200, 10, 0.2, 6);
+    benchmarkThroughput(100000);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <UIKit/UIKit.h>
+#import "WXPrerenderManager.h"
+
+@interface WXPrerenderManager (PoolTests)
+
+@property (nonatomic, strong) NSMutableArray *cachedUrlList;
+@property (nonatomic, strong) NSMutableDictionary *prerenderTasks;
+@property (nonatomic, strong) dispatch_queue_t queue;
+
++ (instancetype)sharedInstance;
+- (void)touchTaskLocked:(id)task key:(NSString *)key;
+- (void)trimToCount:(NSUInteger)count bytes:(NSUInteger)bytes;
+
+@end
+
+@interface WXPrerenderManagerTests : XCTestCase
+
+@property (nonatomic, strong) WXPrerenderManager *manager;
+
+@end
+
+@implementation WXPrerenderManagerTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.manager = [WXPrerenderManager sharedInstance];
+    [self.manager trimToCount:0 bytes:0];
+    [self.manager.prerenderTasks removeAllObjects];
+}
+
+- (void)tearDown
+{
+    [WXPrerenderManager setMaxCacheNumber:5 maxCacheBytes:30 * 1024 * 1024];
+    [self.manager trimToCount:0 bytes:0];
+    [self.manager.prerenderTasks removeAllObjects];
+    [super tearDown];
+}
+
+- (NSString *)urlOfName:(NSString *)name
+{
+    return [NSString stringWithFormat:@"http://prerender.test/%@.js", name];
+}
+
+// pools a ready task the way a finished prerender leaves it, without rendering an instance
+- (id)addTask:(NSString *)name cost:(NSUInteger)cost
+{
+    id task = [NSClassFromString(@"WXPrerenderTask") new];
+    NSString *url = [self urlOfName:name];
+    [task setValue:url forKey:@"url"];
+    [task setValue:[UIView new] forKey:@"view"];
+    [task setValue:[NSDate date] forKey:@"beginDate"];
+    [task setValue:@300000 forKey:@"cacheTime"];
+    [task setValue:@(cost) forKey:@"cost"];
+    NSString *key = [WXPrerenderManager getTaskKeyFromUrl:url];
+    self.manager.prerenderTasks[key] = task;
+    [self.manager touchTaskLocked:task key:key];
+    return task;
+}
+
+- (NSArray *)pooledNames
+{
+    NSMutableArray *names = [NSMutableArray array];
+    for (NSString *key in self.manager.cachedUrlList) {
+        [names addObject:key.lastPathComponent.stringByDeletingPathExtension];
+    }
+    return names;
+}
+
+// prerenders the url, and returns once its task is pooled, before its instance is created on the main thread
+- (void)prerender:(NSString *)name
+{
+    __block BOOL called = NO;
+    [WXPrerenderManager addGlobalTask:[self urlOfName:name] callback:^(id result) {
+        called = YES;
+    }];
+    dispatch_sync(self.manager.queue, ^{});
+    XCTAssertTrue(called);
+}
+
+- (id)taskOfName:(NSString *)name
+{
+    return self.manager.prerenderTasks[[WXPrerenderManager getTaskKeyFromUrl:[self urlOfName:name]]];
+}
+
+- (void)testLeastRecentlyUsedOrder
+{
+    [WXPrerenderManager setMaxCacheNumber:3 maxCacheBytes:NSUIntegerMax];
+    [self prerender:@"a"];
+    [self prerender:@"b"];
+    [self prerender:@"c"];
+    XCTAssertEqualObjects([self pooledNames], (@[@"a", @"b", @"c"]));
+    
+    // a hit makes the task the most recently used, the view is what a finished render leaves
+    [[self taskOfName:@"a"] setValue:[UIView new] forKey:@"view"];
+    XCTAssertTrue([WXPrerenderManager isTaskReady:[self urlOfName:@"a"]]);
+    XCTAssertEqualObjects([self pooledNames], (@[@"b", @"c", @"a"]));
+    
+    // a miss doesn't
+    XCTAssertFalse([WXPrerenderManager isTaskReady:[self urlOfName:@"b"]]);
+    XCTAssertEqualObjects([self pooledNames], (@[@"b", @"c", @"a"]));
+    
+    [self prerender:@"d"];
+    XCTAssertEqualObjects([self pooledNames], (@[@"c", @"a", @"d"]));
+    XCTAssertNil([self taskOfName:@"b"]);
+    
+    // prerendering a pooled url again makes it the most recently used
+    [self prerender:@"c"];
+    XCTAssertEqualObjects([self pooledNames], (@[@"a", @"d", @"c"]));
+}
+
+- (void)testTaskEvictedBeforeItsInstanceIsNotRendered
+{
+    [self prerender:@"a"];
+    id task = [self taskOfName:@"a"];
+    XCTAssertNotNil(task);
+    
+    // the main thread hasn't created the instance yet
+    [self.manager trimToCount:0 bytes:0];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    XCTAssertNil([task valueForKey:@"instance"]);
+    XCTAssertNil([self taskOfName:@"a"]);
+}
+
+- (void)testTrimByCountAndBytes
+{
+    [self addTask:@"a" cost:100];
+    [self addTask:@"b" cost:200];
+    [self addTask:@"c" cost:300];
+    
+    [self.manager trimToCount:10 bytes:500];
+    XCTAssertEqualObjects([self pooledNames], (@[@"b", @"c"]));
+    
+    [self.manager trimToCount:1 bytes:NSUIntegerMax];
+    XCTAssertEqualObjects([self pooledNames], (@[@"c"]));
+    
+    // a task larger than the whole budget is not kept either
+    [self.manager trimToCount:10 bytes:299];
+    XCTAssertEqual([self pooledNames].count, 0);
+    XCTAssertEqual(self.manager.prerenderTasks.count, 0);
+}
+
+- (void)testRenderedTaskLeavesPool
+{
+    [self addTask:@"a" cost:100];
+    [self addTask:@"b" cost:100];
+    NSString *url = [self urlOfName:@"a"];
+    XCTAssertTrue([WXPrerenderManager isTaskReady:url]);
+    
+    [WXPrerenderManager renderFromCache:url];
+    XCTAssertEqualObjects([self pooledNames], (@[@"b"]));
+    
+    // shown by a page, it's never evicted
+    [self.manager trimToCount:0 bytes:0];
+    XCTAssertNotNil([WXPrerenderManager viewFromUrl:url]);
+    XCTAssertNil([WXPrerenderManager viewFromUrl:[self urlOfName:@"b"]]);
+    
+    // using it again doesn't put it back in the pool
+    NSString *key = [WXPrerenderManager getTaskKeyFromUrl:url];
+    [self.manager touchTaskLocked:self.manager.prerenderTasks[key] key:key];
+    XCTAssertEqual([self pooledNames].count, 0);
+}
+
+- (void)testMemoryWarningFlushesPool
+{
+    [self addTask:@"a" cost:100];
+    [self addTask:@"b" cost:100];
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    XCTAssertEqual([self pooledNames].count, 0);
+    XCTAssertEqual(self.manager.prerenderTasks.count, 0);
+}
+
+- (void)testMetrics
+{
+    NSDictionary *before = [WXPrerenderManager metrics];
+    [self addTask:@"a" cost:100];
+    [self addTask:@"b" cost:200];
+    [self addTask:@"c" cost:300];
+    
+    XCTAssertTrue([WXPrerenderManager isTaskReady:[self urlOfName:@"a"]]);
+    XCTAssertFalse([WXPrerenderManager isTaskReady:[self urlOfName:@"missing"]]);
+    XCTAssertFalse([WXPrerenderManager isTaskReady:[self urlOfName:@"missing"]]);
+    [self.manager trimToCount:2 bytes:NSUIntegerMax];
+    
+    NSDictionary *metrics = [WXPrerenderManager metrics];
+    XCTAssertEqual([metrics[@"hits"] unsignedIntegerValue], [before[@"hits"] unsignedIntegerValue] + 1);
+    XCTAssertEqual([metrics[@"misses"] unsignedIntegerValue], [before[@"misses"] unsignedIntegerValue] + 2);
+    XCTAssertEqual([metrics[@"evictions"] unsignedIntegerValue], [before[@"evictions"] unsignedIntegerValue] + 1);
+    XCTAssertEqual([metrics[@"count"] unsignedIntegerValue], 2);
+    XCTAssertEqual([metrics[@"bytes"] unsignedIntegerValue], 500);
+    double lookups = [metrics[@"hits"] doubleValue] + [metrics[@"misses"] doubleValue];
+    XCTAssertEqualWithAccuracy([metrics[@"hitRate"] doubleValue], [metrics[@"hits"] doubleValue] / lookups, 0.0001);
+}
+
+@end
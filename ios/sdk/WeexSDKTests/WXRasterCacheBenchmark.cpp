@@ -0,0 +1,186 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXRasterCache, and benchmarks drawing the borders of a list of cards
+ * with and without it. A software rasterizer of rounded rects stands in for
+ * CoreGraphics. It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -pthread -I../WeexSDK/Sources/Utility WXRasterCacheBenchmark.cpp -o raster_benchmark
+ *   ./raster_benchmark
+ */
+
+#include "WXRasterCache.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static WXRasterKey keyOf(int64_t value)
+{
+    return WXRasterKey().add(value);
+}
+
+static void checkKeys()
+{
+    CHECK(WXRasterKey().add(1.0).bytes() == WXRasterKey().add(1.0).bytes());
+    CHECK(WXRasterKey().add(0.0).bytes() == WXRasterKey().add(-0.0).bytes());
+    CHECK(WXRasterKey().add(1.0).add(2.0).bytes() != WXRasterKey().add(2.0).add(1.0).bytes());
+    CHECK(WXRasterKey().add((int64_t)1).bytes() != WXRasterKey().add(1.0).bytes());
+}
+
+static void checkEviction()
+{
+    WXRasterCache<int> cache(30);
+    int value = 0;
+    cache.put(keyOf(1), 1, 10);
+    cache.put(keyOf(2), 2, 10);
+    cache.put(keyOf(3), 3, 10);
+    CHECK(cache.get(keyOf(1), value) && value == 1);
+    // 2 is the least recently used
+    cache.put(keyOf(4), 4, 10);
+    CHECK(!cache.get(keyOf(2), value));
+    CHECK(cache.get(keyOf(3), value) && value == 3);
+
+    // replacing a value replaces its cost
+    cache.put(keyOf(3), 30, 5);
+    CHECK(cache.get(keyOf(3), value) && value == 30);
+
+    // values costlier than the limit are not kept
+    cache.put(keyOf(5), 5, 31);
+    CHECK(!cache.get(keyOf(5), value));
+
+    WXRasterCacheMetrics metrics = cache.metrics();
+    CHECK(metrics.count == 3 && metrics.totalCost == 25);
+    CHECK(metrics.hits == 3 && metrics.misses == 2 && metrics.evictions == 1);
+
+    cache.setCostLimit(15);
+    metrics = cache.metrics();
+    CHECK(metrics.count == 2 && metrics.totalCost == 15);
+    CHECK(!cache.get(keyOf(1), value));
+
+    cache.clear();
+    metrics = cache.metrics();
+    CHECK(metrics.count == 0 && metrics.totalCost == 0);
+}
+
+struct Border {
+    double width, height, radius, borderWidth;
+    uint32_t color, backgroundColor;
+};
+
+typedef std::shared_ptr<std::vector<uint32_t>> Bitmap;
+
+// fills the background and strokes the border of a rounded rect, pixel by pixel
+static Bitmap rasterize(const Border &border, double scale)
+{
+    int width = (int)(border.width * scale), height = (int)(border.height * scale);
+    double radius = border.radius * scale, borderWidth = border.borderWidth * scale;
+    Bitmap bitmap = std::make_shared<std::vector<uint32_t>>(width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double cx = std::min(std::max(x + 0.5, radius), width - radius);
+            double cy = std::min(std::max(y + 0.5, radius), height - radius);
+            double distance = radius - std::hypot(x + 0.5 - cx, y + 0.5 - cy);
+            double inset = std::min(std::min(x + 0.5, width - x - 0.5), std::min(y + 0.5, height - y - 0.5));
+            if (radius > 0 && (x + 0.5 < radius || x + 0.5 > width - radius) && (y + 0.5 < radius || y + 0.5 > height - radius)) {
+                inset = distance;
+            }
+            uint32_t pixel = 0;
+            if (inset >= 0) {
+                pixel = inset < borderWidth ? border.color : border.backgroundColor;
+            }
+            (*bitmap)[y * width + x] = pixel;
+        }
+    }
+    return bitmap;
+}
+
+static WXRasterKey keyOf(const Border &border, double scale)
+{
+    return WXRasterKey().add(border.width).add(border.height).add(scale).add(border.radius).add(border.borderWidth)
+                        .add((int64_t)border.color).add((int64_t)border.backgroundColor);
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// cells of a list, in a few styles
+static void benchmark(size_t cells, size_t styles)
+{
+    const double scale = 3;
+    std::vector<Border> borders;
+    for (size_t i = 0; i < styles; i++) {
+        borders.push_back(Border{375, 120 + 10.0 * i, 8, 1, 0xffdddddd, 0xffffffff});
+    }
+
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cells; i++) {
+        checksum += rasterize(borders[i % styles], scale)->size();
+    }
+    double drawTime = milliseconds(start);
+
+    WXRasterCache<Bitmap> cache(8 * 1024 * 1024);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cells; i++) {
+        const Border &border = borders[i % styles];
+        WXRasterKey key = keyOf(border, scale);
+        Bitmap bitmap;
+        if (!cache.get(key, bitmap)) {
+            bitmap = rasterize(border, scale);
+            cache.put(key, bitmap, bitmap->size() * sizeof(uint32_t));
+        }
+        checksum -= bitmap->size();
+    }
+    double cacheTime = milliseconds(start);
+    CHECK(checksum == 0);
+
+    WXRasterCacheMetrics metrics = cache.metrics();
+    printf("%4zu cells, %2zu styles: drawn %8.2f ms | cached %8.2f ms, %zu hits %zu misses %zu evictions %zu bytes\n",
+           cells, styles, drawTime, cacheTime, metrics.hits, metrics.misses, metrics.evictions, metrics.totalCost);
+}
+
+int main()
+{
+    checkKeys();
+    checkEviction();
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(200, 1);
+    benchmark(200, 4);
+    // more styles than the cache holds
+    benchmark(200, 40);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import "WXRecycleListPrefetcher.h"
+
+@interface WXRecycleListPrefetcherTests : XCTestCase
+
+@end
+
+@implementation WXRecycleListPrefetcherTests
+
+- (void)testPrefetchAheadOfScrolling
+{
+    WXRecycleListPrefetcher *prefetcher = [WXRecycleListPrefetcher new];
+    NSRange visibleRange = NSMakeRange(10, 5);
+    // the first sample has no velocity
+    XCTAssertEqual([prefetcher indexesToPrefetchWithOffset:1000 time:1 visibleRange:visibleRange itemCount:100 averageItemHeight:100].count, 0);
+    
+    // 400pt/s for 0.5s is 2 cells
+    NSIndexSet *indexes = [prefetcher indexesToPrefetchWithOffset:1040 time:1.1 visibleRange:visibleRange itemCount:100 averageItemHeight:100];
+    XCTAssertEqualObjects(indexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(15, 2)]);
+    
+    // fast scrolling is capped
+    indexes = [prefetcher indexesToPrefetchWithOffset:2040 time:1.2 visibleRange:visibleRange itemCount:100 averageItemHeight:100];
+    XCTAssertEqualObjects(indexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(15, 6)]);
+    
+    // not beyond the last item
+    indexes = [prefetcher indexesToPrefetchWithOffset:3040 time:1.3 visibleRange:NSMakeRange(95, 4) itemCount:100 averageItemHeight:100];
+    XCTAssertEqualObjects(indexes, [NSIndexSet indexSetWithIndex:99]);
+}
+
+- (void)testDirectionChangeCancels
+{
+    WXRecycleListPrefetcher *prefetcher = [WXRecycleListPrefetcher new];
+    NSRange visibleRange = NSMakeRange(3, 5);
+    [prefetcher indexesToPrefetchWithOffset:1000 time:1 visibleRange:visibleRange itemCount:100 averageItemHeight:100];
+    [prefetcher indexesToPrefetchWithOffset:1010 time:1.1 visibleRange:visibleRange itemCount:100 averageItemHeight:100];
+    NSUInteger generation = prefetcher.generation;
+    
+    NSIndexSet *indexes = [prefetcher indexesToPrefetchWithOffset:500 time:1.2 visibleRange:visibleRange itemCount:100 averageItemHeight:100];
+    XCTAssertEqualObjects(indexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 3)]);
+    XCTAssertEqual(prefetcher.generation, generation + 1);
+    
+    [prefetcher cancel];
+    XCTAssertEqual(prefetcher.generation, generation + 2);
+}
+
+@end
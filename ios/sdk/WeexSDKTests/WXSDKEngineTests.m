@@ -24,6 +24,38 @@
 #import "WXHandlerFactory.h"
 #import "WXResourceRequest.h"
 #import "WXResourceRequestHandlerDefaultImpl.h"
+#import "WXBridgeContext.h"
+#import "WXBridgeManager.h"
+#import "WXBridgeProtocol.h"
+#import "WXModuleProtocol.h"
+#import "WXSDKManager.h"
+#import "WXSDKInstance.h"
+
+static NSString *const WXDispatchInstanceId = @"dispatch";
+static const NSUInteger WXDispatchCallCount = 100000;
+
+@interface WXBridgeContext (DispatchTests)
+
+- (id<WXBridgeProtocol>)jsBridge;
+
+@end
+
+@interface WXDispatchTestModule : NSObject <WXModuleProtocol>
+
+@end
+
+@implementation WXDispatchTestModule
+
+@synthesize weexInstance;
+
+WX_EXPORT_METHOD_SYNC(@selector(echo:))
+
+- (id)echo:(id)value
+{
+    return value;
+}
+
+@end
 
 @interface WXSDKEngineTests : XCTestCase
 
@@ -65,6 +97,96 @@
     XCTAssertEqualObjects(NSStringFromSelector(selector), @"fetch:callback:progressCallback:");
 }
 
+- (void)testModuleDispatchIds {
+    
+    [WXSDKEngine registerModule:@"stream" withClass:NSClassFromString(@"WXStreamModule")];
+    
+    NSDictionary *dispatchIds = [WXModuleFactory moduleDispatchIdsWithNames:@[@"stream", @"notExist"]];
+    XCTAssertNil(dispatchIds[@"notExist"]);
+    NSNumber *moduleId = dispatchIds[@"stream"][@"id"];
+    NSNumber *methodId = dispatchIds[@"stream"][@"methods"][@"fetch"];
+    XCTAssertNotNil(moduleId);
+    XCTAssertNotNil(methodId);
+    XCTAssertNotNil(dispatchIds[@"stream"][@"methods"][@"addEventListener"]);
+    
+    WXModuleMethodDescriptor *descriptor = [WXModuleFactory methodDescriptorWithModuleId:[moduleId unsignedIntegerValue] methodId:[methodId unsignedIntegerValue]];
+    XCTAssertEqualObjects(descriptor.moduleName, @"stream");
+    XCTAssertEqualObjects(descriptor.methodName, @"fetch");
+    XCTAssertEqualObjects(NSStringFromClass(descriptor.moduleClass), @"WXStreamModule");
+    XCTAssertEqualObjects(NSStringFromSelector(descriptor.selector), @"fetch:callback:progressCallback:");
+    XCTAssertNotNil(descriptor.signature);
+    XCTAssertFalse(descriptor.isSync);
+    XCTAssertEqual(descriptor, [WXModuleFactory methodDescriptorWithModuleName:@"stream" methodName:@"fetch"]);
+    
+    // re-registering keeps the module id
+    [WXSDKEngine registerModule:@"stream" withClass:NSClassFromString(@"WXStreamModule")];
+    XCTAssertEqualObjects([WXModuleFactory moduleDispatchIdsWithNames:@[@"stream"]][@"stream"][@"id"], moduleId);
+    
+    XCTAssertNil([WXModuleFactory methodDescriptorWithModuleId:NSUIntegerMax methodId:0]);
+    XCTAssertNil([WXModuleFactory methodDescriptorWithModuleId:[moduleId unsignedIntegerValue] methodId:NSUIntegerMax]);
+}
+
+// calls the module method from js the way the runtime does, by names or by the published ids
+- (JSValue *)callModuleMethod:(NSUInteger)count module:(id)module method:(id)method
+{
+    static WXBridgeContext *bridgeContext;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        [WXSDKEngine registerModule:@"dispatchTest" withClass:[WXDispatchTestModule class]];
+        [WXSDKManager storeInstance:[WXSDKInstance new] forID:WXDispatchInstanceId];
+        bridgeContext = [WXBridgeContext new];
+    });
+    
+    __block JSValue *result = nil;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    WXPerformBlockOnBridgeThread(^{
+        id<WXBridgeProtocol> bridge = [bridgeContext jsBridge];
+        [bridge executeJavascript:@"function callModuleMethod(count, module, method) {"
+                                   "  var result;"
+                                   "  for (var i = 0; i < count; i++) {"
+                                   "    result = callNativeModule('dispatch', module, method, [i], {});"
+                                   "  }"
+                                   "  return result;"
+                                   "}"];
+        result = [bridge callJSMethod:@"callModuleMethod" args:@[@(count), module, method]];
+        dispatch_semaphore_signal(semaphore);
+    });
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    return result;
+}
+
+- (NSArray<NSNumber *> *)dispatchTestIds
+{
+    [WXSDKEngine registerModule:@"dispatchTest" withClass:[WXDispatchTestModule class]];
+    NSDictionary *dispatchIds = [WXModuleFactory moduleDispatchIdsWithNames:@[@"dispatchTest"]][@"dispatchTest"];
+    return @[dispatchIds[@"id"], dispatchIds[@"methods"][@"echo"]];
+}
+
+- (void)testModuleDispatchThroughBridge {
+    
+    NSArray<NSNumber *> *ids = [self dispatchTestIds];
+    XCTAssertEqual([[self callModuleMethod:10 module:@"dispatchTest" method:@"echo"] toInt32], 9);
+    XCTAssertEqual([[self callModuleMethod:10 module:ids[0] method:ids[1]] toInt32], 9);
+    XCTAssertTrue([[self callModuleMethod:1 module:@(NSUIntegerMax) method:ids[1]] isUndefined]);
+}
+
+- (void)testModuleDispatchByNamePerformance {
+    
+    [self callModuleMethod:1 module:@"dispatchTest" method:@"echo"];
+    [self measureBlock:^{
+        [self callModuleMethod:WXDispatchCallCount module:@"dispatchTest" method:@"echo"];
+    }];
+}
+
+- (void)testModuleDispatchByIdPerformance {
+    
+    NSArray<NSNumber *> *ids = [self dispatchTestIds];
+    [self callModuleMethod:1 module:ids[0] method:ids[1]];
+    [self measureBlock:^{
+        [self callModuleMethod:WXDispatchCallCount module:ids[0] method:ids[1]];
+    }];
+}
+
 - (void)testRegisterComponent {
     
     [WXSDKEngine registerComponent:@"embed" withClass:NSClassFromString(@"WXEmbedComponent")];
@@ -0,0 +1,297 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Checks WXStorageEngine, and benchmarks it against rewriting the whole
+ * store on every mutation, which is what the plist based storage did.
+ * It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Utility WXStorageEngineBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXStorageEngine.cpp -o storage_benchmark
+ *   ./storage_benchmark [directory]
+ */
+
+#include "WXStorageEngine.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static std::string valueOf(WXStorageEngine &engine, const std::string &key)
+{
+    std::string value;
+    return engine.get(key, value) ? value : "<none>";
+}
+
+static void checkReadWrite(const std::string &path)
+{
+    ::unlink(path.c_str());
+    {
+        WXStorageEngine engine(path, 0, 8);
+        CHECK(engine.open());
+        CHECK(engine.put("a", "1", false, 1));
+        CHECK(engine.put("b", "a long value, not kept in memory", true, 2));
+        CHECK(engine.put("a", "2", false, 3));
+        CHECK(engine.put("c", "3", false, 4));
+        CHECK(engine.remove("c"));
+        CHECK(!engine.remove("c"));
+        CHECK(engine.touch("b", 5));
+        CHECK(valueOf(engine, "a") == "2");
+        CHECK(valueOf(engine, "b") == "a long value, not kept in memory");
+        CHECK(valueOf(engine, "c") == "<none>");
+        CHECK(engine.sync());
+    }
+
+    WXStorageEngine engine(path, 0, 8);
+    CHECK(engine.open());
+    CHECK(engine.count() == 2);
+    CHECK(valueOf(engine, "a") == "2");
+    CHECK(valueOf(engine, "b") == "a long value, not kept in memory");
+    std::vector<std::string> keys = engine.keys();
+    CHECK(keys.size() == 2 && keys[0] == "a" && keys[1] == "b");
+    WXStorageItemInfo info;
+    CHECK(engine.info("b", info) && info.persistent && info.timestamp == 5 && info.size == 32);
+}
+
+static void checkBrokenTail(const std::string &path)
+{
+    ::unlink(path.c_str());
+    size_t size;
+    {
+        WXStorageEngine engine(path, 0);
+        CHECK(engine.open());
+        CHECK(engine.put("a", "1", false, 1));
+        size = engine.fileSize();
+        CHECK(engine.put("b", "2", false, 2));
+    }
+    // the app was killed while writing "b"
+    CHECK(truncate(path.c_str(), size + 10) == 0);
+
+    WXStorageEngine engine(path, 0);
+    CHECK(engine.open());
+    CHECK(engine.count() == 1);
+    CHECK(valueOf(engine, "a") == "1");
+    CHECK(engine.fileSize() == size);
+    CHECK(engine.put("c", "3", false, 3));
+    engine.close();
+    CHECK(engine.open());
+    CHECK(valueOf(engine, "c") == "3");
+}
+
+static void checkEviction(const std::string &path)
+{
+    ::unlink(path.c_str());
+    WXStorageEngine engine(path, 12);
+    CHECK(engine.open());
+    CHECK(engine.put("a", "1234", false, 1));
+    CHECK(engine.put("b", "1234", true, 2));
+    CHECK(engine.put("c", "1234", false, 3));
+    CHECK(engine.touch("a", 4));
+    // "c" is the least recently used non-persistent item
+    CHECK(engine.put("d", "1234", false, 5));
+    CHECK(engine.totalSize() == 12);
+    CHECK(engine.contains("a") && engine.contains("b") && !engine.contains("c") && engine.contains("d"));
+    // a value above the limit is rejected without evicting anything
+    CHECK(!engine.put("e", "1234567890123", false, 6));
+    CHECK(!engine.contains("e") && engine.count() == 3 && engine.totalSize() == 12);
+    // the persistent items leave no room for a new value
+    CHECK(engine.put("f", "12345678", true, 7));
+    CHECK(!engine.put("g", "12345", false, 8));
+    CHECK(engine.contains("b") && engine.contains("f") && !engine.contains("g"));
+    CHECK(engine.totalSize() == 12);
+}
+
+static void checkCompaction(const std::string &path)
+{
+    ::unlink(path.c_str());
+    WXStorageEngine engine(path, 0);
+    CHECK(engine.open());
+    std::string value(1000, 'x');
+    for (int i = 0; i < 1000; i++) {
+        CHECK(engine.put("key" + std::to_string(i % 10), value + std::to_string(i), false, i));
+    }
+    CHECK(engine.fileSize() < 200 * 1024);
+    CHECK(engine.count() == 10);
+    CHECK(valueOf(engine, "key9") == value + "999");
+    engine.close();
+    CHECK(engine.open());
+    CHECK(valueOf(engine, "key0") == value + "990");
+    CHECK(engine.keys().front() == "key0" && engine.keys().back() == "key9");
+}
+
+static void checkGroupCommit(const std::string &path)
+{
+    ::unlink(path.c_str());
+    std::string large(100, 'x');
+    {
+        WXStorageEngine engine(path, 0, 8, 1024);
+        CHECK(engine.open());
+        size_t size = engine.fileSize();
+        CHECK(engine.put("a", "1", false, 1));
+        CHECK(engine.put("b", large, true, 2));
+        CHECK(engine.remove("a"));
+        // read your writes from the pending records
+        CHECK(valueOf(engine, "a") == "<none>");
+        CHECK(valueOf(engine, "b") == large);
+        CHECK(engine.pendingSize() == engine.fileSize() - size);
+
+        // nothing is written before sync
+        WXStorageEngine reader(path, 0);
+        CHECK(reader.open());
+        CHECK(reader.count() == 0);
+        reader.close();
+
+        CHECK(engine.sync());
+        CHECK(engine.pendingSize() == 0);
+        CHECK(valueOf(engine, "b") == large);
+        CHECK(reader.open());
+        CHECK(reader.count() == 1 && valueOf(reader, "b") == large);
+        reader.close();
+
+        // the buffer is written when it outgrows the limit
+        for (int i = 0; i < 20; i++) {
+            CHECK(engine.put("c", large + std::to_string(i), false, 3));
+        }
+        CHECK(engine.pendingSize() < 1024);
+        CHECK(valueOf(engine, "c") == large + "19");
+    }
+
+    // close writes the pending records
+    WXStorageEngine engine(path, 0);
+    CHECK(engine.open());
+    CHECK(engine.count() == 2 && valueOf(engine, "c") == large + "19");
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// serialize the whole store to a temporary file, and rename it
+static size_t rewriteStore(const std::string &path, const std::map<std::string, std::string> &store)
+{
+    std::string contents;
+    for (const auto &entry : store) {
+        contents += "<key>" + entry.first + "</key><string>" + entry.second + "</string>\n";
+    }
+    std::string temporary = path + ".tmp";
+    FILE *file = fopen(temporary.c_str(), "wb");
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+    rename(temporary.c_str(), path.c_str());
+    return contents.size();
+}
+
+static void benchmark(const std::string &directory, size_t existing, size_t writes)
+{
+    std::string value(200, 'v');
+    std::map<std::string, std::string> store;
+    for (size_t i = 0; i < existing; i++) {
+        store["key" + std::to_string(i)] = value;
+    }
+
+    std::string legacyPath = directory + "/legacy.plist";
+    size_t legacyBytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < writes; i++) {
+        store["new" + std::to_string(i)] = value;
+        legacyBytes += rewriteStore(legacyPath, store);
+    }
+    double legacyTime = milliseconds(start);
+    ::unlink(legacyPath.c_str());
+
+    std::string path = directory + "/engine.log";
+    ::unlink(path.c_str());
+    WXStorageEngine engine(path, 5 * 1024 * 1024);
+    engine.open();
+    for (size_t i = 0; i < existing; i++) {
+        engine.put("key" + std::to_string(i), value, false, 0);
+    }
+    size_t fileSize = engine.fileSize();
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < writes; i++) {
+        engine.put("new" + std::to_string(i), value, false, 0);
+    }
+    engine.sync();
+    double engineTime = milliseconds(start);
+    size_t engineBytes = engine.fileSize() - fileSize;
+    engine.close();
+    ::unlink(path.c_str());
+
+    printf("%5zu items, %4zu writes: rewrite %8.2f ms %10zu bytes | log %7.2f ms %8zu bytes\n",
+           existing, writes, legacyTime, legacyBytes, engineTime, engineBytes);
+}
+
+// a burst of writes, committed one by one or in one group
+static void benchmarkBurst(const std::string &directory, size_t writes)
+{
+    std::string value(200, 'v');
+    std::string path = directory + "/engine.log";
+    double times[2];
+    for (int grouped = 0; grouped < 2; grouped++) {
+        ::unlink(path.c_str());
+        WXStorageEngine engine(path, 5 * 1024 * 1024, 1024, grouped ? 256 * 1024 : 0);
+        engine.open();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < writes; i++) {
+            engine.put("key" + std::to_string(i), value, false, 0);
+            if (!grouped) {
+                engine.sync();
+            }
+        }
+        engine.sync();
+        times[grouped] = milliseconds(start);
+    }
+    ::unlink(path.c_str());
+
+    printf("burst of %4zu writes: %zu commits %8.2f ms | 1 commit %7.2f ms\n", writes, writes, times[0], times[1]);
+}
+
+int main(int argc, const char *argv[])
+{
+    std::string directory = argc > 1 ? argv[1] : "/tmp";
+    std::string path = directory + "/wxstorage_check.log";
+
+    checkReadWrite(path);
+    checkBrokenTail(path);
+    checkEviction(path);
+    checkCompaction(path);
+    checkGroupCommit(path);
+    ::unlink(path.c_str());
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(directory, 100, 100);
+    benchmark(directory, 1000, 100);
+    benchmark(directory, 5000, 100);
+    benchmarkBurst(directory, 50);
+    benchmarkBurst(directory, 500);
+
+    return failures ? 1 : 0;
+}
@@ -21,14 +21,19 @@
 #import "WeexSDK.h"
 #import "WXStorageModule.h"
 
+@interface WXStorageModule (Testing)
+
+- (NSString *)storedValueForKey:(NSString *)key;
+- (NSDictionary *)getInfoForKey:(NSString *)key;
+- (NSArray<NSString *> *)indexs;
+
+@end
+
 @interface WXStorageTests : XCTestCase
 
 @property (nonatomic, strong) WXStorageModule *storage;
 @property (nonatomic, strong) dispatch_queue_t storageQueue;
 @property (nonatomic, copy) NSString *directory;
-@property (nonatomic, copy) NSString *filePath;
-@property (nonatomic, copy) NSString *indexPath;
-@property (nonatomic, copy) NSString *infoPath;
 @property (nonatomic, copy) NSString *longValue;
 
 @end
@@ -41,17 +46,16 @@
     self.directory = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES).firstObject;
     self.directory = [self.directory stringByAppendingPathComponent:@"wxstorage"];
     NSLog(@"---storage directory: %@",self.directory);
-    self.filePath = [self.directory stringByAppendingPathComponent:@"wxstorage.plist"];
-    self.infoPath = [self.directory stringByAppendingPathComponent:@"wxstorage.info.plist"];
-    self.indexPath = [self.directory stringByAppendingPathComponent:@"wxstorage.index.plist"];
-    
-    // clear storage
-    [[NSFileManager defaultManager] removeItemAtPath:self.filePath error:nil];
-    [[NSFileManager defaultManager] removeItemAtPath:self.infoPath error:nil];
-    [[NSFileManager defaultManager] removeItemAtPath:self.indexPath error:nil];
     
     self.storage = [WXStorageModule new];
     
+    // clear storage
+    [self.storage getAllKeys:^(id result) {
+        for (NSString *key in result[@"data"]) {
+            [self.storage removeItem:key callback:nil];
+        }
+    }];
+    
     self.longValue = @"longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4longValue4";
     
     [self.storage setItem:@"initKey1" value:@"initValue1" callback:^(id result) {}];
@@ -62,6 +66,22 @@
     self.storageQueue = [self.storage targetExecuteQueue];
 }
 
+- (NSDictionary *)valueDictionary {
+    NSMutableDictionary *values = [NSMutableDictionary dictionary];
+    for (NSString *key in [self.storage indexs]) {
+        values[key] = [self.storage storedValueForKey:key];
+    }
+    return values;
+}
+
+- (NSDictionary *)infoDictionary {
+    NSMutableDictionary *info = [NSMutableDictionary dictionary];
+    for (NSString *key in [self.storage indexs]) {
+        info[key] = [self.storage getInfoForKey:key];
+    }
+    return info;
+}
+
 - (void)tearDown {
     // Put teardown code here. This method is called after the invocation of each test method in the class.
     [super tearDown];
@@ -70,9 +90,9 @@
 - (void)testGetLength {
     XCTestExpectation *expectation = [self expectationWithDescription:@"storage"];
 
-    NSDictionary *dic = [NSDictionary dictionaryWithContentsOfFile:self.filePath];
-    NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:self.infoPath];
-    NSArray *indexArray = [NSArray arrayWithContentsOfFile:self.indexPath];
+    NSDictionary *dic = [self valueDictionary];
+    NSDictionary *infoDic = [self infoDictionary];
+    NSArray *indexArray = [self.storage indexs];
     
     __weak typeof(self) weakSelf = self;
     dispatch_async(self.storageQueue, ^{
@@ -92,9 +112,9 @@
 - (void)testGetAllKeys {
     XCTestExpectation *expectation = [self expectationWithDescription:@"storage"];
 
-    NSDictionary *dic = [NSDictionary dictionaryWithContentsOfFile:self.filePath];
-    NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:self.infoPath];
-    NSArray *indexArray = [NSArray arrayWithContentsOfFile:self.indexPath];
+    NSDictionary *dic = [self valueDictionary];
+    NSDictionary *infoDic = [self infoDictionary];
+    NSArray *indexArray = [self.storage indexs];
     
     __weak typeof(self) weakSelf = self;
     dispatch_async(self.storageQueue, ^{
@@ -127,9 +147,9 @@
             [weakSelf.storage setItem:@"key1" value:@"shortValue12" callback:^(id result) {
                 [expectation fulfill];
 
-                NSDictionary *dic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.filePath];
-                NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
-                NSArray *indexArray = [NSArray arrayWithContentsOfFile:weakSelf.indexPath];
+                NSDictionary *dic = [weakSelf valueDictionary];
+                NSDictionary *infoDic = [weakSelf infoDictionary];
+                NSArray *indexArray = [weakSelf.storage indexs];
                 
                 XCTAssert([@"success" isEqualToString:result[@"result"]]);
                 XCTAssert([@"shortValue12" isEqualToString:dic[@"key1"]]);
@@ -149,14 +169,14 @@
     __weak typeof(self) weakSelf = self;
     dispatch_async(self.storageQueue, ^{
         [self.storage setItem:@"key2" value:@"shortValue2" callback:^(id result) {
-            NSDictionary *infoDic1 = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
+            NSDictionary *infoDic1 = [weakSelf infoDictionary];
             __strong typeof(weakSelf) self = weakSelf;
             XCTAssertEqual(result[@"result"], @"success");
             XCTAssertEqual(infoDic1[@"key2"][@"persistent"], @(NO));
             
             [self.storage setItemPersistent:@"key2" value:@"shortValue22" callback:^(id result) {
                 __strong typeof(weakSelf) self = weakSelf;
-                NSDictionary *infoDic2 = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
+                NSDictionary *infoDic2 = [weakSelf infoDictionary];
 
                 XCTAssertEqual(result[@"result"], @"success");
                 XCTAssertEqual(infoDic2[@"key2"][@"persistent"], @(YES));
@@ -165,7 +185,7 @@
                     __strong typeof(weakSelf) self = weakSelf;
                     [expectation fulfill];
 
-                    NSDictionary *infoDic3 = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
+                    NSDictionary *infoDic3 = [weakSelf infoDictionary];
                     
                     XCTAssertEqual(result[@"result"], @"success");
                     XCTAssertEqual(infoDic3[@"key2"][@"persistent"], @(NO));
@@ -184,7 +204,7 @@
     dispatch_async(self.storageQueue, ^{
         [self.storage setItem:@"key3" value:@"shortValue3" callback:^(id result) {
             __strong typeof(weakSelf) self = weakSelf;
-            NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
+            NSDictionary *infoDic = [weakSelf infoDictionary];
             NSTimeInterval tsNow = [[NSDate date] timeIntervalSince1970];
             NSTimeInterval ts = [infoDic[@"key3"][@"ts"] doubleValue];
             XCTAssertTrue(ABS(tsNow - ts) <= 1);
@@ -193,7 +213,7 @@
             
             [self.storage setItem:@"key3" value:@"shortValue32" callback:^(id result) {
                 __strong typeof(weakSelf) self = weakSelf;
-                NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
+                NSDictionary *infoDic = [weakSelf infoDictionary];
                 NSTimeInterval tsNow = [[NSDate date] timeIntervalSince1970];
                 NSTimeInterval ts = [infoDic[@"key3"][@"ts"] doubleValue];
                 XCTAssertTrue(ABS(tsNow - ts) <= 1);
@@ -203,7 +223,7 @@
                 [self.storage getItem:@"key3" callback:^(id result) {
                     [expectation fulfill];
 
-                    NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
+                    NSDictionary *infoDic = [weakSelf infoDictionary];
                     NSTimeInterval tsNow = [[NSDate date] timeIntervalSince1970];
                     NSTimeInterval ts = [infoDic[@"key3"][@"ts"] doubleValue];
                     XCTAssertTrue(ABS(tsNow - ts) <= 1);
@@ -227,13 +247,12 @@
     dispatch_async(self.storageQueue, ^{
         [self.storage setItem:@"key4" value:longValue callback:^(id result) {
             __strong typeof(weakSelf) self = weakSelf;
-            NSDictionary *dic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.filePath];
-            NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
-            NSArray *indexArray = [NSArray arrayWithContentsOfFile:weakSelf.indexPath];
+            NSDictionary *dic = [weakSelf valueDictionary];
+            NSDictionary *infoDic = [weakSelf infoDictionary];
+            NSArray *indexArray = [weakSelf.storage indexs];
             
             XCTAssertEqual(result[@"result"], @"success");
-            XCTAssertNotEqual(dic[@"key4"], longValue);
-            XCTAssertTrue([dic[@"key4"] isEqualToString:@"#{eulaVlluNegarotSXW}"]);
+            XCTAssertEqualObjects(dic[@"key4"], longValue);
             XCTAssertFalse([infoDic[@"key4"][@"persistent"] boolValue]);
             XCTAssertTrue([infoDic[@"key4"][@"size"] integerValue] == [longValue length]);
             XCTAssertTrue([indexArray containsObject:@"key4"]);
@@ -242,7 +261,7 @@
                 [expectation fulfill];
 
                 NSString *value = result[@"data"];
-                XCTAssertEqual(value, longValue);
+                XCTAssertEqualObjects(value, longValue);
             }];
         }];
     });
@@ -261,7 +280,7 @@
                 NSString *data = result[@"data"];
                 
                 XCTAssertEqual(result[@"result"], @"success");
-                XCTAssertEqual(data, @"shortValue5");
+                XCTAssertEqualObjects(data, @"shortValue5");
                 
                 [weakSelf.storage setItem:@"key5" value:@"shortValue52" callback:^(id result) {
                     [weakSelf.storage getItem:@"key5" callback:^(id result) {
@@ -270,7 +289,7 @@
                         NSString *data = result[@"data"];
                         
                         XCTAssertEqual(result[@"result"], @"success");
-                        XCTAssertEqual(data, @"shortValue52");
+                        XCTAssertEqualObjects(data, @"shortValue52");
                     }];
                 }];
             }];
@@ -280,6 +299,30 @@
     [self waitForExpectationsWithTimeout:5 handler:nil];
 }
 
+- (void)testSetItemBurst {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"storage"];
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(self.storageQueue, ^{
+        for (int i = 0; i < 50; i++) {
+            [weakSelf.storage setItem:[NSString stringWithFormat:@"burst%d", i] value:[NSString stringWithFormat:@"%d", i] callback:nil];
+        }
+        [weakSelf.storage removeItem:@"burst0" callback:nil];
+        
+        // the pending mutations are visible before they are committed
+        for (int i = 1; i < 50; i++) {
+            XCTAssertEqualObjects([weakSelf.storage storedValueForKey:[NSString stringWithFormat:@"burst%d", i]], ([NSString stringWithFormat:@"%d", i]));
+        }
+        XCTAssertNil([weakSelf.storage storedValueForKey:@"burst0"]);
+        [weakSelf.storage length:^(id result) {
+            [expectation fulfill];
+            XCTAssertEqual([result[@"data"] integerValue], 49);
+        }];
+    });
+    
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
 - (void)testRemoveItem {
     XCTestExpectation *expectation = [self expectationWithDescription:@"storage"];
 
@@ -290,12 +333,12 @@
             [weakSelf.storage getItem:@"key6" callback:^(id result) {
                 __strong typeof(weakSelf) self = weakSelf;
                 NSString *value = result[@"data"];
-                XCTAssertEqual(value, @"shortValue6");
+                XCTAssertEqualObjects(value, @"shortValue6");
                 
                 [weakSelf.storage removeItem:@"key6" callback:^(id result) {
-                    NSDictionary *dic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.filePath];
-                    NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
-                    NSArray *indexArray = [NSArray arrayWithContentsOfFile:weakSelf.indexPath];
+                    NSDictionary *dic = [weakSelf valueDictionary];
+                    NSDictionary *infoDic = [weakSelf infoDictionary];
+                    NSArray *indexArray = [weakSelf.storage indexs];
                     
                     XCTAssertEqual(result[@"result"], @"success");
                     XCTAssertNil(dic[@"key6"]);
@@ -305,14 +348,14 @@
                     [weakSelf.storage setItem:@"key6" value:longValue callback:^(id result) {
                         [weakSelf.storage getItem:@"key6" callback:^(id result) {
                             NSString *value = result[@"data"];
-                            XCTAssertEqual(value, longValue);
+                            XCTAssertEqualObjects(value, longValue);
                             
                             [weakSelf.storage removeItem:@"key6" callback:^(id result) {
                                 [expectation fulfill];
 
-                                NSDictionary *dic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.filePath];
-                                NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:weakSelf.infoPath];
-                                NSArray *indexArray = [NSArray arrayWithContentsOfFile:weakSelf.indexPath];
+                                NSDictionary *dic = [weakSelf valueDictionary];
+                                NSDictionary *infoDic = [weakSelf infoDictionary];
+                                NSArray *indexArray = [weakSelf.storage indexs];
                                 
                                 XCTAssertEqual(result[@"result"], @"success");
                                 XCTAssertNil(dic[@"key6"]);
@@ -356,9 +399,9 @@
     dispatch_group_notify(storageGroup, dispatch_get_main_queue(), ^{
         [expectation fulfill];
         
-        NSDictionary *dic = [NSDictionary dictionaryWithContentsOfFile:welf.filePath];
-        NSDictionary *infoDic = [NSDictionary dictionaryWithContentsOfFile:welf.infoPath];
-        NSArray *indexArray = [NSArray arrayWithContentsOfFile:welf.indexPath];
+        NSDictionary *dic = [welf valueDictionary];
+        NSDictionary *infoDic = [welf infoDictionary];
+        NSArray *indexArray = [welf.storage indexs];
         
         NSLog(@"---indexArray: %@", indexArray);
         
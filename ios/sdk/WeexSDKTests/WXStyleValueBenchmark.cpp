@@ -0,0 +1,241 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXStyleValue, and benchmarks the interned lookups against parsing
+ * the strings on every style update. It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Utility WXStyleValueBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXStyleValue.cpp -o style_value_benchmark
+ *   ./style_value_benchmark
+ */
+
+#include "WXStyleValue.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static WXStyleValue parse(const std::string &string)
+{
+    return WXStyleValueParse(string.data(), string.size());
+}
+
+static bool near(double a, double b)
+{
+    return std::fabs(a - b) < 1e-9;
+}
+
+static bool colorIs(const std::string &string, double red, double green, double blue, double alpha)
+{
+    WXStyleValue value = parse(string);
+    return value.hasColor && near(value.color.red, red) && near(value.color.green, green)
+        && near(value.color.blue, blue) && near(value.color.alpha, alpha);
+}
+
+static void checkKeywords()
+{
+    CHECK(parse("row").keyword == WXStyleKeyword::Row);
+    CHECK(parse("row-reverse").keyword == WXStyleKeyword::RowReverse);
+    CHECK(parse("column-reverse").keyword == WXStyleKeyword::ColumnReverse);
+    CHECK(parse("space-between").keyword == WXStyleKeyword::SpaceBetween);
+    CHECK(parse("sticky").keyword == WXStyleKeyword::Sticky);
+    CHECK(parse("rows").keyword == WXStyleKeyword::None);
+    CHECK(parse("Row").keyword == WXStyleKeyword::None);
+    CHECK(parse("").keyword == WXStyleKeyword::None);
+    CHECK(!parse("row").hasColor);
+}
+
+static void checkColors()
+{
+    CHECK(colorIs("#ff0000", 1, 0, 0, 1));
+    CHECK(colorIs("#0f0", 0, 1, 0, 1));
+    CHECK(colorIs("#FFFFFF", 1, 1, 1, 1));
+    CHECK(colorIs("#", 0, 0, 0, 1));
+    CHECK(colorIs("rgb(255,0,51)", 1, 0, 0.2, 1));
+    CHECK(colorIs("rgb(255, 0, 51)", 1, 0, 0.2, 1));
+    CHECK(colorIs("rgba(0,0,255,0.5)", 0, 0, 1, 0.5));
+    CHECK(colorIs("rgba(0,0,255)", 0, 0, 1, 1));
+    CHECK(colorIs("rgb(255 ,0,0)", 1, 0, 0, 1));
+    CHECK(colorIs("red", 1, 0, 0, 1));
+    CHECK(colorIs("white", 1, 1, 1, 1));
+    CHECK(colorIs("rebeccapurple", 0x66 / 255.0, 0x33 / 255.0, 0x99 / 255.0, 1));
+    CHECK(colorIs("transparent", 0, 0, 0, 0));
+    CHECK(!parse("reds").hasColor);
+    CHECK(!parse("750px").hasColor);
+
+    WXStyleColor color;
+    CHECK(WXStyleNamedColorLookup("yellowgreen", 11, color) && near(color.red, 0x9a / 255.0));
+    CHECK(!WXStyleNamedColorLookup("center", 6, color));
+}
+
+static void checkNumbers()
+{
+    WXStyleValue value = parse("750px");
+    CHECK(value.unit == WXStyleUnit::Px && value.number == 750);
+    value = parse("10wx");
+    CHECK(value.unit == WXStyleUnit::Wx && value.number == 10);
+    value = parse(" -1.5e2");
+    CHECK(value.unit == WXStyleUnit::None && value.number == -150);
+    value = parse(".5px");
+    CHECK(value.number == 0.5);
+    value = parse("12abc");
+    CHECK(value.unit == WXStyleUnit::None && value.number == 12);
+    value = parse("auto");
+    CHECK(value.keyword == WXStyleKeyword::Auto && value.number == 0);
+    value = parse("px");
+    CHECK(value.unit == WXStyleUnit::Px && value.number == 0);
+    value = parse("env(safe-area-inset-bottom)");
+    CHECK(value.unit == WXStyleUnit::SafeAreaInsetBottom && value.number == 0);
+    value = parse("env(safe-area-inset-middle)");
+    CHECK(value.unit == WXStyleUnit::None && value.number == 0);
+}
+
+static void checkTable()
+{
+    WXStyleValueTable table(3);
+    uint32_t row = table.intern("row", 3);
+    CHECK(row == 1);
+    CHECK(table.intern("#fff", 4) == 2);
+    CHECK(table.intern("row", 3) == row);
+    CHECK(table.value(row).keyword == WXStyleKeyword::Row);
+
+    uint32_t identifier;
+    WXStyleValue value = table.lookup("750px", 5, &identifier);
+    CHECK(identifier == 3 && value.number == 750);
+    // full, parsed without interning
+    value = table.lookup("10px", 4, &identifier);
+    CHECK(identifier == 0 && value.number == 10);
+    CHECK(table.count() == 3);
+    CHECK(table.value(0).keyword == WXStyleKeyword::None && table.value(0).number == 0);
+
+    // interned from several threads, every string gets one ID
+    WXStyleValueTable shared;
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> identifiers[4];
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&shared, &identifiers, t]() {
+            for (int i = 0; i < 1000; i++) {
+                std::string string = std::to_string(i) + "px";
+                identifiers[t].push_back(shared.intern(string.data(), string.size()));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    CHECK(shared.count() == 1000);
+    for (int t = 1; t < 4; t++) {
+        CHECK(identifiers[t] == identifiers[0]);
+    }
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// the keyword and the named color lookups of WXConvert, one comparison after another
+static int legacyKeyword(const std::string &string)
+{
+    static const char *keywords[] = {
+        "column", "column-reverse", "row", "row-reverse", "stretch", "flex-start", "flex-end", "center",
+        "auto", "nowrap", "wrap", "space-between", "space-around", "absolute", "relative", "fixed", "sticky",
+    };
+    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++) {
+        if (string == keywords[i]) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static void benchmark(size_t updates)
+{
+    // the values of a typical list cell
+    std::vector<std::string> strings = {
+        "row", "center", "space-between", "750px", "88px", "24px", "#ffffff", "#333333",
+        "rgba(0,0,0,0.5)", "relative", "flex-start", "1", "32px", "#f5f5f5", "transparent", "wrap",
+    };
+
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates; i++) {
+        for (const auto &string : strings) {
+            sum += legacyKeyword(string);
+            WXStyleValue value = parse(string);
+            sum += value.number + value.color.alpha;
+        }
+    }
+    double parseTime = milliseconds(start);
+
+    WXStyleValueTable table;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates; i++) {
+        for (const auto &string : strings) {
+            WXStyleValue value = table.lookup(string.data(), string.size());
+            sum += (int)value.keyword + value.number + value.color.alpha;
+        }
+    }
+    double tableTime = milliseconds(start);
+
+    std::vector<uint32_t> identifiers;
+    for (const auto &string : strings) {
+        identifiers.push_back(table.intern(string.data(), string.size()));
+    }
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates; i++) {
+        for (uint32_t identifier : identifiers) {
+            WXStyleValue value = table.value(identifier);
+            sum += (int)value.keyword + value.number + value.color.alpha;
+        }
+    }
+    double identifierTime = milliseconds(start);
+
+    printf("%7zu updates of %zu values: parse %8.2f ms | by string %8.2f ms | by ID %7.2f ms (%g)\n",
+           updates, strings.size(), parseTime, tableTime, identifierTime, sum > 0 ? 1.0 : 0.0);
+}
+
+int main()
+{
+    checkKeywords();
+    checkColors();
+    checkNumbers();
+    checkTable();
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(10000);
+    benchmark(100000);
+
+    return failures ? 1 : 0;
+}
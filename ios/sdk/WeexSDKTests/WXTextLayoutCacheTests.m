@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import "WXTextLayoutCache.h"
+
+@interface WXTextLayoutCacheTests : XCTestCase
+
+@end
+
+@implementation WXTextLayoutCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+    [WXTextLayoutCache removeAllLayouts];
+}
+
+- (WXTextLayout *)layoutForKey:(NSString *)key bounds:(CGRect)bounds built:(NSUInteger *)built
+{
+    return [WXTextLayoutCache layoutForKey:key bounds:bounds building:^WXTextLayout *{
+        (*built)++;
+        return [[WXTextLayout alloc] initWithFrame:NULL size:CGSizeMake(bounds.size.width, 20)];
+    }];
+}
+
+- (void)testSharedLayouts
+{
+    NSUInteger built = 0;
+    CGRect bounds = CGRectMake(0, 0, 100, 0);
+    WXTextLayout *layout = [self layoutForKey:@"14 ¥99" bounds:bounds built:&built];
+    XCTAssertEqual([self layoutForKey:@"14 ¥99" bounds:bounds built:&built], layout);
+    XCTAssertEqual(built, 1);
+    
+    // other texts, or the same text in other bounds
+    [self layoutForKey:@"14 ¥98" bounds:bounds built:&built];
+    [self layoutForKey:@"14 ¥99" bounds:CGRectMake(0, 0, 50, 0) built:&built];
+    XCTAssertEqual(built, 3);
+    
+    NSDictionary *metrics = [WXTextLayoutCache metrics];
+    XCTAssertEqualObjects(metrics[@"hits"], @1);
+    XCTAssertEqualObjects(metrics[@"count"], @3);
+}
+
+- (void)testNilLayoutIsNotCached
+{
+    __block NSUInteger built = 0;
+    for (int i = 0; i < 2; i++) {
+        [WXTextLayoutCache layoutForKey:@"text" bounds:CGRectZero building:^WXTextLayout *{
+            built++;
+            return nil;
+        }];
+    }
+    XCTAssertEqual(built, 2);
+}
+
+@end
@@ -0,0 +1,69 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import "WXThreadSafeMutableDictionary.h"
+
+@interface WXThreadSafeMutableDictionaryTests : XCTestCase
+
+@end
+
+@implementation WXThreadSafeMutableDictionaryTests
+
+- (void)testDictionary
+{
+    WXThreadSafeMutableDictionary *dictionary = [WXThreadSafeMutableDictionary new];
+    NSMutableString *key = [NSMutableString stringWithString:@"a"];
+    dictionary[key] = @1;
+    [key appendString:@"b"];
+    dictionary[@"b"] = @2;
+    XCTAssertEqualObjects(dictionary[@"a"], @1);
+    XCTAssertNil(dictionary[@"ab"]);
+    XCTAssertEqual(dictionary.count, 2);
+    XCTAssertEqualObjects([dictionary copy], (@{@"a": @1, @"b": @2}));
+    XCTAssertEqualObjects([NSSet setWithArray:dictionary.allKeys], ([NSSet setWithObjects:@"a", @"b", nil]));
+    
+    dictionary[@"a"] = nil;
+    XCTAssertEqual(dictionary.count, 1);
+    [dictionary removeAllObjects];
+    XCTAssertEqual(dictionary.count, 0);
+}
+
+- (void)testConcurrentAccess
+{
+    WXThreadSafeMutableDictionary *dictionary = [WXThreadSafeMutableDictionary new];
+    for (int i = 0; i < 100; i++) {
+        dictionary[@(i)] = [NSString stringWithFormat:@"%d", i];
+    }
+    dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+        for (int i = 0; i < 10000; i++) {
+            NSNumber *key = @(i % 100);
+            if (thread == 0 && i % 10 == 0) {
+                dictionary[key] = [NSString stringWithFormat:@"%d", i % 100];
+            } else {
+                NSString *value = dictionary[key];
+                XCTAssertEqual(value.intValue, key.intValue);
+            }
+        }
+    });
+    XCTAssertEqual(dictionary.count, 100);
+}
+
+@end
@@ -19,6 +19,7 @@
 
 #import <XCTest/XCTest.h>
 #import "WXTimerModule.h"
+#import "WXTimerScheduler.h"
 #import "TestSupportUtils.h"
 
 @interface WXTimerModuleTests : XCTestCase
@@ -82,6 +83,35 @@
     XCTAssert(self.timers[@"1"] == nil);
 }
 
+- (void)testScheduler {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Timer Scheduler Unit Test Error!"];
+    NSMutableArray *fired = [NSMutableArray array];
+    WXTimerScheduler *scheduler = [[WXTimerScheduler alloc] initWithRunLoop:[NSRunLoop mainRunLoop] handler:^(NSArray *targets) {
+        [fired addObjectsFromArray:targets];
+        if ([fired containsObject:@"last"]) {
+            [expectation fulfill];
+        }
+    }];
+    
+    [scheduler scheduleTarget:@"late" milliseconds:100 repeats:NO];
+    [scheduler scheduleTarget:@"early" milliseconds:50 repeats:NO];
+    uint64_t cancelled = [scheduler scheduleTarget:@"cancelled" milliseconds:50 repeats:NO];
+    uint64_t interval = [scheduler scheduleTarget:@"interval" milliseconds:30 repeats:YES];
+    [scheduler scheduleTarget:@"last" milliseconds:200 repeats:NO];
+    XCTAssertTrue([scheduler cancel:cancelled]);
+    XCTAssertFalse([scheduler cancel:cancelled]);
+    XCTAssertEqual(scheduler.count, 4);
+    
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    XCTAssertFalse([fired containsObject:@"cancelled"]);
+    XCTAssertTrue([fired indexOfObject:@"early"] < [fired indexOfObject:@"late"]);
+    XCTAssertTrue([fired indexOfObject:@"interval"] < [fired indexOfObject:@"early"]);
+    XCTAssertTrue([[fired filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"SELF == 'interval'"]] count] >= 3);
+    XCTAssertEqual(scheduler.count, 1);
+    XCTAssertTrue([scheduler cancel:interval]);
+    [scheduler invalidate];
+}
+
 - (void)trigger {
     [self.exp fulfill];
 }
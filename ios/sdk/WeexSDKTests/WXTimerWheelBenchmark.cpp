@@ -0,0 +1,295 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXTimerWheel, and benchmarks it against a run loop keeping one
+ * timer per timeout in a sorted array, which is what scheduling an NSTimer
+ * or a delayed perform for each of them amounts to. It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Utility WXTimerWheelBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXTimerWheel.cpp -o timer_benchmark
+ *   ./timer_benchmark
+ */
+
+#include "WXTimerWheel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static std::vector<uint64_t> advance(WXTimerWheel &wheel, uint64_t now)
+{
+    std::vector<uint64_t> expired;
+    wheel.advance(now, expired);
+    return expired;
+}
+
+static void checkBasics()
+{
+    WXTimerWheel wheel(1000);
+    uint64_t deadline;
+    CHECK(!wheel.nextDeadline(deadline));
+
+    uint64_t late = wheel.add(50);
+    uint64_t early = wheel.add(10);
+    uint64_t cancelled = wheel.add(20);
+    uint64_t immediate = wheel.add(0);
+    CHECK(late && early && cancelled && immediate);
+    CHECK(wheel.count() == 4);
+    CHECK(wheel.nextDeadline(deadline) && deadline == 1000);
+
+    // a timer of no delay expires on the next advance, even without time passing
+    std::vector<uint64_t> expired = advance(wheel, 1000);
+    CHECK(expired.size() == 1 && expired[0] == immediate);
+    CHECK(!wheel.contains(immediate) && !wheel.cancel(immediate));
+
+    CHECK(wheel.cancel(cancelled));
+    CHECK(!wheel.cancel(cancelled));
+    CHECK(wheel.nextDeadline(deadline) && deadline == 1010);
+    CHECK(advance(wheel, 1009).empty());
+    expired = advance(wheel, 1010);
+    CHECK(expired.size() == 1 && expired[0] == early);
+
+    // the identifier of a reused timer doesn't match the old one
+    uint64_t reused = wheel.add(5);
+    CHECK((uint32_t)reused == (uint32_t)early && reused != early);
+    CHECK(!wheel.cancel(early) && wheel.contains(reused));
+
+    // several timers expiring in one advance come in deadline order
+    expired = advance(wheel, 2000);
+    CHECK(expired.size() == 2 && expired[0] == reused && expired[1] == late);
+    CHECK(wheel.count() == 0);
+}
+
+static void checkIntervals()
+{
+    WXTimerWheel wheel;
+    uint64_t interval = wheel.add(16, 16);
+    wheel.add(40);
+    std::vector<uint64_t> fired;
+    for (uint64_t now = 1; now <= 100; now++) {
+        for (uint64_t identifier : advance(wheel, now)) {
+            fired.push_back(identifier == interval ? now : 1000 + now);
+        }
+    }
+    std::vector<uint64_t> expected = {16, 32, 1040, 48, 64, 80, 96};
+    CHECK(fired == expected);
+    CHECK(wheel.contains(interval) && wheel.count() == 1);
+
+    // an interval which fell behind fires once, and keeps its period from now
+    std::vector<uint64_t> expired = advance(wheel, 1000);
+    CHECK(expired.size() == 1);
+    uint64_t deadline;
+    CHECK(wheel.nextDeadline(deadline) && deadline == 1016);
+    CHECK(wheel.cancel(interval) && wheel.count() == 0);
+}
+
+static void checkLongDelays()
+{
+    // beyond the range of the wheel, and across the boundaries of its levels
+    WXTimerWheel wheel((1ULL << 24) - 3);
+    uint64_t start = wheel.now();
+    const uint64_t delays[] = {1, 4, 63, 64, 65, 4095, 4096, 4097, 1ULL << 24, (1ULL << 24) + 7, 1ULL << 30, 3ULL << 33};
+    std::map<uint64_t, uint64_t> deadlines;
+    for (uint64_t delay : delays) {
+        deadlines[wheel.add(delay)] = start + delay;
+    }
+
+    // jumping to each deadline fires its timer exactly then
+    size_t fired = 0;
+    uint64_t deadline;
+    int steps = 0;
+    while (wheel.nextDeadline(deadline) && steps++ < 10000) {
+        CHECK(deadline >= wheel.now());
+        for (uint64_t identifier : advance(wheel, deadline)) {
+            CHECK(deadlines[identifier] == deadline);
+            fired++;
+        }
+    }
+    CHECK(fired == sizeof(delays) / sizeof(delays[0]));
+}
+
+// random timers and cancels against a sorted map, with random steps of time
+static void checkRandom()
+{
+    std::mt19937_64 random(42);
+    WXTimerWheel wheel(random() % 100000);
+    std::map<uint64_t, uint64_t> deadlines;
+    for (int round = 0; round < 20000; round++) {
+        int action = random() % 10;
+        if (action < 5) {
+            uint64_t delay = random() % 4 == 0 ? random() % 20000000 : random() % 3000;
+            deadlines[wheel.add(delay)] = wheel.now() + delay;
+        } else if (action < 7 && !deadlines.empty()) {
+            auto entry = deadlines.begin();
+            std::advance(entry, random() % deadlines.size());
+            CHECK(wheel.cancel(entry->first));
+            deadlines.erase(entry);
+        } else {
+            uint64_t now = wheel.now() + (random() % 8 == 0 ? random() % 5000000 : random() % 200);
+            uint64_t next;
+            if (random() % 2 && wheel.nextDeadline(next)) {
+                now = next;
+            }
+            uint64_t previous = 0;
+            for (uint64_t identifier : advance(wheel, now)) {
+                auto entry = deadlines.find(identifier);
+                CHECK(entry != deadlines.end() && entry->second <= now);
+                CHECK(entry->second >= previous);
+                previous = entry->second;
+                deadlines.erase(entry);
+            }
+            // nothing due is left behind, and the next deadline is never late
+            for (const auto &entry : deadlines) {
+                CHECK(entry.second > now);
+            }
+            if (wheel.nextDeadline(next)) {
+                uint64_t earliest = UINT64_MAX;
+                for (const auto &entry : deadlines) {
+                    earliest = std::min(earliest, entry.second);
+                }
+                CHECK(next > now && next <= earliest);
+            }
+        }
+        CHECK(wheel.count() == deadlines.size());
+    }
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Scheduled {
+    uint64_t deadline;
+    uint64_t identifier;
+    int instance;
+    bool operator<(const Scheduled &other) const {
+        return deadline != other.deadline ? deadline < other.deadline : identifier < other.identifier;
+    }
+};
+
+/*
+ * timers of 1 to 100 ms from several instances, a third of them cancelled
+ * before they fire, like the animation loops of a JS framework
+ */
+static void benchmark(size_t timers, int instances)
+{
+    std::mt19937 random(7);
+    std::vector<uint64_t> delays(timers);
+    std::vector<int> owners(timers);
+    std::vector<bool> cancels(timers);
+    for (size_t i = 0; i < timers; i++) {
+        delays[i] = 1 + random() % 100;
+        owners[i] = random() % instances;
+        cancels[i] = random() % 3 == 0;
+    }
+    // 16 new timers in each ms
+    const size_t perTick = 16;
+
+    // a sorted array of timers, one bridge call for each timer which fires
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Scheduled> loop;
+    size_t legacyCalls = 0;
+    size_t legacyTimers = 0;
+    uint64_t now = 0;
+    for (size_t i = 0; i < timers || !loop.empty(); now++) {
+        for (size_t j = 0; j < perTick && i < timers; j++, i++) {
+            Scheduled timer = {now + delays[i], i, owners[i]};
+            loop.insert(std::upper_bound(loop.begin(), loop.end(), timer), timer);
+            legacyTimers++;
+            if (cancels[i]) {
+                loop.erase(std::lower_bound(loop.begin(), loop.end(), timer));
+            }
+        }
+        while (!loop.empty() && loop.front().deadline <= now) {
+            loop.erase(loop.begin());
+            legacyCalls++;
+        }
+    }
+    double legacyTime = milliseconds(start);
+
+    // the wheel, one system timer moved to its next deadline, one call for each instance and tick
+    start = std::chrono::steady_clock::now();
+    WXTimerWheel wheel;
+    std::vector<int> owner;
+    std::vector<uint64_t> expired;
+    std::vector<bool> called(instances);
+    size_t wheelCalls = 0;
+    size_t wakeups = 0;
+    now = 0;
+    for (size_t i = 0; i < timers || wheel.count() > 0; now++) {
+        for (size_t j = 0; j < perTick && i < timers; j++, i++) {
+            uint64_t identifier = wheel.add(delays[i]);
+            if (owner.size() <= (uint32_t)identifier) {
+                owner.resize((uint32_t)identifier + 1);
+            }
+            owner[(uint32_t)identifier] = owners[i];
+            if (cancels[i]) {
+                wheel.cancel(identifier);
+            }
+        }
+        uint64_t deadline;
+        if (!wheel.nextDeadline(deadline) || deadline > now) {
+            continue;
+        }
+        expired.clear();
+        wheel.advance(now, expired);
+        wakeups++;
+        std::fill(called.begin(), called.end(), false);
+        for (uint64_t identifier : expired) {
+            int instance = owner[(uint32_t)identifier];
+            if (!called[instance]) {
+                called[instance] = true;
+                wheelCalls++;
+            }
+        }
+    }
+    double wheelTime = milliseconds(start);
+
+    printf("%6zu timers, %d instances: sorted %8.2f ms, %6zu system timers, %6zu bridge calls | wheel %6.2f ms, %5zu wakeups, %5zu bridge calls\n",
+           timers, instances, legacyTime, legacyTimers, legacyCalls, wheelTime, wakeups, wheelCalls);
+}
+
+int main()
+{
+    checkBasics();
+    checkIntervals();
+    checkLongDelays();
+    checkRandom();
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(10000, 1);
+    benchmark(10000, 4);
+    benchmark(100000, 4);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*
+ * Checks WXTransitionEngine, and benchmarks it against solving the bezier
+ * curve and interpolating every property one by one on each frame, which is
+ * what WXTransition did. It doesn't need Xcode:
+ *
+ *   c++ -std=c++11 -O2 -I../WeexSDK/Sources/Utility WXTransitionEngineBenchmark.cpp \
+ *       ../WeexSDK/Sources/Utility/WXTransitionEngine.cpp -o transition_benchmark
+ *   ./transition_benchmark
+ */
+
+#include "WXTransitionEngine.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        failures++; \
+    } \
+} while (0)
+
+static void checkCurves()
+{
+    WXTimingCurve linear;
+    CHECK(linear.isLinear());
+    CHECK(linear.progress(0.25f) == 0.25f);
+    CHECK(linear.progress(-1.0f) == 0.0f && linear.progress(2.0f) == 1.0f);
+    CHECK(WXTimingCurve(0.25, 0.25, 0.75, 0.75).isLinear());
+
+    // ease, ease-in, ease-out, ease-in-out
+    const double curves[][4] = {{0.25, 0.1, 0.25, 1.0}, {0.42, 0, 1.0, 1.0}, {0, 0, 0.58, 1.0}, {0.42, 0, 0.58, 1.0}};
+    for (const auto &points : curves) {
+        WXTimingCurve curve(points[0], points[1], points[2], points[3]);
+        CHECK(!curve.isLinear());
+        CHECK(curve.progress(0) == 0.0f && curve.progress(1) == 1.0f);
+        double error = 0;
+        for (int i = 0; i <= 1000; i++) {
+            double x = i / 1000.0;
+            error = std::max(error, std::fabs(curve.progress((float)x) - curve.solve(x)));
+        }
+        CHECK(error < 1e-3);
+    }
+    WXTimingCurve easeInOut(0.42, 0, 0.58, 1.0);
+    CHECK(std::fabs(easeInOut.progress(0.5f) - 0.5f) < 1e-4);
+}
+
+static void checkEngine()
+{
+    WXTransitionEngine engine;
+    std::vector<WXTransitionFrame> frames;
+    const float from[] = {0, 100, 0, 0, 0, 1};
+    const float to[] = {100, 0, 1, 1, 1, 1};
+
+    uint32_t first = engine.add(WXTimingCurve(), 0, 1.0, from, to, 1);
+    uint32_t second = engine.add(WXTimingCurve(), 0.5, 0.5, from + 1, to + 1, 5);
+    CHECK(first != 0 && second != first);
+    CHECK(engine.count() == 2);
+
+    // the second one hasn't started
+    engine.tick(0.25, frames);
+    CHECK(frames.size() == 1 && frames[0].identifier == first && !frames[0].finished);
+    CHECK(frames[0].count == 1 && std::fabs(frames[0].values[0] - 25) < 1e-3);
+    CHECK(engine.elapsed(second, 0.25) < 0);
+
+    engine.tick(0.75, frames);
+    CHECK(frames.size() == 2);
+    CHECK(std::fabs(frames[0].values[0] - 75) < 1e-3);
+    CHECK(frames[1].identifier == second && frames[1].count == 5);
+    CHECK(std::fabs(frames[1].values[0] - 50) < 1e-3 && std::fabs(frames[1].values[1] - 0.5f) < 1e-3);
+    CHECK(frames[1].values[4] == 1);
+
+    // the frames after the end are the final values
+    engine.tick(1.5, frames);
+    CHECK(frames.size() == 2 && frames[0].finished && frames[1].finished);
+    CHECK(frames[0].values[0] == 100 && frames[1].values[0] == 0 && frames[1].values[3] == 1);
+    CHECK(engine.count() == 0 && !engine.contains(first));
+    engine.tick(1.6, frames);
+    CHECK(frames.empty());
+
+    // removing one in the middle keeps the channels of the others
+    uint32_t a = engine.add(WXTimingCurve(), 0, 1, from, to, 2);
+    uint32_t b = engine.add(WXTimingCurve(), 0, 1, from + 2, to + 2, 2);
+    uint32_t c = engine.add(WXTimingCurve(), 0, 1, from + 4, to + 4, 2);
+    engine.remove(b);
+    CHECK(engine.contains(a) && !engine.contains(b) && engine.contains(c));
+    engine.tick(0.5, frames);
+    CHECK(frames.size() == 2 && frames[1].identifier == c);
+    CHECK(std::fabs(frames[1].values[0] - 0.5f) < 1e-3 && frames[1].values[1] == 1);
+
+    // a transition without duration finishes on its first frame
+    uint32_t d = engine.add(WXTimingCurve(), 0.5, 0, from, to, 1);
+    engine.tick(0.5, frames);
+    CHECK(frames.size() == 3 && frames[2].identifier == d && frames[2].finished && frames[2].values[0] == 100);
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// solves the curve per frame, and boxes each property, like the old WXTransition
+struct LegacyTransition {
+    WXTimingCurve curve;
+    std::vector<std::vector<float>> from;
+    std::vector<std::vector<float>> per;
+    std::vector<std::vector<float>> values;
+};
+
+static void benchmark(size_t transitions, size_t channels, int frameCount)
+{
+    const WXTimingCurve ease(0.25, 0.1, 0.25, 1.0);
+    std::vector<float> from(channels), to(channels);
+    for (size_t i = 0; i < channels; i++) {
+        from[i] = (float)i;
+        to[i] = (float)(i * 2 + 100);
+    }
+
+    std::vector<LegacyTransition> legacy(transitions, LegacyTransition{ease, {}, {}, {}});
+    for (auto &transition : legacy) {
+        for (size_t i = 0; i < channels; i++) {
+            transition.from.push_back({from[i]});
+            transition.per.push_back({to[i] - from[i]});
+            transition.values.push_back({from[i]});
+        }
+    }
+    float checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frameCount; frame++) {
+        double x = (frame + 1) / (double)frameCount;
+        for (auto &transition : legacy) {
+            double progress = transition.curve.solve(x);
+            for (size_t i = 0; i < channels; i++) {
+                transition.values[i][0] = transition.from[i][0] + transition.per[i][0] * (float)progress;
+            }
+            checksum += transition.values[channels - 1][0];
+        }
+    }
+    double legacyTime = milliseconds(start);
+
+    WXTransitionEngine engine;
+    for (size_t i = 0; i < transitions; i++) {
+        engine.add(ease, 0, 1.0, from.data(), to.data(), channels);
+    }
+    std::vector<WXTransitionFrame> frames;
+    float engineChecksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frameCount; frame++) {
+        engine.tick((frame + 1) / (double)frameCount, frames);
+        for (const WXTransitionFrame &result : frames) {
+            engineChecksum += result.values[result.count - 1];
+        }
+    }
+    double engineTime = milliseconds(start);
+    CHECK(std::fabs(checksum - engineChecksum) < std::fabs(checksum) * 1e-3);
+
+    printf("%4zu transitions x %2zu channels, %d frames: solve %7.2f ms (%6.1f us/frame) | table %6.2f ms (%5.1f us/frame)\n",
+           transitions, channels, frameCount, legacyTime, legacyTime * 1000 / frameCount,
+           engineTime, engineTime * 1000 / frameCount);
+}
+
+int main()
+{
+    checkCurves();
+    checkEngine();
+    printf("checks: %d failures\n\n", failures);
+
+    benchmark(10, 4, 60);
+    benchmark(100, 4, 60);
+    benchmark(500, 8, 60);
+    benchmark(1000, 16, 60);
+
+    return failures ? 1 : 0;
+}
@@ -59,6 +59,9 @@ export default class WeexInstance {
     setId(this, String(id))
     this.config = config || {}
     this.document = new Document(id, this.config.bundleUrl)
+    if (this.config.batchUpdates && this.document.taskCenter) {
+      this.document.taskCenter.batched = true
+    }
     this.requireModule = this.requireModule.bind(this)
     this.isRegisteredModule = isRegisteredModule
     this.isRegisteredComponent = isRegisteredComponent
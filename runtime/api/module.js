@@ -18,12 +18,15 @@
  */
 
 const weexModules = {}
+const dispatchIds = {}
 
 /**
  * Register native modules information.
  * @param {object} newModules
+ * @param {object} newDispatchIds (optional) integer ids of modules and methods,
+ *                                { [name]: { id, methods: { [method]: id } } }
  */
-export function registerModules (newModules) {
+export function registerModules (newModules, newDispatchIds) {
   for (const name in newModules) {
     if (!weexModules[name]) {
       weexModules[name] = {}
@@ -37,6 +40,28 @@ export function registerModules (newModules) {
       }
     })
   }
+  if (newDispatchIds && typeof newDispatchIds === 'object') {
+    for (const name in newDispatchIds) {
+      const ids = newDispatchIds[name]
+      if (ids && typeof ids.id === 'number' && ids.methods) {
+        dispatchIds[name] = ids
+      }
+    }
+  }
+}
+
+/**
+ * Get the pre-resolved native dispatch ids of a module method.
+ * @param {String} module name
+ * @param {String} method name
+ * @return {array | null} [moduleId, methodId]
+ */
+export function getModuleDispatchId (name, method) {
+  const ids = dispatchIds[name]
+  if (ids && typeof ids.methods[method] === 'number') {
+    return [ids.id, ids.methods[method]]
+  }
+  return null
 }
 
 /**
@@ -17,6 +17,8 @@
  * under the License.
  */
 
+import { scheduleFlush, cancelFlush, coalesceActions } from './batch'
+
 /**
 * Create the action object.
 * @param {string} name
@@ -32,6 +34,7 @@ export default class Listener {
     this.id = id
     this.batched = false
     this.updates = []
+    this.flush = this.flush.bind(this)
     if (typeof handler === 'function') {
       Object.defineProperty(this, 'handler', {
         configurable: true,
@@ -212,9 +215,25 @@ export default class Listener {
 
     if (this.batched) {
       updates.push.apply(updates, actions)
+      scheduleFlush(this.flush)
     }
     else {
       return handler(actions)
     }
   }
+
+  /**
+   * Send the coalesced updates in one call of the handler.
+   * @return {undefined | number} the signal sent by native
+   */
+  flush () {
+    cancelFlush(this.flush)
+    if (!this.updates.length) {
+      return
+    }
+    const actions = coalesceActions(this.updates.splice(0))
+    if (actions.length) {
+      return this.handler(actions)
+    }
+  }
 }
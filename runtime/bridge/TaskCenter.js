@@ -21,6 +21,8 @@ import CallbackManager from './CallbackManager'
 import Element from '../vdom/Element'
 import { typof } from '../shared/utils'
 import { normalizePrimitive } from './normalize'
+import { getModuleDispatchId } from '../api/module'
+import { scheduleFlush, cancelFlush, coalesceActions } from './batch'
 
 let fallback = function () {}
 
@@ -35,9 +37,52 @@ export class TaskCenter {
       enumerable: true,
       value: new CallbackManager(id)
     })
+    Object.defineProperty(this, 'pendingActions', {
+      value: []
+    })
+    Object.defineProperty(this, 'flush', {
+      value: this.flush.bind(this)
+    })
+    // When it's batched, DOM actions are coalesced and sent at the end of current tick.
+    this.batched = false
     fallback = sendTasks || function () {}
   }
 
+  /**
+   * Send the queued DOM actions in one native call.
+   * @return {undefined | number} the signal sent by native
+   */
+  flush () {
+    cancelFlush(this.flush)
+    if (!this.pendingActions.length) {
+      return
+    }
+    const pending = this.pendingActions.splice(0)
+    const actions = []
+    pending.forEach(action => {
+      if (typeof action === 'function') {
+        actions.push.apply(actions, action())
+      }
+      else {
+        actions.push(action)
+      }
+    })
+    const coalesced = coalesceActions(actions)
+    if (coalesced.length) {
+      return fallback(this.instanceId, coalesced, '-1')
+    }
+  }
+
+  /**
+   * Queue a function which generates DOM actions when flushing, the actions
+   * are sent in the position where the function is queued.
+   * @param {function} produce
+   */
+  schedule (produce) {
+    this.pendingActions.push(produce)
+    scheduleFlush(this.flush)
+  }
+
   callback (callbackId, data, ifKeepAlive) {
     return this.callbackManager.consume(callbackId, data, ifKeepAlive)
   }
@@ -58,6 +103,8 @@ export class TaskCenter {
   }
 
   destroyCallback () {
+    cancelFlush(this.flush)
+    this.pendingActions.length = 0
     return this.callbackManager.close()
   }
 
@@ -88,23 +135,31 @@ export class TaskCenter {
 
     switch (type) {
       case 'dom':
-        return this[action](this.instanceId, args)
+        return this.callDOM(action, args)
       case 'component':
-        return this.componentHandler(this.instanceId, ref, method, args, Object.assign({ component }, options))
+        return this.callComponent(ref, method, args, Object.assign({ component }, options))
       default:
-        return this.moduleHandler(this.instanceId, module, method, args, options)
+        return this.callModule(module, method, args, options)
     }
   }
 
   callDOM (action, args) {
+    if (this.batched) {
+      this.pendingActions.push({ module: 'dom', method: action, args })
+      scheduleFlush(this.flush)
+      return
+    }
     return this[action](this.instanceId, args)
   }
 
   callComponent (ref, method, args, options) {
+    // keep the order of the queued DOM actions and the component calls
+    this.flush()
     return this.componentHandler(this.instanceId, ref, method, args, options)
   }
 
   callModule (module, method, args, options) {
+    this.flush()
     return this.moduleHandler(this.instanceId, module, method, args, options)
   }
 }
@@ -139,7 +194,17 @@ export function init () {
     ((id, ref, method, args, options) =>
       fallback(id, [{ component: options.component, ref, method, args }]))
 
-  proto.moduleHandler = global.callNativeModule ||
+  const callNativeModule = global.callNativeModule
+  proto.moduleHandler = callNativeModule ?
+    (id, module, method, args, options) => {
+      // native side has published integer ids for this method,
+      // dispatch by ids to skip resolving the names every call
+      const dispatchId = getModuleDispatchId(module, method)
+      if (dispatchId) {
+        return callNativeModule(id, dispatchId[0], dispatchId[1], args, options)
+      }
+      return callNativeModule(id, module, method, args, options)
+    } :
     ((id, module, method, args) =>
       fallback(id, [{ module, method, args }]))
 }
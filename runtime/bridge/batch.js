@@ -0,0 +1,268 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @fileOverview
+ * Microtask-scoped batching of DOM actions. Actions of all instances
+ * queued in the same tick are coalesced and flushed together.
+ */
+
+const UPDATE_METHODS = {
+  updateStyle: 'style',
+  updateAttrs: 'attr'
+}
+
+const pendingFlushes = []
+let flushScheduled = false
+
+function flushAll () {
+  flushScheduled = false
+  const flushes = pendingFlushes.splice(0)
+  for (let i = 0; i < flushes.length; i++) {
+    flushes[i]()
+  }
+}
+
+/**
+ * Run the flush function at the end of current tick. The same function
+ * scheduled several times in one tick only runs once.
+ * @param {function} flush
+ */
+export function scheduleFlush (flush) {
+  if (pendingFlushes.indexOf(flush) >= 0) {
+    return
+  }
+  pendingFlushes.push(flush)
+  if (!flushScheduled) {
+    flushScheduled = true
+    if (typeof Promise === 'function') {
+      Promise.resolve().then(flushAll)
+    }
+    /* istanbul ignore next */
+    else {
+      setTimeout(flushAll, 0)
+    }
+  }
+}
+
+/**
+ * Cancel a scheduled flush function.
+ * @param {function} flush
+ */
+export function cancelFlush (flush) {
+  const index = pendingFlushes.indexOf(flush)
+  if (index >= 0) {
+    pendingFlushes.splice(index, 1)
+  }
+}
+
+/**
+ * Walk the serialized element, record each node by its ref. `holderRef` is
+ * the node whose serialized children include the node, null for the root.
+ */
+function collectNodes (json, parentRef, holderRef, nodes, removedRefs) {
+  nodes[json.ref] = { json, parentRef, holderRef }
+  delete removedRefs[json.ref]
+  if (json.children) {
+    json.children.forEach(child => collectNodes(child, json.ref, json.ref, nodes, removedRefs))
+  }
+}
+
+/**
+ * Whether the node added in this batch is the target or inside the target.
+ */
+function isInside (nodes, ref, targetRef) {
+  while (ref && nodes[ref]) {
+    if (ref === targetRef) {
+      return true
+    }
+    ref = nodes[ref].parentRef
+  }
+  return ref === targetRef
+}
+
+/**
+ * The node inserted by an "addElement" or "moveElement" action.
+ */
+function insertedRef (action) {
+  return action.method === 'addElement' ? action.args[1].ref : action.args[0]
+}
+
+/**
+ * Coalesce DOM actions which are going to be sent in the same batch:
+ *  - updates of the same element are merged into one action, updates of
+ *    elements added in this batch are merged into the "addElement" action.
+ *  - elements added and removed in this batch are dropped, along with
+ *    all the updates to them, unless any of the remaining actions depends
+ *    on them: a node moved out of them, a node nested in the serialized
+ *    element of a remaining one, or a later insertion whose index counts
+ *    them. The "removeElement" action is kept in that case.
+ *  - actions on the removed elements are dropped, unless they are added
+ *    again in this batch.
+ * The order of the remaining actions are kept.
+ * @param {array} actions
+ * @return {array} coalesced actions
+ */
+export function coalesceActions (actions) {
+  const result = []
+  // ref -> node serialized in an "addElement" action of this batch
+  const addedNodes = {}
+  // ref -> the index of "addElement" action in result
+  const addIndexes = {}
+  // ref -> the index of last merged update action in result, by method
+  const updateIndexes = { updateStyle: {}, updateAttrs: {}}
+  // ref -> indexes of the other actions on the element in result
+  const refIndexes = {}
+  // ref -> indexes of the "addElement" and "moveElement" actions into the element
+  const insertIndexes = {}
+  // refs of the elements removed from native in this batch
+  const removedRefs = {}
+
+  function track (indexes, ref, index) {
+    (indexes[ref] || (indexes[ref] = [])).push(index)
+  }
+
+  // whether dropping the elements and the actions on them leaves the
+  // remaining actions valid
+  function canDrop (dropped, targets) {
+    for (const nodeRef in dropped) {
+      const node = addedNodes[nodeRef]
+      if (node.holderRef !== null && !dropped[node.holderRef]) {
+        return false
+      }
+      if ((node.json.children || []).some(child => !dropped[child.ref])) {
+        return false
+      }
+      if ((insertIndexes[nodeRef] || []).some(index => result[index] && !dropped[insertedRef(result[index])])) {
+        return false
+      }
+    }
+    const insertions = []
+    for (const nodeRef in dropped) {
+      if (addIndexes[nodeRef] >= 0) {
+        insertions.push(addIndexes[nodeRef])
+      }
+    }
+    for (const ref in targets) {
+      (refIndexes[ref] || []).forEach(index => {
+        if (result[index] && result[index].method === 'moveElement') {
+          insertions.push(index)
+        }
+      })
+    }
+    return insertions.every(index => {
+      const parentRef = result[index].method === 'addElement' ? result[index].args[0] : result[index].args[1]
+      if (targets[parentRef]) {
+        return true
+      }
+      return (insertIndexes[parentRef] || []).every(later => {
+        const action = result[later]
+        return later < index || !action || targets[insertedRef(action)] || !(action.args[2] >= 0)
+      })
+    })
+  }
+
+  for (let i = 0; i < actions.length; i++) {
+    const action = actions[i]
+    const { method, args } = action
+    const ref = args && args[0]
+
+    if (removedRefs[ref] && method !== 'addElement') {
+      continue
+    }
+
+    if (UPDATE_METHODS[method]) {
+      const added = addedNodes[ref]
+      if (added) {
+        const key = UPDATE_METHODS[method]
+        added.json[key] = Object.assign({}, added.json[key], args[1])
+        continue
+      }
+      const index = updateIndexes[method][ref]
+      if (index >= 0) {
+        const merged = result[index]
+        merged.args = [ref, Object.assign({}, merged.args[1], args[1])]
+        continue
+      }
+      updateIndexes[method][ref] = result.length
+      track(refIndexes, ref, result.length)
+      result.push(action)
+    }
+    else if (method === 'addElement') {
+      const json = args[1]
+      if (json && json.ref) {
+        collectNodes(json, ref, null, addedNodes, removedRefs)
+        addIndexes[json.ref] = result.length
+        track(insertIndexes, ref, result.length)
+      }
+      result.push(action)
+    }
+    else if (method === 'moveElement') {
+      const added = addedNodes[ref]
+      if (added) {
+        added.parentRef = args[1]
+      }
+      track(refIndexes, ref, result.length)
+      track(insertIndexes, args[1], result.length)
+      result.push(action)
+    }
+    else if (method === 'removeElement') {
+      // the nodes added in this batch which are removed along with the element
+      const dropped = {}
+      for (const nodeRef in addedNodes) {
+        if (isInside(addedNodes, nodeRef, ref)) {
+          dropped[nodeRef] = true
+        }
+      }
+      const targets = Object.assign({}, dropped)
+      targets[ref] = true
+      const existing = !addedNodes[ref]
+      const droppable = canDrop(dropped, targets)
+      for (const nodeRef in targets) {
+        if (droppable) {
+          (refIndexes[nodeRef] || []).forEach(index => {
+            result[index] = null
+          })
+          if (addIndexes[nodeRef] >= 0) {
+            result[addIndexes[nodeRef]] = null
+          }
+        }
+        removedRefs[nodeRef] = true
+        delete refIndexes[nodeRef]
+        delete addIndexes[nodeRef]
+        delete insertIndexes[nodeRef]
+        delete addedNodes[nodeRef]
+        delete updateIndexes.updateStyle[nodeRef]
+        delete updateIndexes.updateAttrs[nodeRef]
+      }
+      // the element exists in native before this batch, or is still needed
+      if (existing || !droppable) {
+        result.push(action)
+      }
+    }
+    else {
+      if (ref && typeof ref === 'string') {
+        track(refIndexes, ref, result.length)
+      }
+      result.push(action)
+    }
+  }
+
+  return result.filter(action => action)
+}
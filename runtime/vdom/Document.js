@@ -23,6 +23,7 @@ import Listener from '../bridge/Listener'
 import { TaskCenter } from '../bridge/TaskCenter'
 import { createHandler } from '../bridge/Handler'
 import { addDoc, removeDoc, appendBody, setBody } from './operation'
+import { discardPatch } from './patch'
 
 /**
  * Update all changes for an element.
@@ -178,6 +179,8 @@ export default class Document {
   */
   destroy () {
     this.taskCenter.destroyCallback()
+    this.listener.updates.length = 0
+    discardPatch(this.id)
     delete this.listener
     delete this.nodeMap
     delete this.taskCenter
@@ -26,10 +26,13 @@ import {
   previousElement,
   insertIndex,
   moveIndex,
-  removeIndex
+  removeIndex,
+  resetSerialized,
+  serializeElement
 } from './operation'
 import { uniqueId, isEmpty } from '../shared/utils'
 import { getWeexElement, setElement } from './WeexElement'
+import { markChildren, markInserted, isPending } from './patch'
 
 const DEFAULT_TAG_NAME = 'div'
 const BUBBLE_EVENTS = [
@@ -37,11 +40,55 @@ const BUBBLE_EVENTS = [
   'panstart', 'panmove', 'panend', 'horizontalpan', 'verticalpan', 'swipe'
 ]
 
+/**
+ * Get the event list of the element for serialization.
+ * @param {object} element
+ * @return {array} event
+ */
+function serializeEvent (el) {
+  const event = []
+  for (const type in el.event) {
+    const { params } = el.event[type]
+    if (!params) {
+      event.push(type)
+    }
+    else {
+      event.push({ type, params })
+    }
+  }
+  return event
+}
+
 function registerNode (docId, node) {
   const doc = getDoc(docId)
   doc.nodeMap[node.nodeId] = node
 }
 
+/**
+ * In batched mode, the changes of children are sent as a patch when flushing.
+ * @param {object} element
+ * @return {boolean} whether the changes are recorded in the patch
+ */
+function patchChildren (el) {
+  const taskCenter = getTaskCenter(el.docId)
+  if (taskCenter && taskCenter.batched) {
+    markChildren(el, taskCenter)
+    return true
+  }
+  return false
+}
+
+/**
+ * Get the task center to send the updates of the element. The elements
+ * inserted in current patch will be serialized with the latest data, so
+ * their updates needn't to be sent.
+ * @param {object} element
+ * @return {object} TaskCenter
+ */
+function getUpdateTaskCenter (el) {
+  return isPending(el) ? null : getTaskCenter(el.docId)
+}
+
 export default class Element extends Node {
   constructor (type = DEFAULT_TAG_NAME, props, isExtended) {
     super()
@@ -62,6 +109,12 @@ export default class Element extends Node {
     this.event = {}
     this.children = []
     this.pureChildren = []
+    // the cached results of `toJSON` and `toJSONString`
+    Object.defineProperty(this, 'serialized', {
+      configurable: true,
+      writable: true,
+      value: null
+    })
   }
 
   /**
@@ -73,6 +126,8 @@ export default class Element extends Node {
     if (node.parentNode && node.parentNode !== this) {
       return
     }
+    const patching = patchChildren(this)
+    resetSerialized(this)
     /* istanbul ignore else */
     if (!node.parentNode) {
       linkParent(node, this)
@@ -82,12 +137,15 @@ export default class Element extends Node {
       }
       if (node.nodeType === 1) {
         insertIndex(node, this.pureChildren, this.pureChildren.length)
+        if (patching) {
+          return markInserted(node)
+        }
         const taskCenter = getTaskCenter(this.docId)
         if (taskCenter) {
           return taskCenter.send(
             'dom',
             { action: 'addElement' },
-            [this.ref, node.toJSON(), -1]
+            [this.ref, serializeElement(node, taskCenter), -1]
           )
         }
       }
@@ -97,7 +155,7 @@ export default class Element extends Node {
       if (node.nodeType === 1) {
         const index = moveIndex(node, this.pureChildren, this.pureChildren.length)
         const taskCenter = getTaskCenter(this.docId)
-        if (taskCenter && index >= 0) {
+        if (taskCenter && index >= 0 && !patching) {
           return taskCenter.send(
             'dom',
             { action: 'moveElement' },
@@ -121,6 +179,8 @@ export default class Element extends Node {
     if (node === before || (node.nextSibling && node.nextSibling === before)) {
       return
     }
+    const patching = patchChildren(this)
+    resetSerialized(this)
     if (!node.parentNode) {
       linkParent(node, this)
       insertIndex(node, this.children, this.children.indexOf(before), true)
@@ -136,12 +196,15 @@ export default class Element extends Node {
             ? this.pureChildren.indexOf(pureBefore)
             : this.pureChildren.length
         )
+        if (patching) {
+          return markInserted(node)
+        }
         const taskCenter = getTaskCenter(this.docId)
         if (taskCenter) {
           return taskCenter.send(
             'dom',
             { action: 'addElement' },
-            [this.ref, node.toJSON(), index]
+            [this.ref, serializeElement(node, taskCenter), index]
           )
         }
       }
@@ -159,7 +222,7 @@ export default class Element extends Node {
             : this.pureChildren.length
         )
         const taskCenter = getTaskCenter(this.docId)
-        if (taskCenter && index >= 0) {
+        if (taskCenter && index >= 0 && !patching) {
           return taskCenter.send(
             'dom',
             { action: 'moveElement' },
@@ -183,6 +246,8 @@ export default class Element extends Node {
     if (node === after || (node.previousSibling && node.previousSibling === after)) {
       return
     }
+    const patching = patchChildren(this)
+    resetSerialized(this)
     if (!node.parentNode) {
       linkParent(node, this)
       insertIndex(node, this.children, this.children.indexOf(after) + 1, true)
@@ -196,13 +261,16 @@ export default class Element extends Node {
           this.pureChildren,
           this.pureChildren.indexOf(previousElement(after)) + 1
         )
+        if (patching) {
+          return markInserted(node)
+        }
         const taskCenter = getTaskCenter(this.docId)
         /* istanbul ignore else */
         if (taskCenter) {
           return taskCenter.send(
             'dom',
             { action: 'addElement' },
-            [this.ref, node.toJSON(), index]
+            [this.ref, serializeElement(node, taskCenter), index]
           )
         }
       }
@@ -216,7 +284,7 @@ export default class Element extends Node {
           this.pureChildren.indexOf(previousElement(after)) + 1
         )
         const taskCenter = getTaskCenter(this.docId)
-        if (taskCenter && index >= 0) {
+        if (taskCenter && index >= 0 && !patching) {
           return taskCenter.send(
             'dom',
             { action: 'moveElement' },
@@ -234,11 +302,13 @@ export default class Element extends Node {
    */
   removeChild (node, preserved) {
     if (node.parentNode) {
+      const patching = patchChildren(this)
+      resetSerialized(this)
       removeIndex(node, this.children, true)
       if (node.nodeType === 1) {
         removeIndex(node, this.pureChildren)
         const taskCenter = getTaskCenter(this.docId)
-        if (taskCenter) {
+        if (taskCenter && !patching) {
           taskCenter.send(
             'dom',
             { action: 'removeElement' },
@@ -256,9 +326,10 @@ export default class Element extends Node {
    * Clear all child nodes.
    */
   clear () {
+    resetSerialized(this)
     const taskCenter = getTaskCenter(this.docId)
     /* istanbul ignore else */
-    if (taskCenter) {
+    if (taskCenter && !patchChildren(this)) {
       this.pureChildren.forEach(node => {
         taskCenter.send(
           'dom',
@@ -285,7 +356,8 @@ export default class Element extends Node {
       return
     }
     this.attr[key] = value
-    const taskCenter = getTaskCenter(this.docId)
+    resetSerialized(this)
+    const taskCenter = getUpdateTaskCenter(this)
     if (!silent && taskCenter) {
       const result = {}
       result[key] = value
@@ -312,7 +384,8 @@ export default class Element extends Node {
       }
     }
     if (!isEmpty(mutations)) {
-      const taskCenter = getTaskCenter(this.docId)
+      resetSerialized(this)
+      const taskCenter = getUpdateTaskCenter(this)
       if (!silent && taskCenter) {
         taskCenter.send(
           'dom',
@@ -334,7 +407,8 @@ export default class Element extends Node {
       return
     }
     this.style[key] = value
-    const taskCenter = getTaskCenter(this.docId)
+    resetSerialized(this)
+    const taskCenter = getUpdateTaskCenter(this)
     if (!silent && taskCenter) {
       const result = {}
       result[key] = value
@@ -361,7 +435,8 @@ export default class Element extends Node {
       }
     }
     if (!isEmpty(mutations)) {
-      const taskCenter = getTaskCenter(this.docId)
+      resetSerialized(this)
+      const taskCenter = getUpdateTaskCenter(this)
       if (!silent && taskCenter) {
         taskCenter.send(
           'dom',
@@ -383,7 +458,8 @@ export default class Element extends Node {
     }
 
     Object.assign(this.classStyle, classStyle)
-    const taskCenter = getTaskCenter(this.docId)
+    resetSerialized(this)
+    const taskCenter = getUpdateTaskCenter(this)
     if (taskCenter) {
       taskCenter.send(
         'dom',
@@ -404,7 +480,8 @@ export default class Element extends Node {
     }
     if (!this.event[type]) {
       this.event[type] = { handler, params }
-      const taskCenter = getTaskCenter(this.docId)
+      resetSerialized(this)
+      const taskCenter = getUpdateTaskCenter(this)
       if (taskCenter) {
         taskCenter.send(
           'dom',
@@ -422,7 +499,8 @@ export default class Element extends Node {
   removeEvent (type) {
     if (this.event && this.event[type]) {
       delete this.event[type]
-      const taskCenter = getTaskCenter(this.docId)
+      resetSerialized(this)
+      const taskCenter = getUpdateTaskCenter(this)
       if (taskCenter) {
         taskCenter.send(
           'dom',
@@ -479,32 +557,57 @@ export default class Element extends Node {
   }
 
   /**
-   * Convert current element to JSON like object.
+   * Convert current element to JSON like object. The result is cached until
+   * the element or its descendants are changed, so it shouldn't be modified.
    * @return {object} element
    */
   toJSON () {
+    const serialized = this.serialized || (this.serialized = {})
+    if (serialized.json) {
+      return serialized.json
+    }
     const result = {
       ref: this.ref.toString(),
       type: this.type,
       attr: this.attr,
       style: this.toStyle()
     }
-    const event = []
-    for (const type in this.event) {
-      const { params } = this.event[type]
-      if (!params) {
-        event.push(type)
-      }
-      else {
-        event.push({ type, params })
-      }
-    }
+    const event = serializeEvent(this)
     if (event.length) {
       result.event = event
     }
     if (this.pureChildren.length) {
       result.children = this.pureChildren.map((child) => child.toJSON())
     }
+    serialized.json = result
+    return result
+  }
+
+  /**
+   * Convert current element to JSON string, same as `JSON.stringify(toJSON())`.
+   * The strings of the unchanged descendants are reused.
+   * @return {string} element
+   */
+  toJSONString () {
+    const serialized = this.serialized || (this.serialized = {})
+    if (serialized.string) {
+      return serialized.string
+    }
+    let result = '{"ref":' + JSON.stringify(this.ref.toString())
+      + ',"type":' + JSON.stringify(this.type)
+      + ',"attr":' + JSON.stringify(this.attr)
+      + ',"style":' + JSON.stringify(this.toStyle())
+    const event = serializeEvent(this)
+    if (event.length) {
+      result += ',"event":' + JSON.stringify(event)
+    }
+    if (this.pureChildren.length) {
+      result += ',"children":['
+        + this.pureChildren.map((child) => child.toJSONString()).join(',')
+        + ']'
+    }
+    result += '}'
+    serialized.string = result
     return result
   }
 
@@ -121,12 +121,40 @@ export function appendBody (doc, node, before) {
 }
 
 function sendBody (doc, node) {
-  const body = node.toJSON()
   if (doc && doc.taskCenter && typeof doc.taskCenter.send === 'function') {
+    const body = serializeElement(node, doc.taskCenter)
     doc.taskCenter.send('dom', { action: 'createBody' }, [body])
   }
 }
 
+/**
+ * Serialize the element which is going to be sent to native. If native
+ * declares `WXEnvironment.elementEncoding` as "json", the pre-encoded JSON
+ * string is sent instead of the object, unless the actions are batched and
+ * still need to be merged.
+ * @param {object} element
+ * @param {object} taskCenter
+ * @return {object | string} element
+ */
+export function serializeElement (node, taskCenter) {
+  const env = global.WXEnvironment
+  if (env && env.elementEncoding === 'json' && !taskCenter.batched) {
+    return node.toJSONString()
+  }
+  return node.toJSON()
+}
+
+/**
+ * Drop the cached serialization of the node and its ancestors.
+ * @param {object} node
+ */
+export function resetSerialized (node) {
+  while (node && node.serialized) {
+    node.serialized = null
+    node = node.parentNode
+  }
+}
+
 /**
  * Set up body node.
  * @param {object} document
@@ -137,6 +165,7 @@ export function setBody (doc, el) {
   el.depth = 1
   delete doc.nodeMap[el.nodeId]
   el.ref = '_root'
+  resetSerialized(el)
   doc.nodeMap._root = el
   doc.body = el
 }
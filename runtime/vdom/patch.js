@@ -0,0 +1,236 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @fileOverview
+ * Children patches of batched documents. Instead of sending every
+ * "addElement", "moveElement" and "removeElement" eagerly, the children of
+ * the changed elements are recorded once per batch, and diffed against the
+ * current children when flushing. Reordered children are moved along the
+ * longest increasing subsequence, so only the minimal moves are sent.
+ */
+
+const patchMap = {}
+
+function createAction (method, args) {
+  return { module: 'dom', method, args }
+}
+
+/**
+ * Get the patch of current batch, create one if it doesn't exist.
+ * @param {string} docId
+ * @param {object} taskCenter
+ * @return {object} patch
+ */
+function getPatch (docId, taskCenter) {
+  let patch = patchMap[docId]
+  if (!patch) {
+    patch = patchMap[docId] = {
+      // ref -> the children of the element at the beginning of the batch
+      parents: {},
+      // refs of the elements inserted in this batch (including descendants)
+      pending: {}
+    }
+    taskCenter.schedule(() => flushPatch(docId))
+  }
+  return patch
+}
+
+/**
+ * Record the children of the element before they are changed.
+ * @param {object} element
+ * @param {object} taskCenter
+ */
+export function markChildren (el, taskCenter) {
+  const patch = getPatch(el.docId, taskCenter)
+  if (!patch.parents[el.ref] && !patch.pending[el.ref]) {
+    patch.parents[el.ref] = {
+      node: el,
+      children: el.pureChildren.slice()
+    }
+  }
+}
+
+/**
+ * Mark the element and its descendants as inserted in current batch, they
+ * will be serialized when flushing.
+ * @param {object} element
+ */
+export function markInserted (el) {
+  const patch = patchMap[el.docId]
+  if (patch) {
+    markPending(el, patch.pending)
+  }
+}
+
+function markPending (el, pending) {
+  pending[el.ref] = true
+  el.pureChildren.forEach(child => markPending(child, pending))
+}
+
+/**
+ * Whether the element is going to be serialized in current batch.
+ * @param {object} element
+ * @return {boolean}
+ */
+export function isPending (el) {
+  const patch = patchMap[el.docId]
+  return !!(patch && patch.pending[el.ref])
+}
+
+/**
+ * Discard the patch of the document.
+ * @param {string} docId
+ */
+export function discardPatch (docId) {
+  delete patchMap[docId]
+}
+
+/**
+ * Whether the element is still in the document tree.
+ */
+function isAttached (el) {
+  while (el.parentNode) {
+    if (el.parentNode.pureChildren.indexOf(el) < 0) {
+      return false
+    }
+    el = el.parentNode
+  }
+  return el.role === 'documentElement'
+}
+
+/**
+ * Generate the actions of the patch and discard it. The removals of all the
+ * parents are sent before the insertions, so a node moved to another parent
+ * is removed and then added again with its latest children, instead of
+ * being added before it is removed from the previous parent.
+ * @param {string} docId
+ * @return {array} actions
+ */
+export function flushPatch (docId) {
+  const patch = patchMap[docId]
+  const removals = []
+  const actions = []
+  delete patchMap[docId]
+  if (patch) {
+    for (const ref in patch.parents) {
+      const { node, children } = patch.parents[ref]
+      if (!patch.pending[ref] && isAttached(node)) {
+        diffChildren(node, children, actions, removals)
+      }
+    }
+  }
+  return removals.concat(actions)
+}
+
+/**
+ * Get the indexes of the longest increasing subsequence.
+ * @param {array} list of numbers
+ * @return {array} indexes
+ */
+export function longestIncreasingSubsequence (list) {
+  // tails[k]: index of the smallest tail of the subsequences with length k + 1
+  const tails = []
+  const prev = []
+  for (let i = 0; i < list.length; i++) {
+    let low = 0
+    let high = tails.length
+    while (low < high) {
+      const mid = (low + high) >> 1
+      if (list[tails[mid]] < list[i]) {
+        low = mid + 1
+      }
+      else {
+        high = mid
+      }
+    }
+    prev[i] = low > 0 ? tails[low - 1] : -1
+    tails[low] = i
+  }
+  const result = []
+  let k = tails.length ? tails[tails.length - 1] : -1
+  while (k >= 0) {
+    result.unshift(k)
+    k = prev[k]
+  }
+  return result
+}
+
+/**
+ * Generate the minimal actions to turn the children in native into the
+ * current children of the element.
+ * @param {object} element
+ * @param {array} children in native
+ * @param {array} actions
+ * @param {array} removals, the "removeElement" actions, which are sent
+ *                before the other actions, default to the actions
+ */
+export function diffChildren (el, oldChildren, actions, removals) {
+  removals = removals || actions
+  const newChildren = el.pureChildren
+  const newIndexes = {}
+  newChildren.forEach((child, index) => {
+    newIndexes[child.ref] = index
+  })
+
+  // children in native, keep in sync with the actions
+  const current = []
+  oldChildren.forEach(child => {
+    if (newIndexes[child.ref] >= 0) {
+      current.push(child)
+    }
+    else {
+      removals.push(createAction('removeElement', [child.ref]))
+    }
+  })
+
+  const stable = {}
+  longestIncreasingSubsequence(current.map(child => newIndexes[child.ref]))
+    .forEach(index => {
+      stable[current[index].ref] = true
+    })
+  const existed = {}
+  current.forEach(child => {
+    existed[child.ref] = true
+  })
+
+  // place the children from the last one, before their next sibling
+  for (let i = newChildren.length - 1; i >= 0; i--) {
+    const child = newChildren[i]
+    if (stable[child.ref]) {
+      continue
+    }
+    const next = newChildren[i + 1]
+    if (existed[child.ref]) {
+      const from = current.indexOf(child)
+      current.splice(from, 1)
+      const to = next ? current.indexOf(next) : current.length
+      current.splice(to, 0, child)
+      if (from !== to) {
+        // the index of "moveElement" is counted before removing the node
+        actions.push(createAction('moveElement', [child.ref, el.ref, from < to ? to + 1 : to]))
+      }
+    }
+    else {
+      const to = next ? current.indexOf(next) : current.length
+      current.splice(to, 0, child)
+      actions.push(createAction('addElement', [el.ref, child.toJSON(), to]))
+    }
+  }
+}
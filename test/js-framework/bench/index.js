@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @fileOverview
+ * Bridge throughput benchmark. It replays the DOM operation traces on the
+ * JS runtime with a stand-in native side, and reports the native calls,
+ * the bytes serialized and the JS time per frame of each bridge mode.
+ *
+ * usage:
+ *   npm run bench:bridge -- [options] [trace.json ...]
+ *
+ * options:
+ *   --mode <modes>       comma separated modes: default, encoded, batched
+ *   --runs <n>           repeat times for measuring JS time, 5 by default
+ *   --baseline <file>    fail if native calls or bytes exceed the baseline
+ *   --tolerance <ratio>  allowed growth of bytes, 0.02 by default, since the
+ *                        length of refs grows with the elements created
+ *   --update-baseline    write the results into the baseline file
+ *   --dump <file>        write the native payloads as JSON lines, which can
+ *                        be fed to a native decoder
+ */
+
+import fs from 'fs'
+
+import { Document } from '../../../runtime/vdom'
+import { init } from '../../../runtime/bridge/TaskCenter'
+import { createNative } from './native'
+import { createReplayer } from './trace'
+import createList from './traces/create-list'
+import scrollList from './traces/scroll-list'
+
+const MODES = {
+  default: {},
+  encoded: { env: { elementEncoding: 'json' }},
+  batched: { batched: true }
+}
+
+// relative to the root of the project, where npm scripts run
+const DEFAULT_BASELINE = 'test/js-framework/bench/baseline.json'
+
+function parseArgs (argv) {
+  const options = {
+    modes: Object.keys(MODES),
+    runs: 5,
+    baseline: null,
+    tolerance: 0.02,
+    updateBaseline: false,
+    dump: null,
+    traces: []
+  }
+  for (let i = 0; i < argv.length; i++) {
+    switch (argv[i]) {
+      case '--mode': options.modes = argv[++i].split(','); break
+      case '--runs': options.runs = Math.max(1, parseInt(argv[++i], 10) || 1); break
+      case '--baseline': options.baseline = argv[++i]; break
+      case '--tolerance': options.tolerance = parseFloat(argv[++i]) || 0; break
+      case '--update-baseline': options.updateBaseline = true; break
+      case '--dump': options.dump = argv[++i]; break
+      default: options.traces.push(JSON.parse(fs.readFileSync(argv[i], 'utf8')))
+    }
+  }
+  if (!options.traces.length) {
+    options.traces = [createList, scrollList]
+  }
+  if (options.updateBaseline && !options.baseline) {
+    options.baseline = DEFAULT_BASELINE
+  }
+  return options
+}
+
+function now () {
+  const [s, ns] = process.hrtime()
+  return s * 1e3 + ns / 1e6
+}
+
+let instanceCount = 0
+
+/**
+ * Replay the trace once.
+ * @return {object} native calls, bytes and the JS time of each frame
+ */
+function replayTrace (trace, mode, native) {
+  const { env, batched } = MODES[mode]
+  global.WXEnvironment = env
+  native.reset()
+
+  const doc = new Document(`bench-${++instanceCount}`, '')
+  doc.taskCenter.batched = !!batched
+  const replay = createReplayer(doc)
+
+  // elements take the props objects as their own attr and style
+  const frames = JSON.parse(JSON.stringify(trace.frames))
+  const times = frames.map(frame => {
+    const start = now()
+    replay(frame)
+    doc.taskCenter.flush()
+    return now() - start
+  })
+
+  doc.destroy()
+  delete global.WXEnvironment
+  return { calls: native.calls, actions: native.actions, bytes: native.bytes, times }
+}
+
+function median (list) {
+  const sorted = list.slice().sort((a, b) => a - b)
+  return sorted[Math.floor(sorted.length / 2)]
+}
+
+function measure (trace, mode, native, runs) {
+  let result
+  const frameTimes = []
+  for (let i = 0; i < runs; i++) {
+    result = replayTrace(trace, mode, native)
+    frameTimes.push(result.times)
+  }
+  const frames = trace.frames.length
+  // the median of each frame among all runs
+  const times = trace.frames.map((frame, i) => median(frameTimes.map(run => run[i])))
+  return {
+    calls: result.calls,
+    actions: result.actions,
+    bytes: result.bytes,
+    callsPerFrame: result.calls / frames,
+    bytesPerFrame: result.bytes / frames,
+    msPerFrame: times.reduce((sum, time) => sum + time, 0) / frames,
+    maxMsPerFrame: Math.max(...times)
+  }
+}
+
+function pad (value, width) {
+  const text = String(value)
+  return text.length >= width ? text : ' '.repeat(width - text.length) + text
+}
+
+function report (results) {
+  console.log([
+    pad('trace', 14), pad('mode', 9), pad('calls', 8), pad('actions', 8),
+    pad('calls/f', 9), pad('KB', 9), pad('KB/f', 8), pad('ms/f', 8), pad('max ms', 8)
+  ].join(''))
+  results.forEach(({ trace, mode, result }) => {
+    console.log([
+      pad(trace, 14), pad(mode, 9),
+      pad(result.calls, 8), pad(result.actions, 8),
+      pad(result.callsPerFrame.toFixed(1), 9),
+      pad((result.bytes / 1024).toFixed(1), 9),
+      pad((result.bytesPerFrame / 1024).toFixed(2), 8),
+      pad(result.msPerFrame.toFixed(3), 8),
+      pad(result.maxMsPerFrame.toFixed(3), 8)
+    ].join(''))
+  })
+}
+
+/**
+ * Compare the native calls and bytes with the baseline. JS time is not
+ * compared since it depends on the machine.
+ * @return {array} failures
+ */
+function checkBaseline (results, baseline, tolerance) {
+  const failures = []
+  results.forEach(({ trace, mode, result }) => {
+    const expected = baseline[trace] && baseline[trace][mode]
+    if (!expected) {
+      return
+    }
+    if (result.calls > expected.calls) {
+      failures.push(`${trace} (${mode}): calls ${result.calls} > ${expected.calls}`)
+    }
+    if (result.bytes > expected.bytes * (1 + tolerance)) {
+      failures.push(`${trace} (${mode}): bytes ${result.bytes} > ${expected.bytes}`)
+    }
+  })
+  return failures
+}
+
+function dumpPayloads (file, traces, modes, native) {
+  const lines = []
+  native.record = true
+  traces.forEach(trace => {
+    modes.forEach(mode => {
+      replayTrace(trace, mode, native)
+      native.payloads.forEach(({ api, args }) => {
+        lines.push(JSON.stringify({ trace: trace.name, mode, api, args }))
+      })
+    })
+  })
+  native.record = false
+  fs.writeFileSync(file, lines.join('\n') + '\n')
+}
+
+function main () {
+  const options = parseArgs(process.argv.slice(2))
+  const native = createNative()
+  native.install()
+  init()
+  Document.handler = (id, tasks, callback) => global.callNative(id, tasks, callback)
+
+  const results = []
+  options.traces.forEach(trace => {
+    options.modes.forEach(mode => {
+      if (!MODES[mode]) {
+        throw new Error(`unknown mode "${mode}"`)
+      }
+      results.push({ trace: trace.name, mode, result: measure(trace, mode, native, options.runs) })
+    })
+  })
+  report(results)
+
+  if (options.dump) {
+    dumpPayloads(options.dump, options.traces, options.modes, native)
+  }
+
+  if (options.baseline) {
+    const exists = fs.existsSync(options.baseline)
+    const baseline = exists ? JSON.parse(fs.readFileSync(options.baseline, 'utf8')) : {}
+    if (options.updateBaseline) {
+      results.forEach(({ trace, mode, result }) => {
+        baseline[trace] = baseline[trace] || {}
+        baseline[trace][mode] = { calls: result.calls, bytes: result.bytes }
+      })
+      fs.writeFileSync(options.baseline, JSON.stringify(baseline, null, 2) + '\n')
+      console.log(`baseline updated: ${options.baseline}`)
+    }
+    else {
+      const failures = checkBaseline(results, baseline, options.tolerance)
+      failures.forEach(failure => console.error(`[regression] ${failure}`))
+      if (failures.length) {
+        process.exitCode = 1
+      }
+    }
+  }
+
+  native.uninstall()
+}
+
+main()
@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @fileOverview
+ * A stand-in native side of the bridge. It installs the `global.call*`
+ * functions used by the JS runtime, and counts the native calls and the
+ * bytes which have to be serialized for each call.
+ */
+
+const DOM_APIS = {
+  callCreateBody: 'createBody',
+  callAddElement: 'addElement',
+  callRemoveElement: 'removeElement',
+  callMoveElement: 'moveElement',
+  callUpdateAttrs: 'updateAttrs',
+  callUpdateStyle: 'updateStyle',
+  callAddEvent: 'addEvent',
+  callRemoveEvent: 'removeEvent',
+  callCreateFinish: 'createFinish',
+  callUpdateFinish: 'updateFinish',
+  callRefreshFinish: 'refreshFinish'
+}
+
+/**
+ * The bytes of the arguments which have to be serialized. Pre-encoded
+ * strings are counted as they are.
+ */
+function byteLength (args) {
+  if (!Array.isArray(args)) {
+    args = [args]
+  }
+  return args.reduce((bytes, arg) => {
+    const json = typeof arg === 'string' ? arg : JSON.stringify(arg)
+    return bytes + (json ? Buffer.byteLength(json) : 0)
+  }, 0)
+}
+
+export function createNative () {
+  const native = {
+    calls: 0,
+    bytes: 0,
+    actions: 0,
+    // the payloads received, only kept when `record` is true
+    payloads: [],
+    record: false
+  }
+
+  function receive (api, args, actions) {
+    native.calls++
+    native.actions += actions
+    native.bytes += byteLength(args)
+    if (native.record) {
+      native.payloads.push({ api, args })
+    }
+    return -1
+  }
+
+  native.install = function () {
+    Object.keys(DOM_APIS).forEach(api => {
+      global[api] = (id, ...args) => receive(api, args, 1)
+    })
+    global.callNative = (id, tasks) => {
+      const actions = Array.isArray(tasks) ? tasks.length : 1
+      return receive('callNative', [tasks], actions)
+    }
+    global.callNativeModule = (id, ...args) => receive('callNativeModule', args, 1)
+    global.callNativeComponent = (id, ...args) => receive('callNativeComponent', args, 1)
+  }
+
+  native.uninstall = function () {
+    Object.keys(DOM_APIS).concat([
+      'callNative', 'callNativeModule', 'callNativeComponent'
+    ]).forEach(api => {
+      delete global[api]
+    })
+  }
+
+  native.reset = function () {
+    native.calls = 0
+    native.bytes = 0
+    native.actions = 0
+    native.payloads = []
+  }
+
+  return native
+}
@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @fileOverview
+ * Replay the recorded DOM operations on a vdom document.
+ *
+ * A trace is a JSON object `{ name, frames }`, each frame is a list of
+ * operations which are performed in the same tick:
+ *
+ *   ["body", id, type, props]         create the body element
+ *   ["create", id, type, props]       create an element
+ *   ["append", parentId, id]          append the element to parent
+ *   ["insert", parentId, id, beforeId] insert the element before another one
+ *   ["remove", parentId, id]          remove the element from parent
+ *   ["attr", id, key, value]          set an attribute
+ *   ["style", id, key, value]         set a style
+ *   ["event", id, type]               add an event
+ *   ["finish"]                        send "createFinish"
+ */
+
+export function createReplayer (doc) {
+  const nodes = {}
+
+  const operations = {
+    body (id, type, props) {
+      nodes[id] = doc.createBody(type, props)
+      doc.documentElement.appendChild(nodes[id])
+    },
+    create (id, type, props) {
+      nodes[id] = doc.createElement(type, props)
+    },
+    append (parentId, id) {
+      nodes[parentId].appendChild(nodes[id])
+    },
+    insert (parentId, id, beforeId) {
+      nodes[parentId].insertBefore(nodes[id], nodes[beforeId])
+    },
+    remove (parentId, id) {
+      nodes[parentId].removeChild(nodes[id])
+      delete nodes[id]
+    },
+    attr (id, key, value) {
+      nodes[id].setAttr(key, value)
+    },
+    style (id, key, value) {
+      nodes[id].setStyle(key, value)
+    },
+    event (id, type) {
+      nodes[id].addEvent(type, () => {})
+    },
+    finish () {
+      doc.taskCenter.send('dom', { action: 'createFinish' }, [])
+    }
+  }
+
+  return function replay (frame) {
+    frame.forEach(([name, ...args]) => {
+      operations[name](...args)
+    })
+  }
+}
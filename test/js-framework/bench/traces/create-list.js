@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @fileOverview
+ * First screen creation of a page with a header and a 500 rows list,
+ * each row has an image and two lines of text.
+ */
+
+export const ROW_COUNT = 500
+
+export function createRow (frame, i) {
+  const row = `row${i}`
+  frame.push(
+    ['create', row, 'cell', { attr: { index: i }, style: { flexDirection: 'row', height: 120 }}],
+    ['create', `${row}-image`, 'image', {
+      attr: { src: `https://example.com/images/${i}.jpg` },
+      style: { width: 100, height: 100 }
+    }],
+    ['create', `${row}-title`, 'text', {
+      attr: { value: `Title of row ${i}` },
+      style: { fontSize: 32, color: '#333333' }
+    }],
+    ['create', `${row}-desc`, 'text', {
+      attr: { value: `Description of row ${i}, which is a bit longer than the title` },
+      style: { fontSize: 24, color: '#999999', lines: 2 }
+    }],
+    ['event', row, 'click'],
+    ['append', row, `${row}-image`],
+    ['append', row, `${row}-title`],
+    ['append', row, `${row}-desc`],
+    ['append', 'list', row]
+  )
+  return row
+}
+
+export function createPage (frame) {
+  frame.push(
+    ['body', 'body', 'div', { style: { flex: 1 }}],
+    ['create', 'header', 'div', { style: { height: 88, backgroundColor: '#ffffff' }}],
+    ['create', 'header-title', 'text', { attr: { value: 'Benchmark' }}],
+    ['append', 'header', 'header-title'],
+    ['append', 'body', 'header'],
+    ['create', 'list', 'list', { style: { flex: 1 }}],
+    ['event', 'list', 'scroll'],
+    ['append', 'body', 'list']
+  )
+  for (let i = 0; i < ROW_COUNT; i++) {
+    createRow(frame, i)
+  }
+  frame.push(['finish'])
+}
+
+const frame = []
+createPage(frame)
+
+export default {
+  name: 'create-list',
+  frames: [frame]
+}
@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @fileOverview
+ * Scrolling the 500 rows list for 120 frames. In each frame the visible
+ * rows update their style, and a row is recycled from the top to the
+ * bottom of the list.
+ */
+
+import { ROW_COUNT, createPage } from './create-list'
+
+const FRAME_COUNT = 120
+const VISIBLE_ROWS = 12
+
+const frames = []
+const initial = []
+createPage(initial)
+frames.push(initial)
+
+for (let f = 0; f < FRAME_COUNT; f++) {
+  const frame = []
+  for (let i = 0; i < VISIBLE_ROWS; i++) {
+    const row = `row${(f + i) % ROW_COUNT}`
+    frame.push(
+      ['style', row, 'opacity', i === 0 ? 0.5 : 1],
+      ['style', row, 'transform', `translateY(${-f * 10}px)`]
+    )
+  }
+  frame.push(
+    ['attr', `row${f}-title`, 'value', `Recycled row ${f}`],
+    ['append', 'list', `row${f}`]
+  )
+  frames.push(frame)
+}
+
+export default {
+  name: 'scroll-list',
+  frames
+}
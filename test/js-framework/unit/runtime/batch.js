@@ -0,0 +1,295 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+import chai from 'chai'
+import sinon from 'sinon'
+import sinonChai from 'sinon-chai'
+const { expect } = chai
+chai.use(sinonChai)
+
+import { Document } from '../../../../runtime/vdom'
+import Listener from '../../../../runtime/bridge/Listener'
+import { coalesceActions } from '../../../../runtime/bridge/batch'
+
+function tick () {
+  return Promise.resolve()
+}
+
+function createAction (method, args) {
+  return { module: 'dom', method, args }
+}
+
+describe('coalesce dom actions', () => {
+  it('merges updates of the same element', () => {
+    const actions = coalesceActions([
+      createAction('updateStyle', ['1', { color: 'red' }]),
+      createAction('updateAttrs', ['1', { a: 1 }]),
+      createAction('updateStyle', ['1', { color: 'blue', width: 10 }]),
+      createAction('updateStyle', ['2', { color: 'red' }]),
+      createAction('updateAttrs', ['1', { b: 2 }])
+    ])
+    expect(actions).eql([
+      createAction('updateStyle', ['1', { color: 'blue', width: 10 }]),
+      createAction('updateAttrs', ['1', { a: 1, b: 2 }]),
+      createAction('updateStyle', ['2', { color: 'red' }])
+    ])
+  })
+
+  it('merges updates into the added element', () => {
+    const attr = { a: 1 }
+    const actions = coalesceActions([
+      createAction('addElement', ['_root', {
+        ref: '1', type: 'div', attr, style: {},
+        children: [{ ref: '2', type: 'text', attr: {}, style: {}}]
+      }, -1]),
+      createAction('updateStyle', ['2', { color: 'red' }]),
+      createAction('updateAttrs', ['1', { b: 2 }])
+    ])
+    expect(actions).eql([
+      createAction('addElement', ['_root', {
+        ref: '1', type: 'div', attr: { a: 1, b: 2 }, style: {},
+        children: [{ ref: '2', type: 'text', attr: {}, style: { color: 'red' }}]
+      }, -1])
+    ])
+    expect(attr).eql({ a: 1 })
+  })
+
+  it('drops the elements added and removed in the same batch', () => {
+    const actions = coalesceActions([
+      createAction('addElement', ['_root', { ref: '1', type: 'div' }, -1]),
+      createAction('addElement', ['1', { ref: '2', type: 'div' }, -1]),
+      createAction('updateStyle', ['2', { color: 'red' }]),
+      createAction('addEvent', ['2', 'click']),
+      createAction('updateStyle', ['3', { color: 'red' }]),
+      createAction('removeElement', ['1'])
+    ])
+    expect(actions).eql([
+      createAction('updateStyle', ['3', { color: 'red' }])
+    ])
+  })
+
+  it('drops the updates before removal', () => {
+    const actions = coalesceActions([
+      createAction('updateStyle', ['1', { color: 'red' }]),
+      createAction('addEvent', ['1', 'click']),
+      createAction('removeElement', ['1']),
+      createAction('addElement', ['_root', { ref: '1', type: 'div' }, -1])
+    ])
+    expect(actions).eql([
+      createAction('removeElement', ['1']),
+      createAction('addElement', ['_root', { ref: '1', type: 'div' }, -1])
+    ])
+  })
+
+  it('keeps the removal of moved elements', () => {
+    const actions = coalesceActions([
+      createAction('addElement', ['_root', {
+        ref: '1', type: 'div', children: [{ ref: '2', type: 'div' }]
+      }, -1]),
+      createAction('moveElement', ['2', '_root', 0]),
+      createAction('removeElement', ['1'])
+    ])
+    expect(actions.length).eql(3)
+  })
+
+  it('keeps the removal of elements serialized in a remaining element', () => {
+    const actions = coalesceActions([
+      createAction('addElement', ['_root', {
+        ref: '1', type: 'div', children: [{ ref: '2', type: 'div' }]
+      }, -1]),
+      createAction('updateStyle', ['2', { color: 'red' }]),
+      createAction('removeElement', ['2']),
+      createAction('updateStyle', ['2', { color: 'blue' }])
+    ])
+    expect(actions).eql([
+      createAction('addElement', ['_root', {
+        ref: '1', type: 'div', children: [{ ref: '2', type: 'div', style: { color: 'red' }}]
+      }, -1]),
+      createAction('removeElement', ['2'])
+    ])
+  })
+
+  it('keeps the elements moved out of a removed parent', () => {
+    const actions = coalesceActions([
+      createAction('addElement', ['1', { ref: '3', type: 'div' }, -1]),
+      createAction('moveElement', ['3', '2', 0]),
+      createAction('updateStyle', ['1', { color: 'red' }]),
+      createAction('removeElement', ['1'])
+    ])
+    expect(actions).eql([
+      createAction('addElement', ['1', { ref: '3', type: 'div' }, -1]),
+      createAction('moveElement', ['3', '2', 0]),
+      createAction('removeElement', ['1'])
+    ])
+  })
+
+  it('drops the elements added to a removed parent', () => {
+    const actions = coalesceActions([
+      createAction('addElement', ['1', { ref: '3', type: 'div' }, -1]),
+      createAction('addElement', ['3', { ref: '4', type: 'div' }, -1]),
+      createAction('removeElement', ['1'])
+    ])
+    expect(actions).eql([
+      createAction('removeElement', ['1'])
+    ])
+  })
+
+  it('keeps the removal when a later insertion counts the element', () => {
+    const actions = coalesceActions([
+      createAction('addElement', ['1', { ref: '3', type: 'div' }, 0]),
+      createAction('addElement', ['1', { ref: '4', type: 'div' }, 1]),
+      createAction('removeElement', ['3'])
+    ])
+    expect(actions.length).eql(3)
+  })
+})
+
+describe('batched task center', () => {
+  let doc, spy
+
+  beforeEach(() => {
+    spy = sinon.spy()
+    doc = new Document('foo', '', spy, Listener)
+    doc.taskCenter.batched = true
+    doc.createBody('div')
+    doc.documentElement.appendChild(doc.body)
+  })
+
+  afterEach(() => {
+    doc.destroy()
+  })
+
+  it('sends actions of a tick in one call', () => {
+    return tick().then(() => {
+      spy.resetHistory()
+      const el = doc.createElement('div')
+      doc.body.appendChild(el)
+      el.setStyle('color', 'red')
+      el.setStyle('width', 10)
+      el.setAttr('a', 1)
+      expect(spy.callCount).eql(0)
+      return tick()
+    }).then(() => {
+      expect(spy.callCount).eql(1)
+      const actions = spy.args[0][0]
+      expect(actions.length).eql(1)
+      expect(actions[0].method).eql('addElement')
+      expect(actions[0].args[1].style).eql({ color: 'red', width: 10 })
+      expect(actions[0].args[1].attr).eql({ a: 1 })
+    })
+  })
+
+  it('merges style updates of an existing element', () => {
+    const el = doc.createElement('div')
+    doc.body.appendChild(el)
+    return tick().then(() => {
+      spy.resetHistory()
+      for (let i = 0; i < 10; i++) {
+        el.setStyle('width', i)
+      }
+      return tick()
+    }).then(() => {
+      expect(spy.callCount).eql(1)
+      expect(spy.args[0][0]).eql([
+        createAction('updateStyle', [el.ref, { width: 9 }])
+      ])
+    })
+  })
+
+  it('sends nothing for an element added and removed in one tick', () => {
+    return tick().then(() => {
+      spy.resetHistory()
+      const el = doc.createElement('div')
+      doc.body.appendChild(el)
+      el.setStyle('color', 'red')
+      doc.body.removeChild(el)
+      return tick()
+    }).then(() => {
+      expect(spy.callCount).eql(0)
+    })
+  })
+
+  it('flushes before module calls', () => {
+    const moduleHandler = sinon.stub(doc.taskCenter, 'moduleHandler')
+    return tick().then(() => {
+      spy.resetHistory()
+      const el = doc.createElement('div')
+      doc.body.appendChild(el)
+      doc.taskCenter.send('module', { module: 'modal', method: 'toast' }, [{}])
+      expect(spy.callCount).eql(1)
+      expect(moduleHandler.callCount).eql(1)
+      return tick()
+    }).then(() => {
+      expect(spy.callCount).eql(1)
+      moduleHandler.restore()
+    })
+  })
+
+  it('drops the queued actions after destroy', () => {
+    spy.resetHistory()
+    const el = doc.createElement('div')
+    doc.body.appendChild(el)
+    doc.taskCenter.destroyCallback()
+    return tick().then(() => {
+      expect(spy.callCount).eql(0)
+    })
+  })
+})
+
+describe('batched instances', () => {
+  it('flush all instances once per tick', () => {
+    const spies = [sinon.spy(), sinon.spy()]
+    const docs = spies.map((spy, i) => {
+      const doc = new Document(`batch${i}`, '', spy, Listener)
+      doc.taskCenter.batched = true
+      return doc
+    })
+    docs.forEach(doc => {
+      doc.createBody('div')
+      doc.documentElement.appendChild(doc.body)
+      doc.body.setStyle('color', 'red')
+    })
+    const total = () => spies[0].callCount + spies[1].callCount
+    expect(total()).eql(0)
+    return tick().then(() => {
+      // the last created document owns the task handler
+      expect(total()).eql(2)
+      docs.forEach(doc => doc.destroy())
+    })
+  })
+})
+
+describe('batched listener', () => {
+  it('sends coalesced updates once per tick', () => {
+    const spy = sinon.spy()
+    const listener = new Listener('foo', spy)
+    listener.batched = true
+    listener.setStyle('1', 'color', 'red')
+    listener.setStyle('1', 'width', 10)
+    listener.setAttr('1', 'a', 1)
+    expect(spy.callCount).eql(0)
+    return tick().then(() => {
+      expect(spy.callCount).eql(1)
+      expect(spy.args[0][0]).eql([
+        createAction('updateStyle', ['1', { color: 'red', width: 10 }]),
+        createAction('updateAttrs', ['1', { a: 1 }])
+      ])
+      expect(listener.updates.length).eql(0)
+    })
+  })
+})
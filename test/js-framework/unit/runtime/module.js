@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+import chai from 'chai'
+import sinon from 'sinon'
+import sinonChai from 'sinon-chai'
+const { expect } = chai
+chai.use(sinonChai)
+
+import {
+  registerModules,
+  isRegisteredModule,
+  getModuleDispatchId
+} from '../../../../runtime/api/module'
+import { TaskCenter, init } from '../../../../runtime/bridge/TaskCenter'
+
+describe('module dispatch ids', () => {
+  it('register modules without ids', () => {
+    registerModules({ plain: ['foo', 'bar'] })
+    expect(isRegisteredModule('plain', 'foo')).to.be.true
+    expect(getModuleDispatchId('plain', 'foo')).to.be.null
+  })
+
+  it('register modules with ids', () => {
+    registerModules({ fast: ['foo', 'bar'] }, {
+      fast: { id: 3, methods: { foo: 0, bar: 1 }}
+    })
+    expect(isRegisteredModule('fast', 'bar')).to.be.true
+    expect(getModuleDispatchId('fast', 'foo')).eql([3, 0])
+    expect(getModuleDispatchId('fast', 'bar')).eql([3, 1])
+    expect(getModuleDispatchId('fast', 'baz')).to.be.null
+  })
+
+  it('ignore invalid ids', () => {
+    registerModules({ broken: ['foo'] }, { broken: { methods: { foo: 0 }}})
+    expect(getModuleDispatchId('broken', 'foo')).to.be.null
+  })
+
+  describe('callNativeModule', () => {
+    let originCallNativeModule, spy
+
+    beforeEach(() => {
+      originCallNativeModule = global.callNativeModule
+      spy = sinon.spy()
+      global.callNativeModule = spy
+      init()
+    })
+
+    afterEach(() => {
+      global.callNativeModule = originCallNativeModule
+      init()
+    })
+
+    it('dispatch by ids', () => {
+      registerModules({ stream: ['fetch'] }, {
+        stream: { id: 7, methods: { fetch: 2 }}
+      })
+      const taskCenter = new TaskCenter('dispatch-1')
+      taskCenter.send('module', { module: 'stream', method: 'fetch' }, [{ url: 'a' }])
+      expect(spy.callCount).to.be.equal(1)
+      expect(spy.args[0].slice(0, 4)).eql(['dispatch-1', 7, 2, [{ url: 'a' }]])
+    })
+
+    it('fallback to names for methods without ids', () => {
+      registerModules({ storage: ['getItem', 'setItem'] }, {
+        storage: { id: 8, methods: { getItem: 0 }}
+      })
+      const taskCenter = new TaskCenter('dispatch-3')
+      taskCenter.send('module', { module: 'storage', method: 'getItem' }, ['a'])
+      taskCenter.send('module', { module: 'storage', method: 'setItem' }, ['a', 'b'])
+      expect(spy.callCount).to.be.equal(2)
+      expect(spy.args[0].slice(0, 4)).eql(['dispatch-3', 8, 0, ['a']])
+      expect(spy.args[1].slice(0, 4)).eql(['dispatch-3', 'storage', 'setItem', ['a', 'b']])
+    })
+
+    it('fallback to names', () => {
+      const taskCenter = new TaskCenter('dispatch-2')
+      taskCenter.send('module', { module: 'modal', method: 'toast' }, [{ message: 'a' }])
+      expect(spy.callCount).to.be.equal(1)
+      expect(spy.args[0].slice(0, 4)).eql(['dispatch-2', 'modal', 'toast', [{ message: 'a' }]])
+    })
+  })
+})
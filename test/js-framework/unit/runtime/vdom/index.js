@@ -637,3 +637,94 @@ describe('complicated situations', () => {
       args: [doc.body.ref, el3.toJSON(), 0] }])
   })
 })
+
+describe('serialization cache', () => {
+  let doc, spy
+
+  beforeEach(() => {
+    spy = sinon.spy()
+    doc = new Document('foo', null, spy)
+    doc.createBody('div')
+    doc.documentElement.appendChild(doc.body)
+  })
+
+  afterEach(() => {
+    doc.destroy()
+    delete global.WXEnvironment
+  })
+
+  it('reuses the serialized element', () => {
+    const el = doc.createElement('div', { attr: { a: 1 }})
+    const child = doc.createElement('text')
+    el.appendChild(child)
+    const json = el.toJSON()
+    expect(el.toJSON()).equal(json)
+    expect(json.children[0]).equal(child.toJSON())
+    expect(Object.keys(el)).not.include('serialized')
+  })
+
+  it('resets the cache of changed element and its ancestors', () => {
+    const el = doc.createElement('div')
+    const child = doc.createElement('text')
+    const sibling = doc.createElement('text')
+    el.appendChild(child)
+    el.appendChild(sibling)
+    const json = el.toJSON()
+    const siblingJSON = sibling.toJSON()
+
+    child.setStyle('color', 'red')
+    expect(el.toJSON()).not.equal(json)
+    expect(el.toJSON().children[0].style).eql({ color: 'red' })
+    expect(sibling.toJSON()).equal(siblingJSON)
+
+    const jsonBeforeAttr = el.toJSON()
+    child.setAttr('value', 'abc', true)
+    expect(el.toJSON()).not.equal(jsonBeforeAttr)
+
+    const jsonBeforeEvent = el.toJSON()
+    child.addEvent('click', () => {})
+    expect(el.toJSON()).not.equal(jsonBeforeEvent)
+    expect(el.toJSON().children[0].event).eql(['click'])
+
+    const jsonBeforeRemove = el.toJSON()
+    el.removeChild(sibling)
+    expect(el.toJSON()).not.equal(jsonBeforeRemove)
+    expect(el.toJSON().children.length).eql(1)
+  })
+
+  it('reuses the serialized subtree when inserted', () => {
+    const el = doc.createElement('div')
+    const child = doc.createElement('text')
+    el.appendChild(child)
+    const childJSON = child.toJSON()
+    doc.body.appendChild(el)
+    const json = spy.args[1][0][0].args[1]
+    expect(json.children[0]).equal(childJSON)
+    expect(el.toJSON()).equal(json)
+  })
+
+  it('serializes to the same string as JSON.stringify', () => {
+    const el = doc.createElement('div', {
+      attr: { a: 1, b: 'x"y' },
+      style: { color: 'red' },
+      classStyle: { width: 10 }
+    })
+    el.addEvent('click', () => {}, ['p'])
+    el.appendChild(doc.createElement('text', { attr: { value: 'abc' }}))
+    el.appendChild(doc.createElement('image'))
+    expect(el.toJSONString()).eql(JSON.stringify(el.toJSON()))
+    el.pureChildren[1].setStyle('width', 20)
+    expect(el.toJSONString()).eql(JSON.stringify(el.toJSON()))
+  })
+
+  it('sends pre-encoded elements if native supports', () => {
+    global.WXEnvironment = { elementEncoding: 'json' }
+    const el = doc.createElement('div')
+    el.appendChild(doc.createElement('text'))
+    doc.body.appendChild(el)
+    expect(spy.args[1][0]).eql([{
+      module: 'dom', method: 'addElement',
+      args: [doc.body.ref, JSON.stringify(el.toJSON()), -1]
+    }])
+  })
+})
@@ -0,0 +1,298 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+import chai from 'chai'
+const { expect } = chai
+
+import { Document } from '../../../../../runtime/vdom'
+import { longestIncreasingSubsequence } from '../../../../../runtime/vdom/patch'
+
+function tick () {
+  return Promise.resolve()
+}
+
+/**
+ * A minimal native render tree, which applies the DOM actions the same way
+ * as the native renderers.
+ */
+function createNative () {
+  const nodes = {}
+  const native = { nodes, calls: 0, actions: [] }
+
+  function add (json) {
+    nodes[json.ref] = { ref: json.ref, style: json.style, children: [] }
+    nodes[json.ref].children = (json.children || []).map(child => add(child).ref)
+    return nodes[json.ref]
+  }
+
+  function remove (ref) {
+    nodes[ref].children.forEach(remove)
+    delete nodes[ref]
+  }
+
+  function parentOf (ref) {
+    for (const key in nodes) {
+      if (nodes[key].children.indexOf(ref) >= 0) {
+        return nodes[key]
+      }
+    }
+  }
+
+  native.handler = (actions) => {
+    native.calls++
+    actions.forEach(({ method, args }) => {
+      native.actions.push(method)
+      switch (method) {
+        case 'createBody':
+          add(args[0])
+          break
+        case 'addElement': {
+          const { children } = nodes[args[0]]
+          const node = add(args[1])
+          children.splice(args[2] < 0 ? children.length : args[2], 0, node.ref)
+          break
+        }
+        case 'moveElement': {
+          const [ref, parentRef] = args
+          let index = args[2]
+          const { children } = parentOf(ref)
+          const from = children.indexOf(ref)
+          if (parentRef === parentOf(ref).ref && from < index) {
+            index--
+          }
+          children.splice(from, 1)
+          nodes[parentRef].children.splice(index, 0, ref)
+          break
+        }
+        case 'removeElement': {
+          const { children } = parentOf(args[0])
+          children.splice(children.indexOf(args[0]), 1)
+          remove(args[0])
+          break
+        }
+        case 'updateStyle':
+          Object.assign(nodes[args[0]].style, args[1])
+          break
+      }
+    })
+  }
+
+  native.toJSON = (ref) => {
+    const node = nodes[ref]
+    const json = { ref }
+    if (node.children.length) {
+      json.children = node.children.map(child => native.toJSON(child))
+    }
+    return json
+  }
+
+  return native
+}
+
+function toRefTree (el) {
+  const json = { ref: el.ref }
+  if (el.pureChildren.length) {
+    json.children = el.pureChildren.map(toRefTree)
+  }
+  return json
+}
+
+describe('longest increasing subsequence', () => {
+  it('returns the indexes', () => {
+    expect(longestIncreasingSubsequence([])).eql([])
+    expect(longestIncreasingSubsequence([0, 1, 2])).eql([0, 1, 2])
+    expect(longestIncreasingSubsequence([2, 1, 0])).eql([2])
+    expect(longestIncreasingSubsequence([3, 0, 4, 1, 2])).eql([1, 3, 4])
+    expect(longestIncreasingSubsequence([4, 0, 1, 5, 2, 3])).eql([1, 2, 4, 5])
+  })
+})
+
+describe('patch children', () => {
+  let doc, native, list
+
+  function createRows (count) {
+    const rows = []
+    for (let i = 0; i < count; i++) {
+      rows.push(doc.createElement('cell', { attr: { index: i }}))
+    }
+    return rows
+  }
+
+  // re-insert all the rows in order, the way frameworks update keyed lists
+  function render (rows) {
+    let before = null
+    for (let i = rows.length - 1; i >= 0; i--) {
+      list.insertBefore(rows[i], before)
+      before = rows[i]
+    }
+  }
+
+  beforeEach(() => {
+    native = createNative()
+    doc = new Document('patch', '', native.handler)
+    doc.taskCenter.batched = true
+    doc.createBody('div')
+    list = doc.createElement('list')
+    doc.body.appendChild(list)
+    doc.documentElement.appendChild(doc.body)
+    return tick()
+  })
+
+  afterEach(() => {
+    doc.destroy()
+  })
+
+  it('renders a 500 rows list in one call', () => {
+    native.calls = 0
+    native.actions.length = 0
+    createRows(500).forEach(row => list.appendChild(row))
+    return tick().then(() => {
+      expect(native.calls).eql(1)
+      expect(native.actions.length).eql(500)
+      expect(native.toJSON('_root')).eql(toRefTree(doc.body))
+    })
+  })
+
+  it('moves the sorted rows only', () => {
+    const rows = createRows(500)
+    rows.forEach(row => list.appendChild(row))
+    return tick().then(() => {
+      native.actions.length = 0
+      // move 10 rows from the end to the beginning
+      render(rows.slice(490).concat(rows.slice(0, 490)))
+      return tick()
+    }).then(() => {
+      expect(native.actions).eql(new Array(10).fill('moveElement'))
+      expect(native.toJSON('_root')).eql(toRefTree(doc.body))
+    })
+  })
+
+  it('removes the filtered rows only', () => {
+    const rows = createRows(500)
+    rows.forEach(row => list.appendChild(row))
+    return tick().then(() => {
+      native.actions.length = 0
+      rows.filter((row, i) => i % 50 === 0).forEach(row => list.removeChild(row))
+      return tick()
+    }).then(() => {
+      expect(native.actions).eql(new Array(10).fill('removeElement'))
+      expect(native.toJSON('_root')).eql(toRefTree(doc.body))
+    })
+  })
+
+  it('keeps native in sync with random changes', () => {
+    let rows = createRows(30)
+    rows.forEach(row => list.appendChild(row))
+    let round = 0
+    function shuffle () {
+      const next = rows.filter(() => Math.random() > 0.2)
+        .concat(createRows(Math.floor(Math.random() * 5)))
+      for (let i = next.length - 1; i > 0; i--) {
+        const j = Math.floor(Math.random() * (i + 1))
+        const temp = next[i]
+        next[i] = next[j]
+        next[j] = temp
+      }
+      rows.filter(row => next.indexOf(row) < 0).forEach(row => list.removeChild(row))
+      render(next)
+      rows = next
+      if (rows.length) {
+        rows[0].appendChild(doc.createElement('text'))
+      }
+      return tick().then(() => {
+        expect(native.toJSON('_root')).eql(toRefTree(doc.body))
+        return ++round < 20 && shuffle()
+      })
+    }
+    return tick().then(shuffle)
+  })
+
+  it('moves rows to another list', () => {
+    // the refs of the lists are integer-like, and the first one is lower
+    const lists = [doc.createElement('list'), doc.createElement('list')]
+    const rows = createRows(4)
+    // the removed node keeps its parentNode, frameworks which move keyed
+    // nodes between parents detach it before inserting it
+    function moveTo (row, list, before) {
+      row.parentNode.removeChild(row, true)
+      row.parentNode = null
+      list.insertBefore(row, before)
+    }
+    lists.forEach((list, i) => {
+      doc.body.appendChild(list)
+      list.appendChild(rows[i * 2])
+      list.appendChild(rows[i * 2 + 1])
+    })
+    return tick().then(() => {
+      native.actions.length = 0
+      const row = rows[3]
+      row.appendChild(doc.createElement('text'))
+      moveTo(row, lists[0], rows[0])
+      moveTo(rows[0], lists[1], null)
+      return tick()
+    }).then(() => {
+      expect(native.actions).eql(['removeElement', 'removeElement', 'addElement', 'addElement'])
+      expect(native.toJSON('_root')).eql(toRefTree(doc.body))
+    })
+  })
+
+  it('serializes the latest data of inserted elements', () => {
+    return tick().then(() => {
+      native.actions.length = 0
+      const row = doc.createElement('cell')
+      list.appendChild(row)
+      row.setStyle('color', 'red')
+      row.addEvent('click', () => {})
+      row.appendChild(doc.createElement('text'))
+      return tick()
+    }).then(() => {
+      expect(native.actions).eql(['addElement'])
+      expect(native.toJSON('_root')).eql(toRefTree(doc.body))
+      const row = list.pureChildren[0]
+      expect(native.nodes[row.ref].style).eql({ color: 'red' })
+    })
+  })
+
+  it('sends nothing for elements inserted and removed in one tick', () => {
+    return tick().then(() => {
+      native.calls = 0
+      const row = doc.createElement('cell')
+      list.appendChild(row)
+      row.setStyle('color', 'red')
+      list.removeChild(row)
+      return tick()
+    }).then(() => {
+      expect(native.calls).eql(0)
+    })
+  })
+
+  it('drops the updates of removed elements', () => {
+    const rows = createRows(2)
+    rows.forEach(row => list.appendChild(row))
+    return tick().then(() => {
+      native.actions.length = 0
+      list.removeChild(rows[0], true)
+      rows[0].setStyle('color', 'red')
+      rows[1].setStyle('color', 'blue')
+      return tick()
+    }).then(() => {
+      expect(native.actions).eql(['removeElement', 'updateStyle'])
+      expect(native.nodes[rows[1].ref].style).eql({ color: 'blue' })
+    })
+  })
+})